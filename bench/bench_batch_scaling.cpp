@@ -0,0 +1,84 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <print>
+#include <thread>
+#include <vector>
+#include "cpu6502/batch.hpp"
+#include "cpu6502/opcodes.hpp"
+
+// Batch scaling benchmark: runs the same job set with 1..N worker threads and
+// reports throughput, speedup and parallel efficiency relative to one thread.
+//
+// Usage: bench_batch_scaling [max_threads] [job_count]
+
+namespace
+{
+
+using namespace cpu6502;
+
+// Mixes the seed in A through 200 rounds of ADC/EOR, then stops on BRK
+constexpr std::array<u8, 12> kProgram = {
+    static_cast<u8>(Opcode::LDX_IM), 0x00,  // $8000 LDX #$00
+    static_cast<u8>(Opcode::ADC_IM), 0x07,  // $8002 ADC #$07
+    static_cast<u8>(Opcode::EOR_IM), 0x5A,  // $8004 EOR #$5A
+    static_cast<u8>(Opcode::INX),           // $8006 INX
+    static_cast<u8>(Opcode::CPX_IM), 0xC8,  // $8007 CPX #$C8
+    static_cast<u8>(Opcode::BNE),    0xF7,  // $8009 BNE $8002
+    static_cast<u8>(Opcode::BRK),           // $800B BRK
+};
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    const unsigned hardware    = std::max(std::thread::hardware_concurrency(), 1u);
+    const unsigned max_threads = argc > 1 ? static_cast<unsigned>(std::atoi(argv[1])) : hardware;
+    const auto     job_count   = argc > 2 ? static_cast<std::size_t>(std::atol(argv[2])) : 20000;
+
+    std::vector<BatchJob> jobs(job_count);
+    for (std::size_t i = 0; i < jobs.size(); ++i)
+        {
+            jobs[i].image            = kProgram;
+            jobs[i].registers.pc     = 0x8000;
+            jobs[i].registers.a      = static_cast<u8>(i);
+            jobs[i].stop.stop_on_brk = true;
+        }
+    std::vector<BatchResult> results(jobs.size());
+
+    std::println("Batch scaling: {} jobs, 1..{} threads", jobs.size(), max_threads);
+    std::println("{:>8} {:>12} {:>14} {:>10} {:>11}", "threads", "time (ms)", "jobs/s",
+                 "speedup", "efficiency");
+
+    double baseline_seconds = 0.0;
+    for (unsigned threads = 1; threads <= std::max(max_threads, 1u); ++threads)
+        {
+            BatchRunner runner(threads);
+            runner.run(jobs, results);  // Warm-up: touch every slot's memory once
+
+            const auto start = std::chrono::steady_clock::now();
+            runner.run(jobs, results);
+            const auto end = std::chrono::steady_clock::now();
+
+            const double seconds = std::chrono::duration<double>(end - start).count();
+            if (threads == 1)
+                baseline_seconds = seconds;
+
+            const double speedup = baseline_seconds / seconds;
+            std::println("{:>8} {:>12.3f} {:>14.0f} {:>9.2f}x {:>10.1f}%", threads, seconds * 1e3,
+                         static_cast<double>(jobs.size()) / seconds, speedup,
+                         100.0 * speedup / threads);
+        }
+
+    const auto failed = std::ranges::count_if(results, [](const BatchResult& result) {
+        return !result.outcome || result.outcome->reason != StopReason::Brk;
+    });
+    if (failed != 0)
+        {
+            std::println("{} jobs did not stop on BRK", failed);
+            return 1;
+        }
+
+    return 0;
+}
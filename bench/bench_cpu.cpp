@@ -0,0 +1,614 @@
+#include <benchmark/benchmark.h>
+#include <array>
+#include <optional>
+#include <ostream>
+#include <span>
+#include <streambuf>
+#include <string>
+#include <vector>
+#include "cpu6502/cpu.hpp"
+#include "cpu6502/disassembler.hpp"
+#include "cpu6502/opcodes.hpp"
+#include "cpu6502/rewind.hpp"
+
+// Micro benchmarks: every implemented opcode in every addressing mode, opcode
+// dispatch, Memory::read_word, the disassembler and rewind recording. Each
+// opcode case runs a block of identical instructions through CPU::execute and
+// reports emulated instructions and cycles per second.
+//
+// Usage: cpu6502_bench [--benchmark_filter=regex]
+//                      [--benchmark_out=file.json --benchmark_out_format=json]
+// The run_cpu6502_bench target writes cpu6502_bench.json in the build directory.
+
+namespace
+{
+
+using namespace cpu6502;
+
+constexpr u16 CODE        = 0x8000;
+constexpr u16 SUBROUTINE  = 0x9000;
+constexpr int BLOCK       = 64;  // Instructions per benchmark iteration
+constexpr u8  ZP_OPERAND  = 0x10;
+constexpr u8  ZP_POINTER  = 0x40;  // (zp,X) with X = SAME_PAGE_INDEX and (zp),Y
+constexpr u16 ABS_OPERAND = 0x2000;
+constexpr u16 ABS_INDEXED = 0x20F0;  // Base for abs,X/Y and (zp),Y
+
+constexpr u8 SAME_PAGE_INDEX  = 0x08;  // $20F0 + $08 stays on page $20
+constexpr u8 CROSS_PAGE_INDEX = 0x20;  // $20F0 + $20 crosses into page $21
+
+enum class Mode : u8
+{
+    Implied,
+    Immediate,
+    ZeroPage,
+    ZeroPageX,
+    ZeroPageY,
+    Absolute,
+    AbsoluteX,
+    AbsoluteY,
+    IndirectX,
+    IndirectY,
+    Relative
+};
+
+enum class Variant : u8
+{
+    None,
+    PageCross,  // Indexed operand lands on the next page
+    Taken,      // Branch condition holds
+    NotTaken
+};
+
+struct Case
+{
+    Opcode  opcode;
+    Mode    mode;
+    Variant variant = Variant::None;
+};
+
+constexpr std::array kCases = {
+    Case{Opcode::LDA_IM, Mode::Immediate},
+    Case{Opcode::LDA_ZP, Mode::ZeroPage},
+    Case{Opcode::LDA_ZPX, Mode::ZeroPageX},
+    Case{Opcode::LDA_ABS, Mode::Absolute},
+    Case{Opcode::LDA_ABSX, Mode::AbsoluteX},
+    Case{Opcode::LDA_ABSX, Mode::AbsoluteX, Variant::PageCross},
+    Case{Opcode::LDA_ABSY, Mode::AbsoluteY},
+    Case{Opcode::LDA_ABSY, Mode::AbsoluteY, Variant::PageCross},
+
+    Case{Opcode::LDX_IM, Mode::Immediate},
+    Case{Opcode::LDX_ZP, Mode::ZeroPage},
+    Case{Opcode::LDX_ZPY, Mode::ZeroPageY},
+    Case{Opcode::LDX_ABS, Mode::Absolute},
+    Case{Opcode::LDX_ABSY, Mode::AbsoluteY},
+    Case{Opcode::LDX_ABSY, Mode::AbsoluteY, Variant::PageCross},
+
+    Case{Opcode::LDY_IM, Mode::Immediate},
+    Case{Opcode::LDY_ZP, Mode::ZeroPage},
+    Case{Opcode::LDY_ZPX, Mode::ZeroPageX},
+    Case{Opcode::LDY_ABS, Mode::Absolute},
+    Case{Opcode::LDY_ABSX, Mode::AbsoluteX},
+    Case{Opcode::LDY_ABSX, Mode::AbsoluteX, Variant::PageCross},
+
+    Case{Opcode::ADC_IM, Mode::Immediate},
+    Case{Opcode::ADC_ZP, Mode::ZeroPage},
+    Case{Opcode::ADC_ZPX, Mode::ZeroPageX},
+    Case{Opcode::ADC_ABS, Mode::Absolute},
+    Case{Opcode::ADC_ABSX, Mode::AbsoluteX},
+    Case{Opcode::ADC_ABSX, Mode::AbsoluteX, Variant::PageCross},
+    Case{Opcode::ADC_ABSY, Mode::AbsoluteY},
+    Case{Opcode::ADC_ABSY, Mode::AbsoluteY, Variant::PageCross},
+    Case{Opcode::ADC_INDX, Mode::IndirectX},
+    Case{Opcode::ADC_INDY, Mode::IndirectY},
+    Case{Opcode::ADC_INDY, Mode::IndirectY, Variant::PageCross},
+
+    Case{Opcode::AND_IM, Mode::Immediate},
+    Case{Opcode::AND_ZP, Mode::ZeroPage},
+    Case{Opcode::AND_ZPX, Mode::ZeroPageX},
+    Case{Opcode::AND_ABS, Mode::Absolute},
+    Case{Opcode::AND_ABSX, Mode::AbsoluteX},
+    Case{Opcode::AND_ABSX, Mode::AbsoluteX, Variant::PageCross},
+    Case{Opcode::AND_ABSY, Mode::AbsoluteY},
+    Case{Opcode::AND_ABSY, Mode::AbsoluteY, Variant::PageCross},
+    Case{Opcode::AND_INDX, Mode::IndirectX},
+    Case{Opcode::AND_INDY, Mode::IndirectY},
+    Case{Opcode::AND_INDY, Mode::IndirectY, Variant::PageCross},
+
+    Case{Opcode::EOR_IM, Mode::Immediate},
+    Case{Opcode::EOR_ZP, Mode::ZeroPage},
+    Case{Opcode::EOR_ZPX, Mode::ZeroPageX},
+    Case{Opcode::EOR_ABS, Mode::Absolute},
+    Case{Opcode::EOR_ABSX, Mode::AbsoluteX},
+    Case{Opcode::EOR_ABSX, Mode::AbsoluteX, Variant::PageCross},
+    Case{Opcode::EOR_ABSY, Mode::AbsoluteY},
+    Case{Opcode::EOR_ABSY, Mode::AbsoluteY, Variant::PageCross},
+    Case{Opcode::EOR_INDX, Mode::IndirectX},
+    Case{Opcode::EOR_INDY, Mode::IndirectY},
+    Case{Opcode::EOR_INDY, Mode::IndirectY, Variant::PageCross},
+
+    Case{Opcode::ASL_A, Mode::Implied},
+    Case{Opcode::ASL_ZP, Mode::ZeroPage},
+    Case{Opcode::ASL_ZPX, Mode::ZeroPageX},
+    Case{Opcode::ASL_ABS, Mode::Absolute},
+    Case{Opcode::ASL_ABSX, Mode::AbsoluteX},
+
+    Case{Opcode::CMP_IM, Mode::Immediate},
+    Case{Opcode::CMP_ZP, Mode::ZeroPage},
+    Case{Opcode::CMP_ZPX, Mode::ZeroPageX},
+    Case{Opcode::CMP_ABS, Mode::Absolute},
+    Case{Opcode::CMP_ABSX, Mode::AbsoluteX},
+    Case{Opcode::CMP_ABSX, Mode::AbsoluteX, Variant::PageCross},
+    Case{Opcode::CMP_ABSY, Mode::AbsoluteY},
+    Case{Opcode::CMP_ABSY, Mode::AbsoluteY, Variant::PageCross},
+    Case{Opcode::CMP_INDX, Mode::IndirectX},
+    Case{Opcode::CMP_INDY, Mode::IndirectY},
+    Case{Opcode::CMP_INDY, Mode::IndirectY, Variant::PageCross},
+    Case{Opcode::CPX_IM, Mode::Immediate},
+    Case{Opcode::CPX_ZP, Mode::ZeroPage},
+    Case{Opcode::CPX_ABS, Mode::Absolute},
+    Case{Opcode::CPY_IM, Mode::Immediate},
+    Case{Opcode::CPY_ZP, Mode::ZeroPage},
+    Case{Opcode::CPY_ABS, Mode::Absolute},
+
+    Case{Opcode::BIT_ZP, Mode::ZeroPage},
+    Case{Opcode::BIT_ABS, Mode::Absolute},
+
+    Case{Opcode::INC_ZP, Mode::ZeroPage},
+    Case{Opcode::INC_ZPX, Mode::ZeroPageX},
+    Case{Opcode::INC_ABS, Mode::Absolute},
+    Case{Opcode::INC_ABSX, Mode::AbsoluteX},
+    Case{Opcode::DEC_ZP, Mode::ZeroPage},
+    Case{Opcode::DEC_ZPX, Mode::ZeroPageX},
+    Case{Opcode::DEC_ABS, Mode::Absolute},
+    Case{Opcode::DEC_ABSX, Mode::AbsoluteX},
+    Case{Opcode::INX, Mode::Implied},
+    Case{Opcode::INY, Mode::Implied},
+    Case{Opcode::DEX, Mode::Implied},
+    Case{Opcode::DEY, Mode::Implied},
+
+    Case{Opcode::CLC, Mode::Implied},
+    Case{Opcode::CLD, Mode::Implied},
+    Case{Opcode::CLI, Mode::Implied},
+    Case{Opcode::CLV, Mode::Implied},
+
+    Case{Opcode::BCC, Mode::Relative, Variant::Taken},
+    Case{Opcode::BCC, Mode::Relative, Variant::NotTaken},
+    Case{Opcode::BCS, Mode::Relative, Variant::Taken},
+    Case{Opcode::BCS, Mode::Relative, Variant::NotTaken},
+    Case{Opcode::BEQ, Mode::Relative, Variant::Taken},
+    Case{Opcode::BEQ, Mode::Relative, Variant::NotTaken},
+    Case{Opcode::BNE, Mode::Relative, Variant::Taken},
+    Case{Opcode::BNE, Mode::Relative, Variant::NotTaken},
+    Case{Opcode::BMI, Mode::Relative, Variant::Taken},
+    Case{Opcode::BMI, Mode::Relative, Variant::NotTaken},
+    Case{Opcode::BPL, Mode::Relative, Variant::Taken},
+    Case{Opcode::BPL, Mode::Relative, Variant::NotTaken},
+    Case{Opcode::BVC, Mode::Relative, Variant::Taken},
+    Case{Opcode::BVC, Mode::Relative, Variant::NotTaken},
+    Case{Opcode::BVS, Mode::Relative, Variant::Taken},
+    Case{Opcode::BVS, Mode::Relative, Variant::NotTaken},
+
+    Case{Opcode::JSR, Mode::Absolute},  // Paired with an RTS at SUBROUTINE
+    Case{Opcode::BRK, Mode::Implied},
+};
+
+[[nodiscard]] constexpr u8 byte(Opcode opcode) noexcept
+{
+    return static_cast<u8>(opcode);
+}
+
+// Status byte under which a branch is taken (or not)
+[[nodiscard]] constexpr u8 branch_flags(Opcode opcode, bool taken) noexcept
+{
+    switch (opcode)
+        {
+            case Opcode::BCC:
+                return taken ? 0x00 : 0x01;
+            case Opcode::BCS:
+                return taken ? 0x01 : 0x00;
+            case Opcode::BEQ:
+                return taken ? 0x02 : 0x00;
+            case Opcode::BNE:
+                return taken ? 0x00 : 0x02;
+            case Opcode::BMI:
+                return taken ? 0x80 : 0x00;
+            case Opcode::BPL:
+                return taken ? 0x00 : 0x80;
+            case Opcode::BVS:
+                return taken ? 0x40 : 0x00;
+            case Opcode::BVC:
+                return taken ? 0x00 : 0x40;
+            default:
+                return 0x00;
+        }
+}
+
+[[nodiscard]] std::string case_name(const Case& c)
+{
+    std::string name = std::string("op/") + opcode_name(c.opcode);
+    switch (c.variant)
+        {
+            case Variant::None:
+                break;
+            case Variant::PageCross:
+                name += "/page_cross";
+                break;
+            case Variant::Taken:
+                name += "/taken";
+                break;
+            case Variant::NotTaken:
+                name += "/not_taken";
+                break;
+        }
+    return name;
+}
+
+// Encodes one instruction of the case; returns its length
+[[nodiscard]] u16 encode(const Case& c, u8* out) noexcept
+{
+    out[0] = byte(c.opcode);
+    switch (c.mode)
+        {
+            case Mode::Implied:
+                return 1;
+            case Mode::Immediate:
+                out[1] = 0x5A;
+                return 2;
+            case Mode::ZeroPage:
+            case Mode::ZeroPageX:
+            case Mode::ZeroPageY:
+                out[1] = ZP_OPERAND;
+                return 2;
+            case Mode::IndirectX:
+            case Mode::IndirectY:
+                out[1] = ZP_POINTER;
+                return 2;
+            case Mode::Relative:
+                out[1] = 0x00;  // Taken or not, execution falls through to the next branch
+                return 2;
+            case Mode::Absolute:
+                {
+                    const u16 target = c.opcode == Opcode::JSR ? SUBROUTINE : ABS_OPERAND;
+                    out[1]           = static_cast<u8>(target & 0xFF);
+                    out[2]           = static_cast<u8>(target >> 8);
+                    return 3;
+                }
+            case Mode::AbsoluteX:
+            case Mode::AbsoluteY:
+                out[1] = static_cast<u8>(ABS_INDEXED & 0xFF);
+                out[2] = static_cast<u8>(ABS_INDEXED >> 8);
+                return 3;
+        }
+    return 1;
+}
+
+/**
+ * @type struct
+ * @brief Machine primed with a block of BLOCK instructions at CODE
+ */
+struct Fixture
+{
+    Memory    memory;
+    CPU       cpu;
+    Registers start{};
+    i32       budget = 0;  // Cycles CPU::execute needs for exactly one block
+
+    // Fills memory and measures the block once with CPU::step; false if it faults
+    [[nodiscard]] bool prepare(std::span<const u8> code, u8 index, u8 flags)
+    {
+        (void)memory.load(CODE, code);
+        memory[SUBROUTINE] = byte(Opcode::RTS);
+        (void)memory.write_word(0xFFFE, CODE);  // BRK lands on the first BRK again
+
+        for (u16 offset = 0; offset < 0x100; ++offset)
+            {
+                memory[static_cast<u16>(0x2000 + offset)] = static_cast<u8>(offset * 7);
+                memory[static_cast<u16>(0x2100 + offset)] = static_cast<u8>(offset * 13);
+            }
+        memory[ZP_OPERAND]                           = 0x33;
+        memory[static_cast<u16>(ZP_OPERAND + index)] = 0x44;
+        (void)memory.write_word(ZP_POINTER, ABS_INDEXED);
+        (void)memory.write_word(static_cast<u16>(ZP_POINTER + index), ABS_INDEXED);
+
+        start.pc    = CODE;
+        start.sp    = 0xFF;
+        start.a     = 0x21;
+        start.x     = index;
+        start.y     = index;
+        start.flags = StatusFlags{}.from_byte(flags);
+
+        cpu.set_registers(start);
+        budget = 0;
+        for (int i = 0; i < BLOCK; ++i)
+            {
+                auto cycles = cpu.step(memory);
+                if (!cycles)
+                    return false;
+                budget += *cycles;
+            }
+        return true;
+    }
+
+    void run_block(benchmark::State& state)
+    {
+        for (auto _ : state)
+            {
+                cpu.set_registers(start);
+                auto cycles = cpu.execute(budget, memory);
+                benchmark::DoNotOptimize(cycles);
+            }
+
+        state.SetItemsProcessed(state.iterations() * BLOCK);
+        state.counters["emulated_cycles"] = benchmark::Counter(
+            static_cast<double>(budget), benchmark::Counter::kIsIterationInvariantRate);
+    }
+};
+
+void bench_opcode(benchmark::State& state, Case c)
+{
+    std::array<u8, 3 * BLOCK> code{};
+    u16                       length = 0;
+    for (int i = 0; i < BLOCK; ++i)
+        length = static_cast<u16>(length + encode(c, code.data() + length));
+
+    const u8 index = c.variant == Variant::PageCross ? CROSS_PAGE_INDEX : SAME_PAGE_INDEX;
+    const u8 flags = c.mode == Mode::Relative ? branch_flags(c.opcode, c.variant == Variant::Taken)
+                                              : 0x00;
+
+    Fixture fixture;
+    if (!fixture.prepare(std::span(code).first(length), index, flags))
+        {
+            state.SkipWithError("block faulted");
+            return;
+        }
+    fixture.run_block(state);
+}
+
+// Implied two-cycle opcodes in a fixed pseudo-random order: the switch sees an
+// unpredictable target every instruction instead of the same one
+void bench_dispatch_mixed(benchmark::State& state)
+{
+    constexpr std::array kImplied = {Opcode::INX, Opcode::INY, Opcode::DEX, Opcode::DEY,
+                                     Opcode::CLC, Opcode::CLD, Opcode::CLV, Opcode::CLI};
+
+    std::array<u8, BLOCK> code{};
+    u32                   seed = 0x6502;
+    for (u8& instruction : code)
+        {
+            seed ^= seed << 13;
+            seed ^= seed >> 17;
+            seed ^= seed << 5;
+            instruction = byte(kImplied[seed % kImplied.size()]);
+        }
+
+    Fixture fixture;
+    if (!fixture.prepare(code, 0, 0))
+        {
+            state.SkipWithError("block faulted");
+            return;
+        }
+    fixture.run_block(state);
+}
+
+// Same block as op/INX, one CPU::step call per instruction
+void bench_dispatch_step(benchmark::State& state)
+{
+    std::array<u8, BLOCK> code{};
+    code.fill(byte(Opcode::INX));
+
+    Fixture fixture;
+    if (!fixture.prepare(code, 0, 0))
+        {
+            state.SkipWithError("block faulted");
+            return;
+        }
+
+    for (auto _ : state)
+        {
+            fixture.cpu.set_registers(fixture.start);
+            for (int i = 0; i < BLOCK; ++i)
+                {
+                    auto cycles = fixture.cpu.step(fixture.memory);
+                    benchmark::DoNotOptimize(cycles);
+                }
+        }
+    state.SetItemsProcessed(state.iterations() * BLOCK);
+}
+
+// Same block as op/INX through CPU::run, with an optional breakpoint that is
+// never reached. A breakpoint is a trap opcode in memory, so none of the
+// three should differ: the opcode fetch never looks at the trap table.
+void bench_run_breakpoints(benchmark::State& state, std::optional<u16> breakpoint)
+{
+    std::array<u8, BLOCK> code{};
+    code.fill(byte(Opcode::INX));
+
+    Fixture fixture;
+    if (!fixture.prepare(code, 0, 0))
+        {
+            state.SkipWithError("block faulted");
+            return;
+        }
+
+    StopCondition stop;
+    stop.max_cycles = static_cast<u64>(fixture.budget);
+    if (breakpoint)
+        fixture.memory.set_trap(*breakpoint);
+
+    for (auto _ : state)
+        {
+            fixture.cpu.set_registers(fixture.start);
+            auto result = fixture.cpu.run(stop, fixture.memory);
+            benchmark::DoNotOptimize(result);
+        }
+    state.SetItemsProcessed(state.iterations() * BLOCK);
+}
+
+// One million cycles of a loop that writes the zero page and page 3, plain
+// CPU::run against RewindBuffer::run capturing every interval cycles
+void bench_rewind(benchmark::State& state, std::optional<u64> interval)
+{
+    constexpr u64 CYCLES = 1'000'000;
+
+    constexpr std::array code = {
+        byte(Opcode::INC_ZP),   ZP_OPERAND,                 // INC $10
+        byte(Opcode::INC_ABSX), u8{0x00},   u8{0x03},       // INC $0300,X
+        byte(Opcode::INX),                                  //
+        byte(Opcode::ADC_IM),   u8{0x07},                   // ADC #$07
+        byte(Opcode::CLV),                                  //
+        byte(Opcode::BVC),      u8{0xF5},                   // BVC back to the INC
+    };
+
+    Fixture fixture;
+    if (!fixture.prepare(code, 0, 0))
+        {
+            state.SkipWithError("block faulted");
+            return;
+        }
+
+    StopCondition stop;
+    stop.max_cycles = CYCLES;
+
+    for (auto _ : state)
+        {
+            fixture.cpu.set_registers(fixture.start);
+            if (interval)
+                {
+                    RewindBuffer rewind(RewindConfig{.interval = *interval});
+                    auto         result = rewind.run(stop, fixture.cpu, fixture.memory);
+                    benchmark::DoNotOptimize(result);
+                }
+            else
+                {
+                    auto result = fixture.cpu.run(stop, fixture.memory);
+                    benchmark::DoNotOptimize(result);
+                }
+        }
+    state.counters["emulated_cycles"] = benchmark::Counter(
+        static_cast<double>(CYCLES), benchmark::Counter::kIsIterationInvariantRate);
+}
+
+/**
+ * @type class
+ * @brief Device returning the low address byte, for the I/O read path
+ */
+class EchoDevice final : public IoDevice
+{
+ public:
+    u8   read(u16 address) override { return static_cast<u8>(address & 0xFF); }
+    void write(u16, u8) override {}
+};
+
+// Reads 256 words starting at base, stepping by stride
+void bench_read_word(benchmark::State& state, u16 base, u16 stride, bool io)
+{
+    Memory     memory;
+    EchoDevice device;
+    if (io)
+        memory.map_io(static_cast<u8>(base >> 8), &device);
+
+    for (auto _ : state)
+        {
+            u16 address = base;
+            for (int i = 0; i < 256; ++i)
+                {
+                    auto word = memory.read_word(address);
+                    benchmark::DoNotOptimize(word);
+                    address = static_cast<u16>(address + stride);
+                }
+        }
+    state.SetItemsProcessed(state.iterations() * 256);
+}
+
+// Fills all 64K with the same repeating mix of one, two and three byte instructions
+[[nodiscard]] Memory disassembly_image()
+{
+    constexpr std::array<u8, 6> pattern = {byte(Opcode::LDA_ABSX), 0x10, 0x20,
+                                           byte(Opcode::BNE), 0xFB, byte(Opcode::INX)};
+    Memory memory;
+    for (u32 address = 0; address < Memory::MAX_MEM; ++address)
+        memory[static_cast<u16>(address)] = pattern[address % pattern.size()];
+    return memory;
+}
+
+// Linear sweep of the whole address space into records
+void bench_disassemble_records(benchmark::State& state)
+{
+    const Memory             memory = disassembly_image();
+    std::vector<Instruction> out(Memory::MAX_MEM);
+
+    std::size_t count = 0;
+    for (auto _ : state)
+        {
+            count = disassemble(memory, 0x0000, Memory::MAX_MEM, out);
+            benchmark::DoNotOptimize(out.data());
+        }
+    state.SetItemsProcessed(state.iterations() * static_cast<i64>(count));
+}
+
+/**
+ * @type class
+ * @brief Stream buffer that discards its input, so only formatting is measured
+ */
+class NullBuffer final : public std::streambuf
+{
+ protected:
+    std::streamsize xsputn(const char*, std::streamsize count) override { return count; }
+    int_type        overflow(int_type c) override { return traits_type::not_eof(c); }
+};
+
+// Listing of the whole address space as text
+void bench_disassemble_text(benchmark::State& state)
+{
+    const Memory memory = disassembly_image();
+    NullBuffer   buffer;
+    std::ostream out(&buffer);
+
+    for (auto _ : state)
+        {
+            DisassemblyWriter writer(out);
+            writer.write(memory, 0x0000, Memory::MAX_MEM);
+        }
+    state.SetItemsProcessed(state.iterations() * Memory::MAX_MEM / 2);  // 2 bytes/instruction
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    for (const Case& c : kCases)
+        benchmark::RegisterBenchmark(case_name(c).c_str(), bench_opcode, c);
+
+    benchmark::RegisterBenchmark("dispatch/mixed_implied", bench_dispatch_mixed);
+    benchmark::RegisterBenchmark("dispatch/step_per_instruction", bench_dispatch_step);
+
+    benchmark::RegisterBenchmark("run/no_breakpoints", bench_run_breakpoints, std::nullopt);
+    benchmark::RegisterBenchmark("run/breakpoint_other_page", bench_run_breakpoints,
+                                 std::optional<u16>{0x9000});
+    benchmark::RegisterBenchmark("run/breakpoint_same_page", bench_run_breakpoints,
+                                 std::optional<u16>{0x80F0});
+
+    benchmark::RegisterBenchmark("rewind/plain_run", bench_rewind, std::nullopt);
+    benchmark::RegisterBenchmark("rewind/interval_10000", bench_rewind, std::optional<u64>{10'000});
+    benchmark::RegisterBenchmark("rewind/interval_100000", bench_rewind,
+                                 std::optional<u64>{100'000});
+
+    benchmark::RegisterBenchmark("read_word/ram", bench_read_word, u16{0x2000}, u16{2}, false);
+    benchmark::RegisterBenchmark("read_word/ram_unaligned", bench_read_word, u16{0x2001}, u16{1},
+                                 false);
+    benchmark::RegisterBenchmark("read_word/page_boundary", bench_read_word, u16{0x20FF}, u16{0},
+                                 false);
+    benchmark::RegisterBenchmark("read_word/io_page", bench_read_word, u16{0xD000}, u16{0},
+                                 true);
+
+    benchmark::RegisterBenchmark("disassemble/64k_records", bench_disassemble_records);
+    benchmark::RegisterBenchmark("disassemble/64k_text", bench_disassemble_text);
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+        return 1;
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
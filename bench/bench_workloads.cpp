@@ -0,0 +1,409 @@
+#include <charconv>
+#include <chrono>
+#include <format>
+#include <fstream>
+#include <optional>
+#include <print>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "workloads.hpp"
+
+// Macro benchmark: runs each workload in workloads.hpp until min-time has
+// passed, reports emulated MHz and instructions per second, optionally writes
+// the results as JSON and compares them with a baseline written the same way.
+//
+// Usage: bench_workloads [--filter=substring] [--min-time=seconds]
+//                        [--json=results.json]
+//                        [--baseline=baseline.json] [--threshold=percent]
+//
+// Exit status: 0 ok, 1 a workload is slower than the baseline by more than the
+// threshold (default 5%), 2 bad arguments, an unreadable baseline or a
+// workload that produced the wrong result.
+
+namespace
+{
+
+using namespace cpu6502;
+
+struct Options
+{
+    std::string_view filter;
+    double           min_time  = 0.5;
+    double           threshold = 5.0;  // Percent
+    std::string      json;
+    std::string      baseline;
+};
+
+struct Result
+{
+    std::string_view name;
+    u64              runs         = 0;
+    u64              instructions = 0;  // Per run
+    u64              cycles       = 0;  // Per run
+    double           seconds      = 0.0;  // Over all runs, emulation only
+
+    [[nodiscard]] double mhz() const noexcept
+    {
+        return static_cast<double>(cycles * runs) / seconds / 1e6;
+    }
+
+    [[nodiscard]] double ips() const noexcept
+    {
+        return static_cast<double>(instructions * runs) / seconds;
+    }
+};
+
+struct BaselineEntry
+{
+    std::string name;
+    double      ips = 0.0;
+};
+
+[[nodiscard]] bool parse_double(std::string_view text, double& value) noexcept
+{
+    const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+    return error == std::errc{} && end == text.data() + text.size();
+}
+
+[[nodiscard]] std::optional<Options> parse_options(int argc, char** argv)
+{
+    Options options;
+    for (int i = 1; i < argc; ++i)
+        {
+            const std::string_view arg(argv[i]);
+            const auto             equals = arg.find('=');
+            const std::string_view key    = arg.substr(0, equals);
+            const std::string_view value =
+                equals == std::string_view::npos ? std::string_view{} : arg.substr(equals + 1);
+
+            bool ok = true;
+            if (key == "--filter")
+                options.filter = value;
+            else if (key == "--min-time")
+                ok = parse_double(value, options.min_time) && options.min_time > 0.0;
+            else if (key == "--threshold")
+                ok = parse_double(value, options.threshold) && options.threshold >= 0.0;
+            else if (key == "--json")
+                options.json = value;
+            else if (key == "--baseline")
+                options.baseline = value;
+            else
+                ok = false;
+
+            if (!ok)
+                {
+                    std::println(stderr, "bench_workloads: bad argument '{}'", arg);
+                    return std::nullopt;
+                }
+        }
+    return options;
+}
+
+// Loads the workload into a fresh machine image; returns the start registers
+[[nodiscard]] Registers load(const workloads::Workload& workload, Memory& memory)
+{
+    memory.clear();
+    for (const workloads::Segment& segment : workload.segments)
+        (void)memory.load(segment.address, segment.bytes);
+
+    Registers registers;
+    registers.pc = workloads::ENTRY;
+    registers.sp = 0xFF;
+    return registers;
+}
+
+[[nodiscard]] std::optional<Result> measure(const workloads::Workload& workload, double min_time)
+{
+    using Clock = std::chrono::steady_clock;
+
+    StopCondition stop;
+    stop.stop_on_brk = true;
+    stop.max_cycles  = 1'000'000'000;  // A runaway program is a wrong result, not a hang
+
+    Memory    image;
+    Memory    memory;
+    CPU       cpu;
+    Registers start = load(workload, image);
+    Result    result{workload.name};
+
+    while (result.seconds < min_time)
+        {
+            memory = image;
+            cpu.set_registers(start);
+
+            const auto begin = Clock::now();
+            auto       run   = cpu.run(stop, memory);
+            const auto end   = Clock::now();
+
+            if (!run || run->reason != StopReason::Brk || !workload.check(cpu, memory))
+                return std::nullopt;
+
+            result.seconds += std::chrono::duration<double>(end - begin).count();
+            result.instructions = run->instructions;
+            result.cycles       = run->cycles;
+            ++result.runs;
+        }
+    return result;
+}
+
+void write_json(std::ostream& out, const std::vector<Result>& results)
+{
+    out << "{\n  \"workloads\": [\n";
+    for (std::size_t i = 0; i < results.size(); ++i)
+        {
+            const Result& r = results[i];
+            out << std::format("    {{\"name\": \"{}\", \"runs\": {}, \"instructions\": {}, "
+                               "\"cycles\": {}, \"seconds\": {:.6f}, \"mhz\": {:.3f}, "
+                               "\"ips\": {:.0f}}}{}\n",
+                               r.name, r.runs, r.instructions, r.cycles, r.seconds, r.mhz(),
+                               r.ips(), i + 1 < results.size() ? "," : "");
+        }
+    out << "  ]\n}\n";
+}
+
+/**
+ * @type class
+ * @brief Just enough JSON to read a baseline back: any whitespace and key order
+ *
+ * Every object with a string "name" and a numeric "ips" anywhere in the
+ * document becomes an entry; all other values are parsed and ignored.
+ */
+class BaselineParser
+{
+ public:
+    explicit BaselineParser(std::string_view text) noexcept : text_(text) {}
+
+    [[nodiscard]] std::optional<std::vector<BaselineEntry>> parse()
+    {
+        if (!value())
+            return std::nullopt;
+        skip_space();
+        if (position_ != text_.size())
+            return std::nullopt;
+        return std::move(entries_);
+    }
+
+ private:
+    std::string_view           text_;
+    std::size_t                position_ = 0;
+    std::vector<BaselineEntry> entries_;
+
+    void skip_space() noexcept
+    {
+        while (position_ < text_.size() &&
+               (text_[position_] == ' ' || text_[position_] == '\t' ||
+                text_[position_] == '\n' || text_[position_] == '\r'))
+            ++position_;
+    }
+
+    [[nodiscard]] bool consume(char c) noexcept
+    {
+        skip_space();
+        if (position_ < text_.size() && text_[position_] == c)
+            {
+                ++position_;
+                return true;
+            }
+        return false;
+    }
+
+    [[nodiscard]] bool value(std::string* text = nullptr, std::optional<double>* number = nullptr)
+    {
+        skip_space();
+        if (position_ >= text_.size())
+            return false;
+
+        switch (text_[position_])
+            {
+                case '{':
+                    return object();
+                case '[':
+                    return array();
+                case '"':
+                    return string(text);
+                default:
+                    break;
+            }
+
+        for (const std::string_view literal : {"true", "false", "null"})
+            {
+                if (text_.substr(position_).starts_with(literal))
+                    {
+                        position_ += literal.size();
+                        return true;
+                    }
+            }
+
+        double      parsed = 0.0;
+        const char* first  = text_.data() + position_;
+        const char* last   = text_.data() + text_.size();
+        const auto [end, error] = std::from_chars(first, last, parsed);
+        if (error != std::errc{} || end == first)
+            return false;
+        position_ += static_cast<std::size_t>(end - first);
+        if (number != nullptr)
+            *number = parsed;
+        return true;
+    }
+
+    // Escapes are kept as written; workload names never need them
+    [[nodiscard]] bool string(std::string* out)
+    {
+        const std::size_t start = ++position_;
+        while (position_ < text_.size() && text_[position_] != '"')
+            position_ += text_[position_] == '\\' ? 2u : 1u;
+        if (position_ >= text_.size())
+            return false;
+        if (out != nullptr)
+            *out = std::string(text_.substr(start, position_ - start));
+        ++position_;
+        return true;
+    }
+
+    [[nodiscard]] bool array()
+    {
+        ++position_;
+        if (consume(']'))
+            return true;
+        do
+            {
+                if (!value())
+                    return false;
+            }
+        while (consume(','));
+        return consume(']');
+    }
+
+    [[nodiscard]] bool object()
+    {
+        ++position_;
+        std::string           name;
+        std::optional<double> ips;
+        bool                  named = false;
+
+        if (!consume('}'))
+            {
+                do
+                    {
+                        std::string key;
+                        skip_space();
+                        if (position_ >= text_.size() || text_[position_] != '"' ||
+                            !string(&key) || !consume(':'))
+                            return false;
+
+                        std::string           text;
+                        std::optional<double> number;
+                        if (!value(&text, &number))
+                            return false;
+                        if (key == "name")
+                            {
+                                name  = std::move(text);
+                                named = true;
+                            }
+                        else if (key == "ips")
+                            {
+                                ips = number;
+                            }
+                    }
+                while (consume(','));
+                if (!consume('}'))
+                    return false;
+            }
+
+        if (named && ips)
+            entries_.push_back({std::move(name), *ips});
+        return true;
+    }
+};
+
+// Reads the name/ips pairs back from a file written by write_json
+[[nodiscard]] std::optional<std::vector<BaselineEntry>> read_baseline(const std::string& path)
+{
+    std::ifstream file(path);
+    if (!file)
+        return std::nullopt;
+
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    return BaselineParser(buffer.str()).parse();
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    const auto options = parse_options(argc, argv);
+    if (!options)
+        return 2;
+
+    std::vector<BaselineEntry> baseline;
+    if (!options->baseline.empty())
+        {
+            auto entries = read_baseline(options->baseline);
+            if (!entries)
+                {
+                    std::println(stderr, "bench_workloads: cannot read baseline '{}'",
+                                 options->baseline);
+                    return 2;
+                }
+            baseline = std::move(*entries);
+        }
+
+    std::println("{:<16} {:>12} {:>12} {:>8} {:>10} {:>10} {:>10}", "workload", "instructions",
+                 "cycles", "runs", "MHz", "MIPS", "baseline");
+
+    std::vector<Result> results;
+    int                 regressions = 0;
+    for (const workloads::Workload& workload : workloads::kAll)
+        {
+            if (!options->filter.empty() &&
+                workload.name.find(options->filter) == std::string_view::npos)
+                continue;
+
+            const auto result = measure(workload, options->min_time);
+            if (!result)
+                {
+                    std::println(stderr, "bench_workloads: {} produced a wrong result",
+                                 workload.name);
+                    return 2;
+                }
+            results.push_back(*result);
+
+            std::string verdict = "-";
+            for (const BaselineEntry& entry : baseline)
+                {
+                    if (entry.name != workload.name || entry.ips <= 0.0)
+                        continue;
+
+                    const double change = 100.0 * (result->ips() - entry.ips) / entry.ips;
+                    const bool   slower = change < -options->threshold;
+                    verdict = std::format("{:+.1f}%{}", change, slower ? " SLOWER" : "");
+                    regressions += slower ? 1 : 0;
+                }
+
+            std::println("{:<16} {:>12} {:>12} {:>8} {:>10.2f} {:>10.2f} {:>10}", result->name,
+                         result->instructions, result->cycles, result->runs, result->mhz(),
+                         result->ips() / 1e6, verdict);
+        }
+
+    if (!options->json.empty())
+        {
+            std::ofstream out(options->json);
+            write_json(out, results);
+            if (!out)
+                {
+                    std::println(stderr, "bench_workloads: cannot write '{}'", options->json);
+                    return 2;
+                }
+        }
+
+    if (regressions != 0)
+        {
+            std::println("{} workload(s) regressed by more than {}% against {}", regressions,
+                         options->threshold, options->baseline);
+            return 1;
+        }
+    return 0;
+}
@@ -0,0 +1,411 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <span>
+#include <string_view>
+#include "cpu6502/assembler.hpp"
+#include "cpu6502/cpu.hpp"
+
+// Macro benchmark workloads: small 6502 programs, assembled at compile time by
+// assembler.hpp, plus the data tables they run over. Every program starts
+// at $8000, ends on BRK and leaves a result that check() verifies, so a broken
+// emulator cannot post a fast time for wrong work.
+//
+// The programs stick to the opcodes the CPU dispatches today. Without STA, SBC,
+// LSR or the rotates, memory is written with INC/DEC, subtraction is ADC of the
+// complement with carry set by CMP, and decimal arithmetic is done in software.
+
+namespace cpu6502::workloads
+{
+
+// Count bytes from an xorshift generator, each at least minimum
+template <std::size_t Count>
+[[nodiscard]] constexpr std::array<u8, Count> random_bytes(u32 seed, u8 minimum = 0) noexcept
+{
+    std::array<u8, Count> bytes{};
+    for (u8& value : bytes)
+        {
+            seed ^= seed << 13;
+            seed ^= seed >> 17;
+            seed ^= seed << 5;
+            value = static_cast<u8>(minimum + seed % (256u - minimum));
+        }
+    return bytes;
+}
+
+template <std::size_t Count>
+[[nodiscard]] constexpr std::array<u8, Count> complement(
+    const std::array<u8, Count>& bytes) noexcept
+{
+    std::array<u8, Count> result{};
+    for (std::size_t i = 0; i < Count; ++i)
+        result[i] = static_cast<u8>(~bytes[i]);
+    return result;
+}
+
+[[nodiscard]] constexpr std::array<u8, 256> identity() noexcept
+{
+    std::array<u8, 256> bytes{};
+    for (std::size_t i = 0; i < bytes.size(); ++i)
+        bytes[i] = static_cast<u8>(i);
+    return bytes;
+}
+
+/**
+ * @type struct
+ * @brief Bytes loaded at address before a run
+ */
+struct Segment
+{
+    u16                 address;
+    std::span<const u8> bytes;
+};
+
+/**
+ * @type struct
+ * @brief One benchmark program, its data and its expected result
+ */
+struct Workload
+{
+    std::string_view         name;
+    std::span<const Segment> segments;
+    bool (*check)(const CPU& cpu, const Memory& memory);  // Verifies the result after BRK
+};
+
+inline constexpr u16 ENTRY = 0x8000;
+
+// Sieve of Eratosthenes over 0..255 at $0300, INC marking composites; p lives
+// in $10. Counts the primes into Y.
+inline constexpr FixedString kSieveSource = R"(
+        .org $8000
+p     = $10
+marks = $0300
+        INC p
+next:   INC p
+        LDX p
+        CPX #$10
+        BCS count
+        LDA marks,X
+        BNE next            ; p is composite
+step:   LDY p               ; X += p
+add:    INX
+        BEQ next
+        DEY
+        BNE add
+        INC marks,X
+        CLV
+        BVC step
+count:  LDY #$00
+        LDX #$02
+cloop:  LDA marks,X
+        BNE skip
+        INY
+skip:   INX
+        BNE cloop
+        BRK
+)";
+
+// CRC-8 (polynomial $07) in A over the 256-byte table at $2000, repeated for
+// the number of passes in $11.
+inline constexpr FixedString kCrc8Source = R"(
+        .org $8000
+passes = $11
+table  = $2000
+        LDA #$00
+pass:   LDY #$00
+byte:   EOR table,Y
+        LDX #$08
+bit:    ASL A
+        BCC nox
+        EOR #$07
+nox:    DEX
+        BNE bit
+        INY
+        BNE byte
+        DEC passes
+        BNE pass
+        BRK
+)";
+
+// Counting sort of the 256 keys at $2000: histogram at $0300, then walks the
+// histogram emitting keys in order. With no STA there is no output buffer, so
+// each emitted key is folded into an order-sensitive hash instead: A rotated
+// left (ASL A, whose carry ADC adds back in) plus the key, counting the carries
+// out of the add in $12. $2100 is an identity table so ADC can add the key in X.
+inline constexpr FixedString kCountingSortSource = R"(
+        .org $8000
+carries   = $12
+keys      = $2000
+identity  = $2100
+histogram = $0300
+        LDY #$00
+hist:   LDX keys,Y
+        INC histogram,X
+        INY
+        BNE hist
+        LDA #$00
+        LDX #$00
+walk:   LDY histogram,X
+        BEQ nextk
+emit:   ASL A
+        ADC identity,X      ; A = rotate_left(A) + key
+        BCC nc
+        INC carries
+nc:     DEY
+        BNE emit
+nextk:  INX
+        BNE walk
+        BRK
+)";
+
+// Five-digit unpacked BCD counter at $20 (least significant digit first)
+// incremented as many times as the 16-bit count in $11/$12. A digit that hits
+// 10 is decremented back to 0 and the carry ripples into the next one.
+inline constexpr FixedString kBcdCounterSource = R"(
+        .org $8000
+count  = $11
+digits = $20
+loop:   LDX #$00
+digit:  INC digits,X
+        LDA digits,X
+        CMP #$0A
+        BNE counted
+        LDY #$0A
+clr:    DEC digits,X
+        DEY
+        BNE clr
+        INX
+        CPX #$05
+        BNE digit
+counted:
+        DEC count
+        LDA count
+        CMP #$FF
+        BNE chk
+        DEC count+1
+chk:    LDA count
+        BNE loop
+        LDA count+1
+        BNE loop
+        BRK
+)";
+
+// For 64 table entries: a * b by repeated addition (lo in A, hi in Y), then
+// lo / d by repeated subtraction (quotient in Y). Each hi byte and quotient is
+// added into the 16-bit checksum at $40 by counting; every call is a JSR.
+inline constexpr FixedString kMulDivSource = R"(
+        .org $8000
+checksum = $40
+factor_a = $2000
+factor_b = $2100
+divisor  = $2200
+neg_div  = $2300            ; ~divisor, so ADC with carry set subtracts
+        LDX #$00
+main:   JSR mul
+        JSR sum
+        JSR div
+        JSR sum
+        INX
+        CPX #$40
+        BNE main
+        BRK
+mul:    LDA #$00
+        LDY #$00
+mloop:  CLC
+        ADC factor_a,X
+        BCC mnc
+        INY
+mnc:    DEC factor_b,X
+        BNE mloop
+        RTS
+div:    LDY #$00
+dloop:  CMP divisor,X
+        BCC ddone
+        ADC neg_div,X
+        INY
+        BCS dloop
+ddone:  RTS
+sum:    CPY #$00            ; checksum += Y
+        BEQ sdone
+sloop:  INC checksum
+        BNE snc
+        INC checksum+1
+snc:    DEY
+        BNE sloop
+sdone:  RTS
+)";
+
+// Recursive fib(n) call tree: fib(n) calls fib(n-1) and fib(n-2) down to
+// n < 2 and counts the leaves into $30/$31.
+inline constexpr FixedString kFibonacciSource = R"(
+        .org $8000
+n      = 20
+leaves = $30
+        LDX #n
+        JSR fib
+        BRK
+fib:    CPX #$02
+        BCS rec
+        INC leaves
+        BNE leaf
+        INC leaves+1
+leaf:   RTS
+rec:    DEX
+        JSR fib
+        DEX
+        JSR fib
+        INX
+        INX
+        RTS
+)";
+
+inline constexpr auto kSieveCode        = assemble<kSieveSource>();
+inline constexpr auto kCrc8Code         = assemble<kCrc8Source>();
+inline constexpr auto kCountingSortCode = assemble<kCountingSortSource>();
+inline constexpr auto kBcdCounterCode   = assemble<kBcdCounterSource>();
+inline constexpr auto kMulDivCode       = assemble<kMulDivSource>();
+inline constexpr auto kFibonacciCode    = assemble<kFibonacciSource>();
+
+inline constexpr auto kCrcTable    = random_bytes<256>(0xC0FFEE);
+inline constexpr auto kSortKeys    = random_bytes<256>(0x50F7);
+inline constexpr auto kIdentity    = identity();
+inline constexpr auto kFactorsA    = random_bytes<64>(0xA11CE);
+inline constexpr auto kFactorsB    = random_bytes<64>(0xB0B, 1);  // Multiplier loops need >= 1
+inline constexpr auto kDivisors    = random_bytes<64>(0xD1F, 1);
+inline constexpr auto kDivisorsNot = complement(kDivisors);
+inline constexpr u8   CRC_PASSES   = 16;
+inline constexpr u16  BCD_COUNT    = 50000;
+inline constexpr u16  FIB_N        = assembled_value<kFibonacciSource>("n");
+
+inline constexpr std::array<u8, 1> kCrcPasses = {CRC_PASSES};
+inline constexpr std::array<u8, 2> kBcdCount  = {static_cast<u8>(BCD_COUNT & 0xFF),
+                                                 static_cast<u8>(BCD_COUNT >> 8)};
+
+[[nodiscard]] inline bool check_sieve(const CPU& cpu, const Memory&)
+{
+    int primes = 0;
+    for (int n = 2; n < 256; ++n)
+        {
+            bool prime = true;
+            for (int d = 2; d * d <= n; ++d)
+                prime = prime && n % d != 0;
+            primes += prime ? 1 : 0;
+        }
+    return cpu.get_registers().y == primes;
+}
+
+[[nodiscard]] inline bool check_crc8(const CPU& cpu, const Memory&)
+{
+    u8 crc = 0;
+    for (int pass = 0; pass < CRC_PASSES; ++pass)
+        {
+            for (const u8 byte : kCrcTable)
+                {
+                    crc ^= byte;
+                    for (int bit = 0; bit < 8; ++bit)
+                        crc = static_cast<u8>((crc & 0x80) != 0 ? (crc << 1) ^ 0x07 : crc << 1);
+                }
+        }
+    return cpu.get_registers().a == crc;
+}
+
+[[nodiscard]] inline bool check_counting_sort(const CPU& cpu, const Memory& memory)
+{
+    std::array<u8, 256> histogram{};
+    for (const u8 key : kSortKeys)
+        ++histogram[key];
+    for (std::size_t key = 0; key < histogram.size(); ++key)
+        {
+            if (memory[static_cast<u16>(0x0300 + key)] != histogram[key])
+                return false;
+        }
+
+    // The keys in sorted order, hashed as the walk does
+    std::array<u8, 256> sorted = kSortKeys;
+    std::ranges::sort(sorted);
+    u32 hash    = 0;
+    u8  carries = 0;
+    for (const u8 key : sorted)
+        {
+            hash = ((hash << 1) & 0xFF) + (hash >> 7) + key;
+            if (hash > 0xFF)
+                ++carries;
+            hash &= 0xFF;
+        }
+    return cpu.get_registers().a == hash && memory[0x12] == carries;
+}
+
+[[nodiscard]] inline bool check_bcd_counter(const CPU&, const Memory& memory)
+{
+    u16 rest = BCD_COUNT;
+    for (u16 digit = 0; digit < 5; ++digit)
+        {
+            if (memory[static_cast<u16>(0x20 + digit)] != rest % 10)
+                return false;
+            rest = static_cast<u16>(rest / 10);
+        }
+    return true;
+}
+
+[[nodiscard]] inline bool check_mul_div(const CPU&, const Memory& memory)
+{
+    u32 checksum = 0;
+    for (std::size_t i = 0; i < kFactorsA.size(); ++i)
+        {
+            const u32 product = u32{kFactorsA[i]} * kFactorsB[i];
+            checksum += (product >> 8) + (product & 0xFF) / kDivisors[i];
+        }
+    return static_cast<u32>(memory[0x40] | (memory[0x41] << 8)) == (checksum & 0xFFFF);
+}
+
+[[nodiscard]] inline bool check_fibonacci(const CPU&, const Memory& memory)
+{
+    u32 previous = 1;  // Leaves of fib(0) and fib(1)
+    u32 leaves   = 1;
+    for (u16 n = 2; n <= FIB_N; ++n)
+        {
+            const u32 next = previous + leaves;
+            previous       = leaves;
+            leaves         = next;
+        }
+    return static_cast<u32>(memory[0x30] | (memory[0x31] << 8)) == leaves;
+}
+
+inline constexpr std::array kSieveSegments = {Segment{ENTRY, kSieveCode}};
+
+inline constexpr std::array kCrc8Segments = {
+    Segment{ENTRY, kCrc8Code},
+    Segment{0x2000, kCrcTable},
+    Segment{0x0011, kCrcPasses},
+};
+
+inline constexpr std::array kCountingSortSegments = {
+    Segment{ENTRY, kCountingSortCode},
+    Segment{0x2000, kSortKeys},
+    Segment{0x2100, kIdentity},
+};
+
+inline constexpr std::array kBcdCounterSegments = {
+    Segment{ENTRY, kBcdCounterCode},
+    Segment{0x0011, kBcdCount},
+};
+
+inline constexpr std::array kMulDivSegments = {
+    Segment{ENTRY, kMulDivCode},  Segment{0x2000, kFactorsA},
+    Segment{0x2100, kFactorsB},   Segment{0x2200, kDivisors},
+    Segment{0x2300, kDivisorsNot},
+};
+
+inline constexpr std::array kFibonacciSegments = {Segment{ENTRY, kFibonacciCode}};
+
+inline constexpr std::array kAll = {
+    Workload{"sieve", kSieveSegments, check_sieve},
+    Workload{"crc8", kCrc8Segments, check_crc8},
+    Workload{"counting_sort", kCountingSortSegments, check_counting_sort},
+    Workload{"bcd_counter", kBcdCounterSegments, check_bcd_counter},
+    Workload{"mul_div", kMulDivSegments, check_mul_div},
+    Workload{"fibonacci_calls", kFibonacciSegments, check_fibonacci},
+};
+
+}  // namespace cpu6502::workloads
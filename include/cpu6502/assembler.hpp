@@ -0,0 +1,615 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <span>
+#include <string_view>
+#include "isa.hpp"
+#include "types.hpp"
+
+// Compile-time 6502 assembler. assemble<"source">() turns assembler source into
+// a std::array<u8, N> during compilation, so tests and workloads load a ready
+// image with one copy:
+//
+//     constexpr auto kProgram = assemble<R"(
+//             .org $8000
+//     count = $10
+//             LDX #$05
+//     loop:   INC count
+//             DEX
+//             BNE loop
+//             BRK
+//     )">();
+//
+// Syntax, one statement per line, ';' starts a comment:
+//   label:                 defines label as the current address; may precede a statement
+//   name = expr            defines a constant; it may only use names defined above it
+//   .org expr              sets the address of the first byte; only before any output
+//   .byte expr, ...        emits bytes
+//   .word expr, ...        emits little-endian words
+//   MNE [operand]          #imm, A, addr, addr,X, addr,Y, (addr), (zp,X), (zp),Y
+// Expressions are terms joined by + and -. A term is $hex, %binary, decimal,
+// 'c', * (the address of the statement), a name, or <term / >term for its low
+// or high byte. Mnemonics, directives and registers are case-insensitive;
+// names are not.
+//
+// Zero page addressing is chosen when the operand is below $100 and does not
+// involve labels or '*', so it is decided the same way on both passes; label
+// operands always assemble to the absolute form. BRK assembles to two bytes,
+// the opcode and a padding byte, as the CPU skips one. Errors stop compilation
+// in detail::assembly_error(), with the message in the constexpr backtrace.
+
+namespace cpu6502
+{
+
+/**
+ * @type struct
+ * @brief String literal usable as a template argument
+ */
+template <std::size_t N>
+struct FixedString
+{
+    char text[N]{};
+
+    consteval FixedString(const char (&source)[N]) { std::copy_n(source, N, text); }
+
+    [[nodiscard]] constexpr std::string_view view() const noexcept { return {text, N - 1}; }
+};
+
+namespace detail
+{
+
+// Deliberately not constexpr: reaching it makes the assembly a compile error
+inline void assembly_error(const char* message)
+{
+    (void)message;
+}
+
+[[nodiscard]] constexpr bool is_name_start(char c) noexcept
+{
+    return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || c == '_';
+}
+
+[[nodiscard]] constexpr bool is_name_char(char c) noexcept
+{
+    return is_name_start(c) || (c >= '0' && c <= '9');
+}
+
+[[nodiscard]] constexpr char to_upper(char c) noexcept
+{
+    return c >= 'a' && c <= 'z' ? static_cast<char>(c - 'a' + 'A') : c;
+}
+
+[[nodiscard]] constexpr bool equals_upper(std::string_view text, std::string_view upper) noexcept
+{
+    return std::ranges::equal(text, upper, {}, to_upper);
+}
+
+/**
+ * @type class
+ * @brief Two-pass assembler behind assemble<>()
+ *
+ * The first pass collects label addresses, the second emits bytes with every
+ * label known. Both passes decide operand sizes by the same rules, so labels
+ * cannot move between them.
+ */
+class Assembler
+{
+ public:
+    static constexpr std::size_t MAX_SYMBOLS = 256;
+
+    constexpr explicit Assembler(std::string_view source) noexcept : source_(source) {}
+
+    // Returns the image size; writes the image into out unless out is empty
+    constexpr std::size_t assemble(std::span<u8> out)
+    {
+        run(false, {});
+        return run(true, out);
+    }
+
+    [[nodiscard]] constexpr u16 origin() const noexcept { return origin_; }
+
+    // Address or value of name after assemble()
+    [[nodiscard]] constexpr u16 value_of(std::string_view name) const
+    {
+        const Symbol* symbol = find(name);
+        if (symbol == nullptr)
+            fail("unknown name");
+        return symbol->value;
+    }
+
+ private:
+    struct Symbol
+    {
+        std::string_view name;
+        u16              value    = 0;
+        bool             constant = false;  // Defined with '=' from constants only
+        std::size_t      line     = 0;
+    };
+
+    struct Expression
+    {
+        u16  value    = 0;
+        bool resolved = true;  // False on the first pass for names defined further down
+        bool constant = true;  // No labels or '*', so eligible for zero page
+    };
+
+    std::string_view                source_;
+    std::array<Symbol, MAX_SYMBOLS> symbols_{};
+    std::size_t                     symbol_count_ = 0;
+    bool                            final_        = false;  // Second pass
+    std::span<u8>                   out_;
+    std::size_t                     size_   = 0;
+    u16                             origin_ = 0;
+    u32                             pc_     = 0;
+    u16                             statement_pc_ = 0;  // Value of '*'
+    std::size_t                     line_   = 0;
+    std::string_view                rest_;  // Unparsed part of the current line
+
+    constexpr void fail(const char* message) const
+    {
+        if (message != nullptr)
+            assembly_error(message);
+    }
+
+    constexpr std::size_t run(bool final, std::span<u8> out)
+    {
+        final_ = final;
+        out_   = out;
+        size_  = 0;
+        pc_    = origin_;
+        line_  = 0;
+
+        std::string_view text = source_;
+        while (!text.empty())
+            {
+                const std::size_t end = std::min(text.find('\n'), text.size());
+                std::string_view  line = text.substr(0, end);
+                text.remove_prefix(std::min(end + 1, text.size()));
+                ++line_;
+
+                line = line.substr(0, std::min(line.find(';'), line.size()));
+                statement(line);
+            }
+        return size_;
+    }
+
+    constexpr void statement(std::string_view line)
+    {
+        rest_         = line;
+        statement_pc_ = static_cast<u16>(pc_);
+        skip_space();
+        if (rest_.empty())
+            return;
+
+        if (is_name_start(rest_.front()))
+            {
+                const std::string_view name = read_name();
+                skip_space();
+                if (accept('='))
+                    {
+                        const Expression value = expression();
+                        if (!value.resolved)
+                            fail("constant uses a name that is not defined above it");
+                        define(name, value.value, value.constant);
+                        expect_end();
+                        return;
+                    }
+                if (!accept(':'))
+                    {
+                        instruction(name);
+                        return;
+                    }
+
+                define(name, static_cast<u16>(pc_), false);
+                skip_space();
+                if (rest_.empty())
+                    return;
+            }
+
+        if (accept('.'))
+            directive(read_name());
+        else if (is_name_start(rest_.front()))
+            instruction(read_name());
+        else
+            fail("expected a label, instruction or directive");
+    }
+
+    constexpr void directive(std::string_view name)
+    {
+        if (equals_upper(name, "ORG"))
+            {
+                const Expression address = expression();
+                if (size_ != 0)
+                    fail(".org after code");
+                if (!address.resolved || !address.constant)
+                    fail(".org needs a constant address");
+                origin_ = address.value;
+                pc_     = origin_;
+            }
+        else if (equals_upper(name, "BYTE") || equals_upper(name, "WORD"))
+            {
+                do
+                    {
+                        const Expression value = expression();
+                        if (equals_upper(name, "BYTE"))
+                            emit_byte(value);
+                        else
+                            emit_word(value);
+                    }
+                while (accept(','));
+            }
+        else
+            {
+                fail("unknown directive");
+            }
+        expect_end();
+    }
+
+    constexpr void instruction(std::string_view mnemonic)
+    {
+        using enum AddressingMode;
+
+        skip_space();
+        AddressingMode mode    = Implied;
+        Expression     operand = {.value = 0, .resolved = true, .constant = true};
+
+        if (rest_.empty())
+            {
+                mode = has_mode(mnemonic, Implied) ? Implied : Accumulator;
+            }
+        else if (accept('#'))
+            {
+                mode    = Immediate;
+                operand = expression();
+            }
+        else if (equals_upper(rest_.substr(0, 1), "A") &&
+                 (rest_.size() == 1 || !is_name_char(rest_[1])))
+            {
+                rest_.remove_prefix(1);
+                mode = Accumulator;
+            }
+        else if (accept('('))
+            {
+                operand = expression();
+                if (accept(','))
+                    {
+                        expect_register('X');
+                        expect(')');
+                        mode = IndirectX;
+                    }
+                else
+                    {
+                        expect(')');
+                        if (accept(','))
+                            {
+                                expect_register('Y');
+                                mode = IndirectY;
+                            }
+                        else
+                            {
+                                mode = Indirect;
+                            }
+                    }
+            }
+        else
+            {
+                operand                = expression();
+                const bool zero_page   = operand.constant && operand.value <= 0xFF;
+                const char index       = accept(',') ? read_register() : '\0';
+                const auto choose_mode = [&](AddressingMode zp, AddressingMode absolute)
+                {
+                    return zero_page && has_mode(mnemonic, zp) ? zp : absolute;
+                };
+
+                if (index == 'X')
+                    mode = choose_mode(ZeroPageX, AbsoluteX);
+                else if (index == 'Y')
+                    mode = choose_mode(ZeroPageY, AbsoluteY);
+                else if (has_mode(mnemonic, Relative))
+                    mode = Relative;
+                else
+                    mode = choose_mode(ZeroPage, Absolute);
+            }
+        expect_end();
+
+        const u8 opcode = find_opcode(mnemonic, mode);
+        emit(opcode);
+
+        const OpcodeInfo& info = opcode_info(opcode);
+        if (mode == Relative)
+            {
+                const i32 offset = static_cast<i32>(operand.value) - static_cast<i32>(pc_ + 1);
+                if (final_ && (offset < -128 || offset > 127))
+                    fail("branch target out of range");
+                emit(static_cast<u8>(offset));
+            }
+        else if (info.length == 2)
+            {
+                emit_byte(operand);
+            }
+        else if (info.length == 3)
+            {
+                emit_word(operand);
+            }
+    }
+
+    // Expressions
+
+    constexpr Expression expression()
+    {
+        Expression result = term();
+        skip_space();
+        while (!rest_.empty() && (rest_.front() == '+' || rest_.front() == '-'))
+            {
+                const bool subtract = rest_.front() == '-';
+                rest_.remove_prefix(1);
+
+                const Expression right = term();
+                result.value    = static_cast<u16>(subtract ? result.value - right.value
+                                                            : result.value + right.value);
+                result.resolved = result.resolved && right.resolved;
+                result.constant = result.constant && right.constant;
+                skip_space();
+            }
+        return result;
+    }
+
+    constexpr Expression term()
+    {
+        skip_space();
+        if (rest_.empty())
+            fail("expected an expression");
+
+        const char c = rest_.front();
+        if (c == '<' || c == '>')
+            {
+                rest_.remove_prefix(1);
+                Expression inner = term();
+                inner.value    = c == '<' ? inner.value & 0xFF : inner.value >> 8;
+                inner.constant = true;  // A byte either way
+                return inner;
+            }
+        if (c == '*')
+            {
+                rest_.remove_prefix(1);
+                return {.value = statement_pc_, .resolved = true, .constant = false};
+            }
+        if (c == '\'')
+            {
+                if (rest_.size() < 3 || rest_[2] != '\'')
+                    fail("bad character constant");
+                const char value = rest_[1];
+                rest_.remove_prefix(3);
+                return {.value = static_cast<u8>(value), .resolved = true, .constant = true};
+            }
+        if (c == '$')
+            return number(16, 1);
+        if (c == '%')
+            return number(2, 1);
+        if (c >= '0' && c <= '9')
+            return number(10, 0);
+        if (!is_name_start(c))
+            fail("expected an expression");
+
+        const Symbol* symbol = find(read_name());
+        if (symbol == nullptr)
+            {
+                if (final_)
+                    fail("undefined name");
+                return {.value = 0, .resolved = false, .constant = false};
+            }
+        return {.value    = symbol->value,
+                .resolved = true,
+                .constant = symbol->constant && symbol->line < line_};
+    }
+
+    constexpr Expression number(u32 base, std::size_t prefix)
+    {
+        rest_.remove_prefix(prefix);
+
+        u32         value  = 0;
+        std::size_t digits = 0;
+        for (; digits < rest_.size(); ++digits)
+            {
+                const char c     = to_upper(rest_[digits]);
+                u32        digit = base;
+                if (c >= '0' && c <= '9')
+                    digit = static_cast<u32>(c - '0');
+                else if (c >= 'A' && c <= 'F')
+                    digit = static_cast<u32>(c - 'A' + 10);
+                if (digit >= base)
+                    break;
+
+                value = value * base + digit;
+                if (value > 0xFFFF)
+                    fail("number does not fit in 16 bits");
+            }
+        if (digits == 0)
+            fail("expected digits");
+
+        rest_.remove_prefix(digits);
+        return {.value = static_cast<u16>(value), .resolved = true, .constant = true};
+    }
+
+    // Symbols
+
+    [[nodiscard]] constexpr const Symbol* find(std::string_view name) const noexcept
+    {
+        for (std::size_t i = 0; i < symbol_count_; ++i)
+            {
+                if (symbols_[i].name == name)
+                    return &symbols_[i];
+            }
+        return nullptr;
+    }
+
+    constexpr void define(std::string_view name, u16 value, bool constant)
+    {
+        if (!final_)
+            {
+                if (find(name) != nullptr)
+                    fail("name defined twice");
+                if (symbol_count_ == MAX_SYMBOLS)
+                    fail("too many names");
+                symbols_[symbol_count_++] = {name, value, constant, line_};
+                return;
+            }
+
+        // Second pass: same rules, same values
+        const Symbol* symbol = find(name);
+        if (symbol == nullptr || symbol->value != value)
+            fail("label moved between passes");
+    }
+
+    // Opcode lookup
+
+    [[nodiscard]] static constexpr bool matches(const OpcodeInfo& info, std::string_view mnemonic)
+    {
+        return info.documented() && equals_upper(mnemonic, info.mnemonic);
+    }
+
+    [[nodiscard]] static constexpr bool has_mode(std::string_view mnemonic, AddressingMode mode)
+    {
+        return std::ranges::any_of(OPCODE_TABLE, [&](const OpcodeInfo& info)
+                                   { return info.mode == mode && matches(info, mnemonic); });
+    }
+
+    [[nodiscard]] constexpr u8 find_opcode(std::string_view mnemonic, AddressingMode mode) const
+    {
+        for (std::size_t opcode = 0; opcode < OPCODE_TABLE.size(); ++opcode)
+            {
+                const OpcodeInfo& info = OPCODE_TABLE[opcode];
+                if (info.mode == mode && matches(info, mnemonic))
+                    return static_cast<u8>(opcode);
+            }
+
+        if (!std::ranges::any_of(OPCODE_TABLE, [&](const OpcodeInfo& info)
+                                 { return matches(info, mnemonic); }))
+            fail("unknown mnemonic");
+        else
+            fail("addressing mode not available for this instruction");
+        return 0;
+    }
+
+    // Output
+
+    constexpr void emit(u8 value)
+    {
+        if (pc_ > 0xFFFF)
+            fail("program runs past $FFFF");
+        if (final_ && !out_.empty())
+            out_[size_] = value;
+        ++size_;
+        ++pc_;
+    }
+
+    constexpr void emit_byte(const Expression& value)
+    {
+        if (final_ && value.value > 0xFF)
+            fail("operand does not fit in a byte");
+        emit(static_cast<u8>(value.value));
+    }
+
+    constexpr void emit_word(const Expression& value)
+    {
+        emit(static_cast<u8>(value.value & 0xFF));
+        emit(static_cast<u8>(value.value >> 8));
+    }
+
+    // Lexing
+
+    constexpr void skip_space() noexcept
+    {
+        while (!rest_.empty() && (rest_.front() == ' ' || rest_.front() == '\t' ||
+                                  rest_.front() == '\r'))
+            rest_.remove_prefix(1);
+    }
+
+    constexpr bool accept(char c) noexcept
+    {
+        skip_space();
+        if (rest_.empty() || rest_.front() != c)
+            return false;
+        rest_.remove_prefix(1);
+        return true;
+    }
+
+    constexpr void expect(char c)
+    {
+        if (!accept(c))
+            fail("unexpected character");
+    }
+
+    constexpr void expect_end()
+    {
+        skip_space();
+        if (!rest_.empty())
+            fail("unexpected text at end of line");
+    }
+
+    constexpr std::string_view read_name() noexcept
+    {
+        std::size_t length = 0;
+        while (length < rest_.size() && is_name_char(rest_[length]))
+            ++length;
+
+        const std::string_view name = rest_.substr(0, length);
+        rest_.remove_prefix(length);
+        return name;
+    }
+
+    constexpr char read_register()
+    {
+        skip_space();
+        const std::string_view name = read_name();
+        if (equals_upper(name, "X"))
+            return 'X';
+        if (equals_upper(name, "Y"))
+            return 'Y';
+        fail("expected X or Y");
+        return '\0';
+    }
+
+    constexpr void expect_register(char name)
+    {
+        if (read_register() != name)
+            fail("wrong index register");
+    }
+};
+
+}  // namespace detail
+
+/**
+ * @brief Assembles Source at compile time into its bytes, from the .org address on
+ */
+template <FixedString Source>
+[[nodiscard]] consteval auto assemble()
+{
+    constexpr std::size_t size = detail::Assembler(Source.view()).assemble({});
+
+    std::array<u8, size> image{};
+    detail::Assembler(Source.view()).assemble(image);
+    return image;
+}
+
+// Address of a label, or value of a constant, defined in Source
+template <FixedString Source>
+[[nodiscard]] consteval u16 assembled_value(std::string_view name)
+{
+    detail::Assembler assembler(Source.view());
+    assembler.assemble({});
+    return assembler.value_of(name);
+}
+
+// Address of the first byte of assemble<Source>()
+template <FixedString Source>
+[[nodiscard]] consteval u16 assembled_origin()
+{
+    detail::Assembler assembler(Source.view());
+    assembler.assemble({});
+    return assembler.origin();
+}
+
+}  // namespace cpu6502
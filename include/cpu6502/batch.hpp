@@ -0,0 +1,94 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <expected>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+#include "cpu.hpp"
+#include "error.hpp"
+#include "memory.hpp"
+#include "registers.hpp"
+#include "stop_condition.hpp"
+#include "types.hpp"
+
+namespace cpu6502
+{
+
+/**
+ * @type struct
+ * @brief One independent program run: image, initial registers and stop condition
+ *
+ * The image is borrowed, it must outlive the BatchRunner::run call.
+ */
+struct BatchJob
+{
+    std::span<const u8> image;                 // Bytes copied into cleared memory
+    u16                 load_address = 0x8000;  // Where the image is placed
+    Registers           registers{};           // Initial state, including PC
+    StopCondition       stop{};
+};
+
+/**
+ * @type struct
+ * @brief Outcome of one BatchJob together with the final register state
+ */
+struct BatchResult
+{
+    std::expected<RunResult, EmulatorError> outcome{};
+    Registers                               registers{};
+};
+
+/**
+ * @type class
+ * @brief Runs many independent jobs on a persistent work-stealing thread pool
+ *
+ * Each worker slot owns one CPU and one Memory that are reused from job to job,
+ * so a batch performs no allocation. Jobs are split into one contiguous index
+ * range per worker; a worker that drains its range steals half of the largest
+ * remaining range of another worker. The calling thread takes part as worker 0.
+ */
+class BatchRunner
+{
+ public:
+    explicit BatchRunner(unsigned thread_count = std::thread::hardware_concurrency());
+    ~BatchRunner();
+
+    BatchRunner(const BatchRunner&)            = delete;
+    BatchRunner& operator=(const BatchRunner&) = delete;
+
+    [[nodiscard]] unsigned thread_count() const noexcept
+    {
+        return static_cast<unsigned>(slots_.size());
+    }
+
+    // Runs jobs[i] into results[i]; only the first min(jobs, results) jobs are run
+    void run(std::span<const BatchJob> jobs, std::span<BatchResult> results);
+
+    [[nodiscard]] auto run(std::span<const BatchJob> jobs) -> std::vector<BatchResult>;
+
+ private:
+    struct Slot;
+
+    std::vector<std::unique_ptr<Slot>> slots_;
+    std::vector<std::jthread>          threads_;
+
+    std::span<const BatchJob> jobs_;
+    std::span<BatchResult>    results_;
+
+    std::mutex              mutex_;
+    std::condition_variable start_cv_;
+    std::condition_variable done_cv_;
+    u64                     generation_ = 0;
+    unsigned                running_    = 0;
+    bool                    stopping_   = false;
+
+    void worker_loop(unsigned index);
+    void drain(unsigned index);
+    bool steal(unsigned thief);
+};
+
+}  // namespace cpu6502
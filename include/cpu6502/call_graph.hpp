@@ -0,0 +1,91 @@
+#pragma once
+
+#include <ostream>
+#include <vector>
+#include "observer.hpp"
+#include "symbols.hpp"
+#include "types.hpp"
+
+namespace cpu6502
+{
+
+/**
+ * @type struct
+ * @brief Totals for one subroutine, identified by its entry address
+ *
+ * Inclusive cycles run from the routine's first instruction to the end of its
+ * return and count each outermost activation once, so recursion is not double
+ * counted. Exclusive cycles exclude callees; the JSR itself is the caller's.
+ */
+struct RoutineProfile
+{
+    u16 address          = 0;
+    u64 calls            = 0;
+    u64 inclusive_cycles = 0;
+    u64 exclusive_cycles = 0;
+};
+
+/**
+ * @type class
+ * @brief Shadow call stack profiler fed by the CPU execution observer
+ *
+ * A JSR opens a frame for the routine it lands in; the first instruction
+ * traced becomes a root frame. Frames are closed by stack pointer rather than
+ * by matching RTS: once SP rises above the return address a frame pushed, that
+ * frame is gone however it happened (RTS, PLA/PLA, TXS). An RTS used as a
+ * computed jump pops an address the routine pushed itself, so it leaves the
+ * frame open. Interrupt handlers are charged to the interrupted routine.
+ *
+ * All storage is allocated up front; on_instruction() never allocates. Call
+ * finish() after the run so the last instruction and open frames are counted.
+ */
+class CallGraphProfiler final : public ExecutionObserver
+{
+ public:
+    CallGraphProfiler();
+
+    void on_instruction(const TraceRecord& record) noexcept override;
+
+    // Charges the last instruction up to end_cycles and closes all frames
+    void finish(u64 end_cycles) noexcept;
+    void clear() noexcept;
+
+    [[nodiscard]] std::size_t depth() const noexcept { return frames_.size(); }
+
+    // Routines still open at the given PC and SP, outermost first, into out
+    void call_chain(u16 pc, u8 sp, std::vector<u16>& out) const;
+
+    // Every routine that was entered, highest inclusive cycles first
+    [[nodiscard]] std::vector<RoutineProfile> routines() const;
+
+    // Table of calls, inclusive and exclusive cycles per routine
+    void write_report(std::ostream& out, const SymbolTable& symbols) const;
+
+ private:
+    struct Frame
+    {
+        u16 routine      = 0;
+        i32 return_sp    = 0;  // SP before the JSR; the frame is open while SP is below it
+        u64 start_cycles = 0;
+        u64 exclusive    = 0;
+    };
+
+    struct Totals
+    {
+        u64 calls     = 0;
+        u64 inclusive = 0;
+        u64 exclusive = 0;
+        u32 active    = 0;  // Frames of this routine currently on the shadow stack
+    };
+
+    std::vector<Totals> totals_;  // Indexed by routine address
+    std::vector<Frame>  frames_;
+    u64                 last_cycles_  = 0;
+    bool                call_pending_ = false;
+    i32                 call_sp_      = 0;
+
+    void push(u16 routine, i32 return_sp, u64 start_cycles) noexcept;
+    void pop(u64 end_cycles) noexcept;
+};
+
+}  // namespace cpu6502
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <ostream>
+#include <type_traits>
+#include "isa.hpp"
+#include "memory.hpp"
+#include "symbols.hpp"
+#include "types.hpp"
+
+namespace cpu6502
+{
+
+/**
+ * @type class
+ * @brief Bitmaps of executed instructions and branch outcomes
+ *
+ * Attach with CPU::set_coverage(); the CPU then sets one bit per executed
+ * opcode address, and for conditional branches one bit for the direction
+ * taken. A branch whose offset is zero lands on the next instruction either
+ * way and is recorded as not taken. Maps from separate runs or workers are
+ * combined with merge(), a plain OR. The class is trivially copyable, so a
+ * map can be written out as raw bytes and merged by another process.
+ */
+class CoverageMap
+{
+ public:
+    static constexpr std::size_t WORDS = Memory::MAX_MEM / 64;
+
+    // Called by the CPU after each instruction with the PC it ended on
+    constexpr void record(u16 pc, u8 opcode, u16 next_pc) noexcept
+    {
+        const u64 bit = u64{1} << (pc & 63);
+        executed_[pc >> 6] |= bit;
+
+        if (is_branch(opcode))
+            {
+                auto& outcome = next_pc != static_cast<u16>(pc + 2) ? taken_ : not_taken_;
+                outcome[pc >> 6] |= bit;
+            }
+    }
+
+    constexpr void merge(const CoverageMap& other) noexcept
+    {
+        for (std::size_t i = 0; i < WORDS; ++i)
+            {
+                executed_[i] |= other.executed_[i];
+                taken_[i] |= other.taken_[i];
+                not_taken_[i] |= other.not_taken_[i];
+            }
+    }
+
+    constexpr void clear() noexcept
+    {
+        executed_  = {};
+        taken_     = {};
+        not_taken_ = {};
+    }
+
+    [[nodiscard]] constexpr bool executed(u16 pc) const noexcept { return test(executed_, pc); }
+    [[nodiscard]] constexpr bool taken(u16 pc) const noexcept { return test(taken_, pc); }
+    [[nodiscard]] constexpr bool not_taken(u16 pc) const noexcept { return test(not_taken_, pc); }
+
+    [[nodiscard]] constexpr std::size_t executed_count() const noexcept
+    {
+        std::size_t count = 0;
+        for (const u64 word : executed_)
+            count += static_cast<std::size_t>(std::popcount(word));
+        return count;
+    }
+
+ private:
+    using Bitmap = std::array<u64, WORDS>;
+
+    Bitmap executed_{};
+    Bitmap taken_{};
+    Bitmap not_taken_{};
+
+    [[nodiscard]] static constexpr bool test(const Bitmap& bitmap, u16 pc) noexcept
+    {
+        return ((bitmap[pc >> 6] >> (pc & 63)) & 1) != 0;
+    }
+};
+
+static_assert(std::is_trivially_copyable_v<CoverageMap>);
+
+// lcov tracefile: DA per source line, BRDA for each conditional branch found in
+// memory within a line, both sides reported. test_name may be empty.
+void write_lcov(std::ostream& out, const CoverageMap& coverage, const LineTable& lines,
+                const Memory& memory, std::string_view test_name = {});
+
+// Cobertura XML with the same line and branch data, one class per source file
+void write_cobertura(std::ostream& out, const CoverageMap& coverage, const LineTable& lines,
+                     const Memory& memory);
+
+}  // namespace cpu6502
@@ -2,13 +2,20 @@
 
 #include <expected>
 #include "error.hpp"
+#include "isa.hpp"
 #include "memory.hpp"
+#include "observer.hpp"
+#include "registers.hpp"
+#include "stats.hpp"
 #include "status_flags.hpp"
+#include "stop_condition.hpp"
 #include "types.hpp"
 
 namespace cpu6502
 {
 
+class CoverageMap;
+
 /**
  * @type class
  * @brief CPU class that would include the main cpu core subsystem
@@ -36,9 +43,21 @@ class CPU
     // Lifecycle
     constexpr void reset(Memory& memory) noexcept;
 
+    // Breakpoints are traps set with Memory::set_trap. execute() fails with
+    // BreakpointTrap and run() stops with StopReason::Breakpoint before the
+    // instruction at a trap; step() executes the instruction the trap replaced,
+    // which is how a debugger continues from a breakpoint.
+
     // Execution blocks
     [[nodiscard]] auto execute(i32 cycles, Memory& memory) -> std::expected<i32, EmulatorError>;
 
+    // Execute exactly one instruction, returning the cycles it consumed
+    [[nodiscard]] auto step(Memory& memory) -> std::expected<i32, EmulatorError>;
+
+    // Execute until one of the stop conditions is met
+    [[nodiscard]] auto run(const StopCondition& stop, Memory& memory)
+        -> std::expected<RunResult, EmulatorError>;
+
     // Getter and setters for debugging
     [[nodiscard]] constexpr u16         get_pc() const noexcept { return pc_; }
     [[nodiscard]] constexpr u8          get_sp() const noexcept { return sp_; }
@@ -47,9 +66,41 @@ class CPU
     [[nodiscard]] constexpr u8          get_y() const noexcept { return y_; }
     [[nodiscard]] constexpr StatusFlags get_flags() const noexcept { return flags_; }
 
+    constexpr void set_pc(u16 value) noexcept { pc_ = value; }
+    constexpr void set_sp(u8 value) noexcept { sp_ = value; }
+    constexpr void set_a(u8 value) noexcept { a_ = value; }
     constexpr void set_x(u8 value) noexcept { x_ = value; }
     constexpr void set_y(u8 value) noexcept { y_ = value; }
 
+    // Whole register file, for loading initial state and collecting results
+    [[nodiscard]] constexpr Registers get_registers() const noexcept;
+    constexpr void                    set_registers(const Registers& registers) noexcept;
+
+    // Cycles executed since construction, across execute/step/run
+    [[nodiscard]] constexpr u64 get_cycles() const noexcept { return cycles_; }
+    constexpr void              set_cycles(u64 value) noexcept { cycles_ = value; }
+
+    // Interrupt inputs, sampled before every instruction. IRQ is level
+    // triggered and masked by the I flag; NMI is edge triggered.
+    constexpr void set_irq_line(bool asserted) noexcept { irq_line_ = asserted; }
+    constexpr void trigger_nmi() noexcept { nmi_pending_ = true; }
+
+    [[nodiscard]] constexpr bool get_irq_line() const noexcept { return irq_line_; }
+    [[nodiscard]] constexpr bool get_nmi_pending() const noexcept { return nmi_pending_; }
+    constexpr void               set_nmi_pending(bool pending) noexcept { nmi_pending_ = pending; }
+
+    // Instrumented path: the observer sees every instruction before it executes
+    constexpr void set_observer(ExecutionObserver* observer) noexcept { observer_ = observer; }
+    [[nodiscard]] constexpr ExecutionObserver* get_observer() const noexcept { return observer_; }
+
+    // Coverage bitmaps set on every executed instruction; nullptr detaches. Not owned.
+    constexpr void set_coverage(CoverageMap* coverage) noexcept { coverage_ = coverage; }
+    [[nodiscard]] constexpr CoverageMap* get_coverage() const noexcept { return coverage_; }
+
+    // Per-opcode counters; empty unless built with CPU6502_STATS
+    [[nodiscard]] constexpr StatsCollector&       stats() noexcept { return stats_; }
+    [[nodiscard]] constexpr const StatsCollector& stats() const noexcept { return stats_; }
+
     // Setters for flags
     constexpr void set_flag_c(bool value) noexcept { flags_.carry = value; }
 
@@ -65,21 +116,30 @@ class CPU
     u8          y_{};   // Y register
     StatusFlags flags_{};
 
+    u64                cycles_{};             // Total cycles executed
+    ExecutionObserver* observer_ = nullptr;  // Not owned
+    CoverageMap*       coverage_ = nullptr;  // Not owned
+
+    [[no_unique_address]] StatsCollector stats_;
+    bool               irq_line_    = false;
+    bool               nmi_pending_ = false;
+
+    void notify(const Memory& memory) const noexcept;
+    void notify_interrupt() const noexcept;
+
     // Core operations
-    [[nodiscard]] constexpr auto fetch_byte(i32& cycles, Memory& memory)
-        -> std::expected<u8, EmulatorError>;
+    [[nodiscard]] constexpr auto fetch_byte(Memory& memory) -> std::expected<u8, EmulatorError>;
+
+    [[nodiscard]] constexpr auto fetch_opcode(Memory& memory) -> std::expected<u8, EmulatorError>;
 
-    [[nodiscard]] constexpr auto fetch_word(i32& cycles, Memory& memory)
-        -> std::expected<u16, EmulatorError>;
+    [[nodiscard]] constexpr auto fetch_word(Memory& memory) -> std::expected<u16, EmulatorError>;
 
-    [[nodiscard]] constexpr auto read_byte(i32& cycles, u16 address, Memory& memory)
+    [[nodiscard]] constexpr auto read_byte(u16 address, Memory& memory)
         -> std::expected<u8, EmulatorError>;
 
-    constexpr auto push_byte(i32& cycles, u8 value, Memory& memory)
-        -> std::expected<void, EmulatorError>;
+    constexpr auto push_byte(u8 value, Memory& memory) -> std::expected<void, EmulatorError>;
 
-    [[nodiscard]] constexpr auto pop_byte(i32& cycles, Memory& memory)
-        -> std::expected<u8, EmulatorError>;
+    [[nodiscard]] constexpr auto pop_byte(Memory& memory) -> std::expected<u8, EmulatorError>;
 
     // Helper Methods - Flag changes
 
@@ -97,53 +157,67 @@ class CPU
     constexpr void inc_memory(u8& value) noexcept;
     constexpr void dec_memory(u8& value) noexcept;
 
-    [[nodiscard]] constexpr auto clear_carry_flag(i32& cycles) noexcept
-        -> std::expected<void, EmulatorError>;
+    [[nodiscard]] constexpr auto clear_carry_flag() noexcept -> std::expected<void, EmulatorError>;
 
-    [[nodiscard]] constexpr auto clear_decimal_mode(i32& cycles) noexcept
+    [[nodiscard]] constexpr auto clear_decimal_mode() noexcept
         -> std::expected<void, EmulatorError>;
 
-    [[nodiscard]] constexpr auto clear_interrupt_disable(i32& cycles) noexcept
+    [[nodiscard]] constexpr auto clear_interrupt_disable() noexcept
         -> std::expected<void, EmulatorError>;
 
-    [[nodiscard]] constexpr auto clear_overflow_flag(i32& cycles) noexcept
+    [[nodiscard]] constexpr auto clear_overflow_flag() noexcept
         -> std::expected<void, EmulatorError>;
 
-    [[nodiscard]] constexpr auto inc_x_register(i32& cycles) noexcept
-        -> std::expected<void, EmulatorError>;
+    [[nodiscard]] constexpr auto inc_x_register() noexcept -> std::expected<void, EmulatorError>;
 
-    [[nodiscard]] constexpr auto inc_y_register(i32& cycles) noexcept
-        -> std::expected<void, EmulatorError>;
+    [[nodiscard]] constexpr auto inc_y_register() noexcept -> std::expected<void, EmulatorError>;
 
-    [[nodiscard]] constexpr auto dec_x_register(i32& cycles) noexcept
-        -> std::expected<void, EmulatorError>;
+    [[nodiscard]] constexpr auto dec_x_register() noexcept -> std::expected<void, EmulatorError>;
+
+    [[nodiscard]] constexpr auto dec_y_register() noexcept -> std::expected<void, EmulatorError>;
+
+    // Interrupt sequence: push PC and P, set I, jump through the vector (7 cycles)
+    [[nodiscard]] constexpr bool interrupt_pending() const noexcept
+    {
+        return nmi_pending_ || (irq_line_ && !flags_.interrupt);
+    }
 
-    [[nodiscard]] constexpr auto dec_y_register(i32& cycles) noexcept
+    [[nodiscard]] constexpr auto service_interrupt(i32& cycles, Memory& memory)
         -> std::expected<void, EmulatorError>;
 
-    // Helper for page boundary detection
-    [[nodiscard]] static constexpr auto page_crossed(u16 base_addr, u16 effective_addr) noexcept
+    // Helper for page boundary detection; every caller charges the penalty cycle
+    [[nodiscard]] constexpr auto page_crossed(u16 base_addr, u16 effective_addr) noexcept
     {
-        return (base_addr & 0xFF00) != (effective_addr & 0xFF00);
+        const bool crossed = (base_addr & 0xFF00) != (effective_addr & 0xFF00);
+        if (crossed)
+            stats_.record_page_cross();
+        return crossed;
     }
 
     // Instruction execution
     [[nodiscard]] constexpr auto fetch_and_execute(i32& cycles, Memory& memory)
         -> std::expected<void, EmulatorError>;
 
+    // Executes the original instruction under the trap at PC
+    [[nodiscard]] constexpr auto execute_trapped(i32& cycles, Memory& memory)
+        -> std::expected<void, EmulatorError>;
+
+    [[nodiscard]] constexpr auto execute_opcode(Opcode opcode, i32& cycles, Memory& memory)
+        -> std::expected<void, EmulatorError>;
+
     // Individual instruction implementations
     // Load Accumulator
 
-    [[nodiscard]] constexpr auto execute_lda_immediate(i32& cycles, Memory& memory)
+    [[nodiscard]] constexpr auto execute_lda_immediate(Memory& memory)
         -> std::expected<void, EmulatorError>;
 
-    [[nodiscard]] constexpr auto execute_lda_zero_page(i32& cycles, Memory& memory)
+    [[nodiscard]] constexpr auto execute_lda_zero_page(Memory& memory)
         -> std::expected<void, EmulatorError>;
 
-    [[nodiscard]] constexpr auto execute_lda_zero_page_x(i32& cycles, Memory& memory)
+    [[nodiscard]] constexpr auto execute_lda_zero_page_x(Memory& memory)
         -> std::expected<void, EmulatorError>;
 
-    [[nodiscard]] constexpr auto execute_lda_absolute(i32& cycles, Memory& memory)
+    [[nodiscard]] constexpr auto execute_lda_absolute(Memory& memory)
         -> std::expected<void, EmulatorError>;
 
     [[nodiscard]] constexpr auto execute_lda_absolute_x(i32& cycles, Memory& memory)
@@ -154,40 +228,38 @@ class CPU
 
     // Control Flow instructions
 
-    [[nodiscard]] constexpr auto execute_jsr(i32& cycles, Memory& memory)
-        -> std::expected<void, EmulatorError>;
+    [[nodiscard]] constexpr auto execute_jsr(Memory& memory) -> std::expected<void, EmulatorError>;
 
-    [[nodiscard]] constexpr auto execute_rts(i32& cycles, Memory& memory)
-        -> std::expected<void, EmulatorError>;
+    [[nodiscard]] constexpr auto execute_rts(Memory& memory) -> std::expected<void, EmulatorError>;
 
     // Load X Register
 
-    [[nodiscard]] constexpr auto execute_ldx_immediate(i32& cycles, Memory& memory)
+    [[nodiscard]] constexpr auto execute_ldx_immediate(Memory& memory)
         -> std::expected<void, EmulatorError>;
 
-    [[nodiscard]] constexpr auto execute_ldx_zero_page(i32& cycles, Memory& memory)
+    [[nodiscard]] constexpr auto execute_ldx_zero_page(Memory& memory)
         -> std::expected<void, EmulatorError>;
 
-    [[nodiscard]] constexpr auto execute_ldx_zero_page_y(i32& cycles, Memory& memory)
+    [[nodiscard]] constexpr auto execute_ldx_zero_page_y(Memory& memory)
         -> std::expected<void, EmulatorError>;
 
-    [[nodiscard]] constexpr auto execute_ldx_absolute(i32& cycles, Memory& memory)
+    [[nodiscard]] constexpr auto execute_ldx_absolute(Memory& memory)
         -> std::expected<void, EmulatorError>;
 
     [[nodiscard]] constexpr auto execute_ldx_absolute_y(i32& cycles, Memory& memory)
         -> std::expected<void, EmulatorError>;
 
     // Load Y Register
-    [[nodiscard]] constexpr auto execute_ldy_immediate(i32& cycles, Memory& memory)
+    [[nodiscard]] constexpr auto execute_ldy_immediate(Memory& memory)
         -> std::expected<void, EmulatorError>;
 
-    [[nodiscard]] constexpr auto execute_ldy_zero_page(i32& cycles, Memory& memory)
+    [[nodiscard]] constexpr auto execute_ldy_zero_page(Memory& memory)
         -> std::expected<void, EmulatorError>;
 
-    [[nodiscard]] constexpr auto execute_ldy_zero_page_x(i32& cycles, Memory& memory)
+    [[nodiscard]] constexpr auto execute_ldy_zero_page_x(Memory& memory)
         -> std::expected<void, EmulatorError>;
 
-    [[nodiscard]] constexpr auto execute_ldy_absolute(i32& cycles, Memory& memory)
+    [[nodiscard]] constexpr auto execute_ldy_absolute(Memory& memory)
         -> std::expected<void, EmulatorError>;
 
     [[nodiscard]] constexpr auto execute_ldy_absolute_x(i32& cycles, Memory& memory)
@@ -195,16 +267,16 @@ class CPU
 
     // ADD With Carry
 
-    [[nodiscard]] constexpr auto execute_adc_immediate(i32& cycles, Memory& memory)
+    [[nodiscard]] constexpr auto execute_adc_immediate(Memory& memory)
         -> std::expected<void, EmulatorError>;
 
-    [[nodiscard]] constexpr auto execute_adc_zero_page(i32& cycles, Memory& memory)
+    [[nodiscard]] constexpr auto execute_adc_zero_page(Memory& memory)
         -> std::expected<void, EmulatorError>;
 
-    [[nodiscard]] constexpr auto execute_adc_zero_page_x(i32& cycles, Memory& memory)
+    [[nodiscard]] constexpr auto execute_adc_zero_page_x(Memory& memory)
         -> std::expected<void, EmulatorError>;
 
-    [[nodiscard]] constexpr auto execute_adc_absolute(i32& cycles, Memory& memory)
+    [[nodiscard]] constexpr auto execute_adc_absolute(Memory& memory)
         -> std::expected<void, EmulatorError>;
 
     [[nodiscard]] constexpr auto execute_adc_absolute_x(i32& cycles, Memory& memory)
@@ -213,7 +285,7 @@ class CPU
     [[nodiscard]] constexpr auto execute_adc_absolute_y(i32& cycles, Memory& memory)
         -> std::expected<void, EmulatorError>;
 
-    [[nodiscard]] constexpr auto execute_adc_indirect_x(i32& cycles, Memory& memory)
+    [[nodiscard]] constexpr auto execute_adc_indirect_x(Memory& memory)
         -> std::expected<void, EmulatorError>;
 
     [[nodiscard]] constexpr auto execute_adc_indirect_y(i32& cycles, Memory& memory)
@@ -221,16 +293,16 @@ class CPU
 
     // LOGICAL AND
 
-    [[nodiscard]] constexpr auto execute_and_immediate(i32& cycles, Memory& memory)
+    [[nodiscard]] constexpr auto execute_and_immediate(Memory& memory)
         -> std::expected<void, EmulatorError>;
 
-    [[nodiscard]] constexpr auto execute_and_zero_page(i32& cycles, Memory& memory)
+    [[nodiscard]] constexpr auto execute_and_zero_page(Memory& memory)
         -> std::expected<void, EmulatorError>;
 
-    [[nodiscard]] constexpr auto execute_and_zero_page_x(i32& cycles, Memory& memory)
+    [[nodiscard]] constexpr auto execute_and_zero_page_x(Memory& memory)
         -> std::expected<void, EmulatorError>;
 
-    [[nodiscard]] constexpr auto execute_and_absolute(i32& cycles, Memory& memory)
+    [[nodiscard]] constexpr auto execute_and_absolute(Memory& memory)
         -> std::expected<void, EmulatorError>;
 
     [[nodiscard]] constexpr auto execute_and_absolute_x(i32& cycles, Memory& memory)
@@ -239,7 +311,7 @@ class CPU
     [[nodiscard]] constexpr auto execute_and_absolute_y(i32& cycles, Memory& memory)
         -> std::expected<void, EmulatorError>;
 
-    [[nodiscard]] constexpr auto execute_and_indirect_x(i32& cycles, Memory& memory)
+    [[nodiscard]] constexpr auto execute_and_indirect_x(Memory& memory)
         -> std::expected<void, EmulatorError>;
 
     [[nodiscard]] constexpr auto execute_and_indirect_y(i32& cycles, Memory& memory)
@@ -247,16 +319,16 @@ class CPU
 
     // Exclusive OR
 
-    [[nodiscard]] constexpr auto execute_eor_immediate(i32& cycles, Memory& memory)
+    [[nodiscard]] constexpr auto execute_eor_immediate(Memory& memory)
         -> std::expected<void, EmulatorError>;
 
-    [[nodiscard]] constexpr auto execute_eor_zero_page(i32& cycles, Memory& memory)
+    [[nodiscard]] constexpr auto execute_eor_zero_page(Memory& memory)
         -> std::expected<void, EmulatorError>;
 
-    [[nodiscard]] constexpr auto execute_eor_zero_page_x(i32& cycles, Memory& memory)
+    [[nodiscard]] constexpr auto execute_eor_zero_page_x(Memory& memory)
         -> std::expected<void, EmulatorError>;
 
-    [[nodiscard]] constexpr auto execute_eor_absolute(i32& cycles, Memory& memory)
+    [[nodiscard]] constexpr auto execute_eor_absolute(Memory& memory)
         -> std::expected<void, EmulatorError>;
 
     [[nodiscard]] constexpr auto execute_eor_absolute_x(i32& cycles, Memory& memory)
@@ -265,7 +337,7 @@ class CPU
     [[nodiscard]] constexpr auto execute_eor_absolute_y(i32& cycles, Memory& memory)
         -> std::expected<void, EmulatorError>;
 
-    [[nodiscard]] constexpr auto execute_eor_indirect_x(i32& cycles, Memory& memory)
+    [[nodiscard]] constexpr auto execute_eor_indirect_x(Memory& memory)
         -> std::expected<void, EmulatorError>;
 
     [[nodiscard]] constexpr auto execute_eor_indirect_y(i32& cycles, Memory& memory)
@@ -273,19 +345,19 @@ class CPU
 
     // Arthmetic Shift Left
 
-    [[nodiscard]] constexpr auto execute_shift_left_accumulator(i32& cycles)
+    [[nodiscard]] constexpr auto execute_shift_left_accumulator()
         -> std::expected<void, EmulatorError>;
 
-    [[nodiscard]] constexpr auto execute_shift_left_zero_page(i32& cycles, Memory& memory)
+    [[nodiscard]] constexpr auto execute_shift_left_zero_page(Memory& memory)
         -> std::expected<void, EmulatorError>;
 
-    [[nodiscard]] constexpr auto execute_shift_left_zero_page_x(i32& cycles, Memory& memory)
+    [[nodiscard]] constexpr auto execute_shift_left_zero_page_x(Memory& memory)
         -> std::expected<void, EmulatorError>;
 
-    [[nodiscard]] constexpr auto execute_shift_left_absolute(i32& cycles, Memory& memory)
+    [[nodiscard]] constexpr auto execute_shift_left_absolute(Memory& memory)
         -> std::expected<void, EmulatorError>;
 
-    [[nodiscard]] constexpr auto execute_shift_left_absolute_x(i32& cycles, Memory& memory)
+    [[nodiscard]] constexpr auto execute_shift_left_absolute_x(Memory& memory)
         -> std::expected<void, EmulatorError>;
 
     // Branch Instructions
@@ -299,10 +371,10 @@ class CPU
     [[nodiscard]] constexpr auto execute_beq(i32& cycles, Memory& memory)
         -> std::expected<void, EmulatorError>;
 
-    [[nodiscard]] constexpr auto execute_bit_zero_page(i32& cycles, Memory& memory)
+    [[nodiscard]] constexpr auto execute_bit_zero_page(Memory& memory)
         -> std::expected<void, EmulatorError>;
 
-    [[nodiscard]] constexpr auto execute_bit_absolute(i32& cycles, Memory& memory)
+    [[nodiscard]] constexpr auto execute_bit_absolute(Memory& memory)
         -> std::expected<void, EmulatorError>;
 
     [[nodiscard]] constexpr auto execute_bmi(i32& cycles, Memory& memory)
@@ -314,8 +386,7 @@ class CPU
     [[nodiscard]] constexpr auto execute_bpl(i32& cycles, Memory& memory)
         -> std::expected<void, EmulatorError>;
 
-    [[nodiscard]] constexpr auto execute_brk(i32& cycles, Memory& memory)
-        -> std::expected<void, EmulatorError>;
+    [[nodiscard]] constexpr auto execute_brk(Memory& memory) -> std::expected<void, EmulatorError>;
 
     [[nodiscard]] constexpr auto execute_bvc(i32& cycles, Memory& memory)
         -> std::expected<void, EmulatorError>;
@@ -326,16 +397,16 @@ class CPU
     // Comparision Instuctions
     // COMPARE (Accumulator)
 
-    [[nodiscard]] constexpr auto execute_cmp_immediate(i32& cycles, Memory& memory)
+    [[nodiscard]] constexpr auto execute_cmp_immediate(Memory& memory)
         -> std::expected<void, EmulatorError>;
 
-    [[nodiscard]] constexpr auto execute_cmp_zero_page(i32& cycles, Memory& memory)
+    [[nodiscard]] constexpr auto execute_cmp_zero_page(Memory& memory)
         -> std::expected<void, EmulatorError>;
 
-    [[nodiscard]] constexpr auto execute_cmp_zero_page_x(i32& cycles, Memory& memory)
+    [[nodiscard]] constexpr auto execute_cmp_zero_page_x(Memory& memory)
         -> std::expected<void, EmulatorError>;
 
-    [[nodiscard]] constexpr auto execute_cmp_absolute(i32& cycles, Memory& memory)
+    [[nodiscard]] constexpr auto execute_cmp_absolute(Memory& memory)
         -> std::expected<void, EmulatorError>;
 
     [[nodiscard]] constexpr auto execute_cmp_absolute_x(i32& cycles, Memory& memory)
@@ -344,7 +415,7 @@ class CPU
     [[nodiscard]] constexpr auto execute_cmp_absolute_y(i32& cycles, Memory& memory)
         -> std::expected<void, EmulatorError>;
 
-    [[nodiscard]] constexpr auto execute_cmp_indirect_x(i32& cycles, Memory& memory)
+    [[nodiscard]] constexpr auto execute_cmp_indirect_x(Memory& memory)
         -> std::expected<void, EmulatorError>;
 
     [[nodiscard]] constexpr auto execute_cmp_indirect_y(i32& cycles, Memory& memory)
@@ -352,49 +423,49 @@ class CPU
 
     // Compare X Register
 
-    [[nodiscard]] constexpr auto execute_cpx_immediate(i32& cycles, Memory& memory)
+    [[nodiscard]] constexpr auto execute_cpx_immediate(Memory& memory)
         -> std::expected<void, EmulatorError>;
 
-    [[nodiscard]] constexpr auto execute_cpx_zero_page(i32& cycles, Memory& memory)
+    [[nodiscard]] constexpr auto execute_cpx_zero_page(Memory& memory)
         -> std::expected<void, EmulatorError>;
 
-    [[nodiscard]] constexpr auto execute_cpx_absolute(i32& cycles, Memory& memory)
+    [[nodiscard]] constexpr auto execute_cpx_absolute(Memory& memory)
         -> std::expected<void, EmulatorError>;
 
     // Compare Y Register
 
-    [[nodiscard]] constexpr auto execute_cpy_immediate(i32& cycles, Memory& memory)
+    [[nodiscard]] constexpr auto execute_cpy_immediate(Memory& memory)
         -> std::expected<void, EmulatorError>;
 
-    [[nodiscard]] constexpr auto execute_cpy_zero_page(i32& cycles, Memory& memory)
+    [[nodiscard]] constexpr auto execute_cpy_zero_page(Memory& memory)
         -> std::expected<void, EmulatorError>;
 
-    [[nodiscard]] constexpr auto execute_cpy_absolute(i32& cycles, Memory& memory)
+    [[nodiscard]] constexpr auto execute_cpy_absolute(Memory& memory)
         -> std::expected<void, EmulatorError>;
 
     // Increment and Decrement memory
-    [[nodiscard]] constexpr auto execute_inc_zero_page(i32& cycles, Memory& memory)
+    [[nodiscard]] constexpr auto execute_inc_zero_page(Memory& memory)
         -> std::expected<void, EmulatorError>;
 
-    [[nodiscard]] constexpr auto execute_inc_zero_page_x(i32& cycles, Memory& memory)
+    [[nodiscard]] constexpr auto execute_inc_zero_page_x(Memory& memory)
         -> std::expected<void, EmulatorError>;
 
-    [[nodiscard]] constexpr auto execute_inc_absolute(i32& cycles, Memory& memory)
+    [[nodiscard]] constexpr auto execute_inc_absolute(Memory& memory)
         -> std::expected<void, EmulatorError>;
 
-    [[nodiscard]] constexpr auto execute_inc_absolute_x(i32& cycles, Memory& memory)
+    [[nodiscard]] constexpr auto execute_inc_absolute_x(Memory& memory)
         -> std::expected<void, EmulatorError>;
 
-    [[nodiscard]] constexpr auto execute_dec_zero_page(i32& cycles, Memory& memory)
+    [[nodiscard]] constexpr auto execute_dec_zero_page(Memory& memory)
         -> std::expected<void, EmulatorError>;
 
-    [[nodiscard]] constexpr auto execute_dec_zero_page_x(i32& cycles, Memory& memory)
+    [[nodiscard]] constexpr auto execute_dec_zero_page_x(Memory& memory)
         -> std::expected<void, EmulatorError>;
 
-    [[nodiscard]] constexpr auto execute_dec_absolute(i32& cycles, Memory& memory)
+    [[nodiscard]] constexpr auto execute_dec_absolute(Memory& memory)
         -> std::expected<void, EmulatorError>;
 
-    [[nodiscard]] constexpr auto execute_dec_absolute_x(i32& cycles, Memory& memory)
+    [[nodiscard]] constexpr auto execute_dec_absolute_x(Memory& memory)
         -> std::expected<void, EmulatorError>;
 };
 
@@ -419,37 +490,98 @@ inline constexpr void CPU::reset(Memory& memory) noexcept
         }
 }
 
-inline constexpr auto CPU::fetch_byte(i32& cycles, Memory& memory)
-    -> std::expected<u8, EmulatorError>
+inline constexpr Registers CPU::get_registers() const noexcept
+{
+    return Registers{pc_, sp_, a_, x_, y_, flags_};
+}
+
+inline constexpr void CPU::set_registers(const Registers& registers) noexcept
+{
+    pc_    = registers.pc;
+    sp_    = registers.sp;
+    a_     = registers.a;
+    x_     = registers.x;
+    y_     = registers.y;
+    flags_ = registers.flags;
+}
+
+inline constexpr auto CPU::service_interrupt(i32& cycles, Memory& memory)
+    -> std::expected<void, EmulatorError>
+{
+    // Vector first and SP put back on a failed push, so a fault leaves the
+    // machine as it was and a retry pushes exactly one frame
+    auto address = memory.read_word(nmi_pending_ ? NMI_VECTOR : IRQ_VECTOR);
+    if (!address)
+        return std::unexpected(address.error());
+
+    const u8 sp = sp_;
+
+    auto push_high = push_byte(static_cast<u8>(pc_ >> 8), memory);
+    if (!push_high)
+        {
+            sp_ = sp;
+            return push_high;
+        }
+
+    auto push_low = push_byte(static_cast<u8>(pc_ & 0xFF), memory);
+    if (!push_low)
+        {
+            sp_ = sp;
+            return push_low;
+        }
+
+    // Hardware interrupts push P with the Break flag clear
+    StatusFlags pushed = flags_;
+    pushed.brk         = false;
+    auto push_status   = push_byte(pushed.to_byte(), memory);
+    if (!push_status)
+        {
+            sp_ = sp;
+            return push_status;
+        }
+
+    flags_.interrupt = true;
+    nmi_pending_     = false;
+    pc_              = address.value();
+    cycles -= 7;  // Not an instruction, so not in the opcode table
+
+    return {};
+}
+
+inline constexpr auto CPU::fetch_byte(Memory& memory) -> std::expected<u8, EmulatorError>
 {
     auto result = memory.read_byte(pc_);
     if (!result)
         return result;
     pc_++;
-    cycles--;
     return result;
 }
 
-inline constexpr auto CPU::fetch_word(i32& cycles, Memory& memory)
-    -> std::expected<u16, EmulatorError>
+inline constexpr auto CPU::fetch_opcode(Memory& memory) -> std::expected<u8, EmulatorError>
+{
+    auto result = memory.read_opcode(pc_);
+    if (!result)
+        return result;
+    pc_++;
+    return result;
+}
+
+inline constexpr auto CPU::fetch_word(Memory& memory) -> std::expected<u16, EmulatorError>
 {
     auto result = memory.read_word(pc_);
     if (!result)
         return result;
     pc_ += 2;
-    cycles -= 2;
     return result;
 }
 
-inline constexpr auto CPU::read_byte(i32& cycles, u16 address, Memory& memory)
+inline constexpr auto CPU::read_byte(u16 address, Memory& memory)
     -> std::expected<u8, EmulatorError>
 {
-    cycles--;
     return memory.read_byte(address);  // Fixed: was read_word
 }
 
-inline constexpr auto CPU::push_byte(i32& cycles, u8 value, Memory& memory)
-    -> std::expected<void, EmulatorError>
+inline constexpr auto CPU::push_byte(u8 value, Memory& memory) -> std::expected<void, EmulatorError>
 {
     if (sp_ == 0)
         return std::unexpected(EmulatorError::StackUnderflow);
@@ -457,16 +589,14 @@ inline constexpr auto CPU::push_byte(i32& cycles, u8 value, Memory& memory)
     if (!result)
         return result;
     sp_--;
-    cycles--;
     return {};
 }
 
-inline constexpr auto CPU::pop_byte(i32& cycles, Memory& memory) -> std::expected<u8, EmulatorError>
+inline constexpr auto CPU::pop_byte(Memory& memory) -> std::expected<u8, EmulatorError>
 {
     if (sp_ == 0xFF)
         return std::unexpected(EmulatorError::StackOverflow);
     sp_++;
-    cycles--;
     return memory.read_byte(STACK_PAGE + sp_);
 }
 
@@ -527,37 +657,29 @@ inline constexpr void CPU::arthmetic_shift_left(u8& value) noexcept
     set_zn_flags(value);
 }
 
-inline constexpr auto CPU::clear_carry_flag(i32& cycles) noexcept
-    -> std::expected<void, EmulatorError>
+inline constexpr auto CPU::clear_carry_flag() noexcept -> std::expected<void, EmulatorError>
 {
-    cycles--;
     flags_.carry = 0;
 
     return {};
 }
 
-inline constexpr auto CPU::clear_decimal_mode(i32& cycles) noexcept
-    -> std::expected<void, EmulatorError>
+inline constexpr auto CPU::clear_decimal_mode() noexcept -> std::expected<void, EmulatorError>
 {
-    cycles--;
     flags_.decimal = 0;
 
     return {};
 }
 
-inline constexpr auto CPU::clear_interrupt_disable(i32& cycles) noexcept
-    -> std::expected<void, EmulatorError>
+inline constexpr auto CPU::clear_interrupt_disable() noexcept -> std::expected<void, EmulatorError>
 {
-    cycles--;
     flags_.interrupt = 0;
 
     return {};
 }
 
-inline constexpr auto CPU::clear_overflow_flag(i32& cycles) noexcept
-    -> std::expected<void, EmulatorError>
+inline constexpr auto CPU::clear_overflow_flag() noexcept -> std::expected<void, EmulatorError>
 {
-    cycles--;
     flags_.overflow = 0;
     return {};
 }
@@ -607,40 +729,32 @@ inline constexpr void CPU::dec_memory(u8& value) noexcept
     set_zn_flags(value);
 }
 
-inline constexpr auto CPU::inc_x_register(i32& cycles) noexcept
-    -> std::expected<void, EmulatorError>
+inline constexpr auto CPU::inc_x_register() noexcept -> std::expected<void, EmulatorError>
 {
-    cycles--;
     x_ = x_ + 1;
     set_zn_flags(x_);
 
     return {};
 }
 
-inline constexpr auto CPU::inc_y_register(i32& cycles) noexcept
-    -> std::expected<void, EmulatorError>
+inline constexpr auto CPU::inc_y_register() noexcept -> std::expected<void, EmulatorError>
 {
-    cycles--;
     y_ = y_ + 1;
     set_zn_flags(y_);
 
     return {};
 }
 
-inline constexpr auto CPU::dec_x_register(i32& cycles) noexcept
-    -> std::expected<void, EmulatorError>
+inline constexpr auto CPU::dec_x_register() noexcept -> std::expected<void, EmulatorError>
 {
-    cycles--;
     x_ = x_ - 1;
     set_zn_flags(x_);
 
     return {};
 }
 
-inline constexpr auto CPU::dec_y_register(i32& cycles) noexcept
-    -> std::expected<void, EmulatorError>
+inline constexpr auto CPU::dec_y_register() noexcept -> std::expected<void, EmulatorError>
 {
-    cycles--;
     y_ = y_ - 1;
     set_zn_flags(y_);
 
@@ -650,24 +764,24 @@ inline constexpr auto CPU::dec_y_register(i32& cycles) noexcept
 // Instruction implementations
 // Load Accumulator
 
-inline constexpr auto CPU::execute_lda_immediate(i32& cycles, Memory& memory)
+inline constexpr auto CPU::execute_lda_immediate(Memory& memory)
     -> std::expected<void, EmulatorError>
 {
-    auto value = fetch_byte(cycles, memory);
+    auto value = fetch_byte(memory);
     if (!value)
         return std::unexpected(value.error());
     load_accumulator(value.value());
     return {};
 }
 
-inline constexpr auto CPU::execute_lda_zero_page(i32& cycles, Memory& memory)
+inline constexpr auto CPU::execute_lda_zero_page(Memory& memory)
     -> std::expected<void, EmulatorError>
 {
-    auto address = fetch_byte(cycles, memory);
+    auto address = fetch_byte(memory);
     if (!address)
         return std::unexpected(address.error());
 
-    auto value = read_byte(cycles, address.value(), memory);
+    auto value = read_byte(address.value(), memory);
     if (!value)
         return std::unexpected(value.error());
 
@@ -675,17 +789,16 @@ inline constexpr auto CPU::execute_lda_zero_page(i32& cycles, Memory& memory)
     return {};
 }
 
-inline constexpr auto CPU::execute_lda_zero_page_x(i32& cycles, Memory& memory)
+inline constexpr auto CPU::execute_lda_zero_page_x(Memory& memory)
     -> std::expected<void, EmulatorError>
 {
-    auto address = fetch_byte(cycles, memory);
+    auto address = fetch_byte(memory);
     if (!address)
         return std::unexpected(address.error());
 
     u8 final_address = address.value() + x_;
-    cycles--;
 
-    auto value = read_byte(cycles, final_address, memory);
+    auto value = read_byte(final_address, memory);
     if (!value)
         return std::unexpected(value.error());
 
@@ -693,14 +806,14 @@ inline constexpr auto CPU::execute_lda_zero_page_x(i32& cycles, Memory& memory)
     return {};
 }
 
-inline constexpr auto CPU::execute_lda_absolute(i32& cycles, Memory& memory)
+inline constexpr auto CPU::execute_lda_absolute(Memory& memory)
     -> std::expected<void, EmulatorError>
 {
-    auto address = fetch_word(cycles, memory);
+    auto address = fetch_word(memory);
     if (!address)
         return std::unexpected(address.error());
 
-    auto value = read_byte(cycles, address.value(), memory);
+    auto value = read_byte(address.value(), memory);
     if (!value)
         return std::unexpected(value.error());
 
@@ -711,13 +824,13 @@ inline constexpr auto CPU::execute_lda_absolute(i32& cycles, Memory& memory)
 inline constexpr auto CPU::execute_lda_absolute_x(i32& cycles, Memory& memory)
     -> std::expected<void, EmulatorError>
 {
-    auto address = fetch_word(cycles, memory);
+    auto address = fetch_word(memory);
     if (!address)
         return std::unexpected(address.error());
 
     u16 final_address = address.value() + x_;
 
-    auto value = read_byte(cycles, final_address, memory);
+    auto value = read_byte(final_address, memory);
     if (!value)
         return std::unexpected(value.error());
 
@@ -733,13 +846,13 @@ inline constexpr auto CPU::execute_lda_absolute_x(i32& cycles, Memory& memory)
 inline constexpr auto CPU::execute_lda_absolute_y(i32& cycles, Memory& memory)
     -> std::expected<void, EmulatorError>
 {
-    auto address = fetch_word(cycles, memory);
+    auto address = fetch_word(memory);
     if (!address)
         return std::unexpected(address.error());
 
     u16 final_address = address.value() + y_;
 
-    auto value = read_byte(cycles, final_address, memory);
+    auto value = read_byte(final_address, memory);
     if (!value)
         return std::unexpected(value.error());
 
@@ -754,22 +867,19 @@ inline constexpr auto CPU::execute_lda_absolute_y(i32& cycles, Memory& memory)
 
 // Control flow
 
-inline constexpr auto CPU::execute_jsr(i32& cycles, Memory& memory)
-    -> std::expected<void, EmulatorError>
+inline constexpr auto CPU::execute_jsr(Memory& memory) -> std::expected<void, EmulatorError>
 {
-    auto sub_address = fetch_word(cycles, memory);
+    auto sub_address = fetch_word(memory);
     if (!sub_address)
         return std::unexpected(sub_address.error());
 
     const u16 return_address = pc_ - 1;
 
-    cycles--;  // Cycle 4: internal cycle
-
-    auto push_high = push_byte(cycles, static_cast<u8>(return_address >> 8), memory);
+    auto push_high = push_byte(static_cast<u8>(return_address >> 8), memory);
     if (!push_high)
         return push_high;
 
-    auto push_low = push_byte(cycles, static_cast<u8>(return_address & 0xFF), memory);
+    auto push_low = push_byte(static_cast<u8>(return_address & 0xFF), memory);
     if (!push_low)
         return push_low;
 
@@ -778,16 +888,13 @@ inline constexpr auto CPU::execute_jsr(i32& cycles, Memory& memory)
     return {};
 }
 
-inline constexpr auto CPU::execute_rts(i32& cycles, Memory& memory)
-    -> std::expected<void, EmulatorError>
+inline constexpr auto CPU::execute_rts(Memory& memory) -> std::expected<void, EmulatorError>
 {
-    cycles--;  // Cycle 2: Internal cycle
-
-    auto low = pop_byte(cycles, memory);
+    auto low = pop_byte(memory);
     if (!low)
         return std::unexpected(low.error());
 
-    auto high = pop_byte(cycles, memory);
+    auto high = pop_byte(memory);
     if (!high)
         return std::unexpected(high.error());
 
@@ -795,17 +902,15 @@ inline constexpr auto CPU::execute_rts(i32& cycles, Memory& memory)
         static_cast<u16>(low.value()) | (static_cast<u16>(high.value()) << 8);
     pc_ = return_address + 1;
 
-    cycles -= 2;  // Cycles 5-6: Increment PC and internal operations
-
     return {};
 }
 
 // Load X register
 
-inline constexpr auto CPU::execute_ldx_immediate(i32& cycles, Memory& memory)
+inline constexpr auto CPU::execute_ldx_immediate(Memory& memory)
     -> std::expected<void, EmulatorError>
 {
-    auto value = fetch_byte(cycles, memory);
+    auto value = fetch_byte(memory);
     if (!value)
         return std::unexpected(value.error());
 
@@ -813,14 +918,14 @@ inline constexpr auto CPU::execute_ldx_immediate(i32& cycles, Memory& memory)
     return {};
 }
 
-inline constexpr auto CPU::execute_ldx_zero_page(i32& cycles, Memory& memory)
+inline constexpr auto CPU::execute_ldx_zero_page(Memory& memory)
     -> std::expected<void, EmulatorError>
 {
-    auto address = fetch_byte(cycles, memory);
+    auto address = fetch_byte(memory);
     if (!address)
         return std::unexpected(address.error());
 
-    auto value = read_byte(cycles, address.value(), memory);
+    auto value = read_byte(address.value(), memory);
     if (!value)
         return std::unexpected(address.error());
 
@@ -828,17 +933,16 @@ inline constexpr auto CPU::execute_ldx_zero_page(i32& cycles, Memory& memory)
     return {};
 }
 
-inline constexpr auto CPU::execute_ldx_zero_page_y(i32& cycles, Memory& memory)
+inline constexpr auto CPU::execute_ldx_zero_page_y(Memory& memory)
     -> std::expected<void, EmulatorError>
 {
-    auto initial_address = fetch_byte(cycles, memory);
+    auto initial_address = fetch_byte(memory);
     if (!initial_address)
         return std::unexpected(initial_address.error());
 
     u8 final_address = initial_address.value() + y_;
-    cycles--;
 
-    auto value = read_byte(cycles, final_address, memory);
+    auto value = read_byte(final_address, memory);
     if (!value)
         return std::unexpected(value.error());
 
@@ -846,14 +950,14 @@ inline constexpr auto CPU::execute_ldx_zero_page_y(i32& cycles, Memory& memory)
     return {};
 }
 
-inline constexpr auto CPU::execute_ldx_absolute(i32& cycles, Memory& memory)
+inline constexpr auto CPU::execute_ldx_absolute(Memory& memory)
     -> std::expected<void, EmulatorError>
 {
-    auto address = fetch_word(cycles, memory);
+    auto address = fetch_word(memory);
     if (!address)
         return std::unexpected(address.error());
 
-    auto value = read_byte(cycles, address.value(), memory);
+    auto value = read_byte(address.value(), memory);
     if (!value)
         return std::unexpected(value.error());
 
@@ -864,13 +968,13 @@ inline constexpr auto CPU::execute_ldx_absolute(i32& cycles, Memory& memory)
 inline constexpr auto CPU::execute_ldx_absolute_y(i32& cycles, Memory& memory)
     -> std::expected<void, EmulatorError>
 {
-    auto address = fetch_word(cycles, memory);
+    auto address = fetch_word(memory);
     if (!address)
         return std::unexpected(address.error());
 
     u16 final_address = address.value() + y_;
 
-    auto value = read_byte(cycles, final_address, memory);
+    auto value = read_byte(final_address, memory);
     if (!value)
         return std::unexpected(value.error());
 
@@ -885,10 +989,10 @@ inline constexpr auto CPU::execute_ldx_absolute_y(i32& cycles, Memory& memory)
 
 // Load Y register
 
-inline constexpr auto CPU::execute_ldy_immediate(i32& cycles, Memory& memory)
+inline constexpr auto CPU::execute_ldy_immediate(Memory& memory)
     -> std::expected<void, EmulatorError>
 {
-    auto value = fetch_byte(cycles, memory);
+    auto value = fetch_byte(memory);
     if (!value)
         return std::unexpected(value.error());
 
@@ -896,14 +1000,14 @@ inline constexpr auto CPU::execute_ldy_immediate(i32& cycles, Memory& memory)
     return {};
 }
 
-inline constexpr auto CPU::execute_ldy_zero_page(i32& cycles, Memory& memory)
+inline constexpr auto CPU::execute_ldy_zero_page(Memory& memory)
     -> std::expected<void, EmulatorError>
 {
-    auto address = fetch_byte(cycles, memory);
+    auto address = fetch_byte(memory);
     if (!address)
         return std::unexpected(address.error());
 
-    auto value = read_byte(cycles, address.value(), memory);
+    auto value = read_byte(address.value(), memory);
     if (!value)
         return std::unexpected(address.error());
 
@@ -911,17 +1015,16 @@ inline constexpr auto CPU::execute_ldy_zero_page(i32& cycles, Memory& memory)
     return {};
 }
 
-inline constexpr auto CPU::execute_ldy_zero_page_x(i32& cycles, Memory& memory)
+inline constexpr auto CPU::execute_ldy_zero_page_x(Memory& memory)
     -> std::expected<void, EmulatorError>
 {
-    auto initial_address = fetch_byte(cycles, memory);
+    auto initial_address = fetch_byte(memory);
     if (!initial_address)
         return std::unexpected(initial_address.error());
 
     u8 final_address = initial_address.value() + x_;
-    cycles--;
 
-    auto value = read_byte(cycles, final_address, memory);
+    auto value = read_byte(final_address, memory);
     if (!value)
         return std::unexpected(value.error());
 
@@ -929,14 +1032,14 @@ inline constexpr auto CPU::execute_ldy_zero_page_x(i32& cycles, Memory& memory)
     return {};
 }
 
-inline constexpr auto CPU::execute_ldy_absolute(i32& cycles, Memory& memory)
+inline constexpr auto CPU::execute_ldy_absolute(Memory& memory)
     -> std::expected<void, EmulatorError>
 {
-    auto address = fetch_word(cycles, memory);
+    auto address = fetch_word(memory);
     if (!address)
         return std::unexpected(address.error());
 
-    auto value = read_byte(cycles, address.value(), memory);
+    auto value = read_byte(address.value(), memory);
     if (!value)
         return std::unexpected(value.error());
 
@@ -947,13 +1050,13 @@ inline constexpr auto CPU::execute_ldy_absolute(i32& cycles, Memory& memory)
 inline constexpr auto CPU::execute_ldy_absolute_x(i32& cycles, Memory& memory)
     -> std::expected<void, EmulatorError>
 {
-    auto address = fetch_word(cycles, memory);
+    auto address = fetch_word(memory);
     if (!address)
         return std::unexpected(address.error());
 
     u16 final_address = address.value() + x_;
 
-    auto value = read_byte(cycles, final_address, memory);
+    auto value = read_byte(final_address, memory);
     if (!value)
         return std::unexpected(value.error());
 
@@ -967,10 +1070,10 @@ inline constexpr auto CPU::execute_ldy_absolute_x(i32& cycles, Memory& memory)
 }
 
 // ADC Immediate Mode
-inline constexpr auto CPU::execute_adc_immediate(i32& cycles, Memory& memory)
+inline constexpr auto CPU::execute_adc_immediate(Memory& memory)
     -> std::expected<void, EmulatorError>
 {
-    auto value = fetch_byte(cycles, memory);
+    auto value = fetch_byte(memory);
     if (!value)
         return std::unexpected(value.error());
 
@@ -979,14 +1082,14 @@ inline constexpr auto CPU::execute_adc_immediate(i32& cycles, Memory& memory)
 }
 
 // ADC Zero Page
-inline constexpr auto CPU::execute_adc_zero_page(i32& cycles, Memory& memory)
+inline constexpr auto CPU::execute_adc_zero_page(Memory& memory)
     -> std::expected<void, EmulatorError>
 {
-    auto address = fetch_byte(cycles, memory);
+    auto address = fetch_byte(memory);
     if (!address)
         return std::unexpected(address.error());
 
-    auto value = read_byte(cycles, address.value(), memory);
+    auto value = read_byte(address.value(), memory);
     if (!value)
         return std::unexpected(value.error());
 
@@ -995,17 +1098,16 @@ inline constexpr auto CPU::execute_adc_zero_page(i32& cycles, Memory& memory)
 }
 
 // ADC Zero Page, X
-inline constexpr auto CPU::execute_adc_zero_page_x(i32& cycles, Memory& memory)
+inline constexpr auto CPU::execute_adc_zero_page_x(Memory& memory)
     -> std::expected<void, EmulatorError>
 {
-    auto address = fetch_byte(cycles, memory);
+    auto address = fetch_byte(memory);
     if (!address)
         return std::unexpected(address.error());
 
     u8 final_address = address.value() + x_;
-    cycles--;  // Extra cycle for index addition
 
-    auto value = read_byte(cycles, final_address, memory);
+    auto value = read_byte(final_address, memory);
     if (!value)
         return std::unexpected(value.error());
 
@@ -1014,14 +1116,14 @@ inline constexpr auto CPU::execute_adc_zero_page_x(i32& cycles, Memory& memory)
 }
 
 // ADC Absolute
-inline constexpr auto CPU::execute_adc_absolute(i32& cycles, Memory& memory)
+inline constexpr auto CPU::execute_adc_absolute(Memory& memory)
     -> std::expected<void, EmulatorError>
 {
-    auto address = fetch_word(cycles, memory);
+    auto address = fetch_word(memory);
     if (!address)
         return std::unexpected(address.error());
 
-    auto value = read_byte(cycles, address.value(), memory);
+    auto value = read_byte(address.value(), memory);
     if (!value)
         return std::unexpected(value.error());
 
@@ -1033,13 +1135,13 @@ inline constexpr auto CPU::execute_adc_absolute(i32& cycles, Memory& memory)
 inline constexpr auto CPU::execute_adc_absolute_x(i32& cycles, Memory& memory)
     -> std::expected<void, EmulatorError>
 {
-    auto address = fetch_word(cycles, memory);
+    auto address = fetch_word(memory);
     if (!address)
         return std::unexpected(address.error());
 
     u16 final_address = address.value() + x_;
 
-    auto value = read_byte(cycles, final_address, memory);
+    auto value = read_byte(final_address, memory);
     if (!value)
         return std::unexpected(value.error());
 
@@ -1056,13 +1158,13 @@ inline constexpr auto CPU::execute_adc_absolute_x(i32& cycles, Memory& memory)
 inline constexpr auto CPU::execute_adc_absolute_y(i32& cycles, Memory& memory)
     -> std::expected<void, EmulatorError>
 {
-    auto address = fetch_word(cycles, memory);
+    auto address = fetch_word(memory);
     if (!address)
         return std::unexpected(address.error());
 
     u16 final_address = address.value() + y_;
 
-    auto value = read_byte(cycles, final_address, memory);
+    auto value = read_byte(final_address, memory);
     if (!value)
         return std::unexpected(value.error());
 
@@ -1076,22 +1178,20 @@ inline constexpr auto CPU::execute_adc_absolute_y(i32& cycles, Memory& memory)
 }
 
 // ADC Indirect, X
-inline constexpr auto CPU::execute_adc_indirect_x(i32& cycles, Memory& memory)
+inline constexpr auto CPU::execute_adc_indirect_x(Memory& memory)
     -> std::expected<void, EmulatorError>
 {
-    auto zero_page_addr = fetch_byte(cycles, memory);
+    auto zero_page_addr = fetch_byte(memory);
     if (!zero_page_addr)
         return std::unexpected(zero_page_addr.error());
 
     u8 indexed_addr = zero_page_addr.value() + x_;
-    cycles--;  // Extra cycle for index addition
 
     auto effective_addr = memory.read_word(indexed_addr);
     if (!effective_addr)
         return std::unexpected(effective_addr.error());
-    cycles -= 2;  // Two cycles to read word from zero page
 
-    auto value = read_byte(cycles, effective_addr.value(), memory);
+    auto value = read_byte(effective_addr.value(), memory);
     if (!value)
         return std::unexpected(value.error());
 
@@ -1103,18 +1203,17 @@ inline constexpr auto CPU::execute_adc_indirect_x(i32& cycles, Memory& memory)
 inline constexpr auto CPU::execute_adc_indirect_y(i32& cycles, Memory& memory)
     -> std::expected<void, EmulatorError>
 {
-    auto zero_page_addr = fetch_byte(cycles, memory);
+    auto zero_page_addr = fetch_byte(memory);
     if (!zero_page_addr)
         return std::unexpected(zero_page_addr.error());
 
     auto base_addr = memory.read_word(zero_page_addr.value());
     if (!base_addr)
         return std::unexpected(base_addr.error());
-    cycles -= 2;  // Two cycles to read word from zero page
 
     u16 final_address = base_addr.value() + y_;
 
-    auto value = read_byte(cycles, final_address, memory);
+    auto value = read_byte(final_address, memory);
     if (!value)
         return std::unexpected(value.error());
 
@@ -1128,10 +1227,10 @@ inline constexpr auto CPU::execute_adc_indirect_y(i32& cycles, Memory& memory)
 }
 
 // AND Immediate Mode
-inline constexpr auto CPU::execute_and_immediate(i32& cycles, Memory& memory)
+inline constexpr auto CPU::execute_and_immediate(Memory& memory)
     -> std::expected<void, EmulatorError>
 {
-    auto value = fetch_byte(cycles, memory);
+    auto value = fetch_byte(memory);
     if (!value)
         return std::unexpected(value.error());
 
@@ -1140,14 +1239,14 @@ inline constexpr auto CPU::execute_and_immediate(i32& cycles, Memory& memory)
 }
 
 // AND Zero Page
-inline constexpr auto CPU::execute_and_zero_page(i32& cycles, Memory& memory)
+inline constexpr auto CPU::execute_and_zero_page(Memory& memory)
     -> std::expected<void, EmulatorError>
 {
-    auto address = fetch_byte(cycles, memory);
+    auto address = fetch_byte(memory);
     if (!address)
         return std::unexpected(address.error());
 
-    auto value = read_byte(cycles, address.value(), memory);
+    auto value = read_byte(address.value(), memory);
     if (!value)
         return std::unexpected(value.error());
 
@@ -1156,17 +1255,16 @@ inline constexpr auto CPU::execute_and_zero_page(i32& cycles, Memory& memory)
 }
 
 // AND Zero Page, X
-inline constexpr auto CPU::execute_and_zero_page_x(i32& cycles, Memory& memory)
+inline constexpr auto CPU::execute_and_zero_page_x(Memory& memory)
     -> std::expected<void, EmulatorError>
 {
-    auto address = fetch_byte(cycles, memory);
+    auto address = fetch_byte(memory);
     if (!address)
         return std::unexpected(address.error());
 
     u8 final_address = address.value() + x_;
-    cycles--;  // Extra cycle for index addition
 
-    auto value = read_byte(cycles, final_address, memory);
+    auto value = read_byte(final_address, memory);
     if (!value)
         return std::unexpected(value.error());
 
@@ -1175,14 +1273,14 @@ inline constexpr auto CPU::execute_and_zero_page_x(i32& cycles, Memory& memory)
 }
 
 // AND Absolute
-inline constexpr auto CPU::execute_and_absolute(i32& cycles, Memory& memory)
+inline constexpr auto CPU::execute_and_absolute(Memory& memory)
     -> std::expected<void, EmulatorError>
 {
-    auto address = fetch_word(cycles, memory);
+    auto address = fetch_word(memory);
     if (!address)
         return std::unexpected(address.error());
 
-    auto value = read_byte(cycles, address.value(), memory);
+    auto value = read_byte(address.value(), memory);
     if (!value)
         return std::unexpected(value.error());
 
@@ -1194,13 +1292,13 @@ inline constexpr auto CPU::execute_and_absolute(i32& cycles, Memory& memory)
 inline constexpr auto CPU::execute_and_absolute_x(i32& cycles, Memory& memory)
     -> std::expected<void, EmulatorError>
 {
-    auto address = fetch_word(cycles, memory);
+    auto address = fetch_word(memory);
     if (!address)
         return std::unexpected(address.error());
 
     u16 final_address = address.value() + x_;
 
-    auto value = read_byte(cycles, final_address, memory);
+    auto value = read_byte(final_address, memory);
     if (!value)
         return std::unexpected(value.error());
 
@@ -1217,13 +1315,13 @@ inline constexpr auto CPU::execute_and_absolute_x(i32& cycles, Memory& memory)
 inline constexpr auto CPU::execute_and_absolute_y(i32& cycles, Memory& memory)
     -> std::expected<void, EmulatorError>
 {
-    auto address = fetch_word(cycles, memory);
+    auto address = fetch_word(memory);
     if (!address)
         return std::unexpected(address.error());
 
     u16 final_address = address.value() + y_;
 
-    auto value = read_byte(cycles, final_address, memory);
+    auto value = read_byte(final_address, memory);
     if (!value)
         return std::unexpected(value.error());
 
@@ -1237,22 +1335,20 @@ inline constexpr auto CPU::execute_and_absolute_y(i32& cycles, Memory& memory)
 }
 
 // AND Indirect, X
-inline constexpr auto CPU::execute_and_indirect_x(i32& cycles, Memory& memory)
+inline constexpr auto CPU::execute_and_indirect_x(Memory& memory)
     -> std::expected<void, EmulatorError>
 {
-    auto zero_page_addr = fetch_byte(cycles, memory);
+    auto zero_page_addr = fetch_byte(memory);
     if (!zero_page_addr)
         return std::unexpected(zero_page_addr.error());
 
     u8 indexed_addr = zero_page_addr.value() + x_;
-    cycles--;  // Extra cycle for index addition
 
     auto effective_addr = memory.read_word(indexed_addr);
     if (!effective_addr)
         return std::unexpected(effective_addr.error());
-    cycles -= 2;  // Two cycles to read word from zero page
 
-    auto value = read_byte(cycles, effective_addr.value(), memory);
+    auto value = read_byte(effective_addr.value(), memory);
     if (!value)
         return std::unexpected(value.error());
 
@@ -1264,18 +1360,17 @@ inline constexpr auto CPU::execute_and_indirect_x(i32& cycles, Memory& memory)
 inline constexpr auto CPU::execute_and_indirect_y(i32& cycles, Memory& memory)
     -> std::expected<void, EmulatorError>
 {
-    auto zero_page_addr = fetch_byte(cycles, memory);
+    auto zero_page_addr = fetch_byte(memory);
     if (!zero_page_addr)
         return std::unexpected(zero_page_addr.error());
 
     auto base_addr = memory.read_word(zero_page_addr.value());
     if (!base_addr)
         return std::unexpected(base_addr.error());
-    cycles -= 2;  // Two cycles to read word from zero page
 
     u16 final_address = base_addr.value() + y_;
 
-    auto value = read_byte(cycles, final_address, memory);
+    auto value = read_byte(final_address, memory);
     if (!value)
         return std::unexpected(value.error());
 
@@ -1289,112 +1384,96 @@ inline constexpr auto CPU::execute_and_indirect_y(i32& cycles, Memory& memory)
 }
 
 // Arthmetic Shift Left
-inline constexpr auto CPU::execute_shift_left_accumulator(i32& cycles)
-    -> std::expected<void, EmulatorError>
+inline constexpr auto CPU::execute_shift_left_accumulator() -> std::expected<void, EmulatorError>
 {
-    cycles--;
     arthmetic_shift_left(a_);  // Pass Accumulator by reference
     return {};
 }
 
-inline constexpr auto CPU::execute_shift_left_zero_page(i32& cycles, Memory& memory)
+inline constexpr auto CPU::execute_shift_left_zero_page(Memory& memory)
     -> std::expected<void, EmulatorError>
 {
-    auto address = fetch_byte(cycles, memory);
+    auto address = fetch_byte(memory);
     if (!address)
         return std::unexpected(address.error());
 
-    auto value = read_byte(cycles, address.value(), memory);
+    auto value = read_byte(address.value(), memory);
     if (!value)
         return std::unexpected(value.error());
 
     u8 temp = value.value();
     arthmetic_shift_left(temp);
 
-    cycles--;
-
     auto write_result = memory.write_byte(address.value(), temp);
     if (!write_result)
         return write_result;
-    cycles--;
 
     return {};
 }
 
-inline constexpr auto CPU::execute_shift_left_zero_page_x(i32& cycles, Memory& memory)
+inline constexpr auto CPU::execute_shift_left_zero_page_x(Memory& memory)
     -> std::expected<void, EmulatorError>
 {
-    auto zero_page_addr = fetch_byte(cycles, memory);
+    auto zero_page_addr = fetch_byte(memory);
     if (!zero_page_addr)
         return std::unexpected(zero_page_addr.error());
 
     u8 final_addr = zero_page_addr.value() + x_;
-    cycles--;
 
-    auto value = read_byte(cycles, final_addr, memory);
+    auto value = read_byte(final_addr, memory);
     if (!value)
         return std::unexpected(value.error());
 
     u8 temp = value.value();
     arthmetic_shift_left(temp);
 
-    cycles--;
-
     auto write_result = memory.write_byte(final_addr, temp);
     if (!write_result)
         return write_result;
-    cycles--;
 
     return {};
 }
 
-inline constexpr auto CPU::execute_shift_left_absolute(i32& cycles, Memory& memory)
+inline constexpr auto CPU::execute_shift_left_absolute(Memory& memory)
     -> std::expected<void, EmulatorError>
 {
-    auto address = fetch_word(cycles, memory);
+    auto address = fetch_word(memory);
     if (!address)
         return std::unexpected(address.error());
 
-    auto value = read_byte(cycles, address.value(), memory);
+    auto value = read_byte(address.value(), memory);
     if (!value)
         return std::unexpected(value.error());
 
     u8 temp = value.value();
     arthmetic_shift_left(temp);
 
-    cycles--;
-
     auto write_result = memory.write_byte(address.value(), temp);
     if (!write_result)
         return write_result;
-    cycles--;
 
     return {};
 }
 
-inline constexpr auto CPU::execute_shift_left_absolute_x(i32& cycles, Memory& memory)
+inline constexpr auto CPU::execute_shift_left_absolute_x(Memory& memory)
     -> std::expected<void, EmulatorError>
 {
-    auto address = fetch_word(cycles, memory);
+    auto address = fetch_word(memory);
     if (!address)
         return std::unexpected(address.error());
 
     u16 final_address = address.value() + x_;
-    cycles--;
 
-    auto value = read_byte(cycles, final_address, memory);
+    auto value = read_byte(final_address, memory);
     if (!value)
         return std::unexpected(value.error());
 
     u8 temp = value.value();
     arthmetic_shift_left(temp);
 
-    cycles--;
-
     auto write_result = memory.write_byte(final_address, temp);
     if (!write_result)
         return write_result;
-    cycles--;
     return {};
 }
 
@@ -1403,14 +1482,17 @@ inline constexpr auto CPU::execute_shift_left_absolute_x(i32& cycles, Memory& me
 inline constexpr auto CPU::execute_bcc(i32& cycles, Memory& memory)
     -> std::expected<void, EmulatorError>
 {
-    auto offset_result = fetch_byte(cycles, memory);
+    auto offset_result = fetch_byte(memory);
     if (!offset_result)
         return std::unexpected(offset_result.error());
 
     // Convert to signed 8 bit value
     i8 offset = static_cast<i8>(offset_result.value());
 
-    if (!flags_.carry)
+    const bool taken = !flags_.carry;
+    stats_.record_branch(Opcode::BCC, taken);
+
+    if (taken)
         {
             cycles--;
 
@@ -1432,14 +1514,17 @@ inline constexpr auto CPU::execute_bcc(i32& cycles, Memory& memory)
 inline constexpr auto CPU::execute_bcs(i32& cycles, Memory& memory)
     -> std::expected<void, EmulatorError>
 {
-    auto offset_result = fetch_byte(cycles, memory);
+    auto offset_result = fetch_byte(memory);
     if (!offset_result)
         return std::unexpected(offset_result.error());
 
     // Convert to signed 8 bit value
     i8 offset = static_cast<i8>(offset_result.value());
 
-    if (flags_.carry)
+    const bool taken = flags_.carry;
+    stats_.record_branch(Opcode::BCS, taken);
+
+    if (taken)
         {
             cycles--;
 
@@ -1461,14 +1546,17 @@ inline constexpr auto CPU::execute_bcs(i32& cycles, Memory& memory)
 inline constexpr auto CPU::execute_beq(i32& cycles, Memory& memory)
     -> std::expected<void, EmulatorError>
 {
-    auto offset_result = fetch_byte(cycles, memory);
+    auto offset_result = fetch_byte(memory);
     if (!offset_result)
         return std::unexpected(offset_result.error());
 
     // Convert to signed 8 bit value
     i8 offset = static_cast<i8>(offset_result.value());
 
-    if (flags_.zero)
+    const bool taken = flags_.zero;
+    stats_.record_branch(Opcode::BEQ, taken);
+
+    if (taken)
         {
             cycles--;
 
@@ -1487,14 +1575,14 @@ inline constexpr auto CPU::execute_beq(i32& cycles, Memory& memory)
     return {};
 }
 
-inline constexpr auto CPU::execute_bit_zero_page(i32& cycles, Memory& memory)
+inline constexpr auto CPU::execute_bit_zero_page(Memory& memory)
     -> std::expected<void, EmulatorError>
 {
-    auto address = fetch_byte(cycles, memory);
+    auto address = fetch_byte(memory);
     if (!address)
         return std::unexpected(address.error());
 
-    auto value = read_byte(cycles, address.value(), memory);
+    auto value = read_byte(address.value(), memory);
     if (!value)
         return std::unexpected(value.error());
 
@@ -1509,14 +1597,14 @@ inline constexpr auto CPU::execute_bit_zero_page(i32& cycles, Memory& memory)
     return {};
 }
 
-inline constexpr auto CPU::execute_bit_absolute(i32& cycles, Memory& memory)
+inline constexpr auto CPU::execute_bit_absolute(Memory& memory)
     -> std::expected<void, EmulatorError>
 {
-    auto address = fetch_word(cycles, memory);
+    auto address = fetch_word(memory);
     if (!address)
         return std::unexpected(address.error());
 
-    auto value = read_byte(cycles, address.value(), memory);
+    auto value = read_byte(address.value(), memory);
     if (!value)
         return std::unexpected(value.error());
 
@@ -1534,14 +1622,17 @@ inline constexpr auto CPU::execute_bit_absolute(i32& cycles, Memory& memory)
 inline constexpr auto CPU::execute_bmi(i32& cycles, Memory& memory)
     -> std::expected<void, EmulatorError>
 {
-    auto offset_result = fetch_byte(cycles, memory);
+    auto offset_result = fetch_byte(memory);
     if (!offset_result)
         return std::unexpected(offset_result.error());
 
     // Convert to signed 8 bit value
     i8 offset = static_cast<i8>(offset_result.value());
 
-    if (flags_.negative)
+    const bool taken = flags_.negative;
+    stats_.record_branch(Opcode::BMI, taken);
+
+    if (taken)
         {
             cycles--;
 
@@ -1563,14 +1654,17 @@ inline constexpr auto CPU::execute_bmi(i32& cycles, Memory& memory)
 inline constexpr auto CPU::execute_bne(i32& cycles, Memory& memory)
     -> std::expected<void, EmulatorError>
 {
-    auto offset_result = fetch_byte(cycles, memory);
+    auto offset_result = fetch_byte(memory);
     if (!offset_result)
         return std::unexpected(offset_result.error());
 
     // Convert to signed 8 bit value
     i8 offset = static_cast<i8>(offset_result.value());
 
-    if (!flags_.zero)
+    const bool taken = !flags_.zero;
+    stats_.record_branch(Opcode::BNE, taken);
+
+    if (taken)
         {
             cycles--;
 
@@ -1592,14 +1686,17 @@ inline constexpr auto CPU::execute_bne(i32& cycles, Memory& memory)
 inline constexpr auto CPU::execute_bpl(i32& cycles, Memory& memory)
     -> std::expected<void, EmulatorError>
 {
-    auto offset_result = fetch_byte(cycles, memory);
+    auto offset_result = fetch_byte(memory);
     if (!offset_result)
         return std::unexpected(offset_result.error());
 
     // Convert to signed 8 bit value
     i8 offset = static_cast<i8>(offset_result.value());
 
-    if (!flags_.negative)
+    const bool taken = !flags_.negative;
+    stats_.record_branch(Opcode::BPL, taken);
+
+    if (taken)
         {
             cycles--;
 
@@ -1621,14 +1718,17 @@ inline constexpr auto CPU::execute_bpl(i32& cycles, Memory& memory)
 inline constexpr auto CPU::execute_bvc(i32& cycles, Memory& memory)
     -> std::expected<void, EmulatorError>
 {
-    auto offset_result = fetch_byte(cycles, memory);
+    auto offset_result = fetch_byte(memory);
     if (!offset_result)
         return std::unexpected(offset_result.error());
 
     // Convert to signed 8 bit value
     i8 offset = static_cast<i8>(offset_result.value());
 
-    if (!flags_.overflow)
+    const bool taken = !flags_.overflow;
+    stats_.record_branch(Opcode::BVC, taken);
+
+    if (taken)
         {
             cycles--;
 
@@ -1650,14 +1750,17 @@ inline constexpr auto CPU::execute_bvc(i32& cycles, Memory& memory)
 inline constexpr auto CPU::execute_bvs(i32& cycles, Memory& memory)
     -> std::expected<void, EmulatorError>
 {
-    auto offset_result = fetch_byte(cycles, memory);
+    auto offset_result = fetch_byte(memory);
     if (!offset_result)
         return std::unexpected(offset_result.error());
 
     // Convert to signed 8 bit value
     i8 offset = static_cast<i8>(offset_result.value());
 
-    if (flags_.overflow)
+    const bool taken = flags_.overflow;
+    stats_.record_branch(Opcode::BVS, taken);
+
+    if (taken)
         {
             cycles--;
 
@@ -1676,25 +1779,24 @@ inline constexpr auto CPU::execute_bvs(i32& cycles, Memory& memory)
     return {};
 }
 
-inline constexpr auto CPU::execute_brk(i32& cycles, Memory& memory)
-    -> std::expected<void, EmulatorError>
+inline constexpr auto CPU::execute_brk(Memory& memory) -> std::expected<void, EmulatorError>
 {
     // BRK is a 2-byte instruction (opcode + padding byte)
     pc_++;  // Skip the padding byte
 
     // Push PC (return address) onto stack
-    auto push_high = push_byte(cycles, static_cast<u8>(pc_ >> 8), memory);
+    auto push_high = push_byte(static_cast<u8>(pc_ >> 8), memory);
     if (!push_high)
         return push_high;
 
-    auto push_low = push_byte(cycles, static_cast<u8>(pc_ & 0xFF), memory);
+    auto push_low = push_byte(static_cast<u8>(pc_ & 0xFF), memory);
     if (!push_low)
         return push_low;
 
     // Push status flags with Break flag set
     flags_.brk       = true;
     u8   status      = flags_.to_byte();
-    auto push_status = push_byte(cycles, status, memory);
+    auto push_status = push_byte(status, memory);
     if (!push_status)
         return push_status;
 
@@ -1707,7 +1809,6 @@ inline constexpr auto CPU::execute_brk(i32& cycles, Memory& memory)
         return std::unexpected(irq_vector.error());
 
     pc_ = irq_vector.value();
-    cycles -= 2;  // Reading the vector takes 2 cycles
 
     return {};
 }
@@ -1715,10 +1816,10 @@ inline constexpr auto CPU::execute_brk(i32& cycles, Memory& memory)
 // Exclusive OR
 // Immediate
 
-inline constexpr auto CPU::execute_eor_immediate(i32& cycles, Memory& memory)
+inline constexpr auto CPU::execute_eor_immediate(Memory& memory)
     -> std::expected<void, EmulatorError>
 {
-    auto value = fetch_byte(cycles, memory);
+    auto value = fetch_byte(memory);
     if (!value)
         return std::unexpected(value.error());
 
@@ -1727,14 +1828,14 @@ inline constexpr auto CPU::execute_eor_immediate(i32& cycles, Memory& memory)
 }
 
 // EOR Zero Page
-inline constexpr auto CPU::execute_eor_zero_page(i32& cycles, Memory& memory)
+inline constexpr auto CPU::execute_eor_zero_page(Memory& memory)
     -> std::expected<void, EmulatorError>
 {
-    auto address = fetch_byte(cycles, memory);
+    auto address = fetch_byte(memory);
     if (!address)
         return std::unexpected(address.error());
 
-    auto value = read_byte(cycles, address.value(), memory);
+    auto value = read_byte(address.value(), memory);
     if (!value)
         return std::unexpected(value.error());
 
@@ -1743,17 +1844,16 @@ inline constexpr auto CPU::execute_eor_zero_page(i32& cycles, Memory& memory)
 }
 
 // EOR Zero Page, X
-inline constexpr auto CPU::execute_eor_zero_page_x(i32& cycles, Memory& memory)
+inline constexpr auto CPU::execute_eor_zero_page_x(Memory& memory)
     -> std::expected<void, EmulatorError>
 {
-    auto address = fetch_byte(cycles, memory);
+    auto address = fetch_byte(memory);
     if (!address)
         return std::unexpected(address.error());
 
     u8 final_address = address.value() + x_;
-    cycles--;  // Extra cycle for index addition
 
-    auto value = read_byte(cycles, final_address, memory);
+    auto value = read_byte(final_address, memory);
     if (!value)
         return std::unexpected(value.error());
 
@@ -1762,14 +1862,14 @@ inline constexpr auto CPU::execute_eor_zero_page_x(i32& cycles, Memory& memory)
 }
 
 // EOR Absolute
-inline constexpr auto CPU::execute_eor_absolute(i32& cycles, Memory& memory)
+inline constexpr auto CPU::execute_eor_absolute(Memory& memory)
     -> std::expected<void, EmulatorError>
 {
-    auto address = fetch_word(cycles, memory);
+    auto address = fetch_word(memory);
     if (!address)
         return std::unexpected(address.error());
 
-    auto value = read_byte(cycles, address.value(), memory);
+    auto value = read_byte(address.value(), memory);
     if (!value)
         return std::unexpected(value.error());
 
@@ -1781,13 +1881,13 @@ inline constexpr auto CPU::execute_eor_absolute(i32& cycles, Memory& memory)
 inline constexpr auto CPU::execute_eor_absolute_x(i32& cycles, Memory& memory)
     -> std::expected<void, EmulatorError>
 {
-    auto address = fetch_word(cycles, memory);
+    auto address = fetch_word(memory);
     if (!address)
         return std::unexpected(address.error());
 
     u16 final_address = address.value() + x_;
 
-    auto value = read_byte(cycles, final_address, memory);
+    auto value = read_byte(final_address, memory);
     if (!value)
         return std::unexpected(value.error());
 
@@ -1804,13 +1904,13 @@ inline constexpr auto CPU::execute_eor_absolute_x(i32& cycles, Memory& memory)
 inline constexpr auto CPU::execute_eor_absolute_y(i32& cycles, Memory& memory)
     -> std::expected<void, EmulatorError>
 {
-    auto address = fetch_word(cycles, memory);
+    auto address = fetch_word(memory);
     if (!address)
         return std::unexpected(address.error());
 
     u16 final_address = address.value() + y_;
 
-    auto value = read_byte(cycles, final_address, memory);
+    auto value = read_byte(final_address, memory);
     if (!value)
         return std::unexpected(value.error());
 
@@ -1824,22 +1924,20 @@ inline constexpr auto CPU::execute_eor_absolute_y(i32& cycles, Memory& memory)
 }
 
 // EOR Indirect, X
-inline constexpr auto CPU::execute_eor_indirect_x(i32& cycles, Memory& memory)
+inline constexpr auto CPU::execute_eor_indirect_x(Memory& memory)
     -> std::expected<void, EmulatorError>
 {
-    auto zero_page_addr = fetch_byte(cycles, memory);
+    auto zero_page_addr = fetch_byte(memory);
     if (!zero_page_addr)
         return std::unexpected(zero_page_addr.error());
 
     u8 indexed_addr = zero_page_addr.value() + x_;
-    cycles--;  // Extra cycle for index addition
 
     auto effective_addr = memory.read_word(indexed_addr);
     if (!effective_addr)
         return std::unexpected(effective_addr.error());
-    cycles -= 2;  // Two cycles to read word from zero page
 
-    auto value = read_byte(cycles, effective_addr.value(), memory);
+    auto value = read_byte(effective_addr.value(), memory);
     if (!value)
         return std::unexpected(value.error());
 
@@ -1851,18 +1949,17 @@ inline constexpr auto CPU::execute_eor_indirect_x(i32& cycles, Memory& memory)
 inline constexpr auto CPU::execute_eor_indirect_y(i32& cycles, Memory& memory)
     -> std::expected<void, EmulatorError>
 {
-    auto zero_page_addr = fetch_byte(cycles, memory);
+    auto zero_page_addr = fetch_byte(memory);
     if (!zero_page_addr)
         return std::unexpected(zero_page_addr.error());
 
     auto base_addr = memory.read_word(zero_page_addr.value());
     if (!base_addr)
         return std::unexpected(base_addr.error());
-    cycles -= 2;  // Two cycles to read word from zero page
 
     u16 final_address = base_addr.value() + y_;
 
-    auto value = read_byte(cycles, final_address, memory);
+    auto value = read_byte(final_address, memory);
     if (!value)
         return std::unexpected(value.error());
 
@@ -1878,10 +1975,10 @@ inline constexpr auto CPU::execute_eor_indirect_y(i32& cycles, Memory& memory)
 // CMP - Compare
 // Immediate
 
-inline constexpr auto CPU::execute_cmp_immediate(i32& cycles, Memory& memory)
+inline constexpr auto CPU::execute_cmp_immediate(Memory& memory)
     -> std::expected<void, EmulatorError>
 {
-    auto value = fetch_byte(cycles, memory);
+    auto value = fetch_byte(memory);
     if (!value)
         return std::unexpected(value.error());
 
@@ -1890,14 +1987,14 @@ inline constexpr auto CPU::execute_cmp_immediate(i32& cycles, Memory& memory)
 }
 
 // CMP Zero Page
-inline constexpr auto CPU::execute_cmp_zero_page(i32& cycles, Memory& memory)
+inline constexpr auto CPU::execute_cmp_zero_page(Memory& memory)
     -> std::expected<void, EmulatorError>
 {
-    auto address = fetch_byte(cycles, memory);
+    auto address = fetch_byte(memory);
     if (!address)
         return std::unexpected(address.error());
 
-    auto value = read_byte(cycles, address.value(), memory);
+    auto value = read_byte(address.value(), memory);
     if (!value)
         return std::unexpected(value.error());
 
@@ -1906,17 +2003,16 @@ inline constexpr auto CPU::execute_cmp_zero_page(i32& cycles, Memory& memory)
 }
 
 // CMP Zero Page, X
-inline constexpr auto CPU::execute_cmp_zero_page_x(i32& cycles, Memory& memory)
+inline constexpr auto CPU::execute_cmp_zero_page_x(Memory& memory)
     -> std::expected<void, EmulatorError>
 {
-    auto address = fetch_byte(cycles, memory);
+    auto address = fetch_byte(memory);
     if (!address)
         return std::unexpected(address.error());
 
     u8 final_address = address.value() + x_;
-    cycles--;  // Extra cycle for index addition
 
-    auto value = read_byte(cycles, final_address, memory);
+    auto value = read_byte(final_address, memory);
     if (!value)
         return std::unexpected(value.error());
 
@@ -1925,14 +2021,14 @@ inline constexpr auto CPU::execute_cmp_zero_page_x(i32& cycles, Memory& memory)
 }
 
 // CMP Absolute
-inline constexpr auto CPU::execute_cmp_absolute(i32& cycles, Memory& memory)
+inline constexpr auto CPU::execute_cmp_absolute(Memory& memory)
     -> std::expected<void, EmulatorError>
 {
-    auto address = fetch_word(cycles, memory);
+    auto address = fetch_word(memory);
     if (!address)
         return std::unexpected(address.error());
 
-    auto value = read_byte(cycles, address.value(), memory);
+    auto value = read_byte(address.value(), memory);
     if (!value)
         return std::unexpected(value.error());
 
@@ -1944,13 +2040,13 @@ inline constexpr auto CPU::execute_cmp_absolute(i32& cycles, Memory& memory)
 inline constexpr auto CPU::execute_cmp_absolute_x(i32& cycles, Memory& memory)
     -> std::expected<void, EmulatorError>
 {
-    auto address = fetch_word(cycles, memory);
+    auto address = fetch_word(memory);
     if (!address)
         return std::unexpected(address.error());
 
     u16 final_address = address.value() + x_;
 
-    auto value = read_byte(cycles, final_address, memory);
+    auto value = read_byte(final_address, memory);
     if (!value)
         return std::unexpected(value.error());
 
@@ -1967,13 +2063,13 @@ inline constexpr auto CPU::execute_cmp_absolute_x(i32& cycles, Memory& memory)
 inline constexpr auto CPU::execute_cmp_absolute_y(i32& cycles, Memory& memory)
     -> std::expected<void, EmulatorError>
 {
-    auto address = fetch_word(cycles, memory);
+    auto address = fetch_word(memory);
     if (!address)
         return std::unexpected(address.error());
 
     u16 final_address = address.value() + y_;
 
-    auto value = read_byte(cycles, final_address, memory);
+    auto value = read_byte(final_address, memory);
     if (!value)
         return std::unexpected(value.error());
 
@@ -1987,22 +2083,20 @@ inline constexpr auto CPU::execute_cmp_absolute_y(i32& cycles, Memory& memory)
 }
 
 // CMP Indirect, X
-inline constexpr auto CPU::execute_cmp_indirect_x(i32& cycles, Memory& memory)
+inline constexpr auto CPU::execute_cmp_indirect_x(Memory& memory)
     -> std::expected<void, EmulatorError>
 {
-    auto zero_page_addr = fetch_byte(cycles, memory);
+    auto zero_page_addr = fetch_byte(memory);
     if (!zero_page_addr)
         return std::unexpected(zero_page_addr.error());
 
     u8 indexed_addr = zero_page_addr.value() + x_;
-    cycles--;  // Extra cycle for index addition
 
     auto effective_addr = memory.read_word(indexed_addr);
     if (!effective_addr)
         return std::unexpected(effective_addr.error());
-    cycles -= 2;  // Two cycles to read word from zero page
 
-    auto value = read_byte(cycles, effective_addr.value(), memory);
+    auto value = read_byte(effective_addr.value(), memory);
     if (!value)
         return std::unexpected(value.error());
 
@@ -2014,18 +2108,17 @@ inline constexpr auto CPU::execute_cmp_indirect_x(i32& cycles, Memory& memory)
 inline constexpr auto CPU::execute_cmp_indirect_y(i32& cycles, Memory& memory)
     -> std::expected<void, EmulatorError>
 {
-    auto zero_page_addr = fetch_byte(cycles, memory);
+    auto zero_page_addr = fetch_byte(memory);
     if (!zero_page_addr)
         return std::unexpected(zero_page_addr.error());
 
     auto base_addr = memory.read_word(zero_page_addr.value());
     if (!base_addr)
         return std::unexpected(base_addr.error());
-    cycles -= 2;  // Two cycles to read word from zero page
 
     u16 final_address = base_addr.value() + y_;
 
-    auto value = read_byte(cycles, final_address, memory);
+    auto value = read_byte(final_address, memory);
     if (!value)
         return std::unexpected(value.error());
 
@@ -2041,10 +2134,10 @@ inline constexpr auto CPU::execute_cmp_indirect_y(i32& cycles, Memory& memory)
 // CPX - Compare X Register
 // Immediate
 
-inline constexpr auto CPU::execute_cpx_immediate(i32& cycles, Memory& memory)
+inline constexpr auto CPU::execute_cpx_immediate(Memory& memory)
     -> std::expected<void, EmulatorError>
 {
-    auto value = fetch_byte(cycles, memory);
+    auto value = fetch_byte(memory);
     if (!value)
         return std::unexpected(value.error());
 
@@ -2053,14 +2146,14 @@ inline constexpr auto CPU::execute_cpx_immediate(i32& cycles, Memory& memory)
 }
 
 // CPX Zero Page
-inline constexpr auto CPU::execute_cpx_zero_page(i32& cycles, Memory& memory)
+inline constexpr auto CPU::execute_cpx_zero_page(Memory& memory)
     -> std::expected<void, EmulatorError>
 {
-    auto address = fetch_byte(cycles, memory);
+    auto address = fetch_byte(memory);
     if (!address)
         return std::unexpected(address.error());
 
-    auto value = read_byte(cycles, address.value(), memory);
+    auto value = read_byte(address.value(), memory);
     if (!value)
         return std::unexpected(value.error());
 
@@ -2069,14 +2162,14 @@ inline constexpr auto CPU::execute_cpx_zero_page(i32& cycles, Memory& memory)
 }
 
 // CPX Absolute
-inline constexpr auto CPU::execute_cpx_absolute(i32& cycles, Memory& memory)
+inline constexpr auto CPU::execute_cpx_absolute(Memory& memory)
     -> std::expected<void, EmulatorError>
 {
-    auto address = fetch_word(cycles, memory);
+    auto address = fetch_word(memory);
     if (!address)
         return std::unexpected(address.error());
 
-    auto value = read_byte(cycles, address.value(), memory);
+    auto value = read_byte(address.value(), memory);
     if (!value)
         return std::unexpected(value.error());
 
@@ -2087,10 +2180,10 @@ inline constexpr auto CPU::execute_cpx_absolute(i32& cycles, Memory& memory)
 // CPY - Compare Y Register
 // Immediate
 
-inline constexpr auto CPU::execute_cpy_immediate(i32& cycles, Memory& memory)
+inline constexpr auto CPU::execute_cpy_immediate(Memory& memory)
     -> std::expected<void, EmulatorError>
 {
-    auto value = fetch_byte(cycles, memory);
+    auto value = fetch_byte(memory);
     if (!value)
         return std::unexpected(value.error());
 
@@ -2099,14 +2192,14 @@ inline constexpr auto CPU::execute_cpy_immediate(i32& cycles, Memory& memory)
 }
 
 // CPY Zero Page
-inline constexpr auto CPU::execute_cpy_zero_page(i32& cycles, Memory& memory)
+inline constexpr auto CPU::execute_cpy_zero_page(Memory& memory)
     -> std::expected<void, EmulatorError>
 {
-    auto address = fetch_byte(cycles, memory);
+    auto address = fetch_byte(memory);
     if (!address)
         return std::unexpected(address.error());
 
-    auto value = read_byte(cycles, address.value(), memory);
+    auto value = read_byte(address.value(), memory);
     if (!value)
         return std::unexpected(value.error());
 
@@ -2115,14 +2208,14 @@ inline constexpr auto CPU::execute_cpy_zero_page(i32& cycles, Memory& memory)
 }
 
 // CPY Absolute
-inline constexpr auto CPU::execute_cpy_absolute(i32& cycles, Memory& memory)
+inline constexpr auto CPU::execute_cpy_absolute(Memory& memory)
     -> std::expected<void, EmulatorError>
 {
-    auto address = fetch_word(cycles, memory);
+    auto address = fetch_word(memory);
     if (!address)
         return std::unexpected(address.error());
 
-    auto value = read_byte(cycles, address.value(), memory);
+    auto value = read_byte(address.value(), memory);
     if (!value)
         return std::unexpected(value.error());
 
@@ -2131,206 +2224,178 @@ inline constexpr auto CPU::execute_cpy_absolute(i32& cycles, Memory& memory)
 }
 
 // Increment and Decrement
-inline constexpr auto CPU::execute_inc_zero_page(i32& cycles, Memory& memory)
+inline constexpr auto CPU::execute_inc_zero_page(Memory& memory)
     -> std::expected<void, EmulatorError>
 {
-    auto address = fetch_byte(cycles, memory);
+    auto address = fetch_byte(memory);
     if (!address)
         return std::unexpected(address.error());
 
-    auto value = read_byte(cycles, address.value(), memory);
+    auto value = read_byte(address.value(), memory);
     if (!value)
         return std::unexpected(value.error());
 
     u8 temp = value.value();
     inc_memory(temp);
 
-    cycles--;
-
     auto write_result = memory.write_byte(address.value(), temp);
     if (!write_result)
         return write_result;
-    cycles--;
 
     return {};
 }
 
-inline constexpr auto CPU::execute_inc_zero_page_x(i32& cycles, Memory& memory)
+inline constexpr auto CPU::execute_inc_zero_page_x(Memory& memory)
     -> std::expected<void, EmulatorError>
 {
-    auto zero_page_addr = fetch_byte(cycles, memory);
+    auto zero_page_addr = fetch_byte(memory);
     if (!zero_page_addr)
         return std::unexpected(zero_page_addr.error());
 
     u8 final_addr = zero_page_addr.value() + x_;
-    cycles--;
 
-    auto value = read_byte(cycles, final_addr, memory);
+    auto value = read_byte(final_addr, memory);
     if (!value)
         return std::unexpected(value.error());
 
     u8 temp = value.value();
     inc_memory(temp);
 
-    cycles--;
-
     auto write_result = memory.write_byte(final_addr, temp);
     if (!write_result)
         return write_result;
-    cycles--;
 
     return {};
 }
 
-inline constexpr auto CPU::execute_inc_absolute(i32& cycles, Memory& memory)
+inline constexpr auto CPU::execute_inc_absolute(Memory& memory)
     -> std::expected<void, EmulatorError>
 {
-    auto address = fetch_word(cycles, memory);
+    auto address = fetch_word(memory);
     if (!address)
         return std::unexpected(address.error());
 
-    auto value = read_byte(cycles, address.value(), memory);
+    auto value = read_byte(address.value(), memory);
     if (!value)
         return std::unexpected(value.error());
 
     u8 temp = value.value();
     inc_memory(temp);
 
-    cycles--;
-
     auto write_result = memory.write_byte(address.value(), temp);
     if (!write_result)
         return write_result;
-    cycles--;
 
     return {};
 }
 
-inline constexpr auto CPU::execute_inc_absolute_x(i32& cycles, Memory& memory)
+inline constexpr auto CPU::execute_inc_absolute_x(Memory& memory)
     -> std::expected<void, EmulatorError>
 {
-    auto address = fetch_word(cycles, memory);
+    auto address = fetch_word(memory);
     if (!address)
         return std::unexpected(address.error());
 
     u16 final_address = address.value() + x_;
-    cycles--;
 
-    auto value = read_byte(cycles, final_address, memory);
+    auto value = read_byte(final_address, memory);
     if (!value)
         return std::unexpected(value.error());
 
     u8 temp = value.value();
     inc_memory(temp);
 
-    cycles--;
-
     auto write_result = memory.write_byte(final_address, temp);
     if (!write_result)
         return write_result;
-    cycles--;
     return {};
 }
 
 // Decrement
-inline constexpr auto CPU::execute_dec_zero_page(i32& cycles, Memory& memory)
+inline constexpr auto CPU::execute_dec_zero_page(Memory& memory)
     -> std::expected<void, EmulatorError>
 {
-    auto address = fetch_byte(cycles, memory);
+    auto address = fetch_byte(memory);
     if (!address)
         return std::unexpected(address.error());
 
-    auto value = read_byte(cycles, address.value(), memory);
+    auto value = read_byte(address.value(), memory);
     if (!value)
         return std::unexpected(value.error());
 
     u8 temp = value.value();
     dec_memory(temp);
 
-    cycles--;
-
     auto write_result = memory.write_byte(address.value(), temp);
     if (!write_result)
         return write_result;
-    cycles--;
 
     return {};
 }
 
-inline constexpr auto CPU::execute_dec_zero_page_x(i32& cycles, Memory& memory)
+inline constexpr auto CPU::execute_dec_zero_page_x(Memory& memory)
     -> std::expected<void, EmulatorError>
 {
-    auto zero_page_addr = fetch_byte(cycles, memory);
+    auto zero_page_addr = fetch_byte(memory);
     if (!zero_page_addr)
         return std::unexpected(zero_page_addr.error());
 
     u8 final_addr = zero_page_addr.value() + x_;
-    cycles--;
 
-    auto value = read_byte(cycles, final_addr, memory);
+    auto value = read_byte(final_addr, memory);
     if (!value)
         return std::unexpected(value.error());
 
     u8 temp = value.value();
     dec_memory(temp);
 
-    cycles--;
-
     auto write_result = memory.write_byte(final_addr, temp);
     if (!write_result)
         return write_result;
-    cycles--;
 
     return {};
 }
 
-inline constexpr auto CPU::execute_dec_absolute(i32& cycles, Memory& memory)
+inline constexpr auto CPU::execute_dec_absolute(Memory& memory)
     -> std::expected<void, EmulatorError>
 {
-    auto address = fetch_word(cycles, memory);
+    auto address = fetch_word(memory);
     if (!address)
         return std::unexpected(address.error());
 
-    auto value = read_byte(cycles, address.value(), memory);
+    auto value = read_byte(address.value(), memory);
     if (!value)
         return std::unexpected(value.error());
 
     u8 temp = value.value();
     dec_memory(temp);
 
-    cycles--;
-
     auto write_result = memory.write_byte(address.value(), temp);
     if (!write_result)
         return write_result;
-    cycles--;
 
     return {};
 }
 
-inline constexpr auto CPU::execute_dec_absolute_x(i32& cycles, Memory& memory)
+inline constexpr auto CPU::execute_dec_absolute_x(Memory& memory)
     -> std::expected<void, EmulatorError>
 {
-    auto address = fetch_word(cycles, memory);
+    auto address = fetch_word(memory);
     if (!address)
         return std::unexpected(address.error());
 
     u16 final_address = address.value() + x_;
-    cycles--;
 
-    auto value = read_byte(cycles, final_address, memory);
+    auto value = read_byte(final_address, memory);
     if (!value)
         return std::unexpected(value.error());
 
     u8 temp = value.value();
     dec_memory(temp);
 
-    cycles--;
-
     auto write_result = memory.write_byte(final_address, temp);
     if (!write_result)
         return write_result;
-    cycles--;
     return {};
 }
 
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <ostream>
+#include <span>
+#include <string_view>
+#include "isa.hpp"
+#include "memory.hpp"
+#include "observer.hpp"
+#include "symbols.hpp"
+#include "types.hpp"
+
+namespace cpu6502
+{
+
+/**
+ * @type struct
+ * @brief One decoded instruction
+ *
+ * operand holds the raw operand bytes, little endian; only the low byte is
+ * meaningful for one-byte operands. Branch targets are computed by target().
+ */
+struct Instruction
+{
+    u16 address = 0;
+    u16 operand = 0;
+    u8  opcode  = 0;
+    u8  length  = 1;
+
+    [[nodiscard]] constexpr const OpcodeInfo& info() const noexcept { return opcode_info(opcode); }
+
+    // Address the operand refers to: the branch target for relative branches
+    [[nodiscard]] constexpr u16 target() const noexcept
+    {
+        if (info().mode != AddressingMode::Relative)
+            return operand;
+        return static_cast<u16>(address + 2 + static_cast<i8>(operand & 0xFF));
+    }
+};
+
+// Decodes an instruction from its bytes; lo and hi are ignored past its length
+[[nodiscard]] constexpr Instruction decode(u16 address, u8 opcode, u8 lo, u8 hi) noexcept
+{
+    const u8 length = opcode_info(opcode).length;
+
+    Instruction instruction;
+    instruction.address = address;
+    instruction.opcode  = opcode;
+    instruction.length  = length;
+    if (length == 2)
+        instruction.operand = lo;
+    else if (length == 3)
+        instruction.operand = static_cast<u16>(lo | (hi << 8));
+    return instruction;
+}
+
+// Decodes the instruction at address, wrapping at $FFFF. Reads RAM directly,
+// so I/O devices see no accesses, and looks through breakpoint traps.
+[[nodiscard]] constexpr Instruction decode(const Memory& memory, u16 address) noexcept
+{
+    return decode(address, memory.peek(address), memory.peek(static_cast<u16>(address + 1)),
+                  memory.peek(static_cast<u16>(address + 2)));
+}
+
+/**
+ * @brief Linear sweep: decodes consecutive instructions starting at address
+ *
+ * Stops when out is full or the next instruction would start at or past
+ * address + size; an instruction starting inside the range is decoded whole.
+ * Returns the number of instructions written. Continue a sweep that filled out
+ * from out.back().address + out.back().length.
+ */
+[[nodiscard]] std::size_t disassemble(const Memory& memory, u16 address, u32 size,
+                                      std::span<Instruction> out) noexcept;
+
+/**
+ * @brief Range mode: decodes the instruction at each address of addresses
+ *
+ * For trace post-processing, where the addresses are the executed PCs.
+ * Returns min(addresses.size(), out.size()).
+ */
+[[nodiscard]] std::size_t disassemble(const Memory& memory, std::span<const u16> addresses,
+                                      std::span<Instruction> out) noexcept;
+
+// Longest text format_instruction() writes, "LDA ($12),Y"
+inline constexpr std::size_t MAX_INSTRUCTION_TEXT = 12;
+
+/**
+ * @brief Writes instruction as assembler text ("LDA $2010,X") into out
+ *
+ * Undocumented opcodes are written as ".byte $XX". Returns the number of
+ * characters written; the text is truncated if out is shorter than
+ * MAX_INSTRUCTION_TEXT and is not NUL-terminated.
+ */
+std::size_t format_instruction(const Instruction& instruction, std::span<char> out) noexcept;
+
+/**
+ * @type class
+ * @brief Streams a disassembly listing into a buffered std::ostream
+ *
+ * Each line is "8000  BD 10 20  LDA $2010,X": address, instruction bytes and
+ * text. With a symbol table, operand addresses that a symbol covers are
+ * written as "name" or "name+offset" and a symbol starting at an instruction
+ * gets a "name:" line before it. Text is collected in a buffer allocated once
+ * by the constructor and written out when it fills, by flush() and by the
+ * destructor, so no line allocates.
+ */
+class DisassemblyWriter
+{
+ public:
+    static constexpr std::size_t BUFFER_SIZE = 64 * 1024;
+
+    explicit DisassemblyWriter(std::ostream& out, const SymbolTable* symbols = nullptr);
+    ~DisassemblyWriter();
+
+    DisassemblyWriter(const DisassemblyWriter&)            = delete;
+    DisassemblyWriter& operator=(const DisassemblyWriter&) = delete;
+
+    void write(const Instruction& instruction);
+
+    // Linear sweep over [address, address + size)
+    void write(const Memory& memory, u16 address, u32 size);
+
+    // One line per record, decoded from the record's opcode and memory's operands
+    void write(const Memory& memory, std::span<const TraceRecord> records);
+
+    // Appends raw text, such as a header or comment line
+    void put(std::string_view text);
+
+    void flush();
+
+ private:
+    std::ostream&           out_;
+    const SymbolTable*      symbols_;
+    std::unique_ptr<char[]> buffer_;
+    std::size_t             used_ = 0;
+};
+
+}  // namespace cpu6502
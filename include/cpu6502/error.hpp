@@ -11,7 +11,19 @@ enum class EmulatorError {
     StackOverflow,
     InvalidOpcode,
     StackUnderflow,
-    InsufficientCycles
+    InsufficientCycles,
+    GuardedPageAccess,
+    InvalidSaveState,
+    RewindOutOfRange,
+    ReplayDivergence,
+    MarkerNotReached,
+    ForkFailed,
+    InvalidImage,
+    BreakpointTrap,
+    InvalidExpression,
+    InterruptInsideInstruction,
+    NotBooted,
+    ForkBodyThrew
 };
 
 /**
@@ -29,6 +41,30 @@ constexpr const char* error_message(EmulatorError error) noexcept {
             return "Stack Underflow";
         case EmulatorError::InsufficientCycles:
             return "InSufficient Cycles used";
+        case EmulatorError::GuardedPageAccess:
+            return "Access to a guarded memory page";
+        case EmulatorError::InvalidSaveState:
+            return "Save state has the wrong size, magic or version";
+        case EmulatorError::RewindOutOfRange:
+            return "Requested point is older than the rewind buffer";
+        case EmulatorError::ReplayDivergence:
+            return "Replay diverged from the recorded input log";
+        case EmulatorError::MarkerNotReached:
+            return "Boot stopped before reaching the marker PC";
+        case EmulatorError::ForkFailed:
+            return "Could not fork a child process";
+        case EmulatorError::InvalidImage:
+            return "Image file is malformed or fails its checksum";
+        case EmulatorError::BreakpointTrap:
+            return "Stopped at a breakpoint trap";
+        case EmulatorError::InvalidExpression:
+            return "Expression is malformed or too deeply nested";
+        case EmulatorError::InterruptInsideInstruction:
+            return "Interrupt raised through the recorder from inside an instruction";
+        case EmulatorError::NotBooted:
+            return "Fork server used before boot() reached its marker";
+        case EmulatorError::ForkBodyThrew:
+            return "Forked test case exited with an exception";
         default:
             return "Unknown Error: Check source";
     }
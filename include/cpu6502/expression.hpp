@@ -0,0 +1,123 @@
+#pragma once
+
+#include <cstddef>
+#include <expected>
+#include <optional>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "error.hpp"
+#include "types.hpp"
+
+namespace cpu6502
+{
+
+class CPU;
+class Memory;
+class SymbolTable;
+
+/**
+ * @type class
+ * @brief Debugger expression, compiled once to stack bytecode
+ *
+ * For breakpoint conditions and watch expressions, e.g.
+ * "A == $42 && X > 3 && [$0200] != 0". Operands are numbers ($FF, 0xFF,
+ * %1010, 255), the registers A X Y SP PC P (in either case), symbols from
+ * the table passed to compile(), and [address] for the byte there. Binary
+ * operators, loosest first: ||, &&, == !=, < <= > >=, | ^, + -, &. Unlike C
+ * the bitwise operators bind tighter than comparisons, so "P & 1 == 0" is
+ * true with carry clear. Unary - ! ~ bind tightest. Arithmetic is on 32-bit
+ * values and wraps; comparisons and logic give 0 or 1.
+ *
+ * evaluate() runs the bytecode on a fixed-size stack, so it neither
+ * allocates nor touches I/O devices (memory is read with Memory::peek).
+ */
+class Expression
+{
+ public:
+    static constexpr std::size_t MAX_DEPTH = 16;  // Evaluation stack and nesting limit
+
+    // InvalidExpression if text does not parse or nests deeper than MAX_DEPTH
+    [[nodiscard]] static auto compile(std::string_view text, const SymbolTable* symbols = nullptr)
+        -> std::expected<Expression, EmulatorError>;
+
+    [[nodiscard]] i32 evaluate(const CPU& cpu, const Memory& memory) const noexcept;
+
+    [[nodiscard]] bool holds(const CPU& cpu, const Memory& memory) const noexcept
+    {
+        return evaluate(cpu, memory) != 0;
+    }
+
+ private:
+    enum class Op : u8
+    {
+        Push,  // operand
+        A,
+        X,
+        Y,
+        Sp,
+        Pc,
+        P,
+        Peek,  // [top]
+        Negate,
+        Not,
+        Complement,
+        Add,
+        Subtract,
+        BitAnd,
+        BitOr,
+        BitXor,
+        Equal,
+        NotEqual,
+        Less,
+        LessEqual,
+        Greater,
+        GreaterEqual,
+        LogicalAnd,
+        LogicalOr
+    };
+
+    struct Step
+    {
+        Op  op      = Op::Push;
+        i32 operand = 0;
+    };
+
+    std::vector<Step> code_;
+
+    friend class ExpressionParser;
+};
+
+/**
+ * @type class
+ * @brief Condition, ignore count and hit count of one breakpoint
+ *
+ * Call reached() each time the breakpoint's trap fires. A reach counts as
+ * a hit only when the condition holds (or there is none), and the first
+ * ignore_count hits do not stop the target, as with gdb's "ignore N".
+ * Nothing is allocated after construction.
+ */
+class BreakpointCondition
+{
+ public:
+    BreakpointCondition() = default;
+    explicit BreakpointCondition(std::optional<Expression> condition, u64 ignore_count = 0)
+        : condition_(std::move(condition)), ignore_count_(ignore_count)
+    {
+    }
+
+    // True if the target should stop here
+    [[nodiscard]] bool reached(const CPU& cpu, const Memory& memory) noexcept;
+
+    [[nodiscard]] u64 hit_count() const noexcept { return hit_count_; }
+    [[nodiscard]] u64 ignore_count() const noexcept { return ignore_count_; }
+
+    void reset_hits() noexcept { hit_count_ = 0; }
+
+ private:
+    std::optional<Expression> condition_;
+    u64                       ignore_count_ = 0;
+    u64                       hit_count_    = 0;
+};
+
+}  // namespace cpu6502
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <expected>
+#include <functional>
+#include <limits>
+#include <memory>
+#include "cpu.hpp"
+#include "error.hpp"
+#include "memory.hpp"
+#include "stop_condition.hpp"
+#include "types.hpp"
+
+namespace cpu6502
+{
+
+/**
+ * @type class
+ * @brief Boots a machine once and hands out copies of the warm state
+ *
+ * boot() runs a private copy of the machine up to a marker PC and freezes it
+ * there. Every test case then starts from that state instead of from reset:
+ * clone_into() copies it into a caller-owned CPU and Memory, fork_run() runs
+ * the case in a fork()ed child so the kernel shares the frozen pages copy on
+ * write and the parent state can never be disturbed. I/O mappings are copied
+ * along with the memory, the devices themselves are shared.
+ *
+ * fork() duplicates only the calling thread; call fork_run() while no other
+ * thread holds a lock the case needs.
+ */
+class ForkServer
+{
+ public:
+    using Body = std::function<int(CPU& cpu, Memory& memory)>;
+
+    // Copies the starting machine; the originals are not touched afterwards
+    ForkServer(const CPU& cpu, const Memory& memory);
+
+    // Runs the frozen machine until it is about to execute marker_pc
+    auto boot(u16 marker_pc, u64 max_cycles = std::numeric_limits<u64>::max())
+        -> std::expected<RunResult, EmulatorError>;
+
+    [[nodiscard]] bool ready() const noexcept { return ready_; }
+
+    // Overwrites cpu and memory with the frozen state; NotBooted before boot() succeeded
+    auto clone_into(CPU& cpu, Memory& memory) const -> std::expected<void, EmulatorError>;
+
+    // Runs body on a copy-on-write clone in a child process and returns its exit
+    // status, or 128 + signal number if the child was killed. NotBooted before
+    // boot() succeeded; ForkBodyThrew if an exception escaped body.
+    auto fork_run(const Body& body) const -> std::expected<int, EmulatorError>;
+
+    [[nodiscard]] const CPU&    cpu() const noexcept { return cpu_; }
+    [[nodiscard]] const Memory& memory() const noexcept { return *memory_; }
+
+ private:
+    CPU                     cpu_;
+    std::unique_ptr<Memory> memory_;
+    bool                    ready_ = false;
+};
+
+}  // namespace cpu6502
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <expected>
+#include <optional>
+#include <string>
+#include "cpu.hpp"
+#include "error.hpp"
+#include "memory.hpp"
+#include "stop_condition.hpp"
+#include "types.hpp"
+
+namespace cpu6502
+{
+
+/**
+ * @type enum class
+ * @brief Host CPU event counted by HostCounters
+ */
+enum class HostEvent : u8
+{
+    Cycles,
+    Instructions,
+    BranchMisses,
+    L1iMisses
+};
+
+inline constexpr std::size_t HOST_EVENT_COUNT = 4;
+
+using HostCounts = std::array<std::optional<u64>, HOST_EVENT_COUNT>;
+
+/**
+ * @type struct
+ * @brief Host counter deltas over one measured emulator call
+ */
+struct HostMeasurement
+{
+    HostCounts counts{};                 // nullopt for events the host could not count
+    u64        emulated_cycles       = 0;
+    u64        emulated_instructions = 0;  // 0 when the call does not report it
+
+    [[nodiscard]] std::optional<u64> count(HostEvent event) const noexcept
+    {
+        return counts[static_cast<std::size_t>(event)];
+    }
+
+    // e.g. host cycles per 6502 instruction
+    [[nodiscard]] std::optional<double> per_instruction(HostEvent event) const noexcept;
+    [[nodiscard]] std::optional<double> per_emulated_cycle(HostEvent event) const noexcept;
+};
+
+/**
+ * @type class
+ * @brief Reads host hardware counters around emulator calls (Linux perf events)
+ *
+ * Each event is opened on its own for the calling thread, user space only, so
+ * one event the PMU or kernel refuses does not take the others down. Where
+ * perf_event_open is missing, forbidden (perf_event_paranoid, seccomp in
+ * containers) or the OS is not Linux, the events are simply unavailable:
+ * measurements still run the emulator and report nullopt counts, and
+ * unavailable_reason() says why. Counts are scaled when the kernel had to
+ * multiplex the counters.
+ */
+class HostCounters
+{
+ public:
+    HostCounters();
+    ~HostCounters();
+
+    HostCounters(const HostCounters&)            = delete;
+    HostCounters& operator=(const HostCounters&) = delete;
+
+    [[nodiscard]] bool available(HostEvent event) const noexcept;
+    [[nodiscard]] bool any_available() const noexcept;
+
+    // Empty when every event opened
+    [[nodiscard]] const std::string& unavailable_reason() const noexcept { return reason_; }
+
+    // Raw interface: zero and enable the counters, then disable and read them
+    void                     start() noexcept;
+    [[nodiscard]] HostCounts stop() noexcept;
+
+    // Measures one CPU::execute call; instructions are not reported by execute
+    auto measure_execute(CPU& cpu, Memory& memory, i32 cycles)
+        -> std::expected<HostMeasurement, EmulatorError>;
+
+    // Measures one CPU::run call, with per-instruction figures
+    auto measure_run(CPU& cpu, Memory& memory, const StopCondition& stop)
+        -> std::expected<HostMeasurement, EmulatorError>;
+
+ private:
+    std::array<int, HOST_EVENT_COUNT> fds_;
+    std::string                       reason_;
+};
+
+}  // namespace cpu6502
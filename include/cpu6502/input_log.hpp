@@ -0,0 +1,180 @@
+#pragma once
+
+#include <cstddef>
+#include <expected>
+#include <memory>
+#include <span>
+#include <vector>
+#include "cpu.hpp"
+#include "error.hpp"
+#include "memory.hpp"
+#include "stop_condition.hpp"
+#include "types.hpp"
+
+namespace cpu6502
+{
+
+/**
+ * @type enum class
+ * @brief Kind of non-deterministic input captured in an InputLog
+ */
+enum class InputKind : u8
+{
+    IoRead,   // Value returned by a memory-mapped device
+    IrqLine,  // IRQ line changed level
+    Nmi       // NMI edge
+};
+
+/**
+ * @type struct
+ * @brief One decoded InputLog record
+ *
+ * cycles is CPU::get_cycles() when the input was observed: the start of the
+ * instruction for I/O reads, the instruction boundary for interrupt lines.
+ */
+struct InputEvent
+{
+    u64       cycles  = 0;
+    InputKind kind    = InputKind::IoRead;
+    u16       address = 0;  // IoRead only
+    u8        value   = 0;  // Read value, or IRQ level
+};
+
+/**
+ * @type class
+ * @brief Append-only binary log of everything a run did not compute itself
+ *
+ * Each record is a tag byte, the cycle delta to the previous record as an
+ * LEB128 varint and a kind-specific payload. The tag holds the kind, the IRQ
+ * level and a flag for "same address as the previous I/O read", so polling a
+ * status register costs three bytes per read.
+ */
+class InputLog
+{
+ public:
+    InputLog() = default;
+
+    // Adopts previously serialized bytes; decoding stops at the first malformed record
+    explicit InputLog(std::span<const u8> bytes);
+
+    void append(const InputEvent& event);
+    void clear() noexcept;
+
+    [[nodiscard]] std::span<const u8> bytes() const noexcept { return bytes_; }
+    [[nodiscard]] std::size_t         event_count() const noexcept { return events_; }
+
+    /**
+     * @type class
+     * @brief Forward cursor over the records of an InputLog
+     */
+    class Reader
+    {
+     public:
+        explicit Reader(const InputLog& log) noexcept : log_(&log) {}
+
+        // Decodes the next record; false at the end of the log
+        [[nodiscard]] bool next(InputEvent& event) noexcept;
+
+     private:
+        friend class InputLog;
+
+        const InputLog* log_;
+        std::size_t     position_     = 0;
+        u64             cycles_       = 0;
+        u16             last_address_ = 0;
+    };
+
+ private:
+    std::vector<u8> bytes_;
+    std::size_t     events_       = 0;
+    u64             last_cycles_  = 0;
+    u16             last_address_ = 0;
+};
+
+/**
+ * @type class
+ * @brief Captures device reads and interrupt lines of a live run into an InputLog
+ *
+ * attach() puts a tap in front of a device so every read through Memory is
+ * logged with the current cycle count. Interrupts must be raised through the
+ * recorder rather than on the CPU directly so they are logged too, and only
+ * between run() or step() calls: they are stamped with the current cycle and
+ * replayed before the instruction starting there. Inside an instruction that
+ * cycle is the one the instruction started on, so a device raising one from
+ * its read() or write() is refused with InterruptInsideInstruction; observer
+ * callbacks must not raise them either.
+ */
+class InputRecorder
+{
+ public:
+    InputRecorder(CPU& cpu, InputLog& log) noexcept;
+    ~InputRecorder();
+
+    InputRecorder(const InputRecorder&)            = delete;
+    InputRecorder& operator=(const InputRecorder&) = delete;
+
+    // Maps device on page through a recording tap; the recorder must outlive the mapping
+    void attach(Memory& memory, u8 page, IoDevice& device);
+
+    auto set_irq_line(bool asserted) -> std::expected<void, EmulatorError>;
+    auto trigger_nmi() -> std::expected<void, EmulatorError>;
+
+ private:
+    class Tap;
+
+    CPU&                              cpu_;
+    InputLog&                         log_;
+    std::vector<std::unique_ptr<Tap>> taps_;
+    bool                              in_device_ = false;  // Inside a tapped read or write
+};
+
+/**
+ * @type class
+ * @brief Re-runs a recorded session from an InputLog without the original devices
+ *
+ * Start from the state the recording started from. Attached pages answer reads
+ * from the log and drop writes; every other access is plain RAM and never
+ * looks at the log. run() executes at full speed up to the next recorded
+ * interrupt change, applies it and carries on. A read whose cycle or address
+ * does not match the log marks the replay as diverged and run() fails with
+ * ReplayDivergence at the end of the current stretch.
+ */
+class InputReplayer
+{
+ public:
+    InputReplayer(CPU& cpu, const InputLog& log);
+    ~InputReplayer();
+
+    InputReplayer(const InputReplayer&)            = delete;
+    InputReplayer& operator=(const InputReplayer&) = delete;
+
+    // Serves reads on page from the log; the replayer must outlive the mapping
+    void attach(Memory& memory, u8 page);
+
+    // Runs like CPU::run, injecting recorded interrupts on their cycle
+    auto run(const StopCondition& stop, Memory& memory) -> std::expected<RunResult, EmulatorError>;
+
+    [[nodiscard]] bool diverged() const noexcept { return diverged_; }
+
+    // True once every recorded input has been consumed
+    [[nodiscard]] bool finished() const noexcept;
+
+ private:
+    class Source;
+
+    CPU&                    cpu_;
+    InputLog::Reader        io_reader_;
+    InputLog::Reader        interrupt_reader_;
+    InputEvent              next_io_{};
+    InputEvent              next_interrupt_{};
+    bool                    has_io_        = false;
+    bool                    has_interrupt_ = false;
+    bool                    diverged_      = false;
+    std::unique_ptr<Source> source_;
+
+    void advance_io() noexcept;
+    void advance_interrupt() noexcept;
+    auto serve_read(u16 address) noexcept -> u8;
+};
+
+}  // namespace cpu6502
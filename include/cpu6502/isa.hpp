@@ -0,0 +1,286 @@
+#pragma once
+
+#include <array>
+#include <string_view>
+#include "types.hpp"
+
+namespace cpu6502
+{
+
+/**
+ * @type enum class
+ * @brief Operand addressing mode of an instruction
+ */
+enum class AddressingMode : u8
+{
+    Implied,
+    Accumulator,
+    Immediate,
+    ZeroPage,
+    ZeroPageX,
+    ZeroPageY,
+    Absolute,
+    AbsoluteX,
+    AbsoluteY,
+    Indirect,   // JMP ($nnnn)
+    IndirectX,  // ($nn,X)
+    IndirectY,  // ($nn),Y
+    Relative    // Conditional branches
+};
+
+// Status flag masks, in the bit layout of StatusFlags::to_byte()
+inline constexpr u8 FLAG_C   = 0x01;
+inline constexpr u8 FLAG_Z   = 0x02;
+inline constexpr u8 FLAG_I   = 0x04;
+inline constexpr u8 FLAG_D   = 0x08;
+inline constexpr u8 FLAG_V   = 0x40;
+inline constexpr u8 FLAG_N   = 0x80;
+inline constexpr u8 FLAG_ALL = FLAG_C | FLAG_Z | FLAG_I | FLAG_D | FLAG_V | FLAG_N;
+
+/**
+ * @type struct
+ * @brief Static description of one opcode byte
+ *
+ * flags_read and flags_written are FLAG_* masks of the architectural flags an
+ * instruction depends on and may change; B is not a flag, it only exists in
+ * the copy of P pushed by BRK and PHP. Undocumented opcodes keep the defaults:
+ * mnemonic "???", cycles 0.
+ */
+struct OpcodeInfo
+{
+    std::string_view mnemonic      = "???";      // e.g. "LDA"
+    std::string_view name          = "UNKNOWN";  // Opcode enumerator style, e.g. "LDA_ABSX"
+    AddressingMode   mode          = AddressingMode::Implied;
+    u8               length        = 1;  // Bytes including the opcode
+    u8               cycles        = 0;  // Base cycles charged by CPU, before penalties
+    u8               flags_read    = 0;
+    u8               flags_written = 0;
+    bool             page_penalty  = false;  // +1 cycle when the indexed read crosses a page
+    bool             implemented   = false;  // Dispatched by the CPU
+
+    [[nodiscard]] constexpr bool documented() const noexcept { return cycles != 0; }
+};
+
+// Bytes an instruction in mode occupies, opcode included
+[[nodiscard]] constexpr u8 instruction_length(AddressingMode mode) noexcept
+{
+    switch (mode)
+        {
+            case AddressingMode::Implied:
+            case AddressingMode::Accumulator:
+                return 1;
+            case AddressingMode::Absolute:
+            case AddressingMode::AbsoluteX:
+            case AddressingMode::AbsoluteY:
+            case AddressingMode::Indirect:
+                return 3;
+            default:
+                return 2;
+        }
+}
+
+namespace detail
+{
+
+inline constexpr u8 PAGE_PENALTY = 0x01;
+inline constexpr u8 IMPLEMENTED  = 0x02;
+
+[[nodiscard]] consteval std::array<OpcodeInfo, 256> make_opcode_table()
+{
+    using enum AddressingMode;
+
+    constexpr u8 C = FLAG_C, Z = FLAG_Z, I = FLAG_I, D = FLAG_D, V = FLAG_V, N = FLAG_N;
+    constexpr u8 ALL = FLAG_ALL;
+
+    std::array<OpcodeInfo, 256> table{};
+    const auto add = [&table](u8 opcode, std::string_view mnemonic, std::string_view name,
+                              AddressingMode mode, u8 cycles, u8 reads, u8 writes, u8 traits)
+    {
+        table[opcode] = {mnemonic,
+                         name,
+                         mode,
+                         instruction_length(mode),
+                         cycles,
+                         reads,
+                         writes,
+                         (traits & PAGE_PENALTY) != 0,
+                         (traits & IMPLEMENTED) != 0};
+    };
+
+    add(0x00, "BRK", "BRK", Implied, 7, ALL, I, IMPLEMENTED);
+    add(0x01, "ORA", "ORA_INDX", IndirectX, 6, 0, N | Z, 0);
+    add(0x05, "ORA", "ORA_ZP", ZeroPage, 3, 0, N | Z, 0);
+    add(0x06, "ASL", "ASL_ZP", ZeroPage, 5, 0, N | Z | C, IMPLEMENTED);
+    add(0x08, "PHP", "PHP", Implied, 3, ALL, 0, 0);
+    add(0x09, "ORA", "ORA_IM", Immediate, 2, 0, N | Z, 0);
+    add(0x0A, "ASL", "ASL_A", Accumulator, 2, 0, N | Z | C, IMPLEMENTED);
+    add(0x0D, "ORA", "ORA_ABS", Absolute, 4, 0, N | Z, 0);
+    add(0x0E, "ASL", "ASL_ABS", Absolute, 6, 0, N | Z | C, IMPLEMENTED);
+    add(0x10, "BPL", "BPL", Relative, 2, N, 0, IMPLEMENTED);
+    add(0x11, "ORA", "ORA_INDY", IndirectY, 5, 0, N | Z, PAGE_PENALTY);
+    add(0x15, "ORA", "ORA_ZPX", ZeroPageX, 4, 0, N | Z, 0);
+    add(0x16, "ASL", "ASL_ZPX", ZeroPageX, 6, 0, N | Z | C, IMPLEMENTED);
+    add(0x18, "CLC", "CLC", Implied, 2, 0, C, IMPLEMENTED);
+    add(0x19, "ORA", "ORA_ABSY", AbsoluteY, 4, 0, N | Z, PAGE_PENALTY);
+    add(0x1D, "ORA", "ORA_ABSX", AbsoluteX, 4, 0, N | Z, PAGE_PENALTY);
+    add(0x1E, "ASL", "ASL_ABSX", AbsoluteX, 7, 0, N | Z | C, IMPLEMENTED);
+    add(0x20, "JSR", "JSR", Absolute, 6, 0, 0, IMPLEMENTED);
+    add(0x21, "AND", "AND_INDX", IndirectX, 6, 0, N | Z, IMPLEMENTED);
+    add(0x24, "BIT", "BIT_ZP", ZeroPage, 3, 0, N | V | Z, IMPLEMENTED);
+    add(0x25, "AND", "AND_ZP", ZeroPage, 3, 0, N | Z, IMPLEMENTED);
+    add(0x26, "ROL", "ROL_ZP", ZeroPage, 5, C, N | Z | C, 0);
+    add(0x28, "PLP", "PLP", Implied, 4, 0, ALL, 0);
+    add(0x29, "AND", "AND_IM", Immediate, 2, 0, N | Z, IMPLEMENTED);
+    add(0x2A, "ROL", "ROL_A", Accumulator, 2, C, N | Z | C, 0);
+    add(0x2C, "BIT", "BIT_ABS", Absolute, 4, 0, N | V | Z, IMPLEMENTED);
+    add(0x2D, "AND", "AND_ABS", Absolute, 4, 0, N | Z, IMPLEMENTED);
+    add(0x2E, "ROL", "ROL_ABS", Absolute, 6, C, N | Z | C, 0);
+    add(0x30, "BMI", "BMI", Relative, 2, N, 0, IMPLEMENTED);
+    add(0x31, "AND", "AND_INDY", IndirectY, 5, 0, N | Z, PAGE_PENALTY | IMPLEMENTED);
+    add(0x35, "AND", "AND_ZPX", ZeroPageX, 4, 0, N | Z, IMPLEMENTED);
+    add(0x36, "ROL", "ROL_ZPX", ZeroPageX, 6, C, N | Z | C, 0);
+    add(0x38, "SEC", "SEC", Implied, 2, 0, C, 0);
+    add(0x39, "AND", "AND_ABSY", AbsoluteY, 4, 0, N | Z, PAGE_PENALTY | IMPLEMENTED);
+    add(0x3D, "AND", "AND_ABSX", AbsoluteX, 4, 0, N | Z, PAGE_PENALTY | IMPLEMENTED);
+    add(0x3E, "ROL", "ROL_ABSX", AbsoluteX, 7, C, N | Z | C, 0);
+    add(0x40, "RTI", "RTI", Implied, 6, 0, ALL, 0);
+    add(0x41, "EOR", "EOR_INDX", IndirectX, 6, 0, N | Z, IMPLEMENTED);
+    add(0x45, "EOR", "EOR_ZP", ZeroPage, 3, 0, N | Z, IMPLEMENTED);
+    add(0x46, "LSR", "LSR_ZP", ZeroPage, 5, 0, N | Z | C, 0);
+    add(0x48, "PHA", "PHA", Implied, 3, 0, 0, 0);
+    add(0x49, "EOR", "EOR_IM", Immediate, 2, 0, N | Z, IMPLEMENTED);
+    add(0x4A, "LSR", "LSR_A", Accumulator, 2, 0, N | Z | C, 0);
+    add(0x4C, "JMP", "JMP_ABS", Absolute, 3, 0, 0, 0);
+    add(0x4D, "EOR", "EOR_ABS", Absolute, 4, 0, N | Z, IMPLEMENTED);
+    add(0x4E, "LSR", "LSR_ABS", Absolute, 6, 0, N | Z | C, 0);
+    add(0x50, "BVC", "BVC", Relative, 2, V, 0, IMPLEMENTED);
+    add(0x51, "EOR", "EOR_INDY", IndirectY, 5, 0, N | Z, PAGE_PENALTY | IMPLEMENTED);
+    add(0x55, "EOR", "EOR_ZPX", ZeroPageX, 4, 0, N | Z, IMPLEMENTED);
+    add(0x56, "LSR", "LSR_ZPX", ZeroPageX, 6, 0, N | Z | C, 0);
+    add(0x58, "CLI", "CLI", Implied, 2, 0, I, IMPLEMENTED);
+    add(0x59, "EOR", "EOR_ABSY", AbsoluteY, 4, 0, N | Z, PAGE_PENALTY | IMPLEMENTED);
+    add(0x5D, "EOR", "EOR_ABSX", AbsoluteX, 4, 0, N | Z, PAGE_PENALTY | IMPLEMENTED);
+    add(0x5E, "LSR", "LSR_ABSX", AbsoluteX, 7, 0, N | Z | C, 0);
+    add(0x60, "RTS", "RTS", Implied, 6, 0, 0, IMPLEMENTED);
+    add(0x61, "ADC", "ADC_INDX", IndirectX, 6, C | D, N | V | Z | C, IMPLEMENTED);
+    add(0x65, "ADC", "ADC_ZP", ZeroPage, 3, C | D, N | V | Z | C, IMPLEMENTED);
+    add(0x66, "ROR", "ROR_ZP", ZeroPage, 5, C, N | Z | C, 0);
+    add(0x68, "PLA", "PLA", Implied, 4, 0, N | Z, 0);
+    add(0x69, "ADC", "ADC_IM", Immediate, 2, C | D, N | V | Z | C, IMPLEMENTED);
+    add(0x6A, "ROR", "ROR_A", Accumulator, 2, C, N | Z | C, 0);
+    add(0x6C, "JMP", "JMP_IND", Indirect, 5, 0, 0, 0);
+    add(0x6D, "ADC", "ADC_ABS", Absolute, 4, C | D, N | V | Z | C, IMPLEMENTED);
+    add(0x6E, "ROR", "ROR_ABS", Absolute, 6, C, N | Z | C, 0);
+    add(0x70, "BVS", "BVS", Relative, 2, V, 0, IMPLEMENTED);
+    add(0x71, "ADC", "ADC_INDY", IndirectY, 5, C | D, N | V | Z | C, PAGE_PENALTY | IMPLEMENTED);
+    add(0x75, "ADC", "ADC_ZPX", ZeroPageX, 4, C | D, N | V | Z | C, IMPLEMENTED);
+    add(0x76, "ROR", "ROR_ZPX", ZeroPageX, 6, C, N | Z | C, 0);
+    add(0x78, "SEI", "SEI", Implied, 2, 0, I, 0);
+    add(0x79, "ADC", "ADC_ABSY", AbsoluteY, 4, C | D, N | V | Z | C, PAGE_PENALTY | IMPLEMENTED);
+    add(0x7D, "ADC", "ADC_ABSX", AbsoluteX, 4, C | D, N | V | Z | C, PAGE_PENALTY | IMPLEMENTED);
+    add(0x7E, "ROR", "ROR_ABSX", AbsoluteX, 7, C, N | Z | C, 0);
+    add(0x81, "STA", "STA_INDX", IndirectX, 6, 0, 0, 0);
+    add(0x84, "STY", "STY_ZP", ZeroPage, 3, 0, 0, 0);
+    add(0x85, "STA", "STA_ZP", ZeroPage, 3, 0, 0, 0);
+    add(0x86, "STX", "STX_ZP", ZeroPage, 3, 0, 0, 0);
+    add(0x88, "DEY", "DEY", Implied, 2, 0, N | Z, IMPLEMENTED);
+    add(0x8A, "TXA", "TXA", Implied, 2, 0, N | Z, 0);
+    add(0x8C, "STY", "STY_ABS", Absolute, 4, 0, 0, 0);
+    add(0x8D, "STA", "STA_ABS", Absolute, 4, 0, 0, 0);
+    add(0x8E, "STX", "STX_ABS", Absolute, 4, 0, 0, 0);
+    add(0x90, "BCC", "BCC", Relative, 2, C, 0, IMPLEMENTED);
+    add(0x91, "STA", "STA_INDY", IndirectY, 6, 0, 0, 0);
+    add(0x94, "STY", "STY_ZPX", ZeroPageX, 4, 0, 0, 0);
+    add(0x95, "STA", "STA_ZPX", ZeroPageX, 4, 0, 0, 0);
+    add(0x96, "STX", "STX_ZPY", ZeroPageY, 4, 0, 0, 0);
+    add(0x98, "TYA", "TYA", Implied, 2, 0, N | Z, 0);
+    add(0x99, "STA", "STA_ABSY", AbsoluteY, 5, 0, 0, 0);
+    add(0x9A, "TXS", "TXS", Implied, 2, 0, 0, 0);
+    add(0x9D, "STA", "STA_ABSX", AbsoluteX, 5, 0, 0, 0);
+    add(0xA0, "LDY", "LDY_IM", Immediate, 2, 0, N | Z, IMPLEMENTED);
+    add(0xA1, "LDA", "LDA_INDX", IndirectX, 6, 0, N | Z, 0);
+    add(0xA2, "LDX", "LDX_IM", Immediate, 2, 0, N | Z, IMPLEMENTED);
+    add(0xA4, "LDY", "LDY_ZP", ZeroPage, 3, 0, N | Z, IMPLEMENTED);
+    add(0xA5, "LDA", "LDA_ZP", ZeroPage, 3, 0, N | Z, IMPLEMENTED);
+    add(0xA6, "LDX", "LDX_ZP", ZeroPage, 3, 0, N | Z, IMPLEMENTED);
+    add(0xA8, "TAY", "TAY", Implied, 2, 0, N | Z, 0);
+    add(0xA9, "LDA", "LDA_IM", Immediate, 2, 0, N | Z, IMPLEMENTED);
+    add(0xAA, "TAX", "TAX", Implied, 2, 0, N | Z, 0);
+    add(0xAC, "LDY", "LDY_ABS", Absolute, 4, 0, N | Z, IMPLEMENTED);
+    add(0xAD, "LDA", "LDA_ABS", Absolute, 4, 0, N | Z, IMPLEMENTED);
+    add(0xAE, "LDX", "LDX_ABS", Absolute, 4, 0, N | Z, IMPLEMENTED);
+    add(0xB0, "BCS", "BCS", Relative, 2, C, 0, IMPLEMENTED);
+    add(0xB1, "LDA", "LDA_INDY", IndirectY, 5, 0, N | Z, PAGE_PENALTY);
+    add(0xB4, "LDY", "LDY_ZPX", ZeroPageX, 4, 0, N | Z, IMPLEMENTED);
+    add(0xB5, "LDA", "LDA_ZPX", ZeroPageX, 4, 0, N | Z, IMPLEMENTED);
+    add(0xB6, "LDX", "LDX_ZPY", ZeroPageY, 4, 0, N | Z, IMPLEMENTED);
+    add(0xB8, "CLV", "CLV", Implied, 2, 0, V, IMPLEMENTED);
+    add(0xB9, "LDA", "LDA_ABSY", AbsoluteY, 4, 0, N | Z, PAGE_PENALTY | IMPLEMENTED);
+    add(0xBA, "TSX", "TSX", Implied, 2, 0, N | Z, 0);
+    add(0xBC, "LDY", "LDY_ABSX", AbsoluteX, 4, 0, N | Z, PAGE_PENALTY | IMPLEMENTED);
+    add(0xBD, "LDA", "LDA_ABSX", AbsoluteX, 4, 0, N | Z, PAGE_PENALTY | IMPLEMENTED);
+    add(0xBE, "LDX", "LDX_ABSY", AbsoluteY, 4, 0, N | Z, PAGE_PENALTY | IMPLEMENTED);
+    add(0xC0, "CPY", "CPY_IM", Immediate, 2, 0, N | Z | C, IMPLEMENTED);
+    add(0xC1, "CMP", "CMP_INDX", IndirectX, 6, 0, N | Z | C, IMPLEMENTED);
+    add(0xC4, "CPY", "CPY_ZP", ZeroPage, 3, 0, N | Z | C, IMPLEMENTED);
+    add(0xC5, "CMP", "CMP_ZP", ZeroPage, 3, 0, N | Z | C, IMPLEMENTED);
+    add(0xC6, "DEC", "DEC_ZP", ZeroPage, 5, 0, N | Z, IMPLEMENTED);
+    add(0xC8, "INY", "INY", Implied, 2, 0, N | Z, IMPLEMENTED);
+    add(0xC9, "CMP", "CMP_IM", Immediate, 2, 0, N | Z | C, IMPLEMENTED);
+    add(0xCA, "DEX", "DEX", Implied, 2, 0, N | Z, IMPLEMENTED);
+    add(0xCC, "CPY", "CPY_ABS", Absolute, 4, 0, N | Z | C, IMPLEMENTED);
+    add(0xCD, "CMP", "CMP_ABS", Absolute, 4, 0, N | Z | C, IMPLEMENTED);
+    add(0xCE, "DEC", "DEC_ABS", Absolute, 6, 0, N | Z, IMPLEMENTED);
+    add(0xD0, "BNE", "BNE", Relative, 2, Z, 0, IMPLEMENTED);
+    add(0xD1, "CMP", "CMP_INDY", IndirectY, 5, 0, N | Z | C, PAGE_PENALTY | IMPLEMENTED);
+    add(0xD5, "CMP", "CMP_ZPX", ZeroPageX, 4, 0, N | Z | C, IMPLEMENTED);
+    add(0xD6, "DEC", "DEC_ZPX", ZeroPageX, 6, 0, N | Z, IMPLEMENTED);
+    add(0xD8, "CLD", "CLD", Implied, 2, 0, D, IMPLEMENTED);
+    add(0xD9, "CMP", "CMP_ABSY", AbsoluteY, 4, 0, N | Z | C, PAGE_PENALTY | IMPLEMENTED);
+    add(0xDD, "CMP", "CMP_ABSX", AbsoluteX, 4, 0, N | Z | C, PAGE_PENALTY | IMPLEMENTED);
+    add(0xDE, "DEC", "DEC_ABSX", AbsoluteX, 7, 0, N | Z, IMPLEMENTED);
+    add(0xE0, "CPX", "CPX_IM", Immediate, 2, 0, N | Z | C, IMPLEMENTED);
+    add(0xE1, "SBC", "SBC_INDX", IndirectX, 6, C | D, N | V | Z | C, 0);
+    add(0xE4, "CPX", "CPX_ZP", ZeroPage, 3, 0, N | Z | C, IMPLEMENTED);
+    add(0xE5, "SBC", "SBC_ZP", ZeroPage, 3, C | D, N | V | Z | C, 0);
+    add(0xE6, "INC", "INC_ZP", ZeroPage, 5, 0, N | Z, IMPLEMENTED);
+    add(0xE8, "INX", "INX", Implied, 2, 0, N | Z, IMPLEMENTED);
+    add(0xE9, "SBC", "SBC_IM", Immediate, 2, C | D, N | V | Z | C, 0);
+    add(0xEA, "NOP", "NOP", Implied, 2, 0, 0, 0);
+    add(0xEC, "CPX", "CPX_ABS", Absolute, 4, 0, N | Z | C, IMPLEMENTED);
+    add(0xED, "SBC", "SBC_ABS", Absolute, 4, C | D, N | V | Z | C, 0);
+    add(0xEE, "INC", "INC_ABS", Absolute, 6, 0, N | Z, IMPLEMENTED);
+    add(0xF0, "BEQ", "BEQ", Relative, 2, Z, 0, IMPLEMENTED);
+    add(0xF1, "SBC", "SBC_INDY", IndirectY, 5, C | D, N | V | Z | C, PAGE_PENALTY);
+    add(0xF5, "SBC", "SBC_ZPX", ZeroPageX, 4, C | D, N | V | Z | C, 0);
+    add(0xF6, "INC", "INC_ZPX", ZeroPageX, 6, 0, N | Z, IMPLEMENTED);
+    add(0xF8, "SED", "SED", Implied, 2, 0, D, 0);
+    add(0xF9, "SBC", "SBC_ABSY", AbsoluteY, 4, C | D, N | V | Z | C, PAGE_PENALTY);
+    add(0xFD, "SBC", "SBC_ABSX", AbsoluteX, 4, C | D, N | V | Z | C, PAGE_PENALTY);
+    add(0xFE, "INC", "INC_ABSX", AbsoluteX, 7, 0, N | Z, IMPLEMENTED);
+
+    table[0x00].length = 2;  // BRK skips a padding byte
+    return table;
+}
+
+}  // namespace detail
+
+/**
+ * @brief Descriptor of every opcode byte, indexed by the opcode
+ *
+ * The one place opcode knowledge lives: names, operand layout, base cycles and
+ * flag usage. tests/test_isa.cpp checks it against what the CPU actually does.
+ */
+inline constexpr std::array<OpcodeInfo, 256> OPCODE_TABLE = detail::make_opcode_table();
+
+[[nodiscard]] constexpr const OpcodeInfo& opcode_info(u8 opcode) noexcept
+{
+    return OPCODE_TABLE[opcode];
+}
+
+[[nodiscard]] constexpr bool is_branch(u8 opcode) noexcept
+{
+    return OPCODE_TABLE[opcode].mode == AddressingMode::Relative;
+}
+
+}  // namespace cpu6502
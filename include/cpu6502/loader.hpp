@@ -0,0 +1,92 @@
+#pragma once
+
+#include <algorithm>
+#include <expected>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+#include "error.hpp"
+#include "memory.hpp"
+#include "types.hpp"
+
+namespace cpu6502
+{
+
+/**
+ * @type enum class
+ * @brief Program image file formats understood by load_image()
+ */
+enum class ImageFormat : u8
+{
+    Raw,       // Bytes as is, at LoadOptions::raw_address
+    IntelHex,  // Intel HEX records, types 00-05
+    SRecord,   // Motorola S-records, S0-S9
+    Prg,       // Commodore .prg: little-endian load address, then the bytes
+    O65        // André Fachat's o65 relocatable format, loaded at its own bases
+};
+
+/**
+ * @type struct
+ * @brief Options for load_image()
+ */
+struct LoadOptions
+{
+    u16  raw_address      = 0x0000;  // Where ImageFormat::Raw bytes go
+    bool set_reset_vector = true;    // Write a start address the image gives to $FFFC
+};
+
+/**
+ * @type struct
+ * @brief Contiguous range of memory written by a load
+ */
+struct ImageSegment
+{
+    u16 address = 0;
+    u32 size    = 0;  // Up to 64 KiB
+};
+
+/**
+ * @type struct
+ * @brief What load_image() wrote
+ *
+ * Records that continue where the previous one ended are merged, so a typical
+ * HEX or S-record file reports one segment per contiguous block.
+ */
+struct LoadedImage
+{
+    std::vector<ImageSegment> segments;
+    std::optional<u16>        start;  // Entry address, if the format carries one
+
+    // True if some segment wrote address
+    [[nodiscard]] bool covers(u16 address) const noexcept
+    {
+        return std::ranges::any_of(segments, [address](const ImageSegment& segment)
+                                   {
+                                       return address >= segment.address &&
+                                              u32{address} - segment.address < segment.size;
+                                   });
+    }
+};
+
+/**
+ * @brief Parses bytes as format and writes the contents straight into memory
+ *
+ * Single pass with no intermediate buffer: binary formats are copied into
+ * memory, text formats are decoded into it as they are read. Addresses above
+ * $FFFF, or records running past it, fail with InvalidAddress; malformed
+ * input, bad checksums and o65 files that still need linking fail with
+ * InvalidImage. Memory may be partly written when an error is returned.
+ */
+[[nodiscard]] auto load_image(std::span<const u8> bytes, ImageFormat format, Memory& memory,
+                              const LoadOptions& options = {})
+    -> std::expected<LoadedImage, EmulatorError>;
+
+// Guesses the format from the file contents, then from the extension of path
+[[nodiscard]] ImageFormat detect_image_format(std::string_view path,
+                                              std::span<const u8> bytes) noexcept;
+
+// "raw", "ihex", "srec", "prg" or "o65"
+[[nodiscard]] std::optional<ImageFormat> parse_image_format(std::string_view name) noexcept;
+
+}  // namespace cpu6502
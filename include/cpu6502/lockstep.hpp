@@ -0,0 +1,193 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <expected>
+#include <memory>
+#include <span>
+#include "error.hpp"
+#include "memory.hpp"
+#include "registers.hpp"
+#include "stop_condition.hpp"
+#include "types.hpp"
+
+namespace cpu6502
+{
+
+/**
+ * @type struct
+ * @brief Per-instance input of a lockstep sweep
+ *
+ * Every instance starts from the shared image; zero_page (up to 256 bytes) is
+ * copied over $0000.. of this instance only.
+ */
+struct LockstepJob
+{
+    Registers           registers{};
+    std::span<const u8> zero_page{};
+};
+
+/**
+ * @type struct
+ * @brief Per-instance outcome of a lockstep sweep
+ */
+struct LockstepResult
+{
+    std::expected<RunResult, EmulatorError> outcome{};
+    Registers                               registers{};
+    std::array<u8, 256>                     zero_page{};
+    bool                                    scalar_fallback = false;  // Finished on CPU
+};
+
+/**
+ * @type struct
+ * @brief Counters describing how well a sweep stayed in lockstep
+ */
+struct LockstepStats
+{
+    u64 steps             = 0;  // Instructions issued to a group of lanes
+    u64 lane_instructions = 0;  // Instructions retired across all lanes in lockstep
+    u64 scalar_fallbacks  = 0;  // Lanes handed over to the scalar CPU
+};
+
+/**
+ * @type class
+ * @brief Runs one program for many machine states at once, one lane per state
+ *
+ * Registers, the zero page and the stack page live in structure-of-arrays form
+ * so each instruction is applied to all lanes with straight-line loops the
+ * compiler turns into SIMD. The rest of the address space is the shared,
+ * read-only image. Lanes whose PC differs from the group being issued are
+ * masked off; the group with the lowest PC is issued first so branches
+ * reconverge. A lane falls back to the scalar CPU when it would write outside
+ * its private pages, hit an instruction the engine does not vectorise, or stay
+ * fully divergent for DIVERGENCE_LIMIT steps. Cycle counts match CPU::run.
+ */
+template <std::size_t Lanes>
+class LockstepEngine
+{
+    static_assert(Lanes == 8 || Lanes == 16 || Lanes == 32, "Lanes must be 8, 16 or 32");
+
+ public:
+    static constexpr std::size_t LANES            = Lanes;
+    static constexpr u32         DIVERGENCE_LIMIT = 64;
+
+    explicit LockstepEngine(const Memory& image);
+
+    // Runs up to Lanes jobs; results[i] receives the outcome of jobs[i]
+    void run(std::span<const LockstepJob> jobs, const StopCondition& stop,
+             std::span<LockstepResult> results);
+
+    [[nodiscard]] const LockstepStats& stats() const noexcept { return stats_; }
+
+ private:
+    using Lane8  = std::array<u8, Lanes>;
+    using Lane16 = std::array<u16, Lanes>;
+    using Lane64 = std::array<u64, Lanes>;
+
+    enum class Mode : u8
+    {
+        Immediate,
+        ZeroPage,
+        ZeroPageX,
+        ZeroPageY,
+        Absolute,
+        AbsoluteX,
+        AbsoluteY,
+        IndirectX,
+        IndirectY
+    };
+
+    enum class ReadOp : u8
+    {
+        Lda,
+        Ldx,
+        Ldy,
+        Adc,
+        And,
+        Eor,
+        Cmp,
+        Cpx,
+        Cpy,
+        Bit
+    };
+
+    enum class ModifyOp : u8
+    {
+        Asl,
+        Inc,
+        Dec
+    };
+
+    const Memory&           image_;
+    std::unique_ptr<Memory> scratch_;  // Address space of a lane handed to the scalar CPU
+
+    const StopCondition*      stop_ = nullptr;
+    std::span<LockstepResult> results_;
+
+    alignas(64) Lane16 pc_{};
+    alignas(64) Lane8 sp_{};
+    alignas(64) Lane8 a_{};
+    alignas(64) Lane8 x_{};
+    alignas(64) Lane8 y_{};
+    alignas(64) Lane8 carry_{};
+    alignas(64) Lane8 zero_{};
+    alignas(64) Lane8 interrupt_{};
+    alignas(64) Lane8 decimal_{};
+    alignas(64) Lane8 brk_{};
+    alignas(64) Lane8 overflow_{};
+    alignas(64) Lane8 negative_{};
+    alignas(64) Lane8 active_{};  // 0xFF while the lane runs in lockstep
+    alignas(64) Lane64 cycles_{};
+    alignas(64) Lane64 instructions_{};
+    alignas(64) std::array<Lane8, 256> zero_page_{};
+    alignas(64) std::array<Lane8, 256> stack_page_{};
+
+    u32           solo_steps_ = 0;
+    LockstepStats stats_{};
+
+    [[nodiscard]] u8        read(std::size_t lane, u16 address) const noexcept;
+    void                    write(std::size_t lane, u16 address, u8 value) noexcept;
+    [[nodiscard]] Registers lane_registers(std::size_t lane) const noexcept;
+
+    void finish(std::size_t lane, StopReason reason);
+    void fall_back(std::size_t lane);
+    void fall_back(const Lane8& mask);
+    void fall_back_divergent();
+
+    [[nodiscard]] bool issue(u16 pc, Lane8& mask);
+
+    void resolve(Mode mode, u8 operand, u16 word, Lane16& address, Lane8& penalty) const noexcept;
+    void execute_read(ReadOp op, Mode mode, u8 operand, u16 word, const Lane8& mask);
+    void execute_modify(ModifyOp op, Mode mode, u8 operand, u16 word, Lane8& mask);
+    void execute_branch(const Lane8& flag, u8 taken_when, i8 offset, const Lane8& mask);
+    void execute_jsr(u16 target, Lane8& mask);
+    void execute_rts(Lane8& mask);
+    void retire(const Lane8& mask, u16 length, u64 cycles) noexcept;
+};
+
+extern template class LockstepEngine<8>;
+extern template class LockstepEngine<16>;
+extern template class LockstepEngine<32>;
+
+/**
+ * @brief Runs any number of jobs through one engine, Lanes at a time
+ */
+template <std::size_t Lanes>
+auto run_lockstep(const Memory& image, std::span<const LockstepJob> jobs,
+                  const StopCondition& stop, std::span<LockstepResult> results) -> LockstepStats
+{
+    auto engine = std::make_unique<LockstepEngine<Lanes>>(image);
+
+    const std::size_t count = std::min(jobs.size(), results.size());
+    for (std::size_t first = 0; first < count; first += Lanes)
+        {
+            const std::size_t group = std::min(Lanes, count - first);
+            engine->run(jobs.subspan(first, group), stop, results.subspan(first, group));
+        }
+
+    return engine->stats();
+}
+
+}  // namespace cpu6502
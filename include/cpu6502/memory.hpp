@@ -1,12 +1,28 @@
 #pragma once
 
+#include <algorithm>
 #include <array>
+#include <cstddef>
 #include <expected>
+#include <span>
+#include <utility>
 #include "error.hpp"
 #include "types.hpp"
 
 namespace cpu6502 {
 
+/**
+ * @type IoDevice class
+ * @brief Peripheral answering reads and writes on memory-mapped pages
+ */
+class IoDevice {
+ public:
+    virtual ~IoDevice() = default;
+
+    virtual u8   read(u16 address)            = 0;
+    virtual void write(u16 address, u8 value) = 0;
+};
+
 /**
  * @type Memory class
  * @brief Memory class that will define our memory subsystem
@@ -20,6 +36,10 @@ class Memory {
     // Read operations
     [[nodiscard]] constexpr auto read_byte(u16 address) const -> std::expected<u8, EmulatorError>;
 
+    // Opcode fetch: read_byte, except that a trap reads as TRAP_OPCODE
+    [[nodiscard]] constexpr auto read_opcode(u16 address) const
+        -> std::expected<u8, EmulatorError>;
+
     [[nodiscard]] constexpr auto read_word(u16 address) const -> std::expected<u16, EmulatorError>;
 
     // Write operations
@@ -27,15 +47,84 @@ class Memory {
 
     constexpr auto write_word(u16 address, u16 value) -> std::expected<void, EmulatorError>;
 
+    // Bulk copy of an image into memory starting at address
+    constexpr auto load(u16 address, std::span<const u8> bytes)
+        -> std::expected<void, EmulatorError>;
+
     // Utility
     constexpr void clear() noexcept;
 
+    // Page guards: read_*/write_* on a guarded page fail with GuardedPageAccess.
+    // Direct access through operator[] is never guarded.
+    constexpr void guard_page(u8 page, bool guarded = true) noexcept;
+    constexpr void clear_guards() noexcept;
+
+    [[nodiscard]] constexpr bool is_guarded(u16 address) const noexcept;
+
+    // Memory-mapped I/O: read_*/write_* on a mapped page go to the device
+    // instead of RAM. Pass nullptr to unmap. The device is not owned.
+    constexpr void map_io(u8 page, IoDevice* device) noexcept;
+
+    [[nodiscard]] constexpr IoDevice* io_device(u16 address) const noexcept;
+
+    // Breakpoint traps: the byte at a trap address is replaced by TRAP_OPCODE,
+    // which the CPU stops on, and the original goes into a shadow table.
+    // read_*/write_* and load() see and update the original; operator[] and
+    // data() see TRAP_OPCODE. Traps on I/O pages are never hit.
+    static constexpr u8          TRAP_OPCODE = 0x02;  // JAM on the NMOS 6502, never valid code
+    static constexpr std::size_t MAX_TRAPS   = 256;
+
+    // False if the shadow table is full. Setting a trap twice is harmless.
+    constexpr bool set_trap(u16 address) noexcept;
+    constexpr void clear_trap(u16 address) noexcept;
+    constexpr void clear_traps() noexcept;
+
+    [[nodiscard]] constexpr bool        is_trap(u16 address) const noexcept;
+    [[nodiscard]] constexpr std::size_t trap_count() const noexcept { return trap_count_; }
+
+    // What the program would read at address, without I/O side effects:
+    // the original byte under a trap, RAM otherwise
+    [[nodiscard]] constexpr u8 peek(u16 address) const noexcept;
+
+    // After writing size bytes at address through data() or operator[], takes
+    // them as the originals under any traps there and puts TRAP_OPCODE back
+    constexpr void rearm_traps(u16 address, std::size_t size) noexcept;
+
+    // data() with the original byte under every trap, as the program sees it
+    constexpr void copy_without_traps(std::span<u8, MAX_MEM> out) const noexcept;
+
     // Direct access for setup (use carefully)
     constexpr u8&       operator[](u16 address) noexcept;
     constexpr const u8& operator[](u16 address) const noexcept;
 
+    // Whole address space, for bulk copies such as save states
+    [[nodiscard]] constexpr std::span<u8, MAX_MEM>       data() noexcept { return data_; }
+    [[nodiscard]] constexpr std::span<const u8, MAX_MEM> data() const noexcept { return data_; }
+
  private:
-    std::array<u8, MAX_MEM> data_;
+    static constexpr u8 PAGE_GUARDED = 0x01;
+    static constexpr u8 PAGE_IO      = 0x02;
+    static constexpr u8 PAGE_TRAP    = 0x04;
+
+    struct Trap {
+        u16 address  = 0;
+        u8  original = 0;
+    };
+
+    std::array<u8, MAX_MEM>     data_;
+    std::array<u8, 256>         page_flags_{};  // Plain RAM pages are 0
+    std::array<IoDevice*, 256>  io_{};
+    std::array<Trap, MAX_TRAPS> traps_{};  // Shadow table, sorted by address
+    std::size_t                 trap_count_ = 0;
+
+    // Shadow table entry for address; nullptr if it is not a trap
+    [[nodiscard]] constexpr const Trap* find_trap(u16 address) const noexcept;
+    [[nodiscard]] constexpr Trap*       find_trap(u16 address) noexcept;
+
+    // Slow path for pages with any flag set
+    [[nodiscard]] constexpr auto read_flagged(u16 address) const
+        -> std::expected<u8, EmulatorError>;
+    constexpr auto write_flagged(u16 address, u8 value) -> std::expected<void, EmulatorError>;
 };
 
 // Inline implementations
@@ -45,6 +134,20 @@ inline constexpr auto Memory::read_byte(u16 address) const -> std::expected<u8,
     if (address >= MAX_MEM) {
         return std::unexpected(EmulatorError::InvalidAddress);
     }
+    if (page_flags_[address >> 8] != 0) {
+        return read_flagged(address);
+    }
+    return data_[address];
+}
+
+inline constexpr auto Memory::read_opcode(u16 address) const
+    -> std::expected<u8, EmulatorError> {
+    if (address >= MAX_MEM) {
+        return std::unexpected(EmulatorError::InvalidAddress);
+    }
+    if ((page_flags_[address >> 8] & static_cast<u8>(~PAGE_TRAP)) != 0) {
+        return read_flagged(address);
+    }
     return data_[address];
 }
 
@@ -52,6 +155,18 @@ inline constexpr auto Memory::read_word(u16 address) const -> std::expected<u16,
     if (static_cast<u32>(address) + 1u >= MAX_MEM) {
         return std::unexpected(EmulatorError::InvalidAddress);
     }
+    const auto next = static_cast<u16>(address + 1);
+    if ((page_flags_[address >> 8] | page_flags_[next >> 8]) != 0) {
+        auto low = read_flagged(address);
+        if (!low) {
+            return std::unexpected(low.error());
+        }
+        auto high = read_flagged(next);
+        if (!high) {
+            return std::unexpected(high.error());
+        }
+        return static_cast<u16>(*low | (*high << 8));
+    }
     u16 low  = data_[address];
     u16 high = data_[address + 1];
     return low | (high << 8);
@@ -62,6 +177,9 @@ inline constexpr auto Memory::write_byte(u16 address, u8 value)
     if (address >= MAX_MEM) {
         return std::unexpected(EmulatorError::InvalidAddress);
     }
+    if (page_flags_[address >> 8] != 0) {
+        return write_flagged(address, value);
+    }
     data_[address] = value;
     return {};
 }
@@ -71,13 +189,192 @@ inline constexpr auto Memory::write_word(u16 address, u16 value)
     if (static_cast<u32>(address) + 1u >= MAX_MEM) {
         return std::unexpected(EmulatorError::InvalidAddress);
     }
+    const auto next = static_cast<u16>(address + 1);
+    if ((page_flags_[address >> 8] | page_flags_[next >> 8]) != 0) {
+        auto low = write_flagged(address, static_cast<u8>(value & 0xFF));
+        if (!low) {
+            return low;
+        }
+        return write_flagged(next, static_cast<u8>(value >> 8));
+    }
     data_[address]     = static_cast<u8>(value & 0xFF);
     data_[address + 1] = static_cast<u8>(value >> 8);
     return {};
 }
 
+inline constexpr auto Memory::load(u16 address, std::span<const u8> bytes)
+    -> std::expected<void, EmulatorError> {
+    if (static_cast<u32>(address) + bytes.size() > MAX_MEM) {
+        return std::unexpected(EmulatorError::InvalidAddress);
+    }
+    std::ranges::copy(bytes, data_.begin() + address);
+    rearm_traps(address, bytes.size());
+    return {};
+}
+
 inline constexpr void Memory::clear() noexcept {
     data_.fill(0);
+    for (auto& flags : page_flags_) {
+        flags &= static_cast<u8>(~PAGE_TRAP);
+    }
+    trap_count_ = 0;
+}
+
+inline constexpr void Memory::guard_page(u8 page, bool guarded) noexcept {
+    if (guarded) {
+        page_flags_[page] |= PAGE_GUARDED;
+    } else {
+        page_flags_[page] &= static_cast<u8>(~PAGE_GUARDED);
+    }
+}
+
+inline constexpr void Memory::clear_guards() noexcept {
+    for (auto& flags : page_flags_) {
+        flags &= static_cast<u8>(~PAGE_GUARDED);
+    }
+}
+
+inline constexpr bool Memory::is_guarded(u16 address) const noexcept {
+    return (page_flags_[address >> 8] & PAGE_GUARDED) != 0;
+}
+
+inline constexpr void Memory::map_io(u8 page, IoDevice* device) noexcept {
+    io_[page] = device;
+    if (device != nullptr) {
+        page_flags_[page] |= PAGE_IO;
+    } else {
+        page_flags_[page] &= static_cast<u8>(~PAGE_IO);
+    }
+}
+
+inline constexpr IoDevice* Memory::io_device(u16 address) const noexcept {
+    return io_[address >> 8];
+}
+
+inline constexpr bool Memory::set_trap(u16 address) noexcept {
+    if (is_trap(address)) {
+        return true;
+    }
+    if (trap_count_ == MAX_TRAPS) {
+        return false;
+    }
+
+    Trap* const end = traps_.data() + trap_count_;
+    Trap* const at  = std::ranges::lower_bound(traps_.data(), end, address, {}, &Trap::address);
+    std::move_backward(at, end, end + 1);
+    *at = Trap{address, data_[address]};
+    trap_count_++;
+
+    data_[address] = TRAP_OPCODE;
+    page_flags_[address >> 8] |= PAGE_TRAP;
+    return true;
+}
+
+inline constexpr void Memory::clear_trap(u16 address) noexcept {
+    Trap* trap = find_trap(address);
+    if (trap == nullptr) {
+        return;
+    }
+
+    // Leave bytes written through operator[] since the trap was set
+    if (data_[address] == TRAP_OPCODE) {
+        data_[address] = trap->original;
+    }
+    std::move(trap + 1, traps_.data() + trap_count_, trap);
+    trap_count_--;
+
+    const u8   page      = static_cast<u8>(address >> 8);
+    const auto remaining = std::span(traps_.data(), trap_count_);
+    if (std::ranges::none_of(remaining, [page](const Trap& other) {
+            return other.address >> 8 == page;
+        })) {
+        page_flags_[page] &= static_cast<u8>(~PAGE_TRAP);
+    }
+}
+
+inline constexpr void Memory::clear_traps() noexcept {
+    for (const Trap& trap : std::span(traps_.data(), trap_count_)) {
+        if (data_[trap.address] == TRAP_OPCODE) {
+            data_[trap.address] = trap.original;
+        }
+    }
+    for (auto& flags : page_flags_) {
+        flags &= static_cast<u8>(~PAGE_TRAP);
+    }
+    trap_count_ = 0;
+}
+
+inline constexpr bool Memory::is_trap(u16 address) const noexcept {
+    return (page_flags_[address >> 8] & PAGE_TRAP) != 0 && find_trap(address) != nullptr;
+}
+
+inline constexpr u8 Memory::peek(u16 address) const noexcept {
+    if ((page_flags_[address >> 8] & PAGE_TRAP) != 0) {
+        if (const Trap* trap = find_trap(address); trap != nullptr) {
+            return trap->original;
+        }
+    }
+    return data_[address];
+}
+
+inline constexpr void Memory::rearm_traps(u16 address, std::size_t size) noexcept {
+    const u32   last = std::min<u32>(u32{address} + static_cast<u32>(size), MAX_MEM);
+    Trap* const end  = traps_.data() + trap_count_;
+    for (Trap* trap = std::ranges::lower_bound(traps_.data(), end, address, {}, &Trap::address);
+         trap != end && trap->address < last; ++trap) {
+        trap->original       = data_[trap->address];
+        data_[trap->address] = TRAP_OPCODE;
+    }
+}
+
+inline constexpr void Memory::copy_without_traps(std::span<u8, MAX_MEM> out) const noexcept {
+    std::ranges::copy(data_, out.begin());
+    for (const Trap& trap : std::span(traps_.data(), trap_count_)) {
+        out[trap.address] = trap.original;
+    }
+}
+
+inline constexpr auto Memory::find_trap(u16 address) const noexcept -> const Trap* {
+    const Trap* const end = traps_.data() + trap_count_;
+    const Trap* const it =
+        std::ranges::lower_bound(traps_.data(), end, address, {}, &Trap::address);
+    return it != end && it->address == address ? it : nullptr;
+}
+
+inline constexpr auto Memory::find_trap(u16 address) noexcept -> Trap* {
+    return const_cast<Trap*>(std::as_const(*this).find_trap(address));
+}
+
+inline constexpr auto Memory::read_flagged(u16 address) const -> std::expected<u8, EmulatorError> {
+    const u8 flags = page_flags_[address >> 8];
+    if ((flags & PAGE_GUARDED) != 0) {
+        return std::unexpected(EmulatorError::GuardedPageAccess);
+    }
+    if ((flags & PAGE_IO) != 0) {
+        return io_[address >> 8]->read(address);
+    }
+    if ((flags & PAGE_TRAP) != 0) {
+        return peek(address);
+    }
+    return data_[address];
+}
+
+inline constexpr auto Memory::write_flagged(u16 address, u8 value)
+    -> std::expected<void, EmulatorError> {
+    const u8 flags = page_flags_[address >> 8];
+    if ((flags & PAGE_GUARDED) != 0) {
+        return std::unexpected(EmulatorError::GuardedPageAccess);
+    }
+    if ((flags & PAGE_IO) != 0) {
+        io_[address >> 8]->write(address, value);
+        return {};
+    }
+    if (Trap* trap = (flags & PAGE_TRAP) != 0 ? find_trap(address) : nullptr; trap != nullptr) {
+        trap->original = value;  // The trap stays armed over self-modifying code
+        return {};
+    }
+    data_[address] = value;
+    return {};
 }
 
 inline constexpr u8& Memory::operator[](u16 address) noexcept {
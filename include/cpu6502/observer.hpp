@@ -0,0 +1,60 @@
+#pragma once
+
+#include "types.hpp"
+
+namespace cpu6502
+{
+
+/**
+ * @type struct
+ * @brief Machine state just before one instruction executes
+ *
+ * Sixteen bytes, laid out without padding so records can be copied in bulk.
+ */
+struct TraceRecord
+{
+    u64 cycles;  // CPU cycle counter before the instruction
+    u16 pc;      // Address of the opcode
+    u8  opcode;
+    u8  a;
+    u8  x;
+    u8  y;
+    u8  sp;
+    u8  p;  // Status register as pushed by PHP
+};
+
+static_assert(sizeof(TraceRecord) == 16, "TraceRecord must stay compact");
+
+/**
+ * @type enum class
+ * @brief Hardware interrupt being serviced
+ */
+enum class InterruptKind : u8
+{
+    Irq,
+    Nmi
+};
+
+/**
+ * @type class
+ * @brief Receives every instruction a CPU executes while it is attached
+ *
+ * With no observer attached the CPU pays one null check per instruction.
+ * Implementations run on the emulation thread and must not block it.
+ */
+class ExecutionObserver
+{
+ public:
+    virtual ~ExecutionObserver() = default;
+
+    virtual void on_instruction(const TraceRecord& record) noexcept = 0;
+
+    // Called before the CPU pushes PC and P for a hardware interrupt; record.opcode is 0
+    virtual void on_interrupt(const TraceRecord& record, InterruptKind kind) noexcept
+    {
+        (void)record;
+        (void)kind;
+    }
+};
+
+}  // namespace cpu6502
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "isa.hpp"
 #include "types.hpp"
 
 namespace cpu6502
@@ -138,208 +139,7 @@ enum class Opcode : u8
  */
 constexpr const char* opcode_name(Opcode op) noexcept
 {
-    switch (op)
-        {
-            // LDA
-            case Opcode::LDA_IM:
-                return "LDA_IM";
-            case Opcode::LDA_ZP:
-                return "LDA_ZP";
-            case Opcode::LDA_ZPX:
-                return "LDA_ZPX";
-            case Opcode::LDA_ABS:
-                return "LDA_ABS";
-            case Opcode::LDA_ABSX:
-                return "LDA_ABSX";
-            case Opcode::LDA_ABSY:
-                return "LDA_ABSY";
-            // LDX
-            case Opcode::LDX_IM:
-                return "LDX_IM";
-            case Opcode::LDX_ZP:
-                return "LDX_ZP";
-            case Opcode::LDX_ZPY:
-                return "LDX_ZPY";
-            case Opcode::LDX_ABS:
-                return "LDX_ABS";
-            case Opcode::LDX_ABSY:
-                return "LDX_ABSY";
-            // LDY
-            case Opcode::LDY_IM:
-                return "LDY_IM";
-            case Opcode::LDY_ZP:
-                return "LDY_ZP";
-            case Opcode::LDY_ZPX:
-                return "LDY_ZPX";
-            case Opcode::LDY_ABS:
-                return "LDY_ABS";
-            case Opcode::LDY_ABSX:
-                return "LDY_ABSX";
-            // ADC
-            case Opcode::ADC_IM:
-                return "ADC_IM";
-            case Opcode::ADC_ZP:
-                return "ADC_ZP";
-            case Opcode::ADC_ZPX:
-                return "ADC_ZPX";
-            case Opcode::ADC_ABS:
-                return "ADC_ABS";
-            case Opcode::ADC_ABSX:
-                return "ADC_ABSX";
-            case Opcode::ADC_ABSY:
-                return "ADC_ABSY";
-            case Opcode::ADC_INDX:
-                return "ADC_INDX";
-            case Opcode::ADC_INDY:
-                return "ADC_INDY";
-
-            // AND
-            case Opcode::AND_IM:
-                return "AND_IM";
-            case Opcode::AND_ZP:
-                return "AND_ZP";
-            case Opcode::AND_ZPX:
-                return "AND_ZPX";
-            case Opcode::AND_ABS:
-                return "AND_ABS";
-            case Opcode::AND_ABSX:
-                return "AND_ABSX";
-            case Opcode::AND_ABSY:
-                return "AND_ABSY";
-            case Opcode::AND_INDX:
-                return "AND_INDX";
-            case Opcode::AND_INDY:
-                return "AND_INDY";
-
-            // EOR
-            case Opcode::EOR_IM:
-                return "EOR_IM";
-            case Opcode::EOR_ZP:
-                return "EOR_ZP";
-            case Opcode::EOR_ZPX:
-                return "EOR_ZPX";
-            case Opcode::EOR_ABS:
-                return "EOR_ABS";
-            case Opcode::EOR_ABSX:
-                return "EOR_ABSX";
-            case Opcode::EOR_ABSY:
-                return "EOR_ABSY";
-            case Opcode::EOR_INDX:
-                return "EOR_INDX";
-            case Opcode::EOR_INDY:
-                return "EOR_INDY";
-
-                // Arthmetic Shift Left
-            case Opcode::ASL_A:
-                return "ASL_A";
-            case Opcode::ASL_ZP:
-                return "ASL_ZP";
-            case Opcode::ASL_ZPX:
-                return "ASL_ZPX";
-            case Opcode::ASL_ABS:
-                return "ASL_ABS";
-            case Opcode::ASL_ABSX:
-                return "ASL_ABSX";
-
-            // Clear Flags
-            case Opcode::CLC:
-                return "CLC";
-            case Opcode::CLD:
-                return "CLD";
-            case Opcode::CLI:
-                return "CLI";
-            case Opcode::CLV:
-                return "CLV";
-
-            // Branch Instructions
-            case Opcode::BCC:
-                return "BCC";
-            case Opcode::BCS:
-                return "BCS";
-            case Opcode::BEQ:
-                return "BEQ";
-            case Opcode::BIT_ZP:
-                return "BIT_ZP";
-            case Opcode::BIT_ABS:
-                return "BIT_ABS";
-            case Opcode::BMI:
-                return "BMI";
-            case Opcode::BNE:
-                return "BNE";
-            case Opcode::BPL:
-                return "BPL";
-            case Opcode::BRK:
-                return "BRK";
-            case Opcode::BVC:
-                return "BVC";
-            case Opcode::BVS:
-                return "BVS";
-            
-            // Comparision Registers
-            case Opcode::CMP_IM:
-                return "CMP_IM";
-            case Opcode::CMP_ZP:
-                return "CMP_ZP";
-            case Opcode::CMP_ZPX:
-                return "CMP_ZPX";
-            case Opcode::CMP_ABS:
-                return "CMP_ABS";
-            case Opcode::CMP_ABSX:
-                return "CMP_ABSX";
-            case Opcode::CMP_ABSY:
-                return "CMP_ABSY";
-            case Opcode::CMP_INDX:
-                return "CMP_INDX";
-            case Opcode::CMP_INDY:
-                return "CMP_INDY";
-            case Opcode::CPX_IM:
-                return "CPX_IM";
-            case Opcode::CPX_ZP:
-                return "CPX_ZP";
-            case Opcode::CPX_ABS:
-                return "CPX_ABS";
-            case Opcode::CPY_IM:
-                return "CPY_IM";
-            case Opcode::CPY_ZP:
-                return "CPY_ZP";
-            case Opcode::CPY_ABS:
-                return "CPY_ABS";
-
-            // Incremenet and Decrement Registers
-            case Opcode::INC_ZP:
-                return "INC_ZP";
-            case Opcode::INC_ZPX:
-                return "INC_ZPX";
-            case Opcode::INC_ABS:
-                return "INC_ABS";
-            case Opcode::INC_ABSX:
-                return "INC_ABSX";
-            case Opcode::INX:
-                return "INX";
-            case Opcode::INY:
-                return "INY";
-            case Opcode::DEC_ZP:
-                return "DECZ_ZP";
-            case Opcode::DEC_ZPX:
-                return "DEC_ZPX";
-            case Opcode::DEC_ABS:
-                return "DEC_ABS";
-            case Opcode::DEC_ABSX:
-                return "DEC_ABSX";
-            case Opcode::DEX:
-                return "DEX";
-            case Opcode::DEY:
-                return "DEY";
-
-            // Control FLow
-            case Opcode::JSR:
-                return "JSR";
-            case Opcode::RTS:
-                return "RTS";
-
-            default:
-                return "UNKNOWN";
-        }
+    return OPCODE_TABLE[static_cast<u8>(op)].name.data();  // Views a literal, NUL-terminated
 }
 
 }  // namespace cpu6502
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <expected>
+#include <map>
+#include <ostream>
+#include <span>
+#include <vector>
+#include "call_graph.hpp"
+#include "cpu.hpp"
+#include "error.hpp"
+#include "memory.hpp"
+#include "stop_condition.hpp"
+#include "symbols.hpp"
+#include "types.hpp"
+
+namespace cpu6502
+{
+
+/**
+ * @type struct
+ * @brief Sampling period of a SamplingProfiler
+ */
+struct ProfilerConfig
+{
+    u64 interval = 1000;    // Mean cycles between samples
+    u64 jitter   = 250;     // Each period is interval +/- up to jitter cycles
+    u64 seed     = 0x6502;  // Jitter sequence, fixed so profiles are reproducible
+};
+
+/**
+ * @type class
+ * @brief Statistical PC profiler that costs nothing between samples
+ *
+ * run() executes the CPU in stretches of roughly config.interval cycles with
+ * the plain CPU::run loop and records the PC where each stretch ends, so no
+ * per-instruction hook is involved. The jitter keeps the sampling from locking
+ * onto loops whose length divides the interval. Samples are kept per address
+ * and grouped by symbol when reported.
+ *
+ * With a CallGraphProfiler attached (it must also be the CPU's observer) each
+ * sample also records the open call chain, and write_folded() emits whole
+ * stacks instead of single functions.
+ */
+class SamplingProfiler
+{
+ public:
+    explicit SamplingProfiler(const ProfilerConfig& config = {});
+
+    // Runs like CPU::run while sampling the PC
+    auto run(const StopCondition& stop, CPU& cpu, Memory& memory)
+        -> std::expected<RunResult, EmulatorError>;
+
+    void record(u16 pc) noexcept;
+    void clear() noexcept;
+
+    // Shadow call stack sampled alongside the PC; nullptr samples the PC only
+    void set_call_graph(const CallGraphProfiler* calls) noexcept { calls_ = calls; }
+
+    [[nodiscard]] u64                  sample_count() const noexcept { return samples_; }
+    [[nodiscard]] u64                  samples_at(u16 pc) const noexcept { return histogram_[pc]; }
+    [[nodiscard]] std::span<const u64> histogram() const noexcept { return histogram_; }
+
+    // One line per symbol, busiest first: samples, share of total, name
+    void write_flat(std::ostream& out, const SymbolTable& symbols) const;
+
+    // "outer;inner count" lines as consumed by flamegraph.pl and speedscope, or
+    // "name count" when no call graph was attached
+    void write_folded(std::ostream& out, const SymbolTable& symbols) const;
+
+ private:
+    ProfilerConfig                  config_;
+    u64                             rng_state_;
+    u64                             samples_ = 0;
+    std::vector<u64>                histogram_;  // One bucket per address
+    const CallGraphProfiler*        calls_ = nullptr;
+    std::map<std::vector<u16>, u64> stacks_;  // Routine chain plus the sampled PC
+    std::vector<u16>                chain_;   // Scratch for the chain being sampled
+
+    [[nodiscard]] u64 next_period() noexcept;
+};
+
+}  // namespace cpu6502
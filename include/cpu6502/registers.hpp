@@ -0,0 +1,23 @@
+#pragma once
+
+#include "status_flags.hpp"
+#include "types.hpp"
+
+namespace cpu6502
+{
+
+/**
+ * @type struct
+ * @brief Snapshot of the programmer-visible register file
+ */
+struct Registers
+{
+    u16         pc{};      // Program Counter
+    u8          sp{0xFF};  // Stack Pointer (offset from $0100)
+    u8          a{};       // Accumulator
+    u8          x{};       // X register
+    u8          y{};       // Y register
+    StatusFlags flags{};
+};
+
+}  // namespace cpu6502
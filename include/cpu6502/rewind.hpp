@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <expected>
+#include <memory>
+#include <vector>
+#include "cpu.hpp"
+#include "error.hpp"
+#include "memory.hpp"
+#include "save_state.hpp"
+#include "stop_condition.hpp"
+#include "types.hpp"
+
+namespace cpu6502
+{
+
+/**
+ * @type struct
+ * @brief Sizing of a RewindBuffer
+ *
+ * A capture copies and compares all 64K whatever the program wrote, about as
+ * much work as emulating 2'000 cycles. The default interval keeps run()
+ * within a few percent of CPU::run (see the rewind/ benchmarks); rewind_to()
+ * then replays at most that many cycles.
+ */
+struct RewindConfig
+{
+    std::size_t byte_budget       = 16 * 1024 * 1024;  // Upper bound on stored snapshot bytes
+    u64         interval          = 100'000;           // Cycles between snapshots in run()
+    u32         keyframe_interval = 64;                // Every Nth snapshot is a full keyframe
+};
+
+/**
+ * @type class
+ * @brief Bounded history of machine states for stepping backwards in time
+ *
+ * Snapshots are either keyframes (a whole SaveState) or deltas against the
+ * previous snapshot: the register header plus, for every page that changed,
+ * the XOR of old and new contents run-length encoded. Going back to cycle T
+ * restores the newest snapshot at or before T and replays forward with
+ * CPU::step, executing through any breakpoint traps on the way. When the
+ * budget is exceeded the oldest keyframe and its deltas are evicted together;
+ * the newest keyframe group is always kept.
+ *
+ * Going back keeps the newer snapshots, so rewind_to() can also go forward
+ * again. They are dropped once execution resumes from the earlier point, at
+ * the next capture() or run().
+ *
+ * Replay is exact as long as the machine is deterministic between snapshots.
+ */
+class RewindBuffer
+{
+ public:
+    explicit RewindBuffer(const RewindConfig& config = {});
+
+    // Records the current state, first dropping any snapshots newer than it;
+    // ignored if a snapshot at this cycle already exists
+    void capture(const CPU& cpu, const Memory& memory);
+
+    // Runs like CPU::run, capturing a snapshot every config.interval cycles
+    auto run(const StopCondition& stop, CPU& cpu, Memory& memory)
+        -> std::expected<RunResult, EmulatorError>;
+
+    // Puts the machine at the first instruction boundary at or after cycle
+    auto rewind_to(u64 cycle, CPU& cpu, Memory& memory) -> std::expected<void, EmulatorError>;
+
+    // Undoes the last count instructions
+    auto step_back(CPU& cpu, Memory& memory, u64 count = 1) -> std::expected<void, EmulatorError>;
+
+    void clear() noexcept;
+
+    [[nodiscard]] std::size_t bytes_used() const noexcept { return bytes_used_; }
+    [[nodiscard]] std::size_t snapshot_count() const noexcept { return entries_.size(); }
+    [[nodiscard]] u64         oldest_cycle() const noexcept;
+    [[nodiscard]] u64         newest_cycle() const noexcept;
+
+ private:
+    struct Entry
+    {
+        u64             cycles   = 0;
+        bool            keyframe = false;
+        std::vector<u8> data;
+    };
+
+    RewindConfig               config_;
+    std::deque<Entry>          entries_;
+    std::size_t                bytes_used_     = 0;
+    u32                        since_keyframe_ = 0;
+    std::unique_ptr<SaveState> last_;     // State of the newest entry
+    std::unique_ptr<SaveState> scratch_;  // Capture and reconstruction buffer
+
+    void encode_delta(const SaveState& from, const SaveState& to, std::vector<u8>& out) const;
+    void apply_delta(const std::vector<u8>& delta, SaveState& state) const;
+    void reconstruct(std::size_t index, SaveState& state) const;
+    void evict();
+
+    // Loads entry index into the machine; newer entries are kept
+    auto restore(std::size_t index, CPU& cpu, Memory& memory) -> std::expected<void, EmulatorError>;
+
+    // Drops the entries newer than cycle, which execution from there replaces
+    void truncate(u64 cycle);
+
+    // Index of the newest entry at or before cycle, entries_.size() if none
+    [[nodiscard]] std::size_t find(u64 cycle) const noexcept;
+};
+
+}  // namespace cpu6502
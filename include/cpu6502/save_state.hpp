@@ -0,0 +1,64 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <expected>
+#include <span>
+#include <type_traits>
+#include "cpu.hpp"
+#include "error.hpp"
+#include "memory.hpp"
+#include "types.hpp"
+
+namespace cpu6502
+{
+
+/**
+ * @type struct
+ * @brief Fixed-layout snapshot of one CPU and its memory
+ *
+ * The object representation is the file format: a 32-byte header followed by
+ * the 64 KiB address space. Multi-byte header fields are stored little-endian
+ * byte by byte, so the bytes are identical on every host and a save state is
+ * written and read with a single copy. VERSION changes whenever the layout does.
+ */
+struct SaveState
+{
+    static constexpr std::array<u8, 4> MAGIC   = {'6', '5', 'S', 'T'};
+    static constexpr u16               VERSION = 2;
+
+    std::array<u8, 4>               magic{};
+    std::array<u8, 2>               version{};     // Little-endian
+    std::array<u8, 2>               reserved0{};   // Zero
+    std::array<u8, 8>               cycles{};      // Little-endian CPU cycle counter
+    std::array<u8, 2>               pc{};          // Little-endian
+    u8                              sp{};
+    u8                              a{};
+    u8                              x{};
+    u8                              y{};
+    u8                              p{};           // Status register, bit 5 set
+    u8                              interrupts{};  // Bit 0 IRQ line asserted, bit 1 NMI pending
+    std::array<u8, 8>               reserved1{};   // Zero, pads the header to 32 bytes
+    std::array<u8, Memory::MAX_MEM> memory{};
+};
+
+static_assert(std::is_trivially_copyable_v<SaveState>);
+static_assert(std::is_standard_layout_v<SaveState>);
+static_assert(sizeof(SaveState) == 32 + Memory::MAX_MEM, "SaveState layout is the file format");
+static_assert(offsetof(SaveState, memory) == 32);
+
+// Captures registers, interrupt inputs, cycle counter and the whole address space
+void save_state(const CPU& cpu, const Memory& memory, SaveState& state) noexcept;
+
+// Restores a captured state; fails without touching cpu or memory if the header is wrong
+auto load_state(const SaveState& state, CPU& cpu, Memory& memory)
+    -> std::expected<void, EmulatorError>;
+
+// The serialized form of a state, ready to be written out as is
+[[nodiscard]] auto state_bytes(const SaveState& state) noexcept
+    -> std::span<const u8, sizeof(SaveState)>;
+
+// Copies serialized bytes into state after checking size, magic and version
+auto read_state(std::span<const u8> bytes, SaveState& state) -> std::expected<void, EmulatorError>;
+
+}  // namespace cpu6502
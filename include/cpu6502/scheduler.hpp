@@ -0,0 +1,202 @@
+#pragma once
+
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <expected>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include "cpu.hpp"
+#include "error.hpp"
+#include "memory.hpp"
+#include "stop_condition.hpp"
+#include "types.hpp"
+
+namespace cpu6502
+{
+
+class Scheduler;
+
+/**
+ * @type class
+ * @brief Owning handle to a suspended coroutine that runs on a Scheduler
+ *
+ * A Task starts suspended and does nothing until it is handed to
+ * Scheduler::spawn. Once spawned the scheduler owns it; the coroutine frame is
+ * freed as soon as the body returns, or with the scheduler if it never does.
+ */
+class Task
+{
+ public:
+    struct promise_type
+    {
+        Scheduler* scheduler = nullptr;
+
+        Task get_return_object() noexcept
+        {
+            return Task{std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_never  final_suspend() noexcept { return {}; }
+
+        void return_void() noexcept;
+        void unhandled_exception() noexcept { std::terminate(); }
+    };
+
+    Task() = default;
+    Task(Task&& other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+    Task& operator=(Task&& other) noexcept;
+    ~Task();
+
+    Task(const Task&)            = delete;
+    Task& operator=(const Task&) = delete;
+
+ private:
+    friend class Scheduler;
+
+    explicit Task(std::coroutine_handle<promise_type> handle) noexcept : handle_(handle) {}
+
+    std::coroutine_handle<promise_type> handle_{};
+};
+
+/**
+ * @type class
+ * @brief Cooperative scheduler interleaving many machine coroutines on a few threads
+ *
+ * Tasks run until they co_await something: yield() and slice() go to the back
+ * of the ready queue, an unset Event parks the task until Event::set. run()
+ * drives the ready queue on thread_count threads (the caller included) and
+ * returns once every task has either finished or is parked on an Event, so a
+ * service can set events and call run() again. Destroying the scheduler outside
+ * run() destroys the frames of the tasks still pending; their Events must not
+ * be set afterwards.
+ */
+class Scheduler
+{
+ public:
+    explicit Scheduler(unsigned thread_count = 1) noexcept
+        : thread_count_(thread_count != 0 ? thread_count : 1)
+    {
+    }
+
+    Scheduler(const Scheduler&)            = delete;
+    Scheduler& operator=(const Scheduler&) = delete;
+    ~Scheduler();
+
+    // Takes ownership of a task and queues its first resumption
+    void spawn(Task task);
+
+    // Queues a suspended coroutine; used by awaitables such as Event
+    void schedule(std::coroutine_handle<> handle);
+
+    // Runs ready tasks until none are ready and none are running
+    void run();
+
+    // Tasks spawned and not yet finished, including those parked on an Event
+    [[nodiscard]] std::size_t pending() const;
+
+    [[nodiscard]] unsigned thread_count() const noexcept { return thread_count_; }
+
+    struct YieldAwaiter
+    {
+        Scheduler& scheduler;
+
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> handle) { scheduler.schedule(handle); }
+        void await_resume() const noexcept {}
+    };
+
+    // Resumes after every task that was ready before it had its turn
+    [[nodiscard]] YieldAwaiter yield() noexcept { return YieldAwaiter{*this}; }
+
+    struct SliceAwaiter
+    {
+        Scheduler&    scheduler;
+        CPU&          cpu;
+        Memory&       memory;
+        StopCondition stop;
+
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> handle) { scheduler.schedule(handle); }
+        auto await_resume() -> std::expected<RunResult, EmulatorError>
+        {
+            return cpu.run(stop, memory);
+        }
+    };
+
+    // Yields, then runs cpu for one slice bounded by stop once the task is resumed
+    [[nodiscard]] SliceAwaiter slice(CPU& cpu, Memory& memory, const StopCondition& stop) noexcept
+    {
+        return SliceAwaiter{*this, cpu, memory, stop};
+    }
+
+ private:
+    friend struct Task::promise_type;
+
+    unsigned thread_count_;
+
+    mutable std::mutex                  mutex_;
+    std::condition_variable             ready_cv_;
+    std::deque<std::coroutine_handle<>> ready_;
+    std::unordered_set<void*>           live_;         // Frames spawned and not finished
+    unsigned                            running_ = 0;  // Tasks being resumed right now
+
+    void work();
+    void finished(std::coroutine_handle<> handle) noexcept;
+};
+
+/**
+ * @type class
+ * @brief One-shot signal a task can co_await, e.g. for emulated I/O completion
+ *
+ * Waiting on a set event does not suspend. set() may be called from any thread
+ * and hands every waiter back to the scheduler; reset() re-arms the event.
+ */
+class Event
+{
+ public:
+    explicit Event(Scheduler& scheduler) noexcept : scheduler_(scheduler) {}
+
+    Event(const Event&)            = delete;
+    Event& operator=(const Event&) = delete;
+
+    void set();
+    void reset();
+
+    [[nodiscard]] bool is_set() const;
+
+    struct Awaiter
+    {
+        Event& event;
+
+        bool await_ready() const { return event.is_set(); }
+        bool await_suspend(std::coroutine_handle<> handle);
+        void await_resume() const noexcept {}
+    };
+
+    [[nodiscard]] Awaiter operator co_await() noexcept { return Awaiter{*this}; }
+
+ private:
+    Scheduler&                           scheduler_;
+    mutable std::mutex                   mutex_;
+    bool                                 set_ = false;
+    std::vector<std::coroutine_handle<>> waiters_;
+};
+
+/**
+ * @brief Runs a machine to its stop condition in slices of at most quantum cycles
+ *
+ * Between slices the task yields to the scheduler. The combined result equals
+ * a single CPU::run with the same stop condition and is written to result when
+ * the task finishes; cpu, memory and result must outlive the task.
+ */
+[[nodiscard]] Task run_machine(Scheduler& scheduler, CPU& cpu, Memory& memory, StopCondition stop,
+                               u64 quantum, std::expected<RunResult, EmulatorError>& result);
+
+}  // namespace cpu6502
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include "opcodes.hpp"
+#include "types.hpp"
+
+namespace cpu6502
+{
+
+/**
+ * @type struct
+ * @brief Point-in-time copy of the per-opcode execution statistics
+ *
+ * Branch counters are kept for the eight conditional branches only; they are
+ * addressed by opcode through taken()/not_taken().
+ */
+struct ExecutionStats
+{
+    std::array<u64, 256> executions{};          // Instructions executed, per opcode
+    std::array<u64, 256> cycles{};              // Cycles consumed, per opcode
+    std::array<u64, 8>   branches_taken{};      // Per branch, see branch_index()
+    std::array<u64, 8>   branches_not_taken{};  // Per branch, see branch_index()
+    u64                  page_crossings = 0;    // Page-cross penalty cycles taken
+
+    // BPL, BMI, BVC, BVS, BCC, BCS, BNE, BEQ are $10 + $20 * n
+    [[nodiscard]] static constexpr std::size_t branch_index(Opcode opcode) noexcept
+    {
+        return static_cast<std::size_t>(static_cast<u8>(opcode) >> 5);
+    }
+
+    [[nodiscard]] constexpr u64 taken(Opcode branch) const noexcept
+    {
+        return branches_taken[branch_index(branch)];
+    }
+
+    [[nodiscard]] constexpr u64 not_taken(Opcode branch) const noexcept
+    {
+        return branches_not_taken[branch_index(branch)];
+    }
+
+    [[nodiscard]] constexpr u64 total_instructions() const noexcept
+    {
+        u64 total = 0;
+        for (const u64 count : executions)
+            total += count;
+        return total;
+    }
+
+    [[nodiscard]] constexpr u64 total_cycles() const noexcept
+    {
+        u64 total = 0;
+        for (const u64 count : cycles)
+            total += count;
+        return total;
+    }
+};
+
+/**
+ * @type class
+ * @brief Counters updated by the CPU while it executes
+ *
+ * Only built in when CPU6502_STATS is defined (CMake option
+ * CPU6502_ENABLE_STATS). Otherwise the class is empty, every hook is an empty
+ * inline function and snapshot() returns zeros, so the interpreter compiles
+ * to the same code as without the hooks.
+ */
+class StatsCollector
+{
+ public:
+#ifdef CPU6502_STATS
+    static constexpr bool enabled = true;
+
+    constexpr void record_instruction(u8 opcode, i32 cycles) noexcept
+    {
+        ++stats_.executions[opcode];
+        stats_.cycles[opcode] += static_cast<u64>(cycles);
+    }
+
+    constexpr void record_page_cross() noexcept { ++stats_.page_crossings; }
+
+    constexpr void record_branch(Opcode branch, bool taken) noexcept
+    {
+        auto& counters = taken ? stats_.branches_taken : stats_.branches_not_taken;
+        ++counters[ExecutionStats::branch_index(branch)];
+    }
+
+    [[nodiscard]] constexpr ExecutionStats snapshot() const noexcept { return stats_; }
+    constexpr void                         reset() noexcept { stats_ = {}; }
+
+ private:
+    ExecutionStats stats_{};
+#else
+    static constexpr bool enabled = false;
+
+    constexpr void record_instruction(u8, i32) noexcept {}
+    constexpr void record_page_cross() noexcept {}
+    constexpr void record_branch(Opcode, bool) noexcept {}
+
+    [[nodiscard]] constexpr ExecutionStats snapshot() const noexcept { return {}; }
+    constexpr void                         reset() noexcept {}
+#endif
+};
+
+}  // namespace cpu6502
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <limits>
+#include <optional>
+#include "types.hpp"
+
+namespace cpu6502
+{
+
+/**
+ * @type struct
+ * @brief Conditions that end a CPU::run call
+ *
+ * Conditions are checked between instructions, so a run may overshoot
+ * max_cycles by at most one instruction.
+ */
+struct StopCondition
+{
+    u64                max_cycles  = std::numeric_limits<u64>::max();
+    std::optional<u16> stop_pc     = std::nullopt;  // Stop before executing this address
+    bool               stop_on_brk = false;         // Stop before executing a BRK opcode
+};
+
+/**
+ * @type enum class
+ * @brief Which stop condition ended the run
+ */
+enum class StopReason : u8
+{
+    CycleLimit,
+    StopPc,
+    Brk,
+    Breakpoint  // Reached a Memory::set_trap address; always on
+};
+
+/**
+ * @type struct
+ * @brief Outcome of a successful CPU::run call
+ */
+struct RunResult
+{
+    StopReason reason       = StopReason::CycleLimit;
+    u64        cycles       = 0;  // Cycles consumed by this run
+    u64        instructions = 0;  // Instructions executed by this run
+};
+
+}  // namespace cpu6502
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "types.hpp"
+
+namespace cpu6502
+{
+
+/**
+ * @type struct
+ * @brief A named code or data address
+ */
+struct Symbol
+{
+    u16         address = 0;
+    u16         size    = 0;  // 0 when the source does not say
+    std::string name;
+};
+
+/**
+ * @type class
+ * @brief Address to name lookup built from assembler or monitor label files
+ *
+ * Understands VICE monitor labels ("al C:080d .start") and the sym records of
+ * ca65/ld65 debug files (ld65 --dbgfile). Lines that are not labels or do not
+ * parse are skipped. When several labels share an address the first one wins.
+ */
+class SymbolTable
+{
+ public:
+    void add(u16 address, std::string name, u16 size = 0);
+
+    // Both return the number of symbols added
+    std::size_t load_vice_labels(std::string_view text);
+    std::size_t load_ca65_dbg(std::string_view text);
+
+    // Closest symbol at or below address; nullptr if none or address is past its size
+    [[nodiscard]] const Symbol* resolve(u16 address) const noexcept;
+
+    // Symbol with exactly this name; nullptr if none
+    [[nodiscard]] const Symbol* find(std::string_view name) const noexcept;
+
+    // "name" or "name+offset" when a symbol covers address, "$XXXX" otherwise
+    [[nodiscard]] std::string describe(u16 address) const;
+
+    // Like describe() without the offset, for grouping samples by function
+    [[nodiscard]] std::string function_name(u16 address) const;
+
+    [[nodiscard]] std::size_t size() const noexcept { return symbols_.size(); }
+    [[nodiscard]] bool        empty() const noexcept { return symbols_.empty(); }
+
+ private:
+    std::vector<Symbol> symbols_;  // Sorted by address, unique addresses
+};
+
+/**
+ * @type struct
+ * @brief Bytes of the address space generated by one source line
+ */
+struct LineRange
+{
+    u16 address = 0;
+    u16 size    = 0;
+    u32 file    = 0;  // Index into LineTable::files()
+    u32 line    = 0;  // 1-based
+};
+
+/**
+ * @type class
+ * @brief Address ranges of assembly source lines, from ca65/ld65 debug files
+ *
+ * Built from the file, seg, span and line records of ld65 --dbgfile output.
+ * A line that expands to several spans gets one range per span. Spans that
+ * carry a data type (.byte, .word, ...) are left out, so only code lines are
+ * listed.
+ */
+class LineTable
+{
+ public:
+    // Returns the index of the file, adding it if needed
+    u32  add_file(std::string_view name);
+    void add(u32 file, u32 line, u16 address, u16 size);
+
+    // Returns the number of line ranges added
+    std::size_t load_ca65_dbg(std::string_view text);
+
+    [[nodiscard]] std::span<const std::string> files() const noexcept { return files_; }
+    [[nodiscard]] std::span<const LineRange>   ranges() const noexcept { return ranges_; }
+
+ private:
+    std::vector<std::string> files_;
+    std::vector<LineRange>   ranges_;
+};
+
+}  // namespace cpu6502
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <expected>
+#include <memory>
+#include <vector>
+#include "cpu.hpp"
+#include "error.hpp"
+#include "memory.hpp"
+#include "types.hpp"
+
+namespace cpu6502
+{
+
+/**
+ * @type enum class
+ * @brief How System::run interleaves its CPUs
+ */
+enum class Interleave : u8
+{
+    Instruction,  // One instruction at a time, earliest CPU first
+    Slice         // Long guarded slices, synchronising only on shared pages
+};
+
+/**
+ * @type class
+ * @brief Several CPUs sharing one bus, interleaved deterministically by cycle time
+ *
+ * Every CPU keeps its own cycle clock. The reference order is: the CPU with the
+ * lowest clock executes the next instruction, ties going to the lower index.
+ *
+ * Pages marked with share_page() are the ones more than one CPU touches; the
+ * rest of memory is assumed to be used by one CPU only. Interleave::Slice runs
+ * each CPU alone up to a horizon with the shared pages guarded. A CPU that
+ * reaches for a shared page is rolled back to the start of that instruction
+ * and waits; waiting CPUs then execute their shared instruction one at a time
+ * in reference order. Both modes therefore give identical results, Slice just
+ * does far less bookkeeping when the shared pages are quiet. A CPU's observer
+ * hears of a rolled-back instruction once, when it finally executes.
+ */
+class System
+{
+ public:
+    static constexpr u64 DEFAULT_SLICE = 4096;
+
+    explicit System(std::size_t cpu_count);
+
+    [[nodiscard]] std::size_t cpu_count() const noexcept { return cpus_.size(); }
+
+    [[nodiscard]] CPU&       cpu(std::size_t index) noexcept { return cpus_[index]; }
+    [[nodiscard]] const CPU& cpu(std::size_t index) const noexcept { return cpus_[index]; }
+
+    [[nodiscard]] Memory&       bus() noexcept { return *bus_; }
+    [[nodiscard]] const Memory& bus() const noexcept { return *bus_; }
+
+    // Cycles executed by one CPU since construction
+    [[nodiscard]] u64 time(std::size_t index) const noexcept { return time_[index]; }
+
+    void share_page(u8 page, bool shared = true) noexcept { shared_[page] = shared; }
+
+    // Longest stretch a CPU runs unsynchronised in Interleave::Slice
+    void set_slice(u64 cycles) noexcept { slice_ = cycles != 0 ? cycles : 1; }
+
+    // Advances every CPU until its clock reaches the common target, cycles further on
+    auto run(u64 cycles, Interleave mode = Interleave::Slice) -> std::expected<void, EmulatorError>;
+
+ private:
+    std::unique_ptr<Memory> bus_;
+    std::vector<CPU>        cpus_;
+    std::vector<u64>        time_;
+    std::vector<bool>       waiting_;
+    std::array<bool, 256>   shared_{};
+    u64                     target_ = 0;
+    u64                     slice_  = DEFAULT_SLICE;
+
+    auto run_instructions() -> std::expected<void, EmulatorError>;
+    auto run_slices() -> std::expected<void, EmulatorError>;
+    auto run_guarded(std::size_t index, u64 horizon) -> std::expected<void, EmulatorError>;
+    auto step(std::size_t index) -> std::expected<void, EmulatorError>;
+
+    void set_guards(bool guarded) noexcept;
+};
+
+}  // namespace cpu6502
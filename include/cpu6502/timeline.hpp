@@ -0,0 +1,102 @@
+#pragma once
+
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "observer.hpp"
+#include "symbols.hpp"
+#include "types.hpp"
+
+namespace cpu6502
+{
+
+/**
+ * @type enum class
+ * @brief Output encoding of a TimelineWriter
+ */
+enum class TimelineFormat : u8
+{
+    ChromeJson,  // Trace Event Format, loads in chrome://tracing and ui.perfetto.dev
+    Perfetto     // Perfetto TracePacket protobuf stream
+};
+
+/**
+ * @type class
+ * @brief Streams subroutine and interrupt spans of a run as a trace timeline
+ *
+ * One emulated cycle is one time unit (a microsecond in Chrome JSON, a
+ * nanosecond in Perfetto). Subroutine and interrupt spans go on the "6502"
+ * track and are opened and closed with the same stack pointer rule as
+ * CallGraphProfiler; BRK counts as an interrupt. begin()/end() and marker()
+ * write caller-defined spans and instants, such as video frames, on a separate
+ * "markers" track. Every event is written as soon as it is known, so the trace
+ * never has to fit in memory. finish() closes open spans and terminates the
+ * file; the destructor calls it if needed.
+ *
+ * The observer callbacks do not allocate once the span stack and encoding
+ * buffers have grown to size. If writing throws (a stream with exceptions()
+ * set, or running out of memory) they stop recording and failed() turns true.
+ */
+class TimelineWriter final : public ExecutionObserver
+{
+ public:
+    // symbols names subroutine spans; without it they are named by address
+    TimelineWriter(std::ostream& out, TimelineFormat format, const SymbolTable* symbols = nullptr);
+    ~TimelineWriter() override;
+
+    TimelineWriter(const TimelineWriter&)            = delete;
+    TimelineWriter& operator=(const TimelineWriter&) = delete;
+
+    void on_instruction(const TraceRecord& record) noexcept override;
+    void on_interrupt(const TraceRecord& record, InterruptKind kind) noexcept override;
+
+    // Markers track
+    void begin(std::string_view name, u64 cycles);
+    void end(u64 cycles);
+    void marker(std::string_view name, u64 cycles);
+
+    void finish(u64 end_cycles);
+
+    // True once a write threw or the stream went bad; the trace is incomplete
+    [[nodiscard]] bool failed() const noexcept { return failed_ || out_.fail(); }
+
+ private:
+    enum class Phase : u8
+    {
+        Begin,
+        End,
+        Instant
+    };
+
+    enum class Track : u8
+    {
+        Cpu     = 1,
+        Markers = 2
+    };
+
+    std::ostream&      out_;
+    TimelineFormat     format_;
+    const SymbolTable* symbols_;
+    std::vector<i32>   frames_;  // SP before each open span's return address was pushed
+    u32                open_markers_ = 0;
+    u64                last_cycles_  = 0;
+    bool               call_pending_ = false;
+    i32                call_sp_      = 0;
+    bool               first_event_  = true;
+    bool               finished_     = false;
+    bool               failed_       = false;
+    std::string        message_;  // Encoding buffers, reused for every Perfetto packet
+    std::string        packet_;
+    std::string        header_;
+
+    void open(const TraceRecord& record, std::string_view name, i32 return_sp);
+    void close_returned(u8 sp, u64 cycles);
+    void describe_track(Track track, std::string_view name);
+    void emit(Phase phase, Track track, std::string_view name, u64 cycles);
+    void emit_json(Phase phase, Track track, std::string_view name, u64 cycles);
+    void emit_perfetto(Phase phase, Track track, std::string_view name, u64 cycles);
+    void write_packet();
+};
+
+}  // namespace cpu6502
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include "observer.hpp"
+#include "types.hpp"
+
+namespace cpu6502
+{
+
+/**
+ * @type enum class
+ * @brief What the producer does when the ring is full
+ */
+enum class OverflowPolicy : u8
+{
+    Drop,  // Discard the record and count it in dropped()
+    Block  // Spin until the consumer frees a slot
+};
+
+/**
+ * @type class
+ * @brief Lock-free single-producer/single-consumer ring of TraceRecords
+ *
+ * Attach it to a CPU with set_observer() and drain it from one other thread
+ * with pop()/pop_bulk(). The buffer is allocated once in the constructor;
+ * neither side allocates or locks afterwards. Capacity is rounded up to a
+ * power of two. With OverflowPolicy::Block the emulation thread waits for the
+ * consumer, so a consumer must be running.
+ */
+class TraceRing final : public ExecutionObserver
+{
+ public:
+    explicit TraceRing(std::size_t capacity, OverflowPolicy policy = OverflowPolicy::Drop);
+
+    TraceRing(const TraceRing&)            = delete;
+    TraceRing& operator=(const TraceRing&) = delete;
+
+    // Producer side
+    bool push(const TraceRecord& record) noexcept;
+    void on_instruction(const TraceRecord& record) noexcept override { push(record); }
+    void close() noexcept { closed_.store(true, std::memory_order_release); }
+
+    // Consumer side
+    [[nodiscard]] bool        pop(TraceRecord& record) noexcept;
+    [[nodiscard]] std::size_t pop_bulk(std::span<TraceRecord> out) noexcept;
+
+    // True once close() was called and every record has been consumed
+    [[nodiscard]] bool finished() const noexcept;
+
+    [[nodiscard]] std::size_t    capacity() const noexcept { return mask_ + 1; }
+    [[nodiscard]] std::size_t    size() const noexcept;
+    [[nodiscard]] OverflowPolicy policy() const noexcept { return policy_; }
+
+    [[nodiscard]] u64 dropped() const noexcept
+    {
+        return dropped_.load(std::memory_order_relaxed);
+    }
+
+ private:
+    std::unique_ptr<TraceRecord[]> buffer_;
+    std::size_t                    mask_;
+    OverflowPolicy                 policy_;
+
+    // Each index lives on its own cache line next to the copy of the other
+    // index its owner last saw, so the common case touches no shared line
+    alignas(64) std::atomic<std::size_t> head_{0};  // Next slot to write, owned by the producer
+    std::size_t cached_tail_ = 0;
+    std::atomic<u64> dropped_{0};
+
+    alignas(64) std::atomic<std::size_t> tail_{0};  // Next slot to read, owned by the consumer
+    std::size_t cached_head_ = 0;
+
+    alignas(64) std::atomic<bool> closed_{false};
+};
+
+}  // namespace cpu6502
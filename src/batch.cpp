@@ -0,0 +1,214 @@
+#include "cpu6502/batch.hpp"
+#include <algorithm>
+
+namespace cpu6502
+{
+
+namespace
+{
+
+// A slot's pending jobs are the index range [begin, end), packed into one
+// atomic word as (end << 32 | begin) so owner and thieves agree through a CAS
+[[nodiscard]] constexpr u64 pack_range(u32 begin, u32 end) noexcept
+{
+    return (static_cast<u64>(end) << 32) | begin;
+}
+
+[[nodiscard]] constexpr u32 range_begin(u64 range) noexcept
+{
+    return static_cast<u32>(range & 0xFFFFFFFF);
+}
+
+[[nodiscard]] constexpr u32 range_end(u64 range) noexcept
+{
+    return static_cast<u32>(range >> 32);
+}
+
+[[nodiscard]] constexpr u32 range_size(u64 range) noexcept
+{
+    const u32 begin = range_begin(range);
+    const u32 end   = range_end(range);
+    return end > begin ? end - begin : 0;
+}
+
+void run_job(const BatchJob& job, BatchResult& result, CPU& cpu, Memory& memory)
+{
+    memory.clear();
+
+    auto loaded = memory.load(job.load_address, job.image);
+    if (!loaded)
+        {
+            result.outcome   = std::unexpected(loaded.error());
+            result.registers = job.registers;
+            return;
+        }
+
+    cpu.set_registers(job.registers);
+    result.outcome   = cpu.run(job.stop, memory);
+    result.registers = cpu.get_registers();
+}
+
+}  // namespace
+
+struct alignas(64) BatchRunner::Slot
+{
+    std::atomic<u64> range{0};
+    CPU              cpu{};
+    Memory           memory{};
+};
+
+BatchRunner::BatchRunner(unsigned thread_count)
+{
+    const unsigned count = std::max(thread_count, 1u);
+
+    slots_.reserve(count);
+    for (unsigned i = 0; i < count; ++i)
+        {
+            slots_.push_back(std::make_unique<Slot>());
+        }
+
+    // Worker 0 is the thread calling run()
+    threads_.reserve(count - 1);
+    for (unsigned i = 1; i < count; ++i)
+        {
+            threads_.emplace_back([this, i] { worker_loop(i); });
+        }
+}
+
+BatchRunner::~BatchRunner()
+{
+    {
+        std::lock_guard lock(mutex_);
+        stopping_ = true;
+    }
+    start_cv_.notify_all();
+    threads_.clear();  // jthread joins on destruction
+}
+
+void BatchRunner::run(std::span<const BatchJob> jobs, std::span<BatchResult> results)
+{
+    const auto count = static_cast<u32>(std::min(jobs.size(), results.size()));
+    if (count == 0)
+        return;
+
+    jobs_    = jobs.first(count);
+    results_ = results.first(count);
+
+    // Initial even split; stealing rebalances whatever the split got wrong
+    const auto workers = static_cast<u64>(slots_.size());
+    for (u64 i = 0; i < workers; ++i)
+        {
+            const auto begin = static_cast<u32>(count * i / workers);
+            const auto end   = static_cast<u32>(count * (i + 1) / workers);
+            slots_[i]->range.store(pack_range(begin, end), std::memory_order_relaxed);
+        }
+
+    {
+        std::lock_guard lock(mutex_);
+        running_ = static_cast<unsigned>(threads_.size());
+        ++generation_;
+    }
+    start_cv_.notify_all();
+
+    drain(0);
+
+    std::unique_lock lock(mutex_);
+    done_cv_.wait(lock, [this] { return running_ == 0; });
+}
+
+auto BatchRunner::run(std::span<const BatchJob> jobs) -> std::vector<BatchResult>
+{
+    std::vector<BatchResult> results(jobs.size());
+    run(jobs, results);
+    return results;
+}
+
+void BatchRunner::worker_loop(unsigned index)
+{
+    u64 seen_generation = 0;
+
+    while (true)
+        {
+            {
+                std::unique_lock lock(mutex_);
+                start_cv_.wait(lock,
+                               [&] { return stopping_ || generation_ != seen_generation; });
+                if (stopping_)
+                    return;
+                seen_generation = generation_;
+            }
+
+            drain(index);
+
+            {
+                std::lock_guard lock(mutex_);
+                if (--running_ == 0)
+                    done_cv_.notify_one();
+            }
+        }
+}
+
+void BatchRunner::drain(unsigned index)
+{
+    Slot& slot = *slots_[index];
+
+    while (true)
+        {
+            u64 current = slot.range.load(std::memory_order_acquire);
+            while (range_size(current) != 0)
+                {
+                    const u32 begin = range_begin(current);
+                    const u32 end   = range_end(current);
+                    if (slot.range.compare_exchange_weak(current, pack_range(begin + 1, end),
+                                                         std::memory_order_acq_rel,
+                                                         std::memory_order_acquire))
+                        {
+                            run_job(jobs_[begin], results_[begin], slot.cpu, slot.memory);
+                            current = slot.range.load(std::memory_order_acquire);
+                        }
+                }
+
+            if (!steal(index))
+                return;
+        }
+}
+
+bool BatchRunner::steal(unsigned thief)
+{
+    const auto workers = static_cast<unsigned>(slots_.size());
+
+    while (true)
+        {
+            Slot* victim   = nullptr;
+            u64   observed = 0;
+
+            for (unsigned offset = 1; offset < workers; ++offset)
+                {
+                    Slot&     candidate = *slots_[(thief + offset) % workers];
+                    const u64 range     = candidate.range.load(std::memory_order_acquire);
+                    if (range_size(range) > range_size(observed))
+                        {
+                            victim   = &candidate;
+                            observed = range;
+                        }
+                }
+
+            if (victim == nullptr)
+                return false;
+
+            // Take the back half (rounded up) so a single remaining job can move too
+            const u32 begin = range_begin(observed);
+            const u32 end   = range_end(observed);
+            const u32 split = end - (end - begin + 1) / 2;
+
+            if (victim->range.compare_exchange_strong(observed, pack_range(begin, split),
+                                                      std::memory_order_acq_rel,
+                                                      std::memory_order_acquire))
+                {
+                    slots_[thief]->range.store(pack_range(split, end), std::memory_order_release);
+                    return true;
+                }
+        }
+}
+
+}  // namespace cpu6502
@@ -0,0 +1,154 @@
+#include "cpu6502/call_graph.hpp"
+#include <algorithm>
+#include <format>
+#include "cpu6502/memory.hpp"
+#include "cpu6502/opcodes.hpp"
+
+namespace cpu6502
+{
+
+namespace
+{
+
+// SP never reaches this, so the root frame is only closed by finish()
+constexpr i32 ROOT_SP = 0x100;
+
+// Enough for a completely full stack of return addresses, plus the root
+constexpr std::size_t MAX_FRAMES = 129;
+
+}  // namespace
+
+CallGraphProfiler::CallGraphProfiler() : totals_(Memory::MAX_MEM)
+{
+    frames_.reserve(MAX_FRAMES);
+}
+
+void CallGraphProfiler::on_instruction(const TraceRecord& record) noexcept
+{
+    if (frames_.empty())
+        {
+            push(record.pc, ROOT_SP, record.cycles);
+            last_cycles_ = record.cycles;
+        }
+
+    // The previous instruction belongs to whichever routine was on top when it ran
+    frames_.back().exclusive += record.cycles - last_cycles_;
+    last_cycles_ = record.cycles;
+
+    if (call_pending_)
+        {
+            call_pending_ = false;
+            if (frames_.size() < MAX_FRAMES)
+                push(record.pc, call_sp_, record.cycles);
+        }
+
+    // A frame ends once its return address is no longer on the stack
+    while (frames_.size() > 1 && static_cast<i32>(record.sp) >= frames_.back().return_sp)
+        {
+            pop(record.cycles);
+        }
+
+    if (record.opcode == static_cast<u8>(Opcode::JSR))
+        {
+            call_pending_ = true;
+            call_sp_      = record.sp;
+        }
+}
+
+void CallGraphProfiler::finish(u64 end_cycles) noexcept
+{
+    if (frames_.empty())
+        return;
+
+    frames_.back().exclusive += end_cycles - last_cycles_;
+    while (!frames_.empty())
+        {
+            pop(end_cycles);
+        }
+    call_pending_ = false;
+}
+
+void CallGraphProfiler::clear() noexcept
+{
+    std::ranges::fill(totals_, Totals{});
+    frames_.clear();
+    last_cycles_  = 0;
+    call_pending_ = false;
+}
+
+void CallGraphProfiler::call_chain(u16 pc, u8 sp, std::vector<u16>& out) const
+{
+    out.clear();
+
+    // Frames are only closed on the next traced instruction, so an RTS that has
+    // already run still has its frame here; SP says whether it is really open
+    for (const Frame& frame : frames_)
+        {
+            if (!out.empty() && static_cast<i32>(sp) >= frame.return_sp)
+                break;
+            out.push_back(frame.routine);
+        }
+
+    // Likewise a JSR that has run has not pushed the callee's frame yet
+    if (call_pending_ && static_cast<i32>(sp) < call_sp_)
+        out.push_back(pc);
+}
+
+std::vector<RoutineProfile> CallGraphProfiler::routines() const
+{
+    std::vector<RoutineProfile> result;
+    for (std::size_t address = 0; address < totals_.size(); ++address)
+        {
+            const Totals& totals = totals_[address];
+            if (totals.calls != 0)
+                result.push_back({static_cast<u16>(address), totals.calls, totals.inclusive,
+                                  totals.exclusive});
+        }
+
+    std::ranges::stable_sort(result, [](const RoutineProfile& lhs, const RoutineProfile& rhs)
+                             { return lhs.inclusive_cycles > rhs.inclusive_cycles; });
+    return result;
+}
+
+void CallGraphProfiler::write_report(std::ostream& out, const SymbolTable& symbols) const
+{
+    const auto profiles = routines();
+
+    u64 total = 0;
+    for (const RoutineProfile& profile : profiles)
+        total += profile.exclusive_cycles;
+
+    const auto percent = [total](u64 cycles)
+    { return total == 0 ? 0.0 : 100.0 * static_cast<double>(cycles) / static_cast<double>(total); };
+
+    out << std::format("{:>8}  {:>12}  {:>6}  {:>12}  {:>6}  {}\n", "calls", "inclusive", "%",
+                       "exclusive", "%", "routine");
+    for (const RoutineProfile& profile : profiles)
+        {
+            out << std::format("{:>8}  {:>12}  {:>6.2f}  {:>12}  {:>6.2f}  {}\n", profile.calls,
+                               profile.inclusive_cycles, percent(profile.inclusive_cycles),
+                               profile.exclusive_cycles, percent(profile.exclusive_cycles),
+                               symbols.describe(profile.address));
+        }
+}
+
+void CallGraphProfiler::push(u16 routine, i32 return_sp, u64 start_cycles) noexcept
+{
+    Totals& totals = totals_[routine];
+    ++totals.calls;
+    ++totals.active;
+    frames_.push_back({routine, return_sp, start_cycles, 0});
+}
+
+void CallGraphProfiler::pop(u64 end_cycles) noexcept
+{
+    const Frame frame = frames_.back();
+    frames_.pop_back();
+
+    Totals& totals = totals_[frame.routine];
+    totals.exclusive += frame.exclusive;
+    if (--totals.active == 0)
+        totals.inclusive += end_cycles - frame.start_cycles;
+}
+
+}  // namespace cpu6502
@@ -0,0 +1,210 @@
+#include "cpu6502/coverage.hpp"
+#include <format>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace cpu6502
+{
+
+namespace
+{
+
+struct BranchCoverage
+{
+    bool taken     = false;
+    bool not_taken = false;
+};
+
+struct LineCoverage
+{
+    bool                        hit = false;
+    std::vector<BranchCoverage> branches;
+};
+
+using FileCoverage = std::map<u32, LineCoverage>;  // By line number
+
+// Folds the address-level bitmaps into per-file, per-line results
+[[nodiscard]] auto collect(const CoverageMap& coverage, const LineTable& lines,
+                           const Memory& memory) -> std::vector<FileCoverage>
+{
+    std::vector<FileCoverage> files(lines.files().size());
+
+    for (const LineRange& range : lines.ranges())
+        {
+            LineCoverage& line = files[range.file][range.line];
+            for (u32 offset = 0; offset < range.size; ++offset)
+                {
+                    if (coverage.executed(static_cast<u16>(range.address + offset)))
+                        line.hit = true;
+                }
+
+            // Each range starts with an instruction; only that one is checked for a branch.
+            // peek() so a breakpoint on it does not hide the branch.
+            if (range.size >= 2 && is_branch(memory.peek(range.address)))
+                line.branches.push_back(
+                    {coverage.taken(range.address), coverage.not_taken(range.address)});
+        }
+
+    return files;
+}
+
+[[nodiscard]] std::string xml_escape(std::string_view text)
+{
+    std::string escaped;
+    for (const char c : text)
+        {
+            switch (c)
+                {
+                    case '&':
+                        escaped += "&amp;";
+                        break;
+                    case '<':
+                        escaped += "&lt;";
+                        break;
+                    case '>':
+                        escaped += "&gt;";
+                        break;
+                    case '"':
+                        escaped += "&quot;";
+                        break;
+                    default:
+                        escaped += c;
+                }
+        }
+    return escaped;
+}
+
+[[nodiscard]] double rate(std::size_t covered, std::size_t valid) noexcept
+{
+    return valid == 0 ? 1.0 : static_cast<double>(covered) / static_cast<double>(valid);
+}
+
+}  // namespace
+
+void write_lcov(std::ostream& out, const CoverageMap& coverage, const LineTable& lines,
+                const Memory& memory, std::string_view test_name)
+{
+    const auto files = collect(coverage, lines, memory);
+
+    for (std::size_t file = 0; file < files.size(); ++file)
+        {
+            if (files[file].empty())
+                continue;
+
+            out << "TN:" << test_name << '\n';
+            out << "SF:" << lines.files()[file] << '\n';
+
+            std::size_t lines_hit = 0, branches_found = 0, branches_hit = 0;
+            for (const auto& [number, line] : files[file])
+                {
+                    for (std::size_t block = 0; block < line.branches.size(); ++block)
+                        {
+                            const BranchCoverage& branch = line.branches[block];
+                            const bool            sides[] = {branch.taken, branch.not_taken};
+                            for (std::size_t side = 0; side < 2; ++side)
+                                {
+                                    out << std::format("BRDA:{},{},{},{}\n", number, block, side,
+                                                       line.hit ? (sides[side] ? "1" : "0") : "-");
+                                    branches_hit += sides[side] ? 1 : 0;
+                                }
+                            branches_found += 2;
+                        }
+                    out << std::format("DA:{},{}\n", number, line.hit ? 1 : 0);
+                    lines_hit += line.hit ? 1 : 0;
+                }
+
+            out << std::format("BRF:{}\nBRH:{}\n", branches_found, branches_hit);
+            out << std::format("LF:{}\nLH:{}\n", files[file].size(), lines_hit);
+            out << "end_of_record\n";
+        }
+}
+
+void write_cobertura(std::ostream& out, const CoverageMap& coverage, const LineTable& lines,
+                     const Memory& memory)
+{
+    const auto files = collect(coverage, lines, memory);
+
+    struct Totals
+    {
+        std::size_t lines_valid = 0, lines_covered = 0, branches_valid = 0, branches_covered = 0;
+    };
+
+    std::vector<Totals> per_file(files.size());
+    Totals              all;
+    for (std::size_t file = 0; file < files.size(); ++file)
+        {
+            for (const auto& [number, line] : files[file])
+                {
+                    ++per_file[file].lines_valid;
+                    per_file[file].lines_covered += line.hit ? 1 : 0;
+                    for (const BranchCoverage& branch : line.branches)
+                        {
+                            per_file[file].branches_valid += 2;
+                            per_file[file].branches_covered +=
+                                (branch.taken ? 1u : 0u) + (branch.not_taken ? 1u : 0u);
+                        }
+                }
+            all.lines_valid += per_file[file].lines_valid;
+            all.lines_covered += per_file[file].lines_covered;
+            all.branches_valid += per_file[file].branches_valid;
+            all.branches_covered += per_file[file].branches_covered;
+        }
+
+    const double line_rate   = rate(all.lines_covered, all.lines_valid);
+    const double branch_rate = rate(all.branches_covered, all.branches_valid);
+
+    out << "<?xml version=\"1.0\" ?>\n";
+    out << std::format("<coverage line-rate=\"{:.4f}\" branch-rate=\"{:.4f}\" lines-covered=\"{}\" "
+                       "lines-valid=\"{}\" branches-covered=\"{}\" branches-valid=\"{}\" "
+                       "complexity=\"0\" version=\"1\" timestamp=\"0\">\n",
+                       line_rate, branch_rate, all.lines_covered, all.lines_valid,
+                       all.branches_covered, all.branches_valid);
+    out << "  <packages>\n";
+    out << std::format("    <package name=\"6502\" line-rate=\"{:.4f}\" branch-rate=\"{:.4f}\" "
+                       "complexity=\"0\">\n",
+                       line_rate, branch_rate);
+    out << "      <classes>\n";
+
+    for (std::size_t file = 0; file < files.size(); ++file)
+        {
+            if (files[file].empty())
+                continue;
+
+            const Totals& totals = per_file[file];
+            out << std::format("        <class name=\"{0}\" filename=\"{0}\" line-rate=\"{1:.4f}\" "
+                               "branch-rate=\"{2:.4f}\" complexity=\"0\">\n",
+                               xml_escape(lines.files()[file]),
+                               rate(totals.lines_covered, totals.lines_valid),
+                               rate(totals.branches_covered, totals.branches_valid));
+            out << "          <methods/>\n          <lines>\n";
+
+            for (const auto& [number, line] : files[file])
+                {
+                    out << std::format("            <line number=\"{}\" hits=\"{}\"", number,
+                                       line.hit ? 1 : 0);
+                    if (!line.branches.empty())
+                        {
+                            std::size_t covered = 0;
+                            for (const BranchCoverage& branch : line.branches)
+                                covered += (branch.taken ? 1u : 0u) + (branch.not_taken ? 1u : 0u);
+
+                            const std::size_t valid = 2 * line.branches.size();
+                            out << std::format(" branch=\"true\" "
+                                               "condition-coverage=\"{}% ({}/{})\"",
+                                               100 * covered / valid, covered, valid);
+                        }
+                    else
+                        {
+                            out << " branch=\"false\"";
+                        }
+                    out << "/>\n";
+                }
+
+            out << "          </lines>\n        </class>\n";
+        }
+
+    out << "      </classes>\n    </package>\n  </packages>\n</coverage>\n";
+}
+
+}  // namespace cpu6502
@@ -1,354 +1,528 @@
-#include "cpu6502/cpu.hpp"
-#include <print>
-#include "cpu6502/opcodes.hpp"
-
-namespace cpu6502
-{
-
-[[nodiscard]] auto CPU::execute(i32 cycles, Memory& memory) -> std::expected<i32, EmulatorError>
-{
-    const i32 cycles_requested = cycles;
-
-    while (cycles > 0)
-        {
-            auto result = fetch_and_execute(cycles, memory);
-            if (!result)
-                {
-                    return std::unexpected(result.error());
-                }
-        }
-
-    return cycles_requested - cycles;
-}
-
-constexpr auto CPU::fetch_and_execute(i32& cycles, Memory& memory)
-    -> std::expected<void, EmulatorError>
-{
-    std::println("DEBUG: About to fetch from PC = 0x{:04X}", pc_);
-
-    auto ins_result = fetch_byte(cycles, memory);
-    if (!ins_result)
-        return std::unexpected(ins_result.error());
-
-    const auto opcode = static_cast<Opcode>(ins_result.value());
-    std::println("DEBUG: Fetched opcode = 0x{:02X}", static_cast<u8>(opcode));
-    switch (opcode)
-        {
-                // Load Accumulator
-
-            case Opcode::LDA_IM:
-                return execute_lda_immediate(cycles, memory);
-
-            case Opcode::LDA_ZP:
-                return execute_lda_zero_page(cycles, memory);
-
-            case Opcode::LDA_ZPX:
-                return execute_lda_zero_page_x(cycles, memory);
-
-            case Opcode::LDA_ABS:
-                return execute_lda_absolute(cycles, memory);
-
-            case Opcode::LDA_ABSX:
-                return execute_lda_absolute_x(cycles, memory);
-
-            case Opcode::LDA_ABSY:
-                return execute_lda_absolute_y(cycles, memory);
-                /*
-                case Opcode::INDX:
-                    return execute_lda_indirect_x(cycles, memory);
-
-                case Opcode::INDY:
-                    return execute_lda_indirect_y(cycles, memory);
-                */
-
-                // Load X Register
-
-            case Opcode::LDX_IM:
-                return execute_ldx_immediate(cycles, memory);
-
-            case Opcode::LDX_ZP:
-                return execute_ldx_zero_page(cycles, memory);
-
-            case Opcode::LDX_ZPY:
-                return execute_ldx_zero_page_y(cycles, memory);
-
-            case Opcode::LDX_ABS:
-                return execute_ldx_absolute(cycles, memory);
-
-            case Opcode::LDX_ABSY:
-                return execute_ldx_absolute_y(cycles, memory);
-
-                // Load Y Register
-
-            case Opcode::LDY_IM:
-                return execute_ldy_immediate(cycles, memory);
-
-            case Opcode::LDY_ZP:
-                return execute_ldy_zero_page(cycles, memory);
-
-            case Opcode::LDY_ZPX:
-                return execute_ldy_zero_page_x(cycles, memory);
-
-            case Opcode::LDY_ABS:
-                return execute_ldy_absolute(cycles, memory);
-
-            case Opcode::LDY_ABSX:
-                return execute_ldy_absolute_x(cycles, memory);
-
-                // Add With Carry
-
-            case Opcode::ADC_IM:
-                return execute_adc_immediate(cycles, memory);
-
-            case Opcode::ADC_ZP:
-                return execute_adc_zero_page(cycles, memory);
-
-            case Opcode::ADC_ZPX:
-                return execute_adc_zero_page_x(cycles, memory);
-
-            case Opcode::ADC_ABS:
-                return execute_adc_absolute(cycles, memory);
-
-            case Opcode::ADC_ABSX:
-                return execute_adc_absolute_x(cycles, memory);
-
-            case Opcode::ADC_ABSY:
-                return execute_adc_absolute_y(cycles, memory);
-
-            case Opcode::ADC_INDX:
-                return execute_adc_indirect_x(cycles, memory);
-
-            case Opcode::ADC_INDY:
-                return execute_adc_indirect_y(cycles, memory);
-
-                // Logical AND
-
-            case Opcode::AND_IM:
-                return execute_and_immediate(cycles, memory);
-
-            case Opcode::AND_ZP:
-                return execute_and_zero_page(cycles, memory);
-
-            case Opcode::AND_ZPX:
-                return execute_and_zero_page_x(cycles, memory);
-
-            case Opcode::AND_ABS:
-                return execute_and_absolute(cycles, memory);
-
-            case Opcode::AND_ABSX:
-                return execute_and_absolute_x(cycles, memory);
-
-            case Opcode::AND_ABSY:
-                return execute_and_absolute_y(cycles, memory);
-
-            case Opcode::AND_INDX:
-                return execute_and_indirect_x(cycles, memory);
-
-            case Opcode::AND_INDY:
-                return execute_and_indirect_y(cycles, memory);
-
-                // Exclusive OR
-
-            case Opcode::EOR_IM:
-                return execute_eor_immediate(cycles, memory);
-
-            case Opcode::EOR_ZP:
-                return execute_eor_zero_page(cycles, memory);
-
-            case Opcode::EOR_ZPX:
-                return execute_eor_zero_page_x(cycles, memory);
-
-            case Opcode::EOR_ABS:
-                return execute_eor_absolute(cycles, memory);
-
-            case Opcode::EOR_ABSX:
-                return execute_eor_absolute_x(cycles, memory);
-
-            case Opcode::EOR_ABSY:
-                return execute_eor_absolute_y(cycles, memory);
-
-            case Opcode::EOR_INDX:
-                return execute_eor_indirect_x(cycles, memory);
-
-            case Opcode::EOR_INDY:
-                return execute_eor_indirect_y(cycles, memory);
-
-                // ASL - Arithmetic Shift Left
-
-            case Opcode::ASL_A:
-                return execute_shift_left_accumulator(cycles);
-
-            case Opcode::ASL_ZP:
-                return execute_shift_left_zero_page(cycles, memory);
-
-            case Opcode::ASL_ZPX:
-                return execute_shift_left_zero_page_x(cycles, memory);
-
-            case Opcode::ASL_ABS:
-                return execute_shift_left_absolute(cycles, memory);
-
-            case Opcode::ASL_ABSX:
-                return execute_shift_left_absolute_x(cycles, memory);
-
-                // Clear Flags
-
-            case Opcode::CLC:
-                return clear_carry_flag(cycles);
-
-            case Opcode::CLD:
-                return clear_decimal_mode(cycles);
-
-            case Opcode::CLI:
-                return clear_interrupt_disable(cycles);
-
-            case Opcode::CLV:
-                return clear_overflow_flag(cycles);
-
-            // Branch Instructions
-            case Opcode::BCC:
-                return execute_bcc(cycles, memory);
-
-            case Opcode::BCS:
-                return execute_bcs(cycles, memory);
-
-            case Opcode::BEQ:
-                return execute_beq(cycles, memory);
-
-            case Opcode::BIT_ZP:
-                return execute_bit_zero_page(cycles, memory);
-
-            case Opcode::BIT_ABS:
-                return execute_bit_absolute(cycles, memory);
-
-            case Opcode::BMI:
-                return execute_bmi(cycles, memory);
-
-            case Opcode::BNE:
-                return execute_bne(cycles, memory);
-
-            case Opcode::BPL:
-                return execute_bpl(cycles, memory);
-
-            case Opcode::BRK:
-                return execute_brk(cycles, memory);
-
-            case Opcode::BVC:
-                return execute_bvc(cycles, memory);
-
-            case Opcode::BVS:
-                return execute_bvs(cycles, memory);
-
-                // Comparision Instructions
-                // CMP - Compare
-
-            case Opcode::CMP_IM:
-                return execute_cmp_immediate(cycles, memory);
-
-            case Opcode::CMP_ZP:
-                return execute_cmp_zero_page(cycles, memory);
-
-            case Opcode::CMP_ZPX:
-                return execute_cmp_zero_page_x(cycles, memory);
-
-            case Opcode::CMP_ABS:
-                return execute_cmp_absolute(cycles, memory);
-
-            case Opcode::CMP_ABSX:
-                return execute_cmp_absolute_x(cycles, memory);
-
-            case Opcode::CMP_ABSY:
-                return execute_cmp_absolute_y(cycles, memory);
-
-            case Opcode::CMP_INDX:
-                return execute_cmp_indirect_x(cycles, memory);
-
-            case Opcode::CMP_INDY:
-                return execute_cmp_indirect_y(cycles, memory);
-
-                // CPX - Compare X Register
-
-            case Opcode::CPX_IM:
-                return execute_cpx_immediate(cycles, memory);
-
-            case Opcode::CPX_ZP:
-                return execute_cpx_zero_page(cycles, memory);
-
-            case Opcode::CPX_ABS:
-                return execute_cpx_absolute(cycles, memory);
-
-                // CPY - Compare Y Register
-
-            case Opcode::CPY_IM:
-                return execute_cpy_immediate(cycles, memory);
-
-            case Opcode::CPY_ZP:
-                return execute_cpy_zero_page(cycles, memory);
-
-            case Opcode::CPY_ABS:
-                return execute_cpy_absolute(cycles, memory);
-
-            // Add these cases in the switch(opcode) block in fetch_and_execute():
-
-            // INC - Increment Memory
-            case Opcode::INC_ZP:
-                return execute_inc_zero_page(cycles, memory);
-
-            case Opcode::INC_ZPX:
-                return execute_inc_zero_page_x(cycles, memory);
-
-            case Opcode::INC_ABS:
-                return execute_inc_absolute(cycles, memory);
-
-            case Opcode::INC_ABSX:
-                return execute_inc_absolute_x(cycles, memory);
-
-            // DEC - Decrement Memory
-            case Opcode::DEC_ZP:
-                return execute_dec_zero_page(cycles, memory);
-
-            case Opcode::DEC_ZPX:
-                return execute_dec_zero_page_x(cycles, memory);
-
-            case Opcode::DEC_ABS:
-                return execute_dec_absolute(cycles, memory);
-
-            case Opcode::DEC_ABSX:
-                return execute_dec_absolute_x(cycles, memory);
-
-            // INX - Increment X Register
-            case Opcode::INX:
-                return inc_x_register(cycles);
-
-            // INY - Increment Y Register
-            case Opcode::INY:
-                return inc_y_register(cycles);
-
-            // DEX - Decrement X Register
-            case Opcode::DEX:
-                return dec_x_register(cycles);
-
-            // DEY - Decrement Y Register
-            case Opcode::DEY:
-                return dec_y_register(cycles);
-
-                // Control Flow Instructions
-
-            case Opcode::JSR:
-                return execute_jsr(cycles, memory);
-
-            case Opcode::RTS:
-                return execute_rts(cycles, memory);
-            /*
-            case Opcode::JMP_ABS:
-                return execute_jmp_absolute(cycles, memory);
-
-            case Opcode::JMP_IND:
-                return execute_jmp_indirect(cycles, memory);
-            */
-            default:
-                std::println("Unhandled opcode: 0x{:02X}", static_cast<u8>(opcode));
-                return std::unexpected(EmulatorError::InvalidOpcode);
-        }
-}
-
-}  // namespace cpu6502
+#include "cpu6502/cpu.hpp"
+#include <print>
+#include "cpu6502/coverage.hpp"
+#include "cpu6502/opcodes.hpp"
+
+namespace cpu6502
+{
+
+[[nodiscard]] auto CPU::execute(i32 cycles, Memory& memory) -> std::expected<i32, EmulatorError>
+{
+    const i32 cycles_requested = cycles;
+
+    while (cycles > 0)
+        {
+            const i32 before = cycles;
+            if (interrupt_pending())
+                {
+                    if (observer_ != nullptr)
+                        notify_interrupt();
+
+                    auto serviced = service_interrupt(cycles, memory);
+                    if (!serviced)
+                        return std::unexpected(serviced.error());
+
+                    cycles_ += static_cast<u64>(before - cycles);
+                    continue;
+                }
+
+            if (observer_ != nullptr)
+                notify(memory);
+
+            auto result = fetch_and_execute(cycles, memory);
+            if (!result)
+                {
+                    return std::unexpected(result.error());
+                }
+            cycles_ += static_cast<u64>(before - cycles);
+        }
+
+    return cycles_requested - cycles;
+}
+
+[[nodiscard]] auto CPU::step(Memory& memory) -> std::expected<i32, EmulatorError>
+{
+    i32 cycles = 0;
+
+    // A pending interrupt takes the place of the next instruction
+    if (interrupt_pending())
+        {
+            if (observer_ != nullptr)
+                notify_interrupt();
+
+            auto serviced = service_interrupt(cycles, memory);
+            if (!serviced)
+                return std::unexpected(serviced.error());
+
+            cycles_ += static_cast<u64>(-cycles);
+            return -cycles;
+        }
+
+    if (observer_ != nullptr)
+        notify(memory);
+
+    // Stepping is how a debugger leaves a breakpoint, so run what the trap replaced
+    auto result = fetch_and_execute(cycles, memory);
+    if (!result && result.error() == EmulatorError::BreakpointTrap)
+        result = execute_trapped(cycles, memory);
+    if (!result)
+        return std::unexpected(result.error());
+
+    cycles_ += static_cast<u64>(-cycles);
+    return -cycles;
+}
+
+[[nodiscard]] auto CPU::run(const StopCondition& stop, Memory& memory)
+    -> std::expected<RunResult, EmulatorError>
+{
+    RunResult run_result{};
+
+    while (run_result.cycles < stop.max_cycles)
+        {
+            if (interrupt_pending())
+                {
+                    if (observer_ != nullptr)
+                        notify_interrupt();
+
+                    i32  cycles   = 0;
+                    auto serviced = service_interrupt(cycles, memory);
+                    if (!serviced)
+                        return std::unexpected(serviced.error());
+
+                    cycles_ += static_cast<u64>(-cycles);
+                    run_result.cycles += static_cast<u64>(-cycles);
+                    continue;
+                }
+
+            if (stop.stop_pc && pc_ == *stop.stop_pc)
+                {
+                    run_result.reason = StopReason::StopPc;
+                    return run_result;
+                }
+
+            if (stop.stop_on_brk && memory.peek(pc_) == static_cast<u8>(Opcode::BRK))
+                {
+                    run_result.reason = StopReason::Brk;
+                    return run_result;
+                }
+
+            if (observer_ != nullptr)
+                notify(memory);
+
+            i32  cycles = 0;
+            auto result = fetch_and_execute(cycles, memory);
+            if (!result && result.error() == EmulatorError::BreakpointTrap)
+                {
+                    run_result.reason = StopReason::Breakpoint;
+                    return run_result;
+                }
+            if (!result)
+                return std::unexpected(result.error());
+
+            cycles_ += static_cast<u64>(-cycles);
+            run_result.cycles += static_cast<u64>(-cycles);
+            run_result.instructions++;
+        }
+
+    run_result.reason = StopReason::CycleLimit;
+    return run_result;
+}
+
+void CPU::notify(const Memory& memory) const noexcept
+{
+    observer_->on_instruction(
+        TraceRecord{cycles_, pc_, memory.peek(pc_), a_, x_, y_, sp_, flags_.to_byte()});
+}
+
+void CPU::notify_interrupt() const noexcept
+{
+    observer_->on_interrupt(TraceRecord{cycles_, pc_, 0, a_, x_, y_, sp_, flags_.to_byte()},
+                            nmi_pending_ ? InterruptKind::Nmi : InterruptKind::Irq);
+}
+
+constexpr auto CPU::fetch_and_execute(i32& cycles, Memory& memory)
+    -> std::expected<void, EmulatorError>
+{
+#ifdef CPU6502_DEBUG
+    std::println("DEBUG: About to fetch from PC = 0x{:04X}", pc_);
+#endif
+
+    const i32 start     = cycles;
+    const u16 opcode_pc = pc_;
+
+    auto ins_result = fetch_opcode(memory);
+    if (!ins_result)
+        return std::unexpected(ins_result.error());
+
+    const auto opcode = static_cast<Opcode>(ins_result.value());
+#ifdef CPU6502_DEBUG
+    std::println("DEBUG: Fetched opcode = 0x{:02X}", static_cast<u8>(opcode));
+#endif
+
+    // Base cycles come from the ISA table; handlers only add page and branch penalties
+    cycles -= opcode_info(ins_result.value()).cycles;
+
+    auto result = execute_opcode(opcode, cycles, memory);
+    if (result)
+        {
+            stats_.record_instruction(static_cast<u8>(opcode), start - cycles);
+            if (coverage_ != nullptr)
+                coverage_->record(opcode_pc, static_cast<u8>(opcode), pc_);
+        }
+
+    return result;
+}
+
+constexpr auto CPU::execute_trapped(i32& cycles, Memory& memory)
+    -> std::expected<void, EmulatorError>
+{
+    const i32 start     = cycles;
+    const u16 opcode_pc = pc_;
+    const u8  original  = memory.peek(pc_);
+
+    pc_++;
+    cycles -= opcode_info(original).cycles;
+
+    auto result = execute_opcode(static_cast<Opcode>(original), cycles, memory);
+    if (result)
+        {
+            stats_.record_instruction(original, start - cycles);
+            if (coverage_ != nullptr)
+                coverage_->record(opcode_pc, original, pc_);
+        }
+
+    return result;
+}
+
+constexpr auto CPU::execute_opcode(Opcode opcode, i32& cycles, Memory& memory)
+    -> std::expected<void, EmulatorError>
+{
+    switch (opcode)
+        {
+                // Load Accumulator
+
+            case Opcode::LDA_IM:
+                return execute_lda_immediate(memory);
+
+            case Opcode::LDA_ZP:
+                return execute_lda_zero_page(memory);
+
+            case Opcode::LDA_ZPX:
+                return execute_lda_zero_page_x(memory);
+
+            case Opcode::LDA_ABS:
+                return execute_lda_absolute(memory);
+
+            case Opcode::LDA_ABSX:
+                return execute_lda_absolute_x(cycles, memory);
+
+            case Opcode::LDA_ABSY:
+                return execute_lda_absolute_y(cycles, memory);
+                /*
+                case Opcode::INDX:
+                    return execute_lda_indirect_x(cycles, memory);
+
+                case Opcode::INDY:
+                    return execute_lda_indirect_y(cycles, memory);
+                */
+
+                // Load X Register
+
+            case Opcode::LDX_IM:
+                return execute_ldx_immediate(memory);
+
+            case Opcode::LDX_ZP:
+                return execute_ldx_zero_page(memory);
+
+            case Opcode::LDX_ZPY:
+                return execute_ldx_zero_page_y(memory);
+
+            case Opcode::LDX_ABS:
+                return execute_ldx_absolute(memory);
+
+            case Opcode::LDX_ABSY:
+                return execute_ldx_absolute_y(cycles, memory);
+
+                // Load Y Register
+
+            case Opcode::LDY_IM:
+                return execute_ldy_immediate(memory);
+
+            case Opcode::LDY_ZP:
+                return execute_ldy_zero_page(memory);
+
+            case Opcode::LDY_ZPX:
+                return execute_ldy_zero_page_x(memory);
+
+            case Opcode::LDY_ABS:
+                return execute_ldy_absolute(memory);
+
+            case Opcode::LDY_ABSX:
+                return execute_ldy_absolute_x(cycles, memory);
+
+                // Add With Carry
+
+            case Opcode::ADC_IM:
+                return execute_adc_immediate(memory);
+
+            case Opcode::ADC_ZP:
+                return execute_adc_zero_page(memory);
+
+            case Opcode::ADC_ZPX:
+                return execute_adc_zero_page_x(memory);
+
+            case Opcode::ADC_ABS:
+                return execute_adc_absolute(memory);
+
+            case Opcode::ADC_ABSX:
+                return execute_adc_absolute_x(cycles, memory);
+
+            case Opcode::ADC_ABSY:
+                return execute_adc_absolute_y(cycles, memory);
+
+            case Opcode::ADC_INDX:
+                return execute_adc_indirect_x(memory);
+
+            case Opcode::ADC_INDY:
+                return execute_adc_indirect_y(cycles, memory);
+
+                // Logical AND
+
+            case Opcode::AND_IM:
+                return execute_and_immediate(memory);
+
+            case Opcode::AND_ZP:
+                return execute_and_zero_page(memory);
+
+            case Opcode::AND_ZPX:
+                return execute_and_zero_page_x(memory);
+
+            case Opcode::AND_ABS:
+                return execute_and_absolute(memory);
+
+            case Opcode::AND_ABSX:
+                return execute_and_absolute_x(cycles, memory);
+
+            case Opcode::AND_ABSY:
+                return execute_and_absolute_y(cycles, memory);
+
+            case Opcode::AND_INDX:
+                return execute_and_indirect_x(memory);
+
+            case Opcode::AND_INDY:
+                return execute_and_indirect_y(cycles, memory);
+
+                // Exclusive OR
+
+            case Opcode::EOR_IM:
+                return execute_eor_immediate(memory);
+
+            case Opcode::EOR_ZP:
+                return execute_eor_zero_page(memory);
+
+            case Opcode::EOR_ZPX:
+                return execute_eor_zero_page_x(memory);
+
+            case Opcode::EOR_ABS:
+                return execute_eor_absolute(memory);
+
+            case Opcode::EOR_ABSX:
+                return execute_eor_absolute_x(cycles, memory);
+
+            case Opcode::EOR_ABSY:
+                return execute_eor_absolute_y(cycles, memory);
+
+            case Opcode::EOR_INDX:
+                return execute_eor_indirect_x(memory);
+
+            case Opcode::EOR_INDY:
+                return execute_eor_indirect_y(cycles, memory);
+
+                // ASL - Arithmetic Shift Left
+
+            case Opcode::ASL_A:
+                return execute_shift_left_accumulator();
+
+            case Opcode::ASL_ZP:
+                return execute_shift_left_zero_page(memory);
+
+            case Opcode::ASL_ZPX:
+                return execute_shift_left_zero_page_x(memory);
+
+            case Opcode::ASL_ABS:
+                return execute_shift_left_absolute(memory);
+
+            case Opcode::ASL_ABSX:
+                return execute_shift_left_absolute_x(memory);
+
+                // Clear Flags
+
+            case Opcode::CLC:
+                return clear_carry_flag();
+
+            case Opcode::CLD:
+                return clear_decimal_mode();
+
+            case Opcode::CLI:
+                return clear_interrupt_disable();
+
+            case Opcode::CLV:
+                return clear_overflow_flag();
+
+            // Branch Instructions
+            case Opcode::BCC:
+                return execute_bcc(cycles, memory);
+
+            case Opcode::BCS:
+                return execute_bcs(cycles, memory);
+
+            case Opcode::BEQ:
+                return execute_beq(cycles, memory);
+
+            case Opcode::BIT_ZP:
+                return execute_bit_zero_page(memory);
+
+            case Opcode::BIT_ABS:
+                return execute_bit_absolute(memory);
+
+            case Opcode::BMI:
+                return execute_bmi(cycles, memory);
+
+            case Opcode::BNE:
+                return execute_bne(cycles, memory);
+
+            case Opcode::BPL:
+                return execute_bpl(cycles, memory);
+
+            case Opcode::BRK:
+                return execute_brk(memory);
+
+            case Opcode::BVC:
+                return execute_bvc(cycles, memory);
+
+            case Opcode::BVS:
+                return execute_bvs(cycles, memory);
+
+                // Comparision Instructions
+                // CMP - Compare
+
+            case Opcode::CMP_IM:
+                return execute_cmp_immediate(memory);
+
+            case Opcode::CMP_ZP:
+                return execute_cmp_zero_page(memory);
+
+            case Opcode::CMP_ZPX:
+                return execute_cmp_zero_page_x(memory);
+
+            case Opcode::CMP_ABS:
+                return execute_cmp_absolute(memory);
+
+            case Opcode::CMP_ABSX:
+                return execute_cmp_absolute_x(cycles, memory);
+
+            case Opcode::CMP_ABSY:
+                return execute_cmp_absolute_y(cycles, memory);
+
+            case Opcode::CMP_INDX:
+                return execute_cmp_indirect_x(memory);
+
+            case Opcode::CMP_INDY:
+                return execute_cmp_indirect_y(cycles, memory);
+
+                // CPX - Compare X Register
+
+            case Opcode::CPX_IM:
+                return execute_cpx_immediate(memory);
+
+            case Opcode::CPX_ZP:
+                return execute_cpx_zero_page(memory);
+
+            case Opcode::CPX_ABS:
+                return execute_cpx_absolute(memory);
+
+                // CPY - Compare Y Register
+
+            case Opcode::CPY_IM:
+                return execute_cpy_immediate(memory);
+
+            case Opcode::CPY_ZP:
+                return execute_cpy_zero_page(memory);
+
+            case Opcode::CPY_ABS:
+                return execute_cpy_absolute(memory);
+
+            // Add these cases in the switch(opcode) block in fetch_and_execute():
+
+            // INC - Increment Memory
+            case Opcode::INC_ZP:
+                return execute_inc_zero_page(memory);
+
+            case Opcode::INC_ZPX:
+                return execute_inc_zero_page_x(memory);
+
+            case Opcode::INC_ABS:
+                return execute_inc_absolute(memory);
+
+            case Opcode::INC_ABSX:
+                return execute_inc_absolute_x(memory);
+
+            // DEC - Decrement Memory
+            case Opcode::DEC_ZP:
+                return execute_dec_zero_page(memory);
+
+            case Opcode::DEC_ZPX:
+                return execute_dec_zero_page_x(memory);
+
+            case Opcode::DEC_ABS:
+                return execute_dec_absolute(memory);
+
+            case Opcode::DEC_ABSX:
+                return execute_dec_absolute_x(memory);
+
+            // INX - Increment X Register
+            case Opcode::INX:
+                return inc_x_register();
+
+            // INY - Increment Y Register
+            case Opcode::INY:
+                return inc_y_register();
+
+            // DEX - Decrement X Register
+            case Opcode::DEX:
+                return dec_x_register();
+
+            // DEY - Decrement Y Register
+            case Opcode::DEY:
+                return dec_y_register();
+
+                // Control Flow Instructions
+
+            case Opcode::JSR:
+                return execute_jsr(memory);
+
+            case Opcode::RTS:
+                return execute_rts(memory);
+            /*
+            case Opcode::JMP_ABS:
+                return execute_jmp_absolute(cycles, memory);
+
+            case Opcode::JMP_IND:
+                return execute_jmp_indirect(cycles, memory);
+            */
+            default:
+                // Back out of the fetch so PC stays on the breakpoint
+                if (static_cast<u8>(opcode) == Memory::TRAP_OPCODE &&
+                    memory.is_trap(static_cast<u16>(pc_ - 1)))
+                    {
+                        pc_--;
+                        return std::unexpected(EmulatorError::BreakpointTrap);
+                    }
+#ifdef CPU6502_DEBUG
+                std::println("Unhandled opcode: 0x{:02X}", static_cast<u8>(opcode));
+#endif
+                return std::unexpected(EmulatorError::InvalidOpcode);
+        }
+}
+
+}  // namespace cpu6502
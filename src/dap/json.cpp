@@ -0,0 +1,369 @@
+#include "json.hpp"
+#include <charconv>
+#include <cmath>
+#include <format>
+
+namespace dap {
+
+namespace {
+
+const Json NULL_VALUE;
+const Json::Array EMPTY_ARRAY;
+
+class Parser {
+ public:
+    explicit Parser(std::string_view text) : text_(text) {}
+
+    auto document() -> std::optional<Json> {
+        auto value = parse_value(0);
+        skip_space();
+        if (!value || pos_ != text_.size()) {
+            return std::nullopt;
+        }
+        return value;
+    }
+
+ private:
+    static constexpr int MAX_DEPTH = 64;
+
+    std::string_view text_;
+    std::size_t      pos_ = 0;
+
+    void skip_space() {
+        while (pos_ < text_.size() &&
+               (text_[pos_] == ' ' || text_[pos_] == '\t' || text_[pos_] == '\n' ||
+                text_[pos_] == '\r')) {
+            ++pos_;
+        }
+    }
+
+    auto consume(std::string_view token) -> bool {
+        if (text_.substr(pos_).starts_with(token)) {
+            pos_ += token.size();
+            return true;
+        }
+        return false;
+    }
+
+    auto parse_value(int depth) -> std::optional<Json> {
+        skip_space();
+        if (pos_ >= text_.size() || depth > MAX_DEPTH) {
+            return std::nullopt;
+        }
+
+        switch (text_[pos_]) {
+            case '{':
+                return parse_object(depth);
+            case '[':
+                return parse_array(depth);
+            case '"': {
+                auto text = parse_string();
+                if (!text) {
+                    return std::nullopt;
+                }
+                return Json(std::move(*text));
+            }
+            case 't':
+                return consume("true") ? std::optional<Json>(true) : std::nullopt;
+            case 'f':
+                return consume("false") ? std::optional<Json>(false) : std::nullopt;
+            case 'n':
+                return consume("null") ? std::optional<Json>(nullptr) : std::nullopt;
+            default:
+                return parse_number();
+        }
+    }
+
+    auto parse_number() -> std::optional<Json> {
+        double     value = 0.0;
+        const auto begin = text_.data() + pos_;
+        const auto [end, error] =
+            std::from_chars(begin, text_.data() + text_.size(), value, std::chars_format::general);
+        if (error != std::errc{} || end == begin) {
+            return std::nullopt;
+        }
+        pos_ += static_cast<std::size_t>(end - begin);
+        return Json(value);
+    }
+
+    auto parse_hex4() -> std::optional<unsigned> {
+        unsigned   value = 0;
+        const auto begin = text_.data() + pos_;
+        if (text_.size() - pos_ < 4) {
+            return std::nullopt;
+        }
+        const auto [end, error] = std::from_chars(begin, begin + 4, value, 16);
+        if (error != std::errc{} || end != begin + 4) {
+            return std::nullopt;
+        }
+        pos_ += 4;
+        return value;
+    }
+
+    static void append_utf8(std::string& out, unsigned code) {
+        if (code < 0x80) {
+            out += static_cast<char>(code);
+        } else if (code < 0x800) {
+            out += static_cast<char>(0xC0 | (code >> 6));
+            out += static_cast<char>(0x80 | (code & 0x3F));
+        } else if (code < 0x10000) {
+            out += static_cast<char>(0xE0 | (code >> 12));
+            out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (code & 0x3F));
+        } else {
+            out += static_cast<char>(0xF0 | (code >> 18));
+            out += static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+            out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (code & 0x3F));
+        }
+    }
+
+    auto parse_string() -> std::optional<std::string> {
+        ++pos_;  // Opening quote
+        std::string out;
+        while (pos_ < text_.size()) {
+            const char c = text_[pos_++];
+            if (c == '"') {
+                return out;
+            }
+            if (c != '\\') {
+                out += c;
+                continue;
+            }
+            if (pos_ >= text_.size()) {
+                return std::nullopt;
+            }
+
+            switch (text_[pos_++]) {
+                case '"':
+                    out += '"';
+                    break;
+                case '\\':
+                    out += '\\';
+                    break;
+                case '/':
+                    out += '/';
+                    break;
+                case 'b':
+                    out += '\b';
+                    break;
+                case 'f':
+                    out += '\f';
+                    break;
+                case 'n':
+                    out += '\n';
+                    break;
+                case 'r':
+                    out += '\r';
+                    break;
+                case 't':
+                    out += '\t';
+                    break;
+                case 'u': {
+                    auto code = parse_hex4();
+                    if (!code) {
+                        return std::nullopt;
+                    }
+                    // A high surrogate followed by its low half is one code point
+                    if (*code >= 0xD800 && *code < 0xDC00 && consume("\\u")) {
+                        auto low = parse_hex4();
+                        if (!low || *low < 0xDC00 || *low >= 0xE000) {
+                            return std::nullopt;
+                        }
+                        *code = 0x10000 + ((*code - 0xD800) << 10) + (*low - 0xDC00);
+                    }
+                    append_utf8(out, *code);
+                    break;
+                }
+                default:
+                    return std::nullopt;
+            }
+        }
+        return std::nullopt;
+    }
+
+    auto parse_array(int depth) -> std::optional<Json> {
+        ++pos_;
+        Json::Array items;
+        skip_space();
+        if (consume("]")) {
+            return Json(std::move(items));
+        }
+        while (true) {
+            auto item = parse_value(depth + 1);
+            if (!item) {
+                return std::nullopt;
+            }
+            items.push_back(std::move(*item));
+            skip_space();
+            if (consume("]")) {
+                return Json(std::move(items));
+            }
+            if (!consume(",")) {
+                return std::nullopt;
+            }
+        }
+    }
+
+    auto parse_object(int depth) -> std::optional<Json> {
+        ++pos_;
+        Json::Object members;
+        skip_space();
+        if (consume("}")) {
+            return Json(std::move(members));
+        }
+        while (true) {
+            skip_space();
+            if (pos_ >= text_.size() || text_[pos_] != '"') {
+                return std::nullopt;
+            }
+            auto key = parse_string();
+            skip_space();
+            if (!key || !consume(":")) {
+                return std::nullopt;
+            }
+            auto value = parse_value(depth + 1);
+            if (!value) {
+                return std::nullopt;
+            }
+            members.emplace_back(std::move(*key), std::move(*value));
+            skip_space();
+            if (consume("}")) {
+                return Json(std::move(members));
+            }
+            if (!consume(",")) {
+                return std::nullopt;
+            }
+        }
+    }
+};
+
+void dump_string(std::string& out, std::string_view text) {
+    out += '"';
+    for (const char c : text) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if (c == '\n') {
+            out += "\\n";
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            out += std::format("\\u{:04x}", static_cast<unsigned>(c));
+        } else {
+            out += c;
+        }
+    }
+    out += '"';
+}
+
+}  // namespace
+
+auto Json::parse(std::string_view text) -> std::optional<Json> {
+    return Parser(text).document();
+}
+
+auto Json::dump() const -> std::string {
+    std::string out;
+    dump(out);
+    return out;
+}
+
+void Json::dump(std::string& out) const {
+    if (is_null()) {
+        out += "null";
+    } else if (const auto* flag = std::get_if<bool>(&value_)) {
+        out += *flag ? "true" : "false";
+    } else if (const auto* number = std::get_if<double>(&value_)) {
+        // Ids, addresses and counters are written without a fraction or exponent
+        constexpr double EXACT_INTEGERS = 9007199254740992.0;  // 2^53
+        if (!std::isfinite(*number)) {
+            out += "null";  // JSON has no NaN or infinity
+        } else if (std::trunc(*number) == *number && std::fabs(*number) < EXACT_INTEGERS) {
+            out += std::format("{}", static_cast<long long>(*number));
+        } else {
+            out += std::format("{}", *number);
+        }
+    } else if (const auto* text = std::get_if<std::string>(&value_)) {
+        dump_string(out, *text);
+    } else if (const auto* array = std::get_if<Array>(&value_)) {
+        out += '[';
+        for (std::size_t i = 0; i < array->size(); ++i) {
+            if (i != 0) {
+                out += ',';
+            }
+            (*array)[i].dump(out);
+        }
+        out += ']';
+    } else if (const auto* object = std::get_if<Object>(&value_)) {
+        out += '{';
+        for (std::size_t i = 0; i < object->size(); ++i) {
+            if (i != 0) {
+                out += ',';
+            }
+            dump_string(out, (*object)[i].first);
+            out += ':';
+            (*object)[i].second.dump(out);
+        }
+        out += '}';
+    }
+}
+
+bool Json::as_bool(bool fallback) const {
+    const auto* flag = std::get_if<bool>(&value_);
+    return flag != nullptr ? *flag : fallback;
+}
+
+double Json::as_number(double fallback) const {
+    const auto* number = std::get_if<double>(&value_);
+    return number != nullptr ? *number : fallback;
+}
+
+std::string_view Json::as_string(std::string_view fallback) const {
+    const auto* text = std::get_if<std::string>(&value_);
+    return text != nullptr ? std::string_view(*text) : fallback;
+}
+
+auto Json::items() const -> const Array& {
+    const auto* array = std::get_if<Array>(&value_);
+    return array != nullptr ? *array : EMPTY_ARRAY;
+}
+
+auto Json::operator[](std::string_view key) const -> const Json& {
+    if (const auto* object = std::get_if<Object>(&value_)) {
+        for (const auto& [name, value] : *object) {
+            if (name == key) {
+                return value;
+            }
+        }
+    }
+    return NULL_VALUE;
+}
+
+auto Json::operator[](std::size_t index) const -> const Json& {
+    const auto& array = items();
+    return index < array.size() ? array[index] : NULL_VALUE;
+}
+
+auto Json::set(std::string key, Json value) -> Json& {
+    if (!is_object()) {
+        value_ = Object{};
+    }
+    auto& object = std::get<Object>(value_);
+    for (auto& [name, member] : object) {
+        if (name == key) {
+            member = std::move(value);
+            return *this;
+        }
+    }
+    object.emplace_back(std::move(key), std::move(value));
+    return *this;
+}
+
+auto Json::push(Json value) -> Json& {
+    if (!is_array()) {
+        value_ = Array{};
+    }
+    std::get<Array>(value_).push_back(std::move(value));
+    return *this;
+}
+
+}  // namespace dap
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace dap {
+
+/**
+ * @type Json class
+ * @brief Just enough JSON for Debug Adapter Protocol messages
+ *
+ * Numbers are doubles, which holds every sequence number, id and 16-bit
+ * address the protocol carries. Objects keep their members in insertion
+ * order. Looking up a missing member or index gives a null value, so request
+ * arguments can be read without checking each level.
+ */
+class Json {
+ public:
+    using Array  = std::vector<Json>;
+    using Object = std::vector<std::pair<std::string, Json>>;
+
+    Json() = default;
+    Json(std::nullptr_t) {}
+    Json(bool value) : value_(value) {}
+    Json(double value) : value_(value) {}
+    Json(const char* value) : value_(std::string(value)) {}
+    Json(std::string value) : value_(std::move(value)) {}
+    Json(std::string_view value) : value_(std::string(value)) {}
+    Json(Array value) : value_(std::move(value)) {}
+    Json(Object value) : value_(std::move(value)) {}
+
+    template <std::integral T>
+        requires(!std::same_as<T, bool>)
+    Json(T value) : value_(static_cast<double>(value)) {}
+
+    // nullopt on malformed input or trailing text
+    [[nodiscard]] static auto parse(std::string_view text) -> std::optional<Json>;
+
+    [[nodiscard]] auto dump() const -> std::string;
+    void               dump(std::string& out) const;
+
+    [[nodiscard]] bool is_null() const { return std::holds_alternative<std::nullptr_t>(value_); }
+    [[nodiscard]] bool is_bool() const { return std::holds_alternative<bool>(value_); }
+    [[nodiscard]] bool is_number() const { return std::holds_alternative<double>(value_); }
+    [[nodiscard]] bool is_string() const { return std::holds_alternative<std::string>(value_); }
+    [[nodiscard]] bool is_array() const { return std::holds_alternative<Array>(value_); }
+    [[nodiscard]] bool is_object() const { return std::holds_alternative<Object>(value_); }
+
+    // Values of another type give the fallback
+    [[nodiscard]] bool             as_bool(bool fallback = false) const;
+    [[nodiscard]] double           as_number(double fallback = 0.0) const;
+    [[nodiscard]] std::string_view as_string(std::string_view fallback = {}) const;
+
+    // Elements of an array; empty for anything else
+    [[nodiscard]] auto items() const -> const Array&;
+
+    [[nodiscard]] auto operator[](std::string_view key) const -> const Json&;
+    [[nodiscard]] auto operator[](std::size_t index) const -> const Json&;
+
+    // Builders. set() turns a null into an object, push() turns a null into an array.
+    auto set(std::string key, Json value) -> Json&;
+    auto push(Json value) -> Json&;
+
+ private:
+    std::variant<std::nullptr_t, bool, double, std::string, Array, Object> value_;
+};
+
+}  // namespace dap
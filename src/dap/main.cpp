@@ -0,0 +1,29 @@
+#include <unistd.h>
+#include "server.hpp"
+#include "transport.hpp"
+
+// Debug Adapter Protocol server for the 6502 core, talking DAP over stdin and
+// stdout. Point an IDE's debug adapter configuration at this binary; the
+// launch request takes:
+//   program      image to load (required)
+//   format       raw, ihex, srec, prg or o65 (default: detected as in 6502emu)
+//   loadAddress  load address of a raw image (default $8000)
+//   pc           start address (default: as in 6502emu)
+//   stopOnEntry  stop before the first instruction (default false)
+//   stopOnBrk    stop before executing BRK (default true)
+//   debugFile    ld65 --dbgfile output, for symbols and source line breakpoints
+//   labels       VICE monitor label file, for symbols
+// Addresses are numbers or strings written as $C000, 0xC000 or decimal.
+//
+// Source line, instruction and function breakpoints (with conditions and hit
+// counts), continue, pause, step in/over/out by instruction, registers and
+// flags, evaluate, readMemory and disassemble are supported. Conditions and
+// watch expressions take registers, [address] and symbols, as in
+// "A == $42 && X > 3 && [$0200] != 0".
+
+int main() {
+    dap::Transport transport(STDIN_FILENO, STDOUT_FILENO);
+    dap::Server    server(transport);
+    server.run();
+    return 0;
+}
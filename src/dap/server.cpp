@@ -0,0 +1,956 @@
+#include "server.hpp"
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <span>
+#include "cpu6502/disassembler.hpp"
+#include "cpu6502/error.hpp"
+#include "cpu6502/expression.hpp"
+#include "cpu6502/loader.hpp"
+#include "cpu6502/opcodes.hpp"
+
+namespace dap {
+
+using namespace cpu6502;
+
+namespace {
+
+constexpr int THREAD_ID = 1;
+constexpr int FRAME_ID  = 1;
+
+// variablesReference values handed out by scopes
+constexpr int REGISTERS_SCOPE = 1;
+constexpr int FLAGS_SCOPE     = 2;
+
+auto hex_reference(u16 address) -> std::string {
+    return std::format("0x{:04X}", address);
+}
+
+// Numbers as they are, strings as "$C000", "0xC000" or decimal
+auto parse_number(const Json& value) -> std::optional<i64> {
+    if (value.is_number()) {
+        return static_cast<i64>(value.as_number());
+    }
+
+    std::string_view text = value.as_string();
+    int              base = 10;
+    if (text.starts_with('$')) {
+        text.remove_prefix(1);
+        base = 16;
+    } else if (text.starts_with("0x") || text.starts_with("0X")) {
+        text.remove_prefix(2);
+        base = 16;
+    }
+
+    i64 number = 0;
+    const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), number, base);
+    if (text.empty() || error != std::errc{} || end != text.data() + text.size()) {
+        return std::nullopt;
+    }
+    return number;
+}
+
+auto to_address(std::optional<i64> number) -> std::optional<u16> {
+    if (!number || *number < 0 || *number > 0xFFFF) {
+        return std::nullopt;
+    }
+    return static_cast<u16>(*number);
+}
+
+auto base64(std::span<const u8> bytes) -> std::string {
+    constexpr std::string_view ALPHABET =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+    std::string out;
+    out.reserve((bytes.size() + 2) / 3 * 4);
+    for (std::size_t i = 0; i < bytes.size(); i += 3) {
+        const std::size_t left = std::min<std::size_t>(3, bytes.size() - i);
+        u32               word = u32{bytes[i]} << 16;
+        if (left > 1) {
+            word |= u32{bytes[i + 1]} << 8;
+        }
+        if (left > 2) {
+            word |= bytes[i + 2];
+        }
+        out += ALPHABET[(word >> 18) & 0x3F];
+        out += ALPHABET[(word >> 12) & 0x3F];
+        out += left > 1 ? ALPHABET[(word >> 6) & 0x3F] : '=';
+        out += left > 2 ? ALPHABET[word & 0x3F] : '=';
+    }
+    return out;
+}
+
+auto read_file(const std::filesystem::path& path) -> std::optional<std::string> {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return std::nullopt;
+    }
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+auto invalid_instruction(u16 address) -> Json {
+    return Json{}
+        .set("address", hex_reference(address))
+        .set("instruction", "??")
+        .set("presentationHint", "invalid");
+}
+
+}  // namespace
+
+void Server::run() {
+    while (!done_) {
+        if (running_ && !transport_.pending()) {
+            run_slice();
+            continue;
+        }
+
+        auto message = transport_.receive();
+        if (!message) {
+            break;
+        }
+        handle(*message);
+    }
+}
+
+void Server::handle(const Json& message) {
+    using Handler = void (Server::*)(const Json&);
+    static constexpr std::array<std::pair<std::string_view, Handler>, 19> HANDLERS{{
+        {"initialize", &Server::initialize},
+        {"launch", &Server::launch},
+        {"setBreakpoints", &Server::set_breakpoints},
+        {"setInstructionBreakpoints", &Server::set_instruction_breakpoints},
+        {"setFunctionBreakpoints", &Server::set_function_breakpoints},
+        {"configurationDone", &Server::configuration_done},
+        {"threads", &Server::threads},
+        {"stackTrace", &Server::stack_trace},
+        {"scopes", &Server::scopes},
+        {"variables", &Server::variables},
+        {"evaluate", &Server::evaluate},
+        {"readMemory", &Server::read_memory},
+        {"disassemble", &Server::disassemble},
+        {"continue", &Server::continue_},
+        {"next", &Server::next},
+        {"stepIn", &Server::step_in},
+        {"stepOut", &Server::step_out},
+        {"pause", &Server::pause},
+        {"disconnect", &Server::disconnect},
+    }};
+
+    if (message["type"].as_string() != "request") {
+        return;
+    }
+
+    const auto command = message["command"].as_string();
+    const auto handler = std::ranges::find_if(
+        HANDLERS, [command](const auto& entry) { return entry.first == command; });
+    if (handler == HANDLERS.end()) {
+        fail(message, std::format("unsupported request '{}'", command));
+        return;
+    }
+    (this->*handler->second)(message);
+}
+
+void Server::respond(const Json& request, Json body) {
+    Json response;
+    response.set("seq", seq_++)
+        .set("type", "response")
+        .set("request_seq", request["seq"])
+        .set("success", true)
+        .set("command", request["command"]);
+    if (!body.is_null()) {
+        response.set("body", std::move(body));
+    }
+    transport_.send(response);
+}
+
+void Server::fail(const Json& request, std::string_view message) {
+    Json response;
+    response.set("seq", seq_++)
+        .set("type", "response")
+        .set("request_seq", request["seq"])
+        .set("success", false)
+        .set("command", request["command"])
+        .set("message", message);
+    transport_.send(response);
+}
+
+void Server::event(std::string_view name, Json body) {
+    Json message;
+    message.set("seq", seq_++).set("type", "event").set("event", name);
+    if (!body.is_null()) {
+        message.set("body", std::move(body));
+    }
+    transport_.send(message);
+}
+
+void Server::stopped(std::string_view reason, std::string_view description) {
+    running_ = false;
+    step_pc_.reset();
+
+    Json body;
+    body.set("reason", reason).set("threadId", THREAD_ID).set("allThreadsStopped", true);
+    if (!description.empty()) {
+        body.set("description", description).set("text", description);
+    }
+
+    if (reason == "breakpoint") {
+        Json      ids = Json::Array{};
+        const u16 pc  = cpu_.get_pc();
+        auto      add = [&](const std::vector<Breakpoint>& list) {
+            for (const auto& breakpoint : list) {
+                if (breakpoint.address == pc && breakpoint.fired) {
+                    ids.push(breakpoint.id);
+                }
+            }
+        };
+        for (const auto& [path, list] : source_breakpoints_) {
+            add(list);
+        }
+        add(instruction_breakpoints_);
+        add(function_breakpoints_);
+        body.set("hitBreakpointIds", std::move(ids));
+    }
+    event("stopped", std::move(body));
+}
+
+// Execution starts once the program is loaded and the client has sent its
+// breakpoints, whichever of launch and configurationDone comes last
+void Server::start_if_ready() {
+    if (!launched_ || !configured_ || started_) {
+        return;
+    }
+    started_ = true;
+    if (stop_on_entry_) {
+        stopped("entry");
+    } else {
+        running_ = true;  // A breakpoint on the entry point still hits
+    }
+}
+
+// Continue from a stop. The instruction at the PC runs before any stop is
+// checked, or the breakpoint or BRK that stopped the target would stop it again.
+void Server::resume() {
+    leave_pc_ = true;
+    running_  = true;
+}
+
+// Runs until a stop or SLICE_CYCLES have passed. Breakpoints whose condition
+// fails, or whose hits are still being ignored, are stepped over within the
+// slice, so a busy conditional breakpoint costs no trips to the transport.
+void Server::run_slice() {
+    u64 budget = SLICE_CYCLES;
+    while (true) {
+        if (leave_pc_) {
+            leave_pc_   = false;
+            auto cycles = cpu_.step(memory_);
+            if (!cycles) {
+                stopped("exception", error_message(cycles.error()));
+                return;
+            }
+            budget -= std::min(budget, static_cast<u64>(*cycles));
+        }
+
+        StopCondition stop;
+        stop.max_cycles  = budget;
+        stop.stop_pc     = step_pc_;
+        stop.stop_on_brk = stop_on_brk_;
+
+        auto result = cpu_.run(stop, memory_);
+        if (!result) {
+            stopped("exception", error_message(result.error()));
+            return;
+        }
+        budget -= std::min(budget, result->cycles);
+
+        switch (result->reason) {
+            case StopReason::CycleLimit:
+                return;
+            case StopReason::StopPc:
+                if (cpu_.get_sp() >= step_sp_) {
+                    stopped("step");
+                    return;
+                }
+                break;  // A deeper call returned here; keep going
+            case StopReason::Breakpoint:
+                if (breakpoint_fires()) {
+                    stopped("breakpoint");
+                    return;
+                }
+                break;
+            case StopReason::Brk:
+                stopped("exception", "BRK");
+                return;
+        }
+        leave_pc_ = true;
+    }
+}
+
+// Called when the trap at the PC fires. Every breakpoint there counts the
+// reach against its own condition and ignore count, and the target stops if
+// any of them says so.
+auto Server::breakpoint_fires() -> bool {
+    const u16 pc    = cpu_.get_pc();
+    bool      fires = false;
+    auto      check = [&](std::vector<Breakpoint>& list) {
+        for (auto& breakpoint : list) {
+            breakpoint.fired =
+                breakpoint.address == pc && breakpoint.condition.reached(cpu_, memory_);
+            fires = fires || breakpoint.fired;
+        }
+    };
+    for (auto& [path, list] : source_breakpoints_) {
+        check(list);
+    }
+    check(instruction_breakpoints_);
+    check(function_breakpoints_);
+    return fires;
+}
+
+void Server::step_instruction() {
+    auto cycles = cpu_.step(memory_);
+    if (!cycles) {
+        stopped("exception", error_message(cycles.error()));
+    } else {
+        stopped("step");
+    }
+}
+
+// Every breakpoint kind becomes a trap in memory_; false if they do not all fit
+auto Server::rebuild_breakpoints() -> bool {
+    memory_.clear_traps();
+    bool fits = true;
+    auto add  = [&](const std::vector<Breakpoint>& list) {
+        for (const auto& breakpoint : list) {
+            if (breakpoint.address) {
+                fits = memory_.set_trap(*breakpoint.address) && fits;
+            }
+        }
+    };
+    for (const auto& [path, list] : source_breakpoints_) {
+        add(list);
+    }
+    add(instruction_breakpoints_);
+    add(function_breakpoints_);
+    return fits;
+}
+
+void Server::respond_breakpoints(const Json& request, Json results) {
+    if (!rebuild_breakpoints()) {
+        fail(request, std::format("more than {} breakpoints", Memory::MAX_TRAPS));
+        return;
+    }
+    respond(request, Json{}.set("breakpoints", std::move(results)));
+}
+
+// Looks up the address and compiles the condition of breakpoint, both of
+// which depend on the program and debug info that launch loads. Returns the
+// breakpoint as DAP describes it, with a message when it is not verified.
+auto Server::resolve(Breakpoint& breakpoint) const -> Json {
+    const Json&        requested = breakpoint.request;
+    std::optional<u16> address;
+    std::optional<u32> line;
+    std::string_view   missing;
+    switch (breakpoint.kind) {
+        case BreakpointKind::Source: {
+            const auto location =
+                line_address(breakpoint.path, static_cast<u32>(requested["line"].as_number()));
+            if (location) {
+                address = location->first;
+                line    = location->second;
+            }
+            missing = "no code at or after this line";
+            break;
+        }
+        case BreakpointKind::Instruction: {
+            auto reference = parse_number(requested["instructionReference"]);
+            if (reference) {
+                *reference += static_cast<i64>(requested["offset"].as_number());
+            }
+            address = to_address(reference);
+            missing = "not an address from $0000 to $FFFF";
+            break;
+        }
+        case BreakpointKind::Function: {
+            // Function names are symbols, or addresses written as in the other requests
+            const auto& name = requested["name"];
+            address          = to_address(parse_number(name));
+            if (const Symbol* symbol = symbols_.find(name.as_string()); symbol != nullptr) {
+                address = symbol->address;
+            }
+            missing = "no such symbol";
+            break;
+        }
+    }
+
+    Json result;
+    result.set("id", breakpoint.id).set("verified", false);
+    breakpoint.address.reset();
+    if (!address) {
+        result.set("message", missing);
+        return result;
+    }
+
+    auto condition = parse_condition(requested);
+    if (!condition) {
+        result.set("message", "condition or hitCondition does not parse");
+        return result;
+    }
+    breakpoint.address   = *address;
+    breakpoint.condition = std::move(*condition);
+    result.set("verified", true);
+    if (line) {
+        result.set("line", *line);
+    }
+    result.set("instructionReference", hex_reference(*address));
+    return result;
+}
+
+auto Server::add_breakpoint(std::vector<Breakpoint>& list, BreakpointKind kind,
+                            std::string_view path, const Json& requested) -> Json {
+    Breakpoint& breakpoint = list.emplace_back();
+    breakpoint.id          = next_breakpoint_id_++;
+    breakpoint.kind        = kind;
+    breakpoint.path        = path;
+    breakpoint.request     = requested;
+    return resolve(breakpoint);
+}
+
+// Breakpoints may arrive before launch, when there is no program, symbols or
+// line table to resolve them against; resolve them again and report changes
+void Server::resolve_breakpoints() {
+    auto update = [&](std::vector<Breakpoint>& list) {
+        for (auto& breakpoint : list) {
+            event("breakpoint",
+                  Json{}.set("reason", "changed").set("breakpoint", resolve(breakpoint)));
+        }
+    };
+    for (auto& [path, list] : source_breakpoints_) {
+        update(list);
+    }
+    update(instruction_breakpoints_);
+    update(function_breakpoints_);
+
+    if (!rebuild_breakpoints()) {
+        event("output",
+              Json{}
+                  .set("category", "console")
+                  .set("output", std::format("more than {} breakpoints\n", Memory::MAX_TRAPS)));
+    }
+}
+
+// condition is an Expression. hitCondition "N" or ">=N" stops from the Nth
+// hit on and ">N" after it; hits are only counted while the condition holds.
+auto Server::parse_condition(const Json& requested) const -> std::optional<BreakpointCondition> {
+    std::optional<Expression> condition;
+    if (const auto text = requested["condition"].as_string(); !text.empty()) {
+        auto compiled = Expression::compile(text, &symbols_);
+        if (!compiled) {
+            return std::nullopt;
+        }
+        condition = std::move(*compiled);
+    }
+
+    std::string_view hits   = requested["hitCondition"].as_string();
+    u64              ignore = 0;
+    if (!hits.empty()) {
+        const bool after = hits.starts_with('>') && !hits.starts_with(">=");
+        hits.remove_prefix(hits.starts_with(">=") ? 2 : after ? 1 : 0);
+        while (hits.starts_with(' ')) {
+            hits.remove_prefix(1);
+        }
+
+        u64 count = 0;
+        const auto [end, error] = std::from_chars(hits.data(), hits.data() + hits.size(), count);
+        if (hits.empty() || error != std::errc{} || end != hits.data() + hits.size()) {
+            return std::nullopt;
+        }
+        ignore = after ? count : std::max<u64>(count, 1) - 1;
+    }
+    return BreakpointCondition(std::move(condition), ignore);
+}
+
+// First code at or after line in the source file named by path
+auto Server::line_address(std::string_view path, u32 line) const
+    -> std::optional<std::pair<u16, u32>> {
+    if (path.empty()) {
+        return std::nullopt;
+    }
+    const auto wanted = std::filesystem::absolute(std::filesystem::path(path)).lexically_normal();
+
+    // The source with this path, or else the only one with this file name
+    std::optional<u32> file;
+    for (u32 i = 0; i < sources_.size() && !file; ++i) {
+        if (sources_[i] == wanted) {
+            file = i;
+        }
+    }
+    if (!file) {
+        for (u32 i = 0; i < sources_.size(); ++i) {
+            if (sources_[i].filename() != wanted.filename()) {
+                continue;
+            }
+            if (file) {
+                return std::nullopt;  // Ambiguous, the client has to send the full path
+            }
+            file = i;
+        }
+    }
+    if (!file) {
+        return std::nullopt;
+    }
+
+    const LineRange* best = nullptr;
+    for (const auto& range : lines_.ranges()) {
+        if (range.file != *file) {
+            continue;
+        }
+        if (range.line < line) {
+            continue;
+        }
+        if (best == nullptr || range.line < best->line ||
+            (range.line == best->line && range.address < best->address)) {
+            best = &range;
+        }
+    }
+
+    if (best == nullptr) {
+        return std::nullopt;
+    }
+    return std::pair{best->address, best->line};
+}
+
+// Source and line of the code at address, or null without line information
+auto Server::source_of(u16 address) const -> Json {
+    for (const auto& range : lines_.ranges()) {
+        if (address >= range.address && address - range.address < range.size) {
+            const auto& path = sources_[range.file];
+            Json        source;
+            source.set("name", path.filename().string()).set("path", path.string());
+            return Json{}.set("source", std::move(source)).set("line", range.line);
+        }
+    }
+    return {};
+}
+
+void Server::initialize(const Json& request) {
+    Json capabilities;
+    capabilities.set("supportsConfigurationDoneRequest", true)
+        .set("supportsFunctionBreakpoints", true)
+        .set("supportsInstructionBreakpoints", true)
+        .set("supportsConditionalBreakpoints", true)
+        .set("supportsHitConditionalBreakpoints", true)
+        .set("supportsEvaluateForHovers", true)
+        .set("supportsReadMemoryRequest", true)
+        .set("supportsDisassembleRequest", true)
+        .set("supportsSteppingGranularity", false);
+    respond(request, std::move(capabilities));
+    event("initialized");
+}
+
+// Arguments: program, and optionally format, loadAddress, pc, stopOnEntry,
+// stopOnBrk, debugFile (ld65 --dbgfile output) and labels (VICE label file)
+void Server::launch(const Json& request) {
+    // Nothing from an earlier launch in this session carries over
+    memory_.clear();
+    symbols_ = {};
+    lines_   = {};
+    sources_.clear();
+
+    const Json& arguments = request["arguments"];
+    const auto  program   = std::filesystem::path(arguments["program"].as_string());
+    const auto  bytes     = read_file(program);
+    if (program.empty() || !bytes) {
+        fail(request, std::format("cannot read '{}'", program.string()));
+        return;
+    }
+
+    std::optional<ImageFormat> format = detect_image_format(program.string(),
+        {reinterpret_cast<const u8*>(bytes->data()), bytes->size()});
+    if (!arguments["format"].is_null()) {
+        format = parse_image_format(arguments["format"].as_string());
+        if (!format) {
+            fail(request, "format must be raw, ihex, srec, prg or o65");
+            return;
+        }
+    }
+
+    LoadOptions options;
+    options.raw_address = 0x8000;
+    if (!arguments["loadAddress"].is_null()) {
+        const auto address = to_address(parse_number(arguments["loadAddress"]));
+        if (!address) {
+            fail(request, "loadAddress must be an address from $0000 to $FFFF");
+            return;
+        }
+        options.raw_address = *address;
+    }
+
+    const std::span<const u8> image_bytes{reinterpret_cast<const u8*>(bytes->data()),
+                                          bytes->size()};
+    const auto image = load_image(image_bytes, *format, memory_, options);
+    if (!image) {
+        fail(request, std::format("cannot load '{}': {}", program.string(),
+                                  error_message(image.error())));
+        return;
+    }
+
+    // Same entry point rules as 6502emu
+    const bool has_reset_vector =
+        image->start || (image->covers(0xFFFC) && image->covers(0xFFFD));
+    cpu_.reset(memory_);
+    if (!arguments["pc"].is_null()) {
+        const auto pc = to_address(parse_number(arguments["pc"]));
+        if (!pc) {
+            fail(request, "pc must be an address from $0000 to $FFFF");
+            return;
+        }
+        cpu_.set_pc(*pc);
+    } else if (!has_reset_vector && !image->segments.empty()) {
+        cpu_.set_pc(image->segments.front().address);
+    }
+
+    if (const auto path = arguments["debugFile"].as_string(); !path.empty()) {
+        const auto text = read_file(path);
+        if (!text) {
+            fail(request, std::format("cannot read '{}'", path));
+            return;
+        }
+        symbols_.load_ca65_dbg(*text);
+        lines_.load_ca65_dbg(*text);
+
+        // File names in the debug file are relative to where it was written
+        const auto base = std::filesystem::absolute(std::filesystem::path(path)).parent_path();
+        for (const auto& name : lines_.files()) {
+            sources_.push_back((base / name).lexically_normal());
+        }
+    }
+
+    if (const auto path = arguments["labels"].as_string(); !path.empty()) {
+        const auto text = read_file(path);
+        if (!text) {
+            fail(request, std::format("cannot read '{}'", path));
+            return;
+        }
+        symbols_.load_vice_labels(*text);
+    }
+
+    resolve_breakpoints();
+
+    stop_on_entry_ = arguments["stopOnEntry"].as_bool(false);
+    stop_on_brk_   = arguments["stopOnBrk"].as_bool(true);
+    launched_      = true;
+    respond(request);
+    start_if_ready();
+}
+
+void Server::set_breakpoints(const Json& request) {
+    const Json&            arguments = request["arguments"];
+    const std::string_view path      = arguments["source"]["path"].as_string();
+
+    std::vector<Breakpoint> list;
+    Json                    results = Json::Array{};
+    for (const auto& requested : arguments["breakpoints"].items()) {
+        results.push(add_breakpoint(list, BreakpointKind::Source, path, requested));
+    }
+
+    source_breakpoints_.insert_or_assign(std::string(path), std::move(list));
+    respond_breakpoints(request, std::move(results));
+}
+
+void Server::set_instruction_breakpoints(const Json& request) {
+    instruction_breakpoints_.clear();
+
+    Json results = Json::Array{};
+    for (const auto& requested : request["arguments"]["breakpoints"].items()) {
+        results.push(
+            add_breakpoint(instruction_breakpoints_, BreakpointKind::Instruction, {}, requested));
+    }
+
+    respond_breakpoints(request, std::move(results));
+}
+
+void Server::set_function_breakpoints(const Json& request) {
+    function_breakpoints_.clear();
+
+    Json results = Json::Array{};
+    for (const auto& requested : request["arguments"]["breakpoints"].items()) {
+        results.push(
+            add_breakpoint(function_breakpoints_, BreakpointKind::Function, {}, requested));
+    }
+
+    respond_breakpoints(request, std::move(results));
+}
+
+void Server::configuration_done(const Json& request) {
+    configured_ = true;
+    respond(request);
+    start_if_ready();
+}
+
+void Server::threads(const Json& request) {
+    Json thread;
+    thread.set("id", THREAD_ID).set("name", "6502");
+    respond(request, Json{}.set("threads", Json::Array{std::move(thread)}));
+}
+
+void Server::stack_trace(const Json& request) {
+    const u16 pc = cpu_.get_pc();
+
+    Json frame;
+    frame.set("id", FRAME_ID)
+        .set("name", symbols_.function_name(pc))
+        .set("instructionPointerReference", hex_reference(pc))
+        .set("line", 0)
+        .set("column", 0);
+    if (const auto location = source_of(pc); !location.is_null()) {
+        frame.set("source", location["source"]).set("line", location["line"]);
+    }
+
+    respond(request,
+            Json{}.set("stackFrames", Json::Array{std::move(frame)}).set("totalFrames", 1));
+}
+
+void Server::scopes(const Json& request) {
+    Json registers;
+    registers.set("name", "Registers")
+        .set("presentationHint", "registers")
+        .set("variablesReference", REGISTERS_SCOPE)
+        .set("expensive", false);
+
+    Json flags;
+    flags.set("name", "Flags").set("variablesReference", FLAGS_SCOPE).set("expensive", false);
+
+    respond(request, Json{}.set("scopes", Json::Array{std::move(registers), std::move(flags)}));
+}
+
+void Server::variables(const Json& request) {
+    Json list = Json::Array{};
+    auto add  = [&](std::string_view name, std::string value) {
+        Json variable;
+        variable.set("name", name).set("value", std::move(value)).set("variablesReference", 0);
+        list.push(std::move(variable));
+    };
+
+    const auto reference = static_cast<int>(request["arguments"]["variablesReference"].as_number());
+    const auto flags     = cpu_.get_flags();
+    if (reference == REGISTERS_SCOPE) {
+        add("A", std::format("${:02X}", cpu_.get_a()));
+        add("X", std::format("${:02X}", cpu_.get_x()));
+        add("Y", std::format("${:02X}", cpu_.get_y()));
+        add("SP", std::format("${:02X}", cpu_.get_sp()));
+        add("PC", std::format("${:04X}", cpu_.get_pc()));
+        add("P", std::format("${:02X}", flags.to_byte()));
+        add("cycles", std::format("{}", cpu_.get_cycles()));
+    } else if (reference == FLAGS_SCOPE) {
+        add("N", flags.negative ? "1" : "0");
+        add("V", flags.overflow ? "1" : "0");
+        add("B", flags.brk ? "1" : "0");
+        add("D", flags.decimal ? "1" : "0");
+        add("I", flags.interrupt ? "1" : "0");
+        add("Z", flags.zero ? "1" : "0");
+        add("C", flags.carry ? "1" : "0");
+    }
+
+    respond(request, Json{}.set("variables", std::move(list)));
+}
+
+// Watch, hover and REPL expressions, in the syntax of breakpoint conditions
+void Server::evaluate(const Json& request) {
+    const auto text       = request["arguments"]["expression"].as_string();
+    auto       expression = Expression::compile(text, &symbols_);
+    if (!expression) {
+        fail(request, error_message(expression.error()));
+        return;
+    }
+
+    const i32 value = expression->evaluate(cpu_, memory_);
+    respond(request, Json{}
+                         .set("result", std::format("{} (${:X})", value, static_cast<u32>(value)))
+                         .set("variablesReference", 0));
+}
+
+// Reads RAM directly, so I/O devices see no accesses and breakpoints do not show
+void Server::read_memory(const Json& request) {
+    const Json& arguments = request["arguments"];
+    const auto  reference = parse_number(arguments["memoryReference"]);
+    if (!reference) {
+        fail(request, "memoryReference is not an address");
+        return;
+    }
+
+    const i64 start = *reference + static_cast<i64>(arguments["offset"].as_number());
+    const i64 count = std::max<i64>(0, static_cast<i64>(arguments["count"].as_number()));
+    const i64 first = std::clamp<i64>(start, 0, Memory::MAX_MEM);
+    const i64 last  = std::clamp<i64>(start + count, 0, Memory::MAX_MEM);
+
+    Json body;
+    body.set("address", std::format("0x{:04X}", std::max<i64>(start, 0)));
+    if (first < last) {
+        std::vector<u8> data;
+        data.reserve(static_cast<std::size_t>(last - first));
+        for (i64 address = first; address < last; ++address) {
+            data.push_back(memory_.peek(static_cast<u16>(address)));
+        }
+        body.set("data", base64(data));
+    }
+    body.set("unreadableBytes", count - std::max<i64>(0, last - first));
+    respond(request, std::move(body));
+}
+
+void Server::disassemble(const Json& request) {
+    const Json& arguments = request["arguments"];
+    const auto  reference = parse_number(arguments["memoryReference"]);
+    if (!reference) {
+        fail(request, "memoryReference is not an address");
+        return;
+    }
+
+    const i64 base   = *reference + static_cast<i64>(arguments["offset"].as_number());
+    const i64 offset = static_cast<i64>(arguments["instructionOffset"].as_number());
+    const i64 count  =
+        std::max(i64{0}, static_cast<i64>(arguments["instructionCount"].as_number()));
+
+    Json list = Json::Array{};
+    auto full = [&] { return static_cast<i64>(list.items().size()) >= count; };
+
+    // Instructions before base. They are 1 to 3 bytes, so the code leading up
+    // to base starts somewhere in the 3 bytes per instruction below it; take
+    // the earliest start whose sweep lands exactly on base.
+    std::vector<Instruction> decoded;
+    if (offset < 0) {
+        const i64 end   = std::clamp<i64>(base, 0, Memory::MAX_MEM);
+        const i64 first = std::clamp<i64>(base + 3 * offset, 0, end);
+        for (i64 start = first; start <= end; ++start) {
+            decoded.clear();
+            i64 address = start;
+            while (address < end) {
+                decoded.push_back(decode(memory_, static_cast<u16>(address)));
+                address += decoded.back().length;
+            }
+            if (address == end) {
+                break;
+            }
+        }
+        const auto keep = std::min<i64>(-offset, static_cast<i64>(decoded.size()));
+        decoded.erase(decoded.begin(), decoded.end() - keep);
+
+        // Padding where memory below base runs out
+        for (i64 i = keep; i < -offset && !full(); ++i) {
+            list.push(invalid_instruction(static_cast<u16>(std::max<i64>(0, base + offset + i))));
+        }
+    }
+
+    // Then from base on, skipping a positive offset
+    const i64 wanted  = count - static_cast<i64>(list.items().size());
+    i64       skip    = std::max<i64>(0, offset);
+    i64       address = base;
+    while (address >= 0 && address < Memory::MAX_MEM &&
+           static_cast<i64>(decoded.size()) < wanted) {
+        const auto instruction = decode(memory_, static_cast<u16>(address));
+        address += instruction.length;
+        if (skip > 0) {
+            --skip;
+        } else {
+            decoded.push_back(instruction);
+        }
+    }
+
+    std::array<char, MAX_INSTRUCTION_TEXT> text{};
+    for (const auto& instruction : decoded) {
+        if (full()) {
+            break;
+        }
+
+        std::string bytes;
+        for (u8 i = 0; i < instruction.length; ++i) {
+            bytes += std::format("{}{:02X}", i == 0 ? "" : " ",
+                                 memory_.peek(static_cast<u16>(instruction.address + i)));
+        }
+
+        Json entry;
+        entry.set("address", hex_reference(instruction.address))
+            .set("instructionBytes", std::move(bytes))
+            .set("instruction", std::string(text.data(), format_instruction(instruction, text)));
+        if (const Symbol* symbol = symbols_.resolve(instruction.address);
+            symbol != nullptr && symbol->address == instruction.address) {
+            entry.set("symbol", symbol->name);
+        }
+        if (const auto location = source_of(instruction.address); !location.is_null()) {
+            entry.set("location", location["source"]).set("line", location["line"]);
+        }
+        list.push(std::move(entry));
+    }
+
+    // And past $FFFF
+    while (!full()) {
+        list.push(invalid_instruction(0xFFFF));
+    }
+    respond(request, Json{}.set("instructions", std::move(list)));
+}
+
+void Server::continue_(const Json& request) {
+    respond(request, Json{}.set("allThreadsContinued", true));
+    if (started_ && !running_) {
+        resume();
+    }
+}
+
+// Steps over a JSR by running to its return address; anything else is one instruction
+void Server::next(const Json& request) {
+    respond(request);
+    if (!started_ || running_) {
+        return;
+    }
+
+    const u16 pc = cpu_.get_pc();
+    if (memory_.peek(pc) != static_cast<u8>(Opcode::JSR)) {
+        step_instruction();
+        return;
+    }
+    step_pc_ = static_cast<u16>(pc + 3);
+    step_sp_ = cpu_.get_sp();
+    resume();
+}
+
+void Server::step_in(const Json& request) {
+    respond(request);
+    if (started_ && !running_) {
+        step_instruction();
+    }
+}
+
+// Runs to the return address on top of the stack, as pushed by JSR
+void Server::step_out(const Json& request) {
+    respond(request);
+    if (!started_ || running_) {
+        return;
+    }
+
+    const u8 sp = cpu_.get_sp();
+    if (sp >= 0xFE) {
+        step_instruction();  // Nothing to return to
+        return;
+    }
+    const u16 low  = memory_.peek(static_cast<u16>(CPU::STACK_PAGE + static_cast<u8>(sp + 1)));
+    const u16 high = memory_.peek(static_cast<u16>(CPU::STACK_PAGE + static_cast<u8>(sp + 2)));
+    step_pc_       = static_cast<u16>((low | (high << 8)) + 1);
+    step_sp_       = static_cast<u8>(sp + 2);
+    resume();
+}
+
+void Server::pause(const Json& request) {
+    respond(request);
+    if (running_) {
+        stopped("pause");
+    }
+}
+
+void Server::disconnect(const Json& request) {
+    respond(request);
+    done_ = true;
+}
+
+}  // namespace dap
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <filesystem>
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "cpu6502/cpu.hpp"
+#include "cpu6502/expression.hpp"
+#include "cpu6502/memory.hpp"
+#include "cpu6502/symbols.hpp"
+#include "json.hpp"
+#include "transport.hpp"
+
+namespace dap {
+
+/**
+ * @type Server class
+ * @brief Debug Adapter Protocol session for one CPU and its memory
+ *
+ * The target runs through CPU::run in slices of SLICE_CYCLES, and the
+ * transport is polled between slices so a pause request gets through. All
+ * breakpoint kinds (source lines, instructions, functions) become traps in
+ * memory_ (Memory::set_trap), so run() executes exactly as the headless
+ * runner does until it reaches one. Conditions and hit counts are checked
+ * only then, with expressions compiled when the breakpoint is set.
+ */
+class Server {
+ public:
+    static constexpr cpu6502::u64 SLICE_CYCLES = 1'000'000;
+
+    explicit Server(Transport& transport) : transport_(transport) {}
+
+    // Serves requests until a disconnect or the end of input
+    void run();
+
+ private:
+    enum class BreakpointKind { Source, Instruction, Function };
+
+    struct Breakpoint {
+        int                          id   = 0;
+        BreakpointKind               kind = BreakpointKind::Source;
+        std::string                  path;     // Source breakpoints only
+        Json                         request;  // As sent, to resolve again after launch
+        std::optional<cpu6502::u16>  address;  // Unset while not verified
+        cpu6502::BreakpointCondition condition;
+        bool                         fired = false;  // Stopped the target when last reached
+    };
+
+    Transport&   transport_;
+    cpu6502::u64 seq_ = 1;
+
+    cpu6502::Memory memory_;
+    cpu6502::CPU    cpu_;
+
+    cpu6502::SymbolTable               symbols_;
+    cpu6502::LineTable                 lines_;
+    std::vector<std::filesystem::path> sources_;  // lines_.files(), resolved
+
+    std::map<std::string, std::vector<Breakpoint>, std::less<>> source_breakpoints_;
+    std::vector<Breakpoint>                                     instruction_breakpoints_;
+    std::vector<Breakpoint>                                     function_breakpoints_;
+    int                                                         next_breakpoint_id_ = 1;
+
+    bool launched_      = false;
+    bool configured_    = false;
+    bool started_       = false;
+    bool running_       = false;
+    bool done_          = false;
+    bool stop_on_entry_ = false;
+    bool stop_on_brk_   = true;
+    bool leave_pc_      = false;  // Execute one instruction before checking stops
+
+    // Return address that ends a step over or step out, and the lowest SP
+    // it counts at; deeper recursion passing the same address keeps going
+    std::optional<cpu6502::u16> step_pc_;
+    cpu6502::u8                 step_sp_ = 0;
+
+    void handle(const Json& message);
+    void respond(const Json& request, Json body = {});
+    void fail(const Json& request, std::string_view message);
+    void event(std::string_view name, Json body = {});
+    void stopped(std::string_view reason, std::string_view description = {});
+
+    void start_if_ready();
+    void resume();
+    void run_slice();
+    auto breakpoint_fires() -> bool;
+    void step_instruction();
+    auto rebuild_breakpoints() -> bool;
+    void respond_breakpoints(const Json& request, Json results);
+
+    auto add_breakpoint(std::vector<Breakpoint>& list, BreakpointKind kind,
+                        std::string_view path, const Json& requested) -> Json;
+    auto resolve(Breakpoint& breakpoint) const -> Json;
+    void resolve_breakpoints();
+    auto parse_condition(const Json& requested) const
+        -> std::optional<cpu6502::BreakpointCondition>;
+    auto line_address(std::string_view path, cpu6502::u32 line) const
+        -> std::optional<std::pair<cpu6502::u16, cpu6502::u32>>;
+    auto source_of(cpu6502::u16 address) const -> Json;
+
+    // Requests
+    void initialize(const Json& request);
+    void launch(const Json& request);
+    void set_breakpoints(const Json& request);
+    void set_instruction_breakpoints(const Json& request);
+    void set_function_breakpoints(const Json& request);
+    void configuration_done(const Json& request);
+    void threads(const Json& request);
+    void stack_trace(const Json& request);
+    void scopes(const Json& request);
+    void variables(const Json& request);
+    void evaluate(const Json& request);
+    void read_memory(const Json& request);
+    void disassemble(const Json& request);
+    void continue_(const Json& request);
+    void next(const Json& request);
+    void step_in(const Json& request);
+    void step_out(const Json& request);
+    void pause(const Json& request);
+    void disconnect(const Json& request);
+};
+
+}  // namespace dap
@@ -0,0 +1,91 @@
+#include "transport.hpp"
+#include <poll.h>
+#include <unistd.h>
+#include <array>
+#include <cerrno>
+#include <charconv>
+#include <format>
+#include <string_view>
+
+namespace dap {
+
+auto Transport::fill() -> bool {
+    std::array<char, 4096> chunk{};
+    while (true) {
+        const auto count = ::read(in_, chunk.data(), chunk.size());
+        if (count > 0) {
+            buffer_.append(chunk.data(), static_cast<std::size_t>(count));
+            return true;
+        }
+        if (count == 0 || errno != EINTR) {
+            return false;
+        }
+    }
+}
+
+auto Transport::receive() -> std::optional<Json> {
+    // Header lines, then an empty line; only Content-Length matters
+    std::size_t header_end = std::string::npos;
+    while ((header_end = buffer_.find("\r\n\r\n")) == std::string::npos) {
+        if (!fill()) {
+            return std::nullopt;
+        }
+    }
+
+    constexpr std::string_view LENGTH_FIELD = "Content-Length:";
+    const std::string_view     header(buffer_.data(), header_end);
+    const auto                 field = header.find(LENGTH_FIELD);
+    if (field == std::string_view::npos) {
+        return std::nullopt;
+    }
+
+    auto digits = header.substr(field + LENGTH_FIELD.size());
+    while (digits.starts_with(' ')) {
+        digits.remove_prefix(1);
+    }
+    std::size_t length = 0;
+    const auto [end, error] = std::from_chars(digits.data(), digits.data() + digits.size(), length);
+    if (error != std::errc{} || end == digits.data()) {
+        return std::nullopt;
+    }
+
+    const std::size_t body = header_end + 4;
+    while (buffer_.size() - body < length) {
+        if (!fill()) {
+            return std::nullopt;
+        }
+    }
+
+    // A body that is not JSON comes back as null, which the server ignores
+    auto message = Json::parse(std::string_view(buffer_).substr(body, length));
+    buffer_.erase(0, body + length);
+    return message.value_or(Json{});
+}
+
+auto Transport::pending() -> bool {
+    if (!buffer_.empty()) {
+        return true;
+    }
+    pollfd descriptor{in_, POLLIN, 0};
+    return ::poll(&descriptor, 1, 0) > 0;
+}
+
+void Transport::send(const Json& message) {
+    const std::string body = message.dump();
+    std::string       frame = std::format("Content-Length: {}\r\n\r\n", body.size());
+    frame += body;
+
+    std::string_view rest = frame;
+    while (!rest.empty()) {
+        const auto count = ::write(out_, rest.data(), rest.size());
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return;
+        }
+        rest.remove_prefix(static_cast<std::size_t>(count));
+    }
+}
+
+}  // namespace dap
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <optional>
+#include <string>
+#include "json.hpp"
+
+namespace dap {
+
+/**
+ * @type Transport class
+ * @brief Content-Length framed DAP messages over a pair of file descriptors
+ *
+ * Reads go through an internal buffer rather than stdio streams so that
+ * pending() can ask the descriptor whether a request is waiting without
+ * blocking, which is how a running target notices a pause request.
+ */
+class Transport {
+ public:
+    Transport(int in, int out) : in_(in), out_(out) {}
+
+    // Blocks for the next message; nullopt at end of input or on a bad header
+    [[nodiscard]] auto receive() -> std::optional<Json>;
+
+    // True if input is waiting, or the connection was closed
+    [[nodiscard]] auto pending() -> bool;
+
+    void send(const Json& message);
+
+ private:
+    int         in_;
+    int         out_;
+    std::string buffer_;
+
+    // Reads more input into buffer_; false at end of input
+    auto fill() -> bool;
+};
+
+}  // namespace dap
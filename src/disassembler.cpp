@@ -0,0 +1,238 @@
+#include "cpu6502/disassembler.hpp"
+#include <algorithm>
+#include <charconv>
+
+namespace cpu6502
+{
+
+namespace
+{
+
+constexpr std::string_view HEX_DIGITS = "0123456789ABCDEF";
+
+// Writes into a fixed buffer, dropping what does not fit
+struct FixedSink
+{
+    std::span<char> out;
+    std::size_t     used = 0;
+
+    void put(std::string_view text) noexcept
+    {
+        const std::size_t count = std::min(text.size(), out.size() - used);
+        std::copy_n(text.data(), count, out.data() + used);
+        used += count;
+    }
+};
+
+template <typename Sink>
+void put_hex(Sink& sink, u16 value, int digits)
+{
+    char text[4];
+    for (int i = digits - 1; i >= 0; --i)
+        {
+            text[i] = HEX_DIGITS[value & 0x0F];
+            value >>= 4;
+        }
+    sink.put({text, static_cast<std::size_t>(digits)});
+}
+
+// "$XX"/"$XXXX", or the name of the symbol covering address
+template <typename Sink>
+void put_address(Sink& sink, u16 address, int digits, const SymbolTable* symbols)
+{
+    const Symbol* symbol = symbols != nullptr ? symbols->resolve(address) : nullptr;
+    if (symbol == nullptr)
+        {
+            sink.put("$");
+            put_hex(sink, address, digits);
+            return;
+        }
+
+    sink.put(symbol->name);
+    if (symbol->address != address)
+        {
+            char       text[8] = {'+'};
+            const auto result  = std::to_chars(text + 1, text + sizeof(text),
+                                               address - symbol->address);
+            sink.put({text, static_cast<std::size_t>(result.ptr - text)});
+        }
+}
+
+template <typename Sink>
+void put_instruction(Sink& sink, const Instruction& instruction, const SymbolTable* symbols)
+{
+    const OpcodeInfo& info = instruction.info();
+    if (!info.documented())
+        {
+            sink.put(".byte $");
+            put_hex(sink, instruction.opcode, 2);
+            return;
+        }
+
+    sink.put(info.mnemonic);
+
+    const u16 operand = instruction.operand;
+    switch (info.mode)
+        {
+            case AddressingMode::Implied:
+                return;
+            case AddressingMode::Accumulator:
+                sink.put(" A");
+                return;
+            case AddressingMode::Immediate:
+                sink.put(" #$");
+                put_hex(sink, operand, 2);
+                return;
+            case AddressingMode::ZeroPage:
+            case AddressingMode::ZeroPageX:
+            case AddressingMode::ZeroPageY:
+                sink.put(" ");
+                put_address(sink, operand, 2, symbols);
+                break;
+            case AddressingMode::Absolute:
+            case AddressingMode::AbsoluteX:
+            case AddressingMode::AbsoluteY:
+                sink.put(" ");
+                put_address(sink, operand, 4, symbols);
+                break;
+            case AddressingMode::Indirect:
+                sink.put(" (");
+                put_address(sink, operand, 4, symbols);
+                sink.put(")");
+                return;
+            case AddressingMode::IndirectX:
+                sink.put(" (");
+                put_address(sink, operand, 2, symbols);
+                sink.put(",X)");
+                return;
+            case AddressingMode::IndirectY:
+                sink.put(" (");
+                put_address(sink, operand, 2, symbols);
+                sink.put("),Y");
+                return;
+            case AddressingMode::Relative:
+                sink.put(" ");
+                put_address(sink, instruction.target(), 4, symbols);
+                return;
+        }
+
+    if (info.mode == AddressingMode::ZeroPageX || info.mode == AddressingMode::AbsoluteX)
+        sink.put(",X");
+    else if (info.mode == AddressingMode::ZeroPageY || info.mode == AddressingMode::AbsoluteY)
+        sink.put(",Y");
+}
+
+}  // namespace
+
+std::size_t disassemble(const Memory& memory, u16 address, u32 size,
+                        std::span<Instruction> out) noexcept
+{
+    std::size_t count  = 0;
+    u32         offset = 0;
+    while (offset < size && count < out.size())
+        {
+            out[count] = decode(memory, static_cast<u16>(address + offset));
+            offset += out[count].length;
+            ++count;
+        }
+    return count;
+}
+
+std::size_t disassemble(const Memory& memory, std::span<const u16> addresses,
+                        std::span<Instruction> out) noexcept
+{
+    const std::size_t count = std::min(addresses.size(), out.size());
+    for (std::size_t i = 0; i < count; ++i)
+        out[i] = decode(memory, addresses[i]);
+    return count;
+}
+
+std::size_t format_instruction(const Instruction& instruction, std::span<char> out) noexcept
+{
+    FixedSink sink{out};
+    put_instruction(sink, instruction, nullptr);
+    return sink.used;
+}
+
+DisassemblyWriter::DisassemblyWriter(std::ostream& out, const SymbolTable* symbols)
+    : out_(out), symbols_(symbols), buffer_(std::make_unique<char[]>(BUFFER_SIZE))
+{
+}
+
+DisassemblyWriter::~DisassemblyWriter()
+{
+    flush();
+}
+
+void DisassemblyWriter::write(const Instruction& instruction)
+{
+    if (symbols_ != nullptr)
+        {
+            const Symbol* label = symbols_->resolve(instruction.address);
+            if (label != nullptr && label->address == instruction.address)
+                {
+                    put(label->name);
+                    put(":\n");
+                }
+        }
+
+    // Address and bytes are fixed width; assemble them on the stack
+    char line[] = "XXXX            ";
+    for (int i = 3, address = instruction.address; i >= 0; --i, address >>= 4)
+        line[i] = HEX_DIGITS[address & 0x0F];
+
+    const u8 bytes[3] = {instruction.opcode, static_cast<u8>(instruction.operand & 0xFF),
+                         static_cast<u8>(instruction.operand >> 8)};
+    for (int i = 0; i < instruction.length; ++i)
+        {
+            line[6 + i * 3] = HEX_DIGITS[bytes[i] >> 4];
+            line[7 + i * 3] = HEX_DIGITS[bytes[i] & 0x0F];
+        }
+    put({line, sizeof(line) - 1});
+
+    put_instruction(*this, instruction, symbols_);
+    put("\n");
+}
+
+void DisassemblyWriter::write(const Memory& memory, u16 address, u32 size)
+{
+    u32 offset = 0;
+    while (offset < size)
+        {
+            const Instruction instruction = decode(memory, static_cast<u16>(address + offset));
+            write(instruction);
+            offset += instruction.length;
+        }
+}
+
+void DisassemblyWriter::write(const Memory& memory, std::span<const TraceRecord> records)
+{
+    for (const TraceRecord& record : records)
+        {
+            write(decode(record.pc, record.opcode, memory.peek(static_cast<u16>(record.pc + 1)),
+                         memory.peek(static_cast<u16>(record.pc + 2))));
+        }
+}
+
+void DisassemblyWriter::flush()
+{
+    out_.write(buffer_.get(), static_cast<std::streamsize>(used_));
+    used_ = 0;
+}
+
+void DisassemblyWriter::put(std::string_view text)
+{
+    if (text.size() > BUFFER_SIZE - used_)
+        {
+            flush();
+            if (text.size() > BUFFER_SIZE)
+                {
+                    out_.write(text.data(), static_cast<std::streamsize>(text.size()));
+                    return;
+                }
+        }
+    std::copy_n(text.data(), text.size(), buffer_.get() + used_);
+    used_ += text.size();
+}
+
+}  // namespace cpu6502
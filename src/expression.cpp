@@ -0,0 +1,386 @@
+#include "cpu6502/expression.hpp"
+#include <array>
+#include <charconv>
+#include "cpu6502/cpu.hpp"
+#include "cpu6502/memory.hpp"
+#include "cpu6502/symbols.hpp"
+
+namespace cpu6502
+{
+
+namespace
+{
+
+[[nodiscard]] constexpr bool is_digit(char c) noexcept
+{
+    return c >= '0' && c <= '9';
+}
+
+[[nodiscard]] constexpr bool is_name_start(char c) noexcept
+{
+    return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || c == '_' || c == '@' || c == '.';
+}
+
+[[nodiscard]] constexpr bool is_name_char(char c) noexcept
+{
+    return is_name_start(c) || is_digit(c);
+}
+
+[[nodiscard]] constexpr bool equals_upper(std::string_view name, std::string_view upper) noexcept
+{
+    if (name.size() != upper.size())
+        return false;
+    for (std::size_t i = 0; i < name.size(); ++i)
+        {
+            const char c = name[i] >= 'a' && name[i] <= 'z' ? static_cast<char>(name[i] - 32)
+                                                            : name[i];
+            if (c != upper[i])
+                return false;
+        }
+    return true;
+}
+
+// Two's complement wrap without signed overflow
+[[nodiscard]] constexpr i32 wrap(u32 value) noexcept
+{
+    return static_cast<i32>(value);
+}
+
+}  // namespace
+
+/**
+ * @type class
+ * @brief Recursive descent over Expression's grammar, emitting its bytecode
+ */
+class ExpressionParser
+{
+ public:
+    ExpressionParser(std::string_view text, const SymbolTable* symbols) noexcept
+        : text_(text), symbols_(symbols)
+    {
+    }
+
+    [[nodiscard]] auto parse() -> std::expected<Expression, EmulatorError>
+    {
+        const bool parsed = binary(0);
+        skip_space();
+        if (!parsed || pos_ != text_.size())
+            return std::unexpected(EmulatorError::InvalidExpression);
+        return std::move(expression_);
+    }
+
+ private:
+    using Op = Expression::Op;
+
+    struct Operator
+    {
+        std::string_view token;
+        Op               op;
+        int              level;  // 0 binds loosest
+    };
+
+    static constexpr int LEVELS = 7;
+
+    // Longer tokens ahead of their prefixes
+    static constexpr std::array<Operator, 13> OPERATORS{{
+        {"||", Op::LogicalOr, 0},
+        {"&&", Op::LogicalAnd, 1},
+        {"==", Op::Equal, 2},
+        {"!=", Op::NotEqual, 2},
+        {"<=", Op::LessEqual, 3},
+        {">=", Op::GreaterEqual, 3},
+        {"<", Op::Less, 3},
+        {">", Op::Greater, 3},
+        {"|", Op::BitOr, 4},
+        {"^", Op::BitXor, 4},
+        {"+", Op::Add, 5},
+        {"-", Op::Subtract, 5},
+        {"&", Op::BitAnd, 6},
+    }};
+
+    std::string_view   text_;
+    const SymbolTable* symbols_;
+    std::size_t        pos_     = 0;
+    std::size_t        depth_   = 0;  // Stack depth after the code emitted so far
+    std::size_t        nesting_ = 0;
+    Expression         expression_;
+
+    void skip_space() noexcept
+    {
+        while (pos_ < text_.size() && (text_[pos_] == ' ' || text_[pos_] == '\t'))
+            ++pos_;
+    }
+
+    [[nodiscard]] bool consume(char c) noexcept
+    {
+        skip_space();
+        if (pos_ < text_.size() && text_[pos_] == c)
+            {
+                ++pos_;
+                return true;
+            }
+        return false;
+    }
+
+    [[nodiscard]] bool emit(Op op, i32 operand = 0)
+    {
+        switch (op)
+            {
+                case Op::Push:
+                case Op::A:
+                case Op::X:
+                case Op::Y:
+                case Op::Sp:
+                case Op::Pc:
+                case Op::P:
+                    if (++depth_ > Expression::MAX_DEPTH)
+                        return false;
+                    break;
+                case Op::Peek:
+                case Op::Negate:
+                case Op::Not:
+                case Op::Complement:
+                    break;
+                default:
+                    --depth_;
+                    break;
+            }
+        expression_.code_.push_back(Expression::Step{op, operand});
+        return true;
+    }
+
+    // The longest operator token at the current position, if it binds at level
+    [[nodiscard]] const Operator* match(int level) noexcept
+    {
+        skip_space();
+        const std::string_view rest = text_.substr(pos_);
+        for (const Operator& candidate : OPERATORS)
+            {
+                if (rest.starts_with(candidate.token))
+                    {
+                        if (candidate.level != level)
+                            return nullptr;
+                        pos_ += candidate.token.size();
+                        return &candidate;
+                    }
+            }
+        return nullptr;
+    }
+
+    [[nodiscard]] bool binary(int level)
+    {
+        if (level == LEVELS)
+            return unary();
+
+        if (!binary(level + 1))
+            return false;
+        while (const Operator* op = match(level))
+            {
+                if (!binary(level + 1) || !emit(op->op))
+                    return false;
+            }
+        return true;
+    }
+
+    [[nodiscard]] bool nested(bool (ExpressionParser::*rule)())
+    {
+        if (++nesting_ > Expression::MAX_DEPTH)
+            return false;
+        const bool parsed = (this->*rule)();
+        --nesting_;
+        return parsed;
+    }
+
+    [[nodiscard]] bool unary()
+    {
+        if (consume('-'))
+            return nested(&ExpressionParser::unary) && emit(Op::Negate);
+        if (consume('!'))
+            return nested(&ExpressionParser::unary) && emit(Op::Not);
+        if (consume('~'))
+            return nested(&ExpressionParser::unary) && emit(Op::Complement);
+        return primary();
+    }
+
+    [[nodiscard]] bool group()
+    {
+        return binary(0);
+    }
+
+    [[nodiscard]] bool primary()
+    {
+        if (consume('('))
+            return nested(&ExpressionParser::group) && consume(')');
+        if (consume('['))
+            return nested(&ExpressionParser::group) && consume(']') && emit(Op::Peek);
+
+        skip_space();
+        if (pos_ >= text_.size())
+            return false;
+
+        const char c = text_[pos_];
+        if (c == '$')
+            return number(1, 16);
+        if (c == '%')
+            return number(1, 2);
+        if (c == '0' && pos_ + 1 < text_.size() && (text_[pos_ + 1] | 0x20) == 'x')
+            return number(2, 16);
+        if (is_digit(c))
+            return number(0, 10);
+        if (is_name_start(c))
+            return name();
+        return false;
+    }
+
+    [[nodiscard]] bool number(std::size_t prefix, int base)
+    {
+        pos_ += prefix;
+        const char* const first = text_.data() + pos_;
+        const char* const last  = text_.data() + text_.size();
+
+        u32 value = 0;
+        const auto [end, error] = std::from_chars(first, last, value, base);
+        if (error != std::errc{} || end == first || (end != last && is_name_char(*end)))
+            return false;
+
+        pos_ += static_cast<std::size_t>(end - first);
+        return emit(Op::Push, wrap(value));
+    }
+
+    [[nodiscard]] bool name()
+    {
+        const std::size_t start = pos_;
+        while (pos_ < text_.size() && is_name_char(text_[pos_]))
+            ++pos_;
+        const std::string_view text = text_.substr(start, pos_ - start);
+
+        static constexpr std::array<std::pair<std::string_view, Op>, 6> REGISTERS{{
+            {"A", Op::A},
+            {"X", Op::X},
+            {"Y", Op::Y},
+            {"SP", Op::Sp},
+            {"PC", Op::Pc},
+            {"P", Op::P},
+        }};
+        for (const auto& [upper, op] : REGISTERS)
+            {
+                if (equals_upper(text, upper))
+                    return emit(op);
+            }
+
+        const Symbol* symbol = symbols_ != nullptr ? symbols_->find(text) : nullptr;
+        return symbol != nullptr && emit(Op::Push, symbol->address);
+    }
+};
+
+auto Expression::compile(std::string_view text, const SymbolTable* symbols)
+    -> std::expected<Expression, EmulatorError>
+{
+    return ExpressionParser(text, symbols).parse();
+}
+
+i32 Expression::evaluate(const CPU& cpu, const Memory& memory) const noexcept
+{
+    std::array<i32, MAX_DEPTH> stack{};
+    std::size_t                top = 0;
+
+    for (const Step& step : code_)
+        {
+            switch (step.op)
+                {
+                    case Op::Push:
+                        stack[top++] = step.operand;
+                        continue;
+                    case Op::A:
+                        stack[top++] = cpu.get_a();
+                        continue;
+                    case Op::X:
+                        stack[top++] = cpu.get_x();
+                        continue;
+                    case Op::Y:
+                        stack[top++] = cpu.get_y();
+                        continue;
+                    case Op::Sp:
+                        stack[top++] = cpu.get_sp();
+                        continue;
+                    case Op::Pc:
+                        stack[top++] = cpu.get_pc();
+                        continue;
+                    case Op::P:
+                        stack[top++] = cpu.get_flags().to_byte();
+                        continue;
+                    case Op::Peek:
+                        stack[top - 1] = memory.peek(static_cast<u16>(stack[top - 1]));
+                        continue;
+                    case Op::Negate:
+                        stack[top - 1] = wrap(0u - static_cast<u32>(stack[top - 1]));
+                        continue;
+                    case Op::Not:
+                        stack[top - 1] = stack[top - 1] == 0;
+                        continue;
+                    case Op::Complement:
+                        stack[top - 1] = ~stack[top - 1];
+                        continue;
+                    default:
+                        break;
+                }
+
+            const i32 rhs = stack[--top];
+            i32&      lhs = stack[top - 1];
+            switch (step.op)
+                {
+                    case Op::Add:
+                        lhs = wrap(static_cast<u32>(lhs) + static_cast<u32>(rhs));
+                        break;
+                    case Op::Subtract:
+                        lhs = wrap(static_cast<u32>(lhs) - static_cast<u32>(rhs));
+                        break;
+                    case Op::BitAnd:
+                        lhs &= rhs;
+                        break;
+                    case Op::BitOr:
+                        lhs |= rhs;
+                        break;
+                    case Op::BitXor:
+                        lhs ^= rhs;
+                        break;
+                    case Op::Equal:
+                        lhs = lhs == rhs;
+                        break;
+                    case Op::NotEqual:
+                        lhs = lhs != rhs;
+                        break;
+                    case Op::Less:
+                        lhs = lhs < rhs;
+                        break;
+                    case Op::LessEqual:
+                        lhs = lhs <= rhs;
+                        break;
+                    case Op::Greater:
+                        lhs = lhs > rhs;
+                        break;
+                    case Op::GreaterEqual:
+                        lhs = lhs >= rhs;
+                        break;
+                    case Op::LogicalAnd:
+                        lhs = lhs != 0 && rhs != 0;
+                        break;
+                    case Op::LogicalOr:
+                        lhs = lhs != 0 || rhs != 0;
+                        break;
+                    default:
+                        break;
+                }
+        }
+
+    return top == 0 ? 0 : stack[0];
+}
+
+bool BreakpointCondition::reached(const CPU& cpu, const Memory& memory) noexcept
+{
+    if (condition_ && !condition_->holds(cpu, memory))
+        return false;
+    return ++hit_count_ > ignore_count_;
+}
+
+}  // namespace cpu6502
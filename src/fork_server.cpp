@@ -0,0 +1,118 @@
+#include "cpu6502/fork_server.hpp"
+#include <cerrno>
+#include <cstdlib>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#define CPU6502_HAS_FORK 1
+#else
+#define CPU6502_HAS_FORK 0
+#endif
+
+namespace cpu6502
+{
+
+ForkServer::ForkServer(const CPU& cpu, const Memory& memory)
+    : cpu_(cpu), memory_(std::make_unique<Memory>(memory))
+{
+}
+
+auto ForkServer::boot(u16 marker_pc, u64 max_cycles) -> std::expected<RunResult, EmulatorError>
+{
+    StopCondition stop;
+    stop.max_cycles = max_cycles;
+    stop.stop_pc    = marker_pc;
+
+    auto result = cpu_.run(stop, *memory_);
+    if (!result)
+        return std::unexpected(result.error());
+
+    if (result->reason != StopReason::StopPc)
+        return std::unexpected(EmulatorError::MarkerNotReached);
+
+    ready_ = true;
+    return result;
+}
+
+auto ForkServer::clone_into(CPU& cpu, Memory& memory) const -> std::expected<void, EmulatorError>
+{
+    if (!ready_)
+        return std::unexpected(EmulatorError::NotBooted);
+
+    cpu    = cpu_;
+    memory = *memory_;
+    return {};
+}
+
+auto ForkServer::fork_run(const Body& body) const -> std::expected<int, EmulatorError>
+{
+    if (!ready_)
+        return std::unexpected(EmulatorError::NotBooted);
+
+#if CPU6502_HAS_FORK
+    // A child whose body threw says so with one byte here, apart from its exit status
+    int thrown[2];
+    if (::pipe(thrown) < 0)
+        return std::unexpected(EmulatorError::ForkFailed);
+
+    const pid_t pid = ::fork();
+    if (pid < 0)
+        {
+            ::close(thrown[0]);
+            ::close(thrown[1]);
+            return std::unexpected(EmulatorError::ForkFailed);
+        }
+
+    if (pid == 0)
+        {
+            // The child's view of memory_ is already a private copy-on-write mapping.
+            // Nothing may unwind out of here into the parent's copied stack.
+            ::close(thrown[0]);
+            try
+                {
+                    CPU cpu = cpu_;
+                    std::_Exit(body(cpu, *memory_) & 0xFF);
+                }
+            catch (...)
+                {
+                    const char byte = 1;
+                    (void)!::write(thrown[1], &byte, 1);
+                    std::_Exit(EXIT_FAILURE);
+                }
+        }
+
+    ::close(thrown[1]);
+
+    int status = 0;
+    while (::waitpid(pid, &status, 0) < 0)
+        {
+            if (errno != EINTR)
+                {
+                    ::close(thrown[0]);
+                    return std::unexpected(EmulatorError::ForkFailed);
+                }
+        }
+
+    // The child has exited, so this sees either its byte or end of file
+    char    byte = 0;
+    ssize_t got  = 0;
+    do
+        got = ::read(thrown[0], &byte, 1);
+    while (got < 0 && errno == EINTR);
+    ::close(thrown[0]);
+    if (got == 1)
+        return std::unexpected(EmulatorError::ForkBodyThrew);
+
+    if (WIFSIGNALED(status))
+        return 128 + WTERMSIG(status);
+
+    return WEXITSTATUS(status);
+#else
+    (void)body;
+    return std::unexpected(EmulatorError::ForkFailed);
+#endif
+}
+
+}  // namespace cpu6502
@@ -0,0 +1,211 @@
+#include "cpu6502/host_counters.hpp"
+#include <cerrno>
+#include <cstring>
+#include <format>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define CPU6502_HAS_PERF_EVENTS 1
+#else
+#define CPU6502_HAS_PERF_EVENTS 0
+#endif
+
+namespace cpu6502
+{
+
+namespace
+{
+
+constexpr const char* EVENT_NAMES[HOST_EVENT_COUNT] = {"cycles", "instructions", "branch-misses",
+                                                        "L1-icache-load-misses"};
+
+#if CPU6502_HAS_PERF_EVENTS
+
+[[nodiscard]] perf_event_attr attributes(HostEvent event) noexcept
+{
+    perf_event_attr attr{};
+    attr.size           = sizeof(attr);
+    attr.disabled       = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv     = 1;
+    attr.read_format    = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    switch (event)
+        {
+            case HostEvent::Cycles:
+                attr.type   = PERF_TYPE_HARDWARE;
+                attr.config = PERF_COUNT_HW_CPU_CYCLES;
+                break;
+            case HostEvent::Instructions:
+                attr.type   = PERF_TYPE_HARDWARE;
+                attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+                break;
+            case HostEvent::BranchMisses:
+                attr.type   = PERF_TYPE_HARDWARE;
+                attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+                break;
+            case HostEvent::L1iMisses:
+                attr.type   = PERF_TYPE_HW_CACHE;
+                attr.config = PERF_COUNT_HW_CACHE_L1I | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                              (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+                break;
+        }
+    return attr;
+}
+
+[[nodiscard]] int open_event(HostEvent event) noexcept
+{
+    perf_event_attr attr = attributes(event);
+    return static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+}
+
+#endif
+
+}  // namespace
+
+std::optional<double> HostMeasurement::per_instruction(HostEvent event) const noexcept
+{
+    const auto value = count(event);
+    if (!value || emulated_instructions == 0)
+        return std::nullopt;
+
+    return static_cast<double>(*value) / static_cast<double>(emulated_instructions);
+}
+
+std::optional<double> HostMeasurement::per_emulated_cycle(HostEvent event) const noexcept
+{
+    const auto value = count(event);
+    if (!value || emulated_cycles == 0)
+        return std::nullopt;
+
+    return static_cast<double>(*value) / static_cast<double>(emulated_cycles);
+}
+
+HostCounters::HostCounters()
+{
+    fds_.fill(-1);
+
+#if CPU6502_HAS_PERF_EVENTS
+    for (std::size_t i = 0; i < HOST_EVENT_COUNT; ++i)
+        {
+            fds_[i] = open_event(static_cast<HostEvent>(i));
+            if (fds_[i] < 0)
+                {
+                    reason_ += std::format("{}{}: {}", reason_.empty() ? "" : "; ",
+                                           EVENT_NAMES[i], std::strerror(errno));
+                }
+        }
+#else
+    reason_ = "perf events are only supported on Linux";
+#endif
+}
+
+HostCounters::~HostCounters()
+{
+#if CPU6502_HAS_PERF_EVENTS
+    for (const int fd : fds_)
+        {
+            if (fd >= 0)
+                ::close(fd);
+        }
+#endif
+}
+
+bool HostCounters::available(HostEvent event) const noexcept
+{
+    return fds_[static_cast<std::size_t>(event)] >= 0;
+}
+
+bool HostCounters::any_available() const noexcept
+{
+    for (const int fd : fds_)
+        {
+            if (fd >= 0)
+                return true;
+        }
+    return false;
+}
+
+void HostCounters::start() noexcept
+{
+#if CPU6502_HAS_PERF_EVENTS
+    for (const int fd : fds_)
+        {
+            if (fd < 0)
+                continue;
+            ::ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ::ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+}
+
+HostCounts HostCounters::stop() noexcept
+{
+    HostCounts counts{};
+
+#if CPU6502_HAS_PERF_EVENTS
+    for (const int fd : fds_)
+        {
+            if (fd >= 0)
+                ::ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        }
+
+    for (std::size_t i = 0; i < HOST_EVENT_COUNT; ++i)
+        {
+            if (fds_[i] < 0)
+                continue;
+
+            // value, time enabled, time running
+            u64 data[3] = {};
+            if (::read(fds_[i], data, sizeof(data)) != static_cast<ssize_t>(sizeof(data)))
+                continue;
+
+            if (data[2] == 0)
+                counts[i] = 0;  // Never scheduled on the PMU
+            else if (data[2] < data[1])
+                counts[i] = static_cast<u64>(static_cast<double>(data[0]) *
+                                             static_cast<double>(data[1]) /
+                                             static_cast<double>(data[2]));
+            else
+                counts[i] = data[0];
+        }
+#endif
+
+    return counts;
+}
+
+auto HostCounters::measure_execute(CPU& cpu, Memory& memory, i32 cycles)
+    -> std::expected<HostMeasurement, EmulatorError>
+{
+    start();
+    auto result = cpu.execute(cycles, memory);
+    HostMeasurement measurement;
+    measurement.counts = stop();
+
+    if (!result)
+        return std::unexpected(result.error());
+
+    measurement.emulated_cycles = static_cast<u64>(*result);
+    return measurement;
+}
+
+auto HostCounters::measure_run(CPU& cpu, Memory& memory, const StopCondition& stop_condition)
+    -> std::expected<HostMeasurement, EmulatorError>
+{
+    start();
+    auto result = cpu.run(stop_condition, memory);
+    HostMeasurement measurement;
+    measurement.counts = stop();
+
+    if (!result)
+        return std::unexpected(result.error());
+
+    measurement.emulated_cycles       = result->cycles;
+    measurement.emulated_instructions = result->instructions;
+    return measurement;
+}
+
+}  // namespace cpu6502
@@ -0,0 +1,345 @@
+#include "cpu6502/input_log.hpp"
+#include <algorithm>
+
+namespace cpu6502
+{
+
+namespace
+{
+
+// Tag byte: bits 0-1 kind, bit 2 IRQ level, bit 3 address repeats the previous read
+constexpr u8 TAG_KIND_MASK    = 0x03;
+constexpr u8 TAG_IRQ_ASSERTED = 0x04;
+constexpr u8 TAG_SAME_ADDRESS = 0x08;
+constexpr u8 TAG_VALID_MASK   = 0x0F;
+
+void put_varint(std::vector<u8>& out, u64 value)
+{
+    while (value >= 0x80)
+        {
+            out.push_back(static_cast<u8>(value | 0x80));
+            value >>= 7;
+        }
+    out.push_back(static_cast<u8>(value));
+}
+
+[[nodiscard]] bool get_varint(std::span<const u8> in, std::size_t& position, u64& value) noexcept
+{
+    value = 0;
+    for (unsigned shift = 0; shift < 64; shift += 7)
+        {
+            if (position >= in.size())
+                return false;
+
+            const u8 byte = in[position++];
+            value |= static_cast<u64>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0)
+                return true;
+        }
+    return false;
+}
+
+/**
+ * @type struct
+ * @brief Marks the recorder as inside a device access for its lifetime
+ */
+struct InDevice
+{
+    explicit InDevice(bool& flag) noexcept : flag_(flag) { flag_ = true; }
+    ~InDevice() { flag_ = false; }
+
+    InDevice(const InDevice&)            = delete;
+    InDevice& operator=(const InDevice&) = delete;
+
+    bool& flag_;
+};
+
+}  // namespace
+
+InputLog::InputLog(std::span<const u8> bytes) : bytes_(bytes.begin(), bytes.end())
+{
+    // Re-derive the append state and drop any torn record at the end
+    Reader      reader(*this);
+    InputEvent  event;
+    std::size_t valid = 0;
+    while (reader.next(event))
+        {
+            ++events_;
+            last_cycles_ = event.cycles;
+            if (event.kind == InputKind::IoRead)
+                last_address_ = event.address;
+            valid = reader.position_;
+        }
+    bytes_.resize(valid);
+}
+
+void InputLog::append(const InputEvent& event)
+{
+    u8 tag = static_cast<u8>(event.kind);
+    if (event.kind == InputKind::IrqLine && event.value != 0)
+        tag |= TAG_IRQ_ASSERTED;
+
+    const bool same_address =
+        event.kind == InputKind::IoRead && events_ != 0 && event.address == last_address_;
+    if (same_address)
+        tag |= TAG_SAME_ADDRESS;
+
+    bytes_.push_back(tag);
+    put_varint(bytes_, event.cycles - last_cycles_);
+
+    if (event.kind == InputKind::IoRead)
+        {
+            if (!same_address)
+                {
+                    bytes_.push_back(static_cast<u8>(event.address & 0xFF));
+                    bytes_.push_back(static_cast<u8>(event.address >> 8));
+                }
+            bytes_.push_back(event.value);
+            last_address_ = event.address;
+        }
+
+    last_cycles_ = event.cycles;
+    ++events_;
+}
+
+void InputLog::clear() noexcept
+{
+    bytes_.clear();
+    events_       = 0;
+    last_cycles_  = 0;
+    last_address_ = 0;
+}
+
+bool InputLog::Reader::next(InputEvent& event) noexcept
+{
+    const std::span<const u8> in = log_->bytes();
+    std::size_t               position = position_;
+    if (position >= in.size())
+        return false;
+
+    const u8 tag = in[position++];
+    if ((tag & ~TAG_VALID_MASK) != 0 || (tag & TAG_KIND_MASK) > static_cast<u8>(InputKind::Nmi))
+        return false;
+
+    u64 delta = 0;
+    if (!get_varint(in, position, delta))
+        return false;
+
+    InputEvent decoded;
+    decoded.cycles = cycles_ + delta;
+    decoded.kind   = static_cast<InputKind>(tag & TAG_KIND_MASK);
+
+    switch (decoded.kind)
+        {
+            case InputKind::IoRead:
+                if ((tag & TAG_SAME_ADDRESS) != 0)
+                    {
+                        decoded.address = last_address_;
+                    }
+                else
+                    {
+                        if (position + 2 > in.size())
+                            return false;
+                        decoded.address = static_cast<u16>(in[position] | (in[position + 1] << 8));
+                        position += 2;
+                    }
+
+                if (position >= in.size())
+                    return false;
+                decoded.value = in[position++];
+                last_address_ = decoded.address;
+                break;
+
+            case InputKind::IrqLine:
+                decoded.value = (tag & TAG_IRQ_ASSERTED) != 0 ? 1 : 0;
+                break;
+
+            case InputKind::Nmi:
+                break;
+        }
+
+    position_ = position;
+    cycles_   = decoded.cycles;
+    event     = decoded;
+    return true;
+}
+
+/**
+ * @type class
+ * @brief Forwards to the real device and logs what it returned
+ */
+class InputRecorder::Tap final : public IoDevice
+{
+ public:
+    Tap(InputRecorder& recorder, IoDevice& device) noexcept : recorder_(recorder), device_(device)
+    {
+    }
+
+    u8 read(u16 address) override
+    {
+        const InDevice scope(recorder_.in_device_);
+        const u8       value = device_.read(address);
+        recorder_.log_.append({recorder_.cpu_.get_cycles(), InputKind::IoRead, address, value});
+        return value;
+    }
+
+    void write(u16 address, u8 value) override
+    {
+        const InDevice scope(recorder_.in_device_);
+        device_.write(address, value);
+    }
+
+ private:
+    InputRecorder& recorder_;
+    IoDevice&      device_;
+};
+
+InputRecorder::InputRecorder(CPU& cpu, InputLog& log) noexcept : cpu_(cpu), log_(log) {}
+
+InputRecorder::~InputRecorder() = default;
+
+void InputRecorder::attach(Memory& memory, u8 page, IoDevice& device)
+{
+    taps_.push_back(std::make_unique<Tap>(*this, device));
+    memory.map_io(page, taps_.back().get());
+}
+
+auto InputRecorder::set_irq_line(bool asserted) -> std::expected<void, EmulatorError>
+{
+    if (in_device_)
+        return std::unexpected(EmulatorError::InterruptInsideInstruction);
+
+    log_.append({cpu_.get_cycles(), InputKind::IrqLine, 0, static_cast<u8>(asserted ? 1 : 0)});
+    cpu_.set_irq_line(asserted);
+    return {};
+}
+
+auto InputRecorder::trigger_nmi() -> std::expected<void, EmulatorError>
+{
+    if (in_device_)
+        return std::unexpected(EmulatorError::InterruptInsideInstruction);
+
+    log_.append({cpu_.get_cycles(), InputKind::Nmi, 0, 0});
+    cpu_.trigger_nmi();
+    return {};
+}
+
+/**
+ * @type class
+ * @brief Stand-in device answering reads from the log
+ */
+class InputReplayer::Source final : public IoDevice
+{
+ public:
+    explicit Source(InputReplayer& replayer) noexcept : replayer_(replayer) {}
+
+    u8   read(u16 address) override { return replayer_.serve_read(address); }
+    void write(u16, u8) override {}
+
+ private:
+    InputReplayer& replayer_;
+};
+
+InputReplayer::InputReplayer(CPU& cpu, const InputLog& log)
+    : cpu_(cpu),
+      io_reader_(log),
+      interrupt_reader_(log),
+      source_(std::make_unique<Source>(*this))
+{
+    advance_io();
+    advance_interrupt();
+}
+
+InputReplayer::~InputReplayer() = default;
+
+void InputReplayer::attach(Memory& memory, u8 page)
+{
+    memory.map_io(page, source_.get());
+}
+
+auto InputReplayer::run(const StopCondition& stop, Memory& memory)
+    -> std::expected<RunResult, EmulatorError>
+{
+    RunResult total{};
+
+    while (total.cycles < stop.max_cycles)
+        {
+            // Interrupts recorded at the current boundary take effect before the next instruction
+            while (has_interrupt_ && next_interrupt_.cycles <= cpu_.get_cycles())
+                {
+                    if (next_interrupt_.cycles < cpu_.get_cycles())
+                        diverged_ = true;
+
+                    if (next_interrupt_.kind == InputKind::Nmi)
+                        cpu_.trigger_nmi();
+                    else
+                        cpu_.set_irq_line(next_interrupt_.value != 0);
+                    advance_interrupt();
+                }
+
+            if (diverged_)
+                return std::unexpected(EmulatorError::ReplayDivergence);
+
+            StopCondition stretch = stop;
+            stretch.max_cycles    = stop.max_cycles - total.cycles;
+            if (has_interrupt_)
+                stretch.max_cycles =
+                    std::min(stretch.max_cycles, next_interrupt_.cycles - cpu_.get_cycles());
+
+            auto result = cpu_.run(stretch, memory);
+            if (!result)
+                return std::unexpected(result.error());
+
+            total.cycles += result->cycles;
+            total.instructions += result->instructions;
+            if (diverged_)
+                return std::unexpected(EmulatorError::ReplayDivergence);
+
+            if (result->reason != StopReason::CycleLimit)
+                {
+                    total.reason = result->reason;
+                    return total;
+                }
+        }
+
+    total.reason = StopReason::CycleLimit;
+    return total;
+}
+
+bool InputReplayer::finished() const noexcept
+{
+    return !has_io_ && !has_interrupt_;
+}
+
+void InputReplayer::advance_io() noexcept
+{
+    do
+        {
+            has_io_ = io_reader_.next(next_io_);
+        }
+    while (has_io_ && next_io_.kind != InputKind::IoRead);
+}
+
+void InputReplayer::advance_interrupt() noexcept
+{
+    do
+        {
+            has_interrupt_ = interrupt_reader_.next(next_interrupt_);
+        }
+    while (has_interrupt_ && next_interrupt_.kind == InputKind::IoRead);
+}
+
+auto InputReplayer::serve_read(u16 address) noexcept -> u8
+{
+    if (!has_io_ || next_io_.cycles != cpu_.get_cycles() || next_io_.address != address)
+        {
+            diverged_ = true;
+            return 0xFF;  // Open bus
+        }
+
+    const u8 value = next_io_.value;
+    advance_io();
+    return value;
+}
+
+}  // namespace cpu6502
@@ -0,0 +1,429 @@
+#include "cpu6502/loader.hpp"
+#include <algorithm>
+#include <array>
+#include <initializer_list>
+
+namespace cpu6502
+{
+
+namespace
+{
+
+using LoadResult = std::expected<LoadedImage, EmulatorError>;
+
+constexpr u8 NOT_HEX = 0xFF;
+
+constexpr std::array<u8, 256> HEX_VALUES = []
+{
+    std::array<u8, 256> values{};
+    values.fill(NOT_HEX);
+    for (u8 digit = 0; digit < 10; ++digit)
+        values['0' + digit] = digit;
+    for (u8 digit = 0; digit < 6; ++digit)
+        {
+            values['A' + digit] = static_cast<u8>(10 + digit);
+            values['a' + digit] = static_cast<u8>(10 + digit);
+        }
+    return values;
+}();
+
+void add_segment(LoadedImage& image, u16 address, u32 size)
+{
+    if (size == 0)
+        return;
+
+    if (!image.segments.empty())
+        {
+            ImageSegment& last = image.segments.back();
+            if (last.address + last.size == address)
+                {
+                    last.size += size;
+                    return;
+                }
+        }
+    image.segments.push_back({address, size});
+}
+
+// Copies bytes to address and records the segment
+auto place(LoadedImage& image, Memory& memory, u32 address, std::span<const u8> bytes)
+    -> std::expected<void, EmulatorError>
+{
+    if (address + bytes.size() > Memory::MAX_MEM)
+        return std::unexpected(EmulatorError::InvalidAddress);
+
+    std::ranges::copy(bytes, memory.data().begin() + address);
+    memory.rearm_traps(static_cast<u16>(address), bytes.size());
+    add_segment(image, static_cast<u16>(address), static_cast<u32>(bytes.size()));
+    return {};
+}
+
+[[nodiscard]] u16 read_le16(std::span<const u8> bytes, std::size_t offset) noexcept
+{
+    return static_cast<u16>(bytes[offset] | (bytes[offset + 1] << 8));
+}
+
+[[nodiscard]] constexpr bool is_blank(u8 c) noexcept
+{
+    return c == '\n' || c == '\r' || c == ' ' || c == '\t';
+}
+
+/**
+ * @type class
+ * @brief Reads the hex-encoded record formats one line at a time
+ *
+ * Keeps a running sum of the bytes read, for the record checksum.
+ */
+class HexReader
+{
+ public:
+    explicit HexReader(std::span<const u8> text) noexcept : text_(text) {}
+
+    // Skips line breaks and blanks; false at the end of the input
+    [[nodiscard]] bool next_record() noexcept
+    {
+        while (position_ < text_.size() && is_blank(text_[position_]))
+            ++position_;
+        return position_ < text_.size();
+    }
+
+    [[nodiscard]] bool accept(u8 c) noexcept
+    {
+        if (position_ >= text_.size() || text_[position_] != c)
+            return false;
+        ++position_;
+        return true;
+    }
+
+    [[nodiscard]] bool digit(u8& value) noexcept
+    {
+        if (position_ >= text_.size())
+            return false;
+        value = HEX_VALUES[text_[position_]];
+        ++position_;
+        return value != NOT_HEX;
+    }
+
+    [[nodiscard]] bool byte(u8& value) noexcept
+    {
+        if (position_ + 2 > text_.size())
+            return false;
+
+        const u8 high = HEX_VALUES[text_[position_]];
+        const u8 low  = HEX_VALUES[text_[position_ + 1]];
+        position_ += 2;
+        value = static_cast<u8>(high << 4 | low);
+        sum_ += value;
+        return high != NOT_HEX && low != NOT_HEX;
+    }
+
+    // Big-endian value of count bytes
+    [[nodiscard]] bool value(std::size_t count, u32& value) noexcept
+    {
+        value = 0;
+        for (std::size_t i = 0; i < count; ++i)
+            {
+                u8 part = 0;
+                if (!byte(part))
+                    return false;
+                value = value << 8 | part;
+            }
+        return true;
+    }
+
+    [[nodiscard]] u8 sum() const noexcept { return sum_; }
+    void             reset_sum() noexcept { sum_ = 0; }
+
+ private:
+    std::span<const u8> text_;
+    std::size_t         position_ = 0;
+    u8                  sum_      = 0;
+};
+
+// Decodes count data bytes straight into memory at address
+[[nodiscard]] auto read_data(HexReader& reader, LoadedImage& image, Memory& memory, u32 address,
+                             u32 count) -> std::expected<void, EmulatorError>
+{
+    if (address + count > Memory::MAX_MEM)
+        return std::unexpected(EmulatorError::InvalidAddress);
+
+    auto destination = memory.data().begin() + address;
+    for (u32 i = 0; i < count; ++i)
+        {
+            if (!reader.byte(destination[i]))
+                return std::unexpected(EmulatorError::InvalidImage);
+        }
+    memory.rearm_traps(static_cast<u16>(address), count);
+    add_segment(image, static_cast<u16>(address), count);
+    return {};
+}
+
+auto load_intel_hex(std::span<const u8> text, Memory& memory) -> LoadResult
+{
+    constexpr u8 DATA                  = 0x00;
+    constexpr u8 END_OF_FILE           = 0x01;
+    constexpr u8 EXTENDED_SEGMENT      = 0x02;
+    constexpr u8 START_SEGMENT_ADDRESS = 0x03;
+    constexpr u8 EXTENDED_LINEAR       = 0x04;
+    constexpr u8 START_LINEAR_ADDRESS  = 0x05;
+
+    LoadedImage image;
+    HexReader   reader(text);
+    u32         base = 0;
+    while (reader.next_record())
+        {
+            reader.reset_sum();
+
+            u8  count  = 0;
+            u32 offset = 0;
+            u8  type   = 0;
+            if (!reader.accept(':') || !reader.byte(count) || !reader.value(2, offset) ||
+                !reader.byte(type))
+                return std::unexpected(EmulatorError::InvalidImage);
+
+            u32 value = 0;
+            switch (type)
+                {
+                    case DATA:
+                        if (auto read = read_data(reader, image, memory, base + offset, count);
+                            !read)
+                            return std::unexpected(read.error());
+                        break;
+                    case END_OF_FILE:
+                        break;
+                    case EXTENDED_SEGMENT:
+                    case EXTENDED_LINEAR:
+                        if (count != 2 || !reader.value(2, value))
+                            return std::unexpected(EmulatorError::InvalidImage);
+                        base = type == EXTENDED_SEGMENT ? value << 4 : value << 16;
+                        break;
+                    case START_SEGMENT_ADDRESS:
+                    case START_LINEAR_ADDRESS:
+                        if (count != 4 || !reader.value(4, value))
+                            return std::unexpected(EmulatorError::InvalidImage);
+                        if (type == START_SEGMENT_ADDRESS)
+                            value = (value >> 16 << 4) + (value & 0xFFFF);  // CS:IP
+                        if (value > 0xFFFF)
+                            return std::unexpected(EmulatorError::InvalidAddress);
+                        image.start = static_cast<u16>(value);
+                        break;
+                    default:
+                        return std::unexpected(EmulatorError::InvalidImage);
+                }
+
+            u8 checksum = 0;
+            if (!reader.byte(checksum) || reader.sum() != 0)
+                return std::unexpected(EmulatorError::InvalidImage);
+            if (type == END_OF_FILE)
+                break;
+        }
+    return image;
+}
+
+// S9/S8/S7 with address 0 is what most tools write when there is no entry point,
+// so it is not reported as a start address
+auto load_srecord(std::span<const u8> text, Memory& memory) -> LoadResult
+{
+    LoadedImage image;
+    HexReader   reader(text);
+    while (reader.next_record())
+        {
+            u8 type = 0;
+            if (!reader.accept('S') || !reader.digit(type) || type == 4 || type > 9)
+                return std::unexpected(EmulatorError::InvalidImage);
+            reader.reset_sum();
+
+            // Address bytes by record type
+            constexpr std::array<u8, 10> ADDRESS_SIZE = {2, 2, 3, 4, 0, 2, 3, 4, 3, 2};
+            const u8                     address_size = ADDRESS_SIZE[type];
+
+            u8  count   = 0;
+            u32 address = 0;
+            if (!reader.byte(count) || count < address_size + 1 ||
+                !reader.value(address_size, address))
+                return std::unexpected(EmulatorError::InvalidImage);
+
+            const u32 data_size = count - address_size - 1u;
+            if (type >= 1 && type <= 3)
+                {
+                    if (auto read = read_data(reader, image, memory, address, data_size); !read)
+                        return std::unexpected(read.error());
+                }
+            else
+                {
+                    u32 ignored = 0;
+                    for (u32 i = 0; i < data_size; ++i)
+                        {
+                            if (!reader.value(1, ignored))
+                                return std::unexpected(EmulatorError::InvalidImage);
+                        }
+                }
+
+            if (type >= 7 && address != 0)
+                {
+                    if (address > 0xFFFF)
+                        return std::unexpected(EmulatorError::InvalidAddress);
+                    image.start = static_cast<u16>(address);
+                }
+
+            const u8 expected = static_cast<u8>(~reader.sum());
+            u8       checksum = 0;
+            if (!reader.byte(checksum) || checksum != expected)
+                return std::unexpected(EmulatorError::InvalidImage);
+        }
+    return image;
+}
+
+auto load_prg(std::span<const u8> bytes, Memory& memory) -> LoadResult
+{
+    if (bytes.size() < 2)
+        return std::unexpected(EmulatorError::InvalidImage);
+
+    LoadedImage image;
+    if (auto placed = place(image, memory, read_le16(bytes, 0), bytes.subspan(2)); !placed)
+        return std::unexpected(placed.error());
+    return image;
+}
+
+auto load_o65(std::span<const u8> bytes, Memory& memory) -> LoadResult
+{
+    constexpr std::array<u8, 6> MAGIC        = {0x01, 0x00, 'o', '6', '5', 0x00};
+    constexpr u16               MODE_65816   = 0x8000;
+    constexpr u16               MODE_32BIT   = 0x2000;
+    constexpr u16               MODE_OBJECT  = 0x1000;
+    constexpr u16               MODE_BSSZERO = 0x0200;
+    constexpr std::size_t       HEADER_SIZE  = 26;  // Magic, mode and nine 16-bit fields
+
+    if (bytes.size() < HEADER_SIZE || !std::ranges::equal(bytes.first(MAGIC.size()), MAGIC))
+        return std::unexpected(EmulatorError::InvalidImage);
+
+    // Only 6502 executables with 16-bit fields describe something Memory can hold
+    const u16 mode = read_le16(bytes, 6);
+    if ((mode & (MODE_65816 | MODE_32BIT | MODE_OBJECT)) != 0)
+        return std::unexpected(EmulatorError::InvalidImage);
+
+    const u16 text_base = read_le16(bytes, 8);
+    const u16 text_size = read_le16(bytes, 10);
+    const u16 data_base = read_le16(bytes, 12);
+    const u16 data_size = read_le16(bytes, 14);
+    const u16 bss_base  = read_le16(bytes, 16);
+    const u16 bss_size  = read_le16(bytes, 18);
+
+    // Header options: length byte (counting itself), type, data; a zero length ends them
+    std::size_t position = HEADER_SIZE;
+    while (position < bytes.size() && bytes[position] != 0)
+        position += bytes[position];
+    ++position;
+
+    if (position + text_size + data_size + 2 > bytes.size())
+        return std::unexpected(EmulatorError::InvalidImage);
+
+    LoadedImage image;
+    if (auto placed = place(image, memory, text_base, bytes.subspan(position, text_size));
+        !placed)
+        return std::unexpected(placed.error());
+    position += text_size;
+
+    if (auto placed = place(image, memory, data_base, bytes.subspan(position, data_size));
+        !placed)
+        return std::unexpected(placed.error());
+    position += data_size;
+
+    // Undefined references would need a linker
+    if (read_le16(bytes, position) != 0)
+        return std::unexpected(EmulatorError::InvalidImage);
+
+    if ((mode & MODE_BSSZERO) != 0 && bss_size != 0)
+        {
+            if (u32{bss_base} + bss_size > Memory::MAX_MEM)
+                return std::unexpected(EmulatorError::InvalidAddress);
+            std::fill_n(memory.data().begin() + bss_base, bss_size, u8{0});
+            memory.rearm_traps(bss_base, bss_size);
+            add_segment(image, bss_base, bss_size);
+        }
+    return image;
+}
+
+[[nodiscard]] bool ends_with_any(std::string_view path,
+                                 std::initializer_list<std::string_view> suffixes) noexcept
+{
+    return std::ranges::any_of(suffixes, [path](std::string_view suffix)
+                               { return path.ends_with(suffix); });
+}
+
+}  // namespace
+
+auto load_image(std::span<const u8> bytes, ImageFormat format, Memory& memory,
+                const LoadOptions& options) -> std::expected<LoadedImage, EmulatorError>
+{
+    LoadResult result;
+    switch (format)
+        {
+            case ImageFormat::Raw:
+                {
+                    LoadedImage image;
+                    if (auto placed = place(image, memory, options.raw_address, bytes); !placed)
+                        return std::unexpected(placed.error());
+                    result = std::move(image);
+                    break;
+                }
+            case ImageFormat::IntelHex:
+                result = load_intel_hex(bytes, memory);
+                break;
+            case ImageFormat::SRecord:
+                result = load_srecord(bytes, memory);
+                break;
+            case ImageFormat::Prg:
+                result = load_prg(bytes, memory);
+                break;
+            case ImageFormat::O65:
+                result = load_o65(bytes, memory);
+                break;
+        }
+
+    if (result && result->start && options.set_reset_vector)
+        {
+            memory[0xFFFC] = static_cast<u8>(*result->start & 0xFF);
+            memory[0xFFFD] = static_cast<u8>(*result->start >> 8);
+            memory.rearm_traps(0xFFFC, 2);
+        }
+    return result;
+}
+
+ImageFormat detect_image_format(std::string_view path, std::span<const u8> bytes) noexcept
+{
+    if (bytes.size() >= 5 && bytes[0] == 0x01 && bytes[1] == 0x00 && bytes[2] == 'o' &&
+        bytes[3] == '6' && bytes[4] == '5')
+        return ImageFormat::O65;
+    if (bytes.size() >= 11 && bytes[0] == ':' && HEX_VALUES[bytes[1]] != NOT_HEX)
+        return ImageFormat::IntelHex;
+    if (bytes.size() >= 10 && bytes[0] == 'S' && bytes[1] >= '0' && bytes[1] <= '9' &&
+        HEX_VALUES[bytes[2]] != NOT_HEX)
+        return ImageFormat::SRecord;
+
+    if (ends_with_any(path, {".prg", ".PRG"}))
+        return ImageFormat::Prg;
+    if (ends_with_any(path, {".o65"}))
+        return ImageFormat::O65;
+    if (ends_with_any(path, {".hex", ".ihex", ".ihx"}))
+        return ImageFormat::IntelHex;
+    if (ends_with_any(path, {".srec", ".s19", ".s28", ".s37", ".mot"}))
+        return ImageFormat::SRecord;
+    return ImageFormat::Raw;
+}
+
+std::optional<ImageFormat> parse_image_format(std::string_view name) noexcept
+{
+    if (name == "raw")
+        return ImageFormat::Raw;
+    if (name == "ihex")
+        return ImageFormat::IntelHex;
+    if (name == "srec")
+        return ImageFormat::SRecord;
+    if (name == "prg")
+        return ImageFormat::Prg;
+    if (name == "o65")
+        return ImageFormat::O65;
+    return std::nullopt;
+}
+
+}  // namespace cpu6502
@@ -0,0 +1,1034 @@
+#include "cpu6502/lockstep.hpp"
+#include "cpu6502/cpu.hpp"
+#include "cpu6502/opcodes.hpp"
+
+namespace cpu6502
+{
+
+namespace
+{
+
+// Lane masks are 0x00/0xFF bytes so selects become vector blends
+[[nodiscard]] constexpr u8 select(u8 mask, u8 if_set, u8 if_clear) noexcept
+{
+    return static_cast<u8>((if_set & mask) | (if_clear & ~mask));
+}
+
+[[nodiscard]] constexpr u8 to_flag(bool value) noexcept
+{
+    return value ? u8{1} : u8{0};
+}
+
+[[nodiscard]] constexpr bool page_crossed(u16 base_addr, u16 effective_addr) noexcept
+{
+    return (base_addr & 0xFF00) != (effective_addr & 0xFF00);
+}
+
+// Instruction length and cycle count per addressing mode, in Mode order
+constexpr std::array<u16, 9> READ_LENGTH = {2, 2, 2, 2, 3, 3, 3, 2, 2};
+constexpr std::array<u64, 9> READ_CYCLES = {2, 3, 4, 4, 4, 4, 4, 6, 5};
+
+// Read-modify-write only exists for ZeroPage, ZeroPageX, Absolute and AbsoluteX
+constexpr std::array<u16, 9> MODIFY_LENGTH = {0, 2, 2, 0, 3, 3, 0, 0, 0};
+constexpr std::array<u64, 9> MODIFY_CYCLES = {0, 5, 6, 0, 6, 7, 0, 0, 0};
+
+}  // namespace
+
+template <std::size_t Lanes>
+LockstepEngine<Lanes>::LockstepEngine(const Memory& image) : image_(image)
+{
+}
+
+template <std::size_t Lanes>
+u8 LockstepEngine<Lanes>::read(std::size_t lane, u16 address) const noexcept
+{
+    if (address < 0x0100)
+        return zero_page_[static_cast<u8>(address)][lane];
+    if (address < 0x0200)
+        return stack_page_[static_cast<u8>(address)][lane];
+    return image_.peek(address);
+}
+
+template <std::size_t Lanes>
+void LockstepEngine<Lanes>::write(std::size_t lane, u16 address, u8 value) noexcept
+{
+    if (address < 0x0100)
+        zero_page_[static_cast<u8>(address)][lane] = value;
+    else
+        stack_page_[static_cast<u8>(address)][lane] = value;
+}
+
+template <std::size_t Lanes>
+Registers LockstepEngine<Lanes>::lane_registers(std::size_t lane) const noexcept
+{
+    StatusFlags flags;
+    flags.carry     = carry_[lane] != 0;
+    flags.zero      = zero_[lane] != 0;
+    flags.interrupt = interrupt_[lane] != 0;
+    flags.decimal   = decimal_[lane] != 0;
+    flags.brk       = brk_[lane] != 0;
+    flags.overflow  = overflow_[lane] != 0;
+    flags.negative  = negative_[lane] != 0;
+
+    return Registers{pc_[lane], sp_[lane], a_[lane], x_[lane], y_[lane], flags};
+}
+
+template <std::size_t Lanes>
+void LockstepEngine<Lanes>::run(std::span<const LockstepJob> jobs, const StopCondition& stop,
+                                std::span<LockstepResult> results)
+{
+    const std::size_t count = std::min({jobs.size(), results.size(), Lanes});
+
+    stop_       = &stop;
+    results_    = results.first(count);
+    solo_steps_ = 0;
+
+    for (std::size_t address = 0; address < 256; ++address)
+        {
+            zero_page_[address].fill(image_.peek(static_cast<u16>(address)));
+            stack_page_[address].fill(image_.peek(static_cast<u16>(0x0100 + address)));
+        }
+
+    for (std::size_t lane = 0; lane < Lanes; ++lane)
+        {
+            if (lane >= count)
+                {
+                    active_[lane] = 0;
+                    continue;
+                }
+
+            const LockstepJob& job = jobs[lane];
+            pc_[lane]              = job.registers.pc;
+            sp_[lane]              = job.registers.sp;
+            a_[lane]               = job.registers.a;
+            x_[lane]               = job.registers.x;
+            y_[lane]               = job.registers.y;
+            carry_[lane]           = to_flag(job.registers.flags.carry);
+            zero_[lane]            = to_flag(job.registers.flags.zero);
+            interrupt_[lane]       = to_flag(job.registers.flags.interrupt);
+            decimal_[lane]         = to_flag(job.registers.flags.decimal);
+            brk_[lane]             = to_flag(job.registers.flags.brk);
+            overflow_[lane]        = to_flag(job.registers.flags.overflow);
+            negative_[lane]        = to_flag(job.registers.flags.negative);
+            cycles_[lane]          = 0;
+            instructions_[lane]    = 0;
+            active_[lane]          = 0xFF;
+
+            const std::size_t bytes = std::min<std::size_t>(job.zero_page.size(), 256);
+            for (std::size_t address = 0; address < bytes; ++address)
+                {
+                    zero_page_[address][lane] = job.zero_page[address];
+                }
+
+            results_[lane].scalar_fallback = false;
+        }
+
+    while (true)
+        {
+            // Issue the group with the lowest PC first so forward branches reconverge
+            u32         group_pc  = 0x10000;
+            std::size_t remaining = 0;
+            std::size_t last      = 0;
+            for (std::size_t lane = 0; lane < Lanes; ++lane)
+                {
+                    if (active_[lane] != 0)
+                        {
+                            group_pc = std::min<u32>(group_pc, pc_[lane]);
+                            last     = lane;
+                            ++remaining;
+                        }
+                }
+
+            if (remaining == 0)
+                break;
+
+            // A lone lane gains nothing from the vector path
+            if (remaining == 1)
+                {
+                    fall_back(last);
+                    continue;
+                }
+
+            // Stop conditions, checked in the same order as CPU::run
+            Lane8       mask{};
+            std::size_t group = 0;
+            for (std::size_t lane = 0; lane < Lanes; ++lane)
+                {
+                    if (active_[lane] == 0 || pc_[lane] != group_pc)
+                        continue;
+
+                    const auto pc = static_cast<u16>(group_pc);
+                    if (cycles_[lane] >= stop.max_cycles)
+                        finish(lane, StopReason::CycleLimit);
+                    else if (stop.stop_pc && pc == *stop.stop_pc)
+                        finish(lane, StopReason::StopPc);
+                    else if (image_.is_trap(pc))
+                        finish(lane, StopReason::Breakpoint);
+                    else if (stop.stop_on_brk && read(lane, pc) == static_cast<u8>(Opcode::BRK))
+                        finish(lane, StopReason::Brk);
+                    else
+                        {
+                            mask[lane] = 0xFF;
+                            ++group;
+                        }
+                }
+
+            if (group == 0)
+                continue;
+
+            solo_steps_ = group == 1 ? solo_steps_ + 1 : 0;
+            if (solo_steps_ >= DIVERGENCE_LIMIT)
+                {
+                    fall_back_divergent();
+                    solo_steps_ = 0;
+                    continue;
+                }
+
+            if (!issue(static_cast<u16>(group_pc), mask))
+                fall_back(mask);
+        }
+}
+
+template <std::size_t Lanes>
+void LockstepEngine<Lanes>::finish(std::size_t lane, StopReason reason)
+{
+    LockstepResult& result = results_[lane];
+    result.outcome         = RunResult{reason, cycles_[lane], instructions_[lane]};
+    result.registers       = lane_registers(lane);
+    for (std::size_t address = 0; address < 256; ++address)
+        {
+            result.zero_page[address] = zero_page_[address][lane];
+        }
+
+    active_[lane] = 0;
+}
+
+template <std::size_t Lanes>
+void LockstepEngine<Lanes>::fall_back(std::size_t lane)
+{
+    if (!scratch_)
+        scratch_ = std::make_unique<Memory>();
+
+    Memory& memory = *scratch_;
+    memory         = image_;
+
+    // Through write_byte so breakpoint traps in the two pages stay armed
+    std::expected<void, EmulatorError> copied;
+    for (std::size_t offset = 0; offset < 256 && copied; ++offset)
+        {
+            const auto zero  = static_cast<u16>(offset);
+            const auto stack = static_cast<u16>(0x0100 + offset);
+            copied           = memory.write_byte(zero, zero_page_[offset][lane]);
+            if (copied)
+                copied = memory.write_byte(stack, stack_page_[offset][lane]);
+        }
+
+    CPU cpu;
+    cpu.set_registers(lane_registers(lane));
+
+    StopCondition remaining = *stop_;
+    remaining.max_cycles =
+        stop_->max_cycles > cycles_[lane] ? stop_->max_cycles - cycles_[lane] : 0;
+
+    using Outcome           = std::expected<RunResult, EmulatorError>;
+    const Outcome   outcome = copied ? cpu.run(remaining, memory)
+                                     : Outcome(std::unexpected(copied.error()));
+    LockstepResult& result  = results_[lane];
+    if (outcome)
+        {
+            result.outcome = RunResult{outcome->reason, outcome->cycles + cycles_[lane],
+                                       outcome->instructions + instructions_[lane]};
+        }
+    else
+        {
+            result.outcome = std::unexpected(outcome.error());
+        }
+
+    result.registers = cpu.get_registers();
+    for (std::size_t address = 0; address < 256; ++address)
+        {
+            result.zero_page[address] = memory.peek(static_cast<u16>(address));
+        }
+    result.scalar_fallback = true;
+
+    active_[lane] = 0;
+    ++stats_.scalar_fallbacks;
+}
+
+template <std::size_t Lanes>
+void LockstepEngine<Lanes>::fall_back(const Lane8& mask)
+{
+    for (std::size_t lane = 0; lane < Lanes; ++lane)
+        {
+            if (mask[lane] != 0)
+                fall_back(lane);
+        }
+}
+
+template <std::size_t Lanes>
+void LockstepEngine<Lanes>::fall_back_divergent()
+{
+    // Only lanes alone at their PC leave; lanes that still share a PC stay vectorised
+    Lane8 alone{};
+    for (std::size_t lane = 0; lane < Lanes; ++lane)
+        {
+            if (active_[lane] == 0)
+                continue;
+
+            alone[lane] = 0xFF;
+            for (std::size_t other = 0; other < Lanes; ++other)
+                {
+                    if (other != lane && active_[other] != 0 && pc_[other] == pc_[lane])
+                        {
+                            alone[lane] = 0;
+                            break;
+                        }
+                }
+        }
+
+    fall_back(alone);
+}
+
+template <std::size_t Lanes>
+bool LockstepEngine<Lanes>::issue(u16 pc, Lane8& mask)
+{
+    // Code must come from the shared image so operand bytes are the same on every lane
+    if (pc < 0x0200 || pc > 0xFFFD)
+        return false;
+
+    // A breakpoint trap reads as TRAP_OPCODE and sends the lanes to the scalar path
+    const u8  opcode  = image_[pc];
+    const u8  operand = image_.peek(static_cast<u16>(pc + 1));
+    const u16 word    = static_cast<u16>(operand | (image_.peek(static_cast<u16>(pc + 2)) << 8));
+
+    switch (static_cast<Opcode>(opcode))
+        {
+                // Load Accumulator
+
+            case Opcode::LDA_IM:
+                execute_read(ReadOp::Lda, Mode::Immediate, operand, word, mask);
+                break;
+
+            case Opcode::LDA_ZP:
+                execute_read(ReadOp::Lda, Mode::ZeroPage, operand, word, mask);
+                break;
+
+            case Opcode::LDA_ZPX:
+                execute_read(ReadOp::Lda, Mode::ZeroPageX, operand, word, mask);
+                break;
+
+            case Opcode::LDA_ABS:
+                execute_read(ReadOp::Lda, Mode::Absolute, operand, word, mask);
+                break;
+
+            case Opcode::LDA_ABSX:
+                execute_read(ReadOp::Lda, Mode::AbsoluteX, operand, word, mask);
+                break;
+
+            case Opcode::LDA_ABSY:
+                execute_read(ReadOp::Lda, Mode::AbsoluteY, operand, word, mask);
+                break;
+
+                // Load X Register
+
+            case Opcode::LDX_IM:
+                execute_read(ReadOp::Ldx, Mode::Immediate, operand, word, mask);
+                break;
+
+            case Opcode::LDX_ZP:
+                execute_read(ReadOp::Ldx, Mode::ZeroPage, operand, word, mask);
+                break;
+
+            case Opcode::LDX_ZPY:
+                execute_read(ReadOp::Ldx, Mode::ZeroPageY, operand, word, mask);
+                break;
+
+            case Opcode::LDX_ABS:
+                execute_read(ReadOp::Ldx, Mode::Absolute, operand, word, mask);
+                break;
+
+            case Opcode::LDX_ABSY:
+                execute_read(ReadOp::Ldx, Mode::AbsoluteY, operand, word, mask);
+                break;
+
+                // Load Y Register
+
+            case Opcode::LDY_IM:
+                execute_read(ReadOp::Ldy, Mode::Immediate, operand, word, mask);
+                break;
+
+            case Opcode::LDY_ZP:
+                execute_read(ReadOp::Ldy, Mode::ZeroPage, operand, word, mask);
+                break;
+
+            case Opcode::LDY_ZPX:
+                execute_read(ReadOp::Ldy, Mode::ZeroPageX, operand, word, mask);
+                break;
+
+            case Opcode::LDY_ABS:
+                execute_read(ReadOp::Ldy, Mode::Absolute, operand, word, mask);
+                break;
+
+            case Opcode::LDY_ABSX:
+                execute_read(ReadOp::Ldy, Mode::AbsoluteX, operand, word, mask);
+                break;
+
+                // Add With Carry
+
+            case Opcode::ADC_IM:
+                execute_read(ReadOp::Adc, Mode::Immediate, operand, word, mask);
+                break;
+
+            case Opcode::ADC_ZP:
+                execute_read(ReadOp::Adc, Mode::ZeroPage, operand, word, mask);
+                break;
+
+            case Opcode::ADC_ZPX:
+                execute_read(ReadOp::Adc, Mode::ZeroPageX, operand, word, mask);
+                break;
+
+            case Opcode::ADC_ABS:
+                execute_read(ReadOp::Adc, Mode::Absolute, operand, word, mask);
+                break;
+
+            case Opcode::ADC_ABSX:
+                execute_read(ReadOp::Adc, Mode::AbsoluteX, operand, word, mask);
+                break;
+
+            case Opcode::ADC_ABSY:
+                execute_read(ReadOp::Adc, Mode::AbsoluteY, operand, word, mask);
+                break;
+
+            case Opcode::ADC_INDX:
+                execute_read(ReadOp::Adc, Mode::IndirectX, operand, word, mask);
+                break;
+
+            case Opcode::ADC_INDY:
+                execute_read(ReadOp::Adc, Mode::IndirectY, operand, word, mask);
+                break;
+
+                // Logical AND
+
+            case Opcode::AND_IM:
+                execute_read(ReadOp::And, Mode::Immediate, operand, word, mask);
+                break;
+
+            case Opcode::AND_ZP:
+                execute_read(ReadOp::And, Mode::ZeroPage, operand, word, mask);
+                break;
+
+            case Opcode::AND_ZPX:
+                execute_read(ReadOp::And, Mode::ZeroPageX, operand, word, mask);
+                break;
+
+            case Opcode::AND_ABS:
+                execute_read(ReadOp::And, Mode::Absolute, operand, word, mask);
+                break;
+
+            case Opcode::AND_ABSX:
+                execute_read(ReadOp::And, Mode::AbsoluteX, operand, word, mask);
+                break;
+
+            case Opcode::AND_ABSY:
+                execute_read(ReadOp::And, Mode::AbsoluteY, operand, word, mask);
+                break;
+
+            case Opcode::AND_INDX:
+                execute_read(ReadOp::And, Mode::IndirectX, operand, word, mask);
+                break;
+
+            case Opcode::AND_INDY:
+                execute_read(ReadOp::And, Mode::IndirectY, operand, word, mask);
+                break;
+
+                // Exclusive OR
+
+            case Opcode::EOR_IM:
+                execute_read(ReadOp::Eor, Mode::Immediate, operand, word, mask);
+                break;
+
+            case Opcode::EOR_ZP:
+                execute_read(ReadOp::Eor, Mode::ZeroPage, operand, word, mask);
+                break;
+
+            case Opcode::EOR_ZPX:
+                execute_read(ReadOp::Eor, Mode::ZeroPageX, operand, word, mask);
+                break;
+
+            case Opcode::EOR_ABS:
+                execute_read(ReadOp::Eor, Mode::Absolute, operand, word, mask);
+                break;
+
+            case Opcode::EOR_ABSX:
+                execute_read(ReadOp::Eor, Mode::AbsoluteX, operand, word, mask);
+                break;
+
+            case Opcode::EOR_ABSY:
+                execute_read(ReadOp::Eor, Mode::AbsoluteY, operand, word, mask);
+                break;
+
+            case Opcode::EOR_INDX:
+                execute_read(ReadOp::Eor, Mode::IndirectX, operand, word, mask);
+                break;
+
+            case Opcode::EOR_INDY:
+                execute_read(ReadOp::Eor, Mode::IndirectY, operand, word, mask);
+                break;
+
+                // Compare
+
+            case Opcode::CMP_IM:
+                execute_read(ReadOp::Cmp, Mode::Immediate, operand, word, mask);
+                break;
+
+            case Opcode::CMP_ZP:
+                execute_read(ReadOp::Cmp, Mode::ZeroPage, operand, word, mask);
+                break;
+
+            case Opcode::CMP_ZPX:
+                execute_read(ReadOp::Cmp, Mode::ZeroPageX, operand, word, mask);
+                break;
+
+            case Opcode::CMP_ABS:
+                execute_read(ReadOp::Cmp, Mode::Absolute, operand, word, mask);
+                break;
+
+            case Opcode::CMP_ABSX:
+                execute_read(ReadOp::Cmp, Mode::AbsoluteX, operand, word, mask);
+                break;
+
+            case Opcode::CMP_ABSY:
+                execute_read(ReadOp::Cmp, Mode::AbsoluteY, operand, word, mask);
+                break;
+
+            case Opcode::CMP_INDX:
+                execute_read(ReadOp::Cmp, Mode::IndirectX, operand, word, mask);
+                break;
+
+            case Opcode::CMP_INDY:
+                execute_read(ReadOp::Cmp, Mode::IndirectY, operand, word, mask);
+                break;
+
+            case Opcode::CPX_IM:
+                execute_read(ReadOp::Cpx, Mode::Immediate, operand, word, mask);
+                break;
+
+            case Opcode::CPX_ZP:
+                execute_read(ReadOp::Cpx, Mode::ZeroPage, operand, word, mask);
+                break;
+
+            case Opcode::CPX_ABS:
+                execute_read(ReadOp::Cpx, Mode::Absolute, operand, word, mask);
+                break;
+
+            case Opcode::CPY_IM:
+                execute_read(ReadOp::Cpy, Mode::Immediate, operand, word, mask);
+                break;
+
+            case Opcode::CPY_ZP:
+                execute_read(ReadOp::Cpy, Mode::ZeroPage, operand, word, mask);
+                break;
+
+            case Opcode::CPY_ABS:
+                execute_read(ReadOp::Cpy, Mode::Absolute, operand, word, mask);
+                break;
+
+                // Bit Test
+
+            case Opcode::BIT_ZP:
+                execute_read(ReadOp::Bit, Mode::ZeroPage, operand, word, mask);
+                break;
+
+            case Opcode::BIT_ABS:
+                execute_read(ReadOp::Bit, Mode::Absolute, operand, word, mask);
+                break;
+
+                // Arithmetic Shift Left
+
+            case Opcode::ASL_A:
+                for (std::size_t lane = 0; lane < Lanes; ++lane)
+                    {
+                        const auto result = static_cast<u8>(a_[lane] << 1);
+                        carry_[lane]      = select(mask[lane], a_[lane] >> 7, carry_[lane]);
+                        a_[lane]          = select(mask[lane], result, a_[lane]);
+                        zero_[lane]       = select(mask[lane], to_flag(result == 0), zero_[lane]);
+                        negative_[lane]   = select(mask[lane], result >> 7, negative_[lane]);
+                    }
+                retire(mask, 1, 2);
+                break;
+
+            case Opcode::ASL_ZP:
+                execute_modify(ModifyOp::Asl, Mode::ZeroPage, operand, word, mask);
+                break;
+
+            case Opcode::ASL_ZPX:
+                execute_modify(ModifyOp::Asl, Mode::ZeroPageX, operand, word, mask);
+                break;
+
+            case Opcode::ASL_ABS:
+                execute_modify(ModifyOp::Asl, Mode::Absolute, operand, word, mask);
+                break;
+
+            case Opcode::ASL_ABSX:
+                execute_modify(ModifyOp::Asl, Mode::AbsoluteX, operand, word, mask);
+                break;
+
+                // Increment and Decrement Memory
+
+            case Opcode::INC_ZP:
+                execute_modify(ModifyOp::Inc, Mode::ZeroPage, operand, word, mask);
+                break;
+
+            case Opcode::INC_ZPX:
+                execute_modify(ModifyOp::Inc, Mode::ZeroPageX, operand, word, mask);
+                break;
+
+            case Opcode::INC_ABS:
+                execute_modify(ModifyOp::Inc, Mode::Absolute, operand, word, mask);
+                break;
+
+            case Opcode::INC_ABSX:
+                execute_modify(ModifyOp::Inc, Mode::AbsoluteX, operand, word, mask);
+                break;
+
+            case Opcode::DEC_ZP:
+                execute_modify(ModifyOp::Dec, Mode::ZeroPage, operand, word, mask);
+                break;
+
+            case Opcode::DEC_ZPX:
+                execute_modify(ModifyOp::Dec, Mode::ZeroPageX, operand, word, mask);
+                break;
+
+            case Opcode::DEC_ABS:
+                execute_modify(ModifyOp::Dec, Mode::Absolute, operand, word, mask);
+                break;
+
+            case Opcode::DEC_ABSX:
+                execute_modify(ModifyOp::Dec, Mode::AbsoluteX, operand, word, mask);
+                break;
+
+                // Increment and Decrement Registers
+
+            case Opcode::INX:
+            case Opcode::INY:
+            case Opcode::DEX:
+            case Opcode::DEY:
+                {
+                    const bool is_x  = opcode == static_cast<u8>(Opcode::INX) ||
+                                      opcode == static_cast<u8>(Opcode::DEX);
+                    const u8   delta = opcode == static_cast<u8>(Opcode::INX) ||
+                                             opcode == static_cast<u8>(Opcode::INY)
+                                         ? u8{0x01}
+                                         : u8{0xFF};
+                    Lane8&     reg   = is_x ? x_ : y_;
+                    for (std::size_t lane = 0; lane < Lanes; ++lane)
+                        {
+                            const auto result = static_cast<u8>(reg[lane] + delta);
+                            reg[lane]         = select(mask[lane], result, reg[lane]);
+                            zero_[lane] = select(mask[lane], to_flag(result == 0), zero_[lane]);
+                            negative_[lane] = select(mask[lane], result >> 7, negative_[lane]);
+                        }
+                    retire(mask, 1, 2);
+                    break;
+                }
+
+                // Clear Flags
+
+            case Opcode::CLC:
+            case Opcode::CLD:
+            case Opcode::CLI:
+            case Opcode::CLV:
+                {
+                    Lane8& flag = opcode == static_cast<u8>(Opcode::CLC)   ? carry_
+                                  : opcode == static_cast<u8>(Opcode::CLD) ? decimal_
+                                  : opcode == static_cast<u8>(Opcode::CLI) ? interrupt_
+                                                                           : overflow_;
+                    for (std::size_t lane = 0; lane < Lanes; ++lane)
+                        {
+                            flag[lane] = select(mask[lane], 0, flag[lane]);
+                        }
+                    retire(mask, 1, 2);
+                    break;
+                }
+
+                // Branch Instructions
+
+            case Opcode::BCC:
+                execute_branch(carry_, 0, static_cast<i8>(operand), mask);
+                break;
+
+            case Opcode::BCS:
+                execute_branch(carry_, 1, static_cast<i8>(operand), mask);
+                break;
+
+            case Opcode::BEQ:
+                execute_branch(zero_, 1, static_cast<i8>(operand), mask);
+                break;
+
+            case Opcode::BNE:
+                execute_branch(zero_, 0, static_cast<i8>(operand), mask);
+                break;
+
+            case Opcode::BMI:
+                execute_branch(negative_, 1, static_cast<i8>(operand), mask);
+                break;
+
+            case Opcode::BPL:
+                execute_branch(negative_, 0, static_cast<i8>(operand), mask);
+                break;
+
+            case Opcode::BVC:
+                execute_branch(overflow_, 0, static_cast<i8>(operand), mask);
+                break;
+
+            case Opcode::BVS:
+                execute_branch(overflow_, 1, static_cast<i8>(operand), mask);
+                break;
+
+                // Control Flow Instructions
+
+            case Opcode::JSR:
+                execute_jsr(word, mask);
+                break;
+
+            case Opcode::RTS:
+                execute_rts(mask);
+                break;
+
+            default:
+                // BRK and anything the CPU rejects are left to the scalar path
+                return false;
+        }
+
+    ++stats_.steps;
+    return true;
+}
+
+template <std::size_t Lanes>
+void LockstepEngine<Lanes>::resolve(Mode mode, u8 operand, u16 word, Lane16& address,
+                                    Lane8& penalty) const noexcept
+{
+    switch (mode)
+        {
+            case Mode::Immediate:
+            case Mode::ZeroPage:
+                address.fill(operand);
+                break;
+
+            case Mode::ZeroPageX:
+                for (std::size_t lane = 0; lane < Lanes; ++lane)
+                    {
+                        address[lane] = static_cast<u8>(operand + x_[lane]);
+                    }
+                break;
+
+            case Mode::ZeroPageY:
+                for (std::size_t lane = 0; lane < Lanes; ++lane)
+                    {
+                        address[lane] = static_cast<u8>(operand + y_[lane]);
+                    }
+                break;
+
+            case Mode::Absolute:
+                address.fill(word);
+                break;
+
+            case Mode::AbsoluteX:
+            case Mode::AbsoluteY:
+                {
+                    const Lane8& index = mode == Mode::AbsoluteX ? x_ : y_;
+                    for (std::size_t lane = 0; lane < Lanes; ++lane)
+                        {
+                            address[lane] = static_cast<u16>(word + index[lane]);
+                            penalty[lane] = to_flag(page_crossed(word, address[lane]));
+                        }
+                    break;
+                }
+
+            case Mode::IndirectX:
+                // The pointer is read like Memory::read_word, without zero-page wrap
+                for (std::size_t lane = 0; lane < Lanes; ++lane)
+                    {
+                        const auto pointer = static_cast<u8>(operand + x_[lane]);
+                        address[lane] =
+                            static_cast<u16>(read(lane, pointer) |
+                                             (read(lane, static_cast<u16>(pointer + 1)) << 8));
+                    }
+                break;
+
+            case Mode::IndirectY:
+                for (std::size_t lane = 0; lane < Lanes; ++lane)
+                    {
+                        const auto base = static_cast<u16>(
+                            read(lane, operand) | (read(lane, static_cast<u16>(operand + 1)) << 8));
+                        address[lane] = static_cast<u16>(base + y_[lane]);
+                        penalty[lane] = to_flag(page_crossed(base, address[lane]));
+                    }
+                break;
+        }
+}
+
+template <std::size_t Lanes>
+void LockstepEngine<Lanes>::execute_read(ReadOp op, Mode mode, u8 operand, u16 word,
+                                         const Lane8& mask)
+{
+    Lane8 value{};
+    Lane8 penalty{};
+
+    if (mode == Mode::Immediate)
+        {
+            value.fill(operand);
+        }
+    else if (mode == Mode::ZeroPage)
+        {
+            value = zero_page_[operand];
+        }
+    else
+        {
+            Lane16 address{};
+            resolve(mode, operand, word, address, penalty);
+            for (std::size_t lane = 0; lane < Lanes; ++lane)
+                {
+                    value[lane] = read(lane, address[lane]);
+                }
+        }
+
+    switch (op)
+        {
+            case ReadOp::Lda:
+            case ReadOp::Ldx:
+            case ReadOp::Ldy:
+            case ReadOp::And:
+            case ReadOp::Eor:
+                {
+                    Lane8& reg = op == ReadOp::Ldx ? x_ : op == ReadOp::Ldy ? y_ : a_;
+                    for (std::size_t lane = 0; lane < Lanes; ++lane)
+                        {
+                            const u8 result = op == ReadOp::And   ? reg[lane] & value[lane]
+                                              : op == ReadOp::Eor ? reg[lane] ^ value[lane]
+                                                                  : value[lane];
+                            reg[lane]       = select(mask[lane], result, reg[lane]);
+                            zero_[lane] = select(mask[lane], to_flag(result == 0), zero_[lane]);
+                            negative_[lane] = select(mask[lane], result >> 7, negative_[lane]);
+                        }
+                    break;
+                }
+
+            case ReadOp::Adc:
+                for (std::size_t lane = 0; lane < Lanes; ++lane)
+                    {
+                        const auto sum    = static_cast<u16>(a_[lane] + value[lane] + carry_[lane]);
+                        const auto result = static_cast<u8>(sum);
+                        const bool overflow =
+                            (~(a_[lane] ^ value[lane]) & (a_[lane] ^ result) & 0x80) != 0;
+
+                        a_[lane]     = select(mask[lane], result, a_[lane]);
+                        carry_[lane] = select(mask[lane], to_flag(sum > 0xFF), carry_[lane]);
+                        overflow_[lane] = select(mask[lane], to_flag(overflow), overflow_[lane]);
+                        zero_[lane]     = select(mask[lane], to_flag(result == 0), zero_[lane]);
+                        negative_[lane] = select(mask[lane], result >> 7, negative_[lane]);
+                    }
+                break;
+
+            case ReadOp::Cmp:
+            case ReadOp::Cpx:
+            case ReadOp::Cpy:
+                {
+                    const Lane8& reg = op == ReadOp::Cpx ? x_ : op == ReadOp::Cpy ? y_ : a_;
+                    for (std::size_t lane = 0; lane < Lanes; ++lane)
+                        {
+                            const auto result = static_cast<u8>(reg[lane] - value[lane]);
+                            carry_[lane] =
+                                select(mask[lane], to_flag(reg[lane] >= value[lane]), carry_[lane]);
+                            zero_[lane] = select(mask[lane], to_flag(result == 0), zero_[lane]);
+                            negative_[lane] = select(mask[lane], result >> 7, negative_[lane]);
+                        }
+                    break;
+                }
+
+            case ReadOp::Bit:
+                for (std::size_t lane = 0; lane < Lanes; ++lane)
+                    {
+                        const bool is_zero = (a_[lane] & value[lane]) == 0;
+                        zero_[lane]        = select(mask[lane], to_flag(is_zero), zero_[lane]);
+                        negative_[lane]    = select(mask[lane], value[lane] >> 7, negative_[lane]);
+                        overflow_[lane] =
+                            select(mask[lane], (value[lane] >> 6) & 0x01, overflow_[lane]);
+                    }
+                break;
+        }
+
+    const auto index = static_cast<std::size_t>(mode);
+    retire(mask, READ_LENGTH[index], READ_CYCLES[index]);
+    for (std::size_t lane = 0; lane < Lanes; ++lane)
+        {
+            cycles_[lane] += static_cast<u64>(penalty[lane] & mask[lane]);
+        }
+}
+
+template <std::size_t Lanes>
+void LockstepEngine<Lanes>::execute_modify(ModifyOp op, Mode mode, u8 operand, u16 word,
+                                           Lane8& mask)
+{
+    const auto index = static_cast<std::size_t>(mode);
+
+    if (mode == Mode::ZeroPage)
+        {
+            // Uniform address: the whole row is one vector
+            Lane8& row = zero_page_[operand];
+            for (std::size_t lane = 0; lane < Lanes; ++lane)
+                {
+                    const u8 result = op == ModifyOp::Asl   ? static_cast<u8>(row[lane] << 1)
+                                      : op == ModifyOp::Inc ? static_cast<u8>(row[lane] + 1)
+                                                            : static_cast<u8>(row[lane] - 1);
+                    if (op == ModifyOp::Asl)
+                        carry_[lane] = select(mask[lane], row[lane] >> 7, carry_[lane]);
+
+                    row[lane]       = select(mask[lane], result, row[lane]);
+                    zero_[lane]     = select(mask[lane], to_flag(result == 0), zero_[lane]);
+                    negative_[lane] = select(mask[lane], result >> 7, negative_[lane]);
+                }
+
+            retire(mask, MODIFY_LENGTH[index], MODIFY_CYCLES[index]);
+            return;
+        }
+
+    Lane16 address{};
+    Lane8  penalty{};  // Read-modify-write pays no page-cross penalty
+    resolve(mode, operand, word, address, penalty);
+
+    // Writes to shared memory would make the lane's address space private
+    Lane8 shared{};
+    for (std::size_t lane = 0; lane < Lanes; ++lane)
+        {
+            if (mask[lane] != 0 && address[lane] >= 0x0200)
+                {
+                    shared[lane] = 0xFF;
+                    mask[lane]   = 0;
+                }
+        }
+    fall_back(shared);
+
+    for (std::size_t lane = 0; lane < Lanes; ++lane)
+        {
+            if (mask[lane] == 0)
+                continue;
+
+            const u8 value  = read(lane, address[lane]);
+            const u8 result = op == ModifyOp::Asl   ? static_cast<u8>(value << 1)
+                              : op == ModifyOp::Inc ? static_cast<u8>(value + 1)
+                                                    : static_cast<u8>(value - 1);
+            if (op == ModifyOp::Asl)
+                carry_[lane] = value >> 7;
+
+            write(lane, address[lane], result);
+            zero_[lane]     = to_flag(result == 0);
+            negative_[lane] = result >> 7;
+        }
+
+    retire(mask, MODIFY_LENGTH[index], MODIFY_CYCLES[index]);
+}
+
+template <std::size_t Lanes>
+void LockstepEngine<Lanes>::execute_branch(const Lane8& flag, u8 taken_when, i8 offset,
+                                           const Lane8& mask)
+{
+    for (std::size_t lane = 0; lane < Lanes; ++lane)
+        {
+            const auto next   = static_cast<u16>(pc_[lane] + 2);
+            const auto target = static_cast<u16>(static_cast<i32>(next) + offset);
+            const bool taken  = flag[lane] == taken_when;
+            const u64  cycles = 2 + (taken ? 1 + to_flag(page_crossed(next, target)) : 0);
+
+            pc_[lane]           = mask[lane] != 0 ? (taken ? target : next) : pc_[lane];
+            cycles_[lane]       += mask[lane] != 0 ? cycles : 0;
+            instructions_[lane] += mask[lane] != 0 ? 1u : 0u;
+        }
+
+    for (std::size_t lane = 0; lane < Lanes; ++lane)
+        {
+            stats_.lane_instructions += static_cast<u64>(mask[lane] & 0x01);
+        }
+}
+
+template <std::size_t Lanes>
+void LockstepEngine<Lanes>::execute_jsr(u16 target, Lane8& mask)
+{
+    // push_byte refuses to write with SP at $00, leave that error to the CPU
+    Lane8 overflowing{};
+    for (std::size_t lane = 0; lane < Lanes; ++lane)
+        {
+            if (mask[lane] != 0 && sp_[lane] < 2)
+                {
+                    overflowing[lane] = 0xFF;
+                    mask[lane]        = 0;
+                }
+        }
+    fall_back(overflowing);
+
+    for (std::size_t lane = 0; lane < Lanes; ++lane)
+        {
+            if (mask[lane] == 0)
+                continue;
+
+            const auto return_address          = static_cast<u16>(pc_[lane] + 2);
+            stack_page_[sp_[lane]][lane]       = static_cast<u8>(return_address >> 8);
+            stack_page_[sp_[lane] - 1u][lane] = static_cast<u8>(return_address & 0xFF);
+            sp_[lane]                          = static_cast<u8>(sp_[lane] - 2);
+        }
+
+    retire(mask, 3, 6);
+    for (std::size_t lane = 0; lane < Lanes; ++lane)
+        {
+            pc_[lane] = mask[lane] != 0 ? target : pc_[lane];
+        }
+}
+
+template <std::size_t Lanes>
+void LockstepEngine<Lanes>::execute_rts(Lane8& mask)
+{
+    // pop_byte refuses to read with SP at $FF, leave that error to the CPU
+    Lane8 underflowing{};
+    for (std::size_t lane = 0; lane < Lanes; ++lane)
+        {
+            if (mask[lane] != 0 && sp_[lane] > 0xFD)
+                {
+                    underflowing[lane] = 0xFF;
+                    mask[lane]         = 0;
+                }
+        }
+    fall_back(underflowing);
+
+    for (std::size_t lane = 0; lane < Lanes; ++lane)
+        {
+            if (mask[lane] == 0)
+                continue;
+
+            const u8 low  = stack_page_[sp_[lane] + 1u][lane];
+            const u8 high = stack_page_[sp_[lane] + 2u][lane];
+            sp_[lane]     = static_cast<u8>(sp_[lane] + 2);
+            pc_[lane]     = static_cast<u16>((low | (high << 8)) + 1);
+            cycles_[lane] += 6;
+            ++instructions_[lane];
+            ++stats_.lane_instructions;
+        }
+}
+
+template <std::size_t Lanes>
+void LockstepEngine<Lanes>::retire(const Lane8& mask, u16 length, u64 cycles) noexcept
+{
+    for (std::size_t lane = 0; lane < Lanes; ++lane)
+        {
+            const bool issued   = mask[lane] != 0;
+            pc_[lane]           = issued ? static_cast<u16>(pc_[lane] + length) : pc_[lane];
+            cycles_[lane]       += issued ? cycles : 0;
+            instructions_[lane] += issued ? 1u : 0u;
+            stats_.lane_instructions += issued ? 1u : 0u;
+        }
+}
+
+template class LockstepEngine<8>;
+template class LockstepEngine<16>;
+template class LockstepEngine<32>;
+
+}  // namespace cpu6502
@@ -1,146 +1,261 @@
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <optional>
 #include <print>
+#include <string>
+#include <string_view>
+#include <vector>
 #include "cpu6502/cpu.hpp"
+#include "cpu6502/error.hpp"
+#include "cpu6502/loader.hpp"
 #include "cpu6502/memory.hpp"
-#include "cpu6502/opcodes.hpp"
-
-int main() {
-    using namespace cpu6502;
-
-    Memory mem;
-    CPU    cpu;
-
-    // Program the reset vector to point to our program at $8000
-    mem[0xFFFC] = 0x00;  // Low byte of start address ($8000)
-    mem[0xFFFD] = 0x80;  // High byte of start address ($8000)
-
-    std::println("6502 Emulator - Modern C++23");
-    std::println("============================");
-    std::println("Memory Map:");
-    std::println("  Zero Page:  $0000-$00FF (special addressing)");
-    std::println("  Stack:      $0100-$01FF (fixed, cannot relocate)");
-    std::println("  Program:    $8000-$FFFF (typical ROM location)");
-    std::println("  Vectors:    $FFFA-$FFFF (NMI, RESET, IRQ/BRK)");
-    std::println("");
-
-    // Test 1: Simple JSR/RTS
-    cpu.reset(mem);  // Reset FIRST
-    std::println("=== Test 1: JSR/RTS ===");
-    mem[0x8000] = static_cast<u8>(Opcode::JSR);
-    mem[0x8001] = 0x42;
-    mem[0x8002] = 0x42;
-    mem[0x4242] = static_cast<u8>(Opcode::LDA_IM);
-    mem[0x4243] = 0x84;
-    mem[0x4244] = static_cast<u8>(Opcode::RTS);
-
-    auto result = cpu.execute(14, mem);
-    if (result) {
-        std::println("✓ Test 1 passed - A: 0x{:02X}, Cycles: {}", cpu.get_a(), result.value());
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+// Headless runner: loads a program image, runs it to a stop condition and
+// reports throughput. Meant for comparing builds on the same host.
+//
+// Usage: 6502emu [options] <image>
+//   --format=FORMAT    raw, ihex, srec, prg or o65 (default: detected from the
+//                      contents, then the file extension, else raw)
+//   --load=ADDR        load address of a raw image (default $8000)
+//   --pc=ADDR          start address (default: the reset vector if the image
+//                      gives a start address or covers $FFFC-$FFFD, else the
+//                      address of its first segment)
+//   --stop-pc=ADDR     stop before executing ADDR
+//   --max-cycles=N     stop after N cycles
+//   --no-brk           do not stop on BRK (on by default)
+//   --json             print the report as a JSON object
+// Addresses are hex with an optional $ or 0x prefix.
+//
+// Exit status: 0 after a clean stop, 1 on an emulator error, 2 on bad usage.
+
+namespace {
+
+using namespace cpu6502;
+
+struct Options {
+    std::string                image;
+    std::optional<ImageFormat> format;
+    u16                        load_address = 0x8000;
+    std::optional<u16>         pc;
+    StopCondition              stop{.stop_on_brk = true};
+    bool                       json = false;
+};
+
+auto usage() -> int {
+    std::println(stderr,
+                 "usage: 6502emu [--format=raw|ihex|srec|prg|o65] [--load=ADDR] [--pc=ADDR] "
+                 "[--stop-pc=ADDR] [--max-cycles=N] [--no-brk] [--json] <image>");
+    return 2;
+}
+
+auto parse_address(std::string_view text) -> std::optional<u16> {
+    if (text.starts_with('$')) {
+        text.remove_prefix(1);
+    } else if (text.starts_with("0x") || text.starts_with("0X")) {
+        text.remove_prefix(2);
     }
 
-    // Test 2: Absolute,X without page crossing (4 cycles)
-    cpu.reset(mem);
-    cpu.set_x(0x05);
-    std::println("\n=== Test 2: LDA Absolute,X (No Page Cross) ===");
-    mem[0x8000] = static_cast<u8>(Opcode::LDA_ABSX);
-    mem[0x8001] = 0x00;
-    mem[0x8002] = 0x20;
-    mem[0x2005] = 0x42;
-
-    result = cpu.execute(4, mem);
-    if (result) {
-        std::println("✓ Base: $2000, X: $05, Effective: $2005");
-        std::println("✓ No page cross - A: 0x{:02X}, Cycles: {} (expected 4)", cpu.get_a(),
-                     result.value());
+    u32 value = 0;
+    const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value, 16);
+    if (text.empty() || error != std::errc{} || end != text.data() + text.size() ||
+        value > 0xFFFF) {
+        return std::nullopt;
     }
+    return static_cast<u16>(value);
+}
 
-    // Test 3: Absolute,X WITH page crossing (5 cycles)
-    cpu.reset(mem);
-    cpu.set_x(0xFF);
-    std::println("\n=== Test 3: LDA Absolute,X (Page Cross!) ===");
-    mem[0x8000] = static_cast<u8>(Opcode::LDA_ABSX);
-    mem[0x8001] = 0xFF;
-    mem[0x8002] = 0x20;
-    mem[0x21FE] = 0x99;
-
-    result = cpu.execute(5, mem);
-    if (result) {
-        std::println("✓ Base: $20FF, X: $FF, Effective: $21FE");
-        std::println("✓ Page crossed ($20 -> $21) - A: 0x{:02X}, Cycles: {} (expected 5)",
-                     cpu.get_a(), result.value());
+auto parse_options(int argc, char** argv) -> std::optional<Options> {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg(argv[i]);
+        const auto             equals = arg.find('=');
+        const std::string_view key    = arg.substr(0, equals);
+        const std::string_view value =
+            equals == std::string_view::npos ? std::string_view{} : arg.substr(equals + 1);
+
+        if (key == "--load" || key == "--pc" || key == "--stop-pc") {
+            const auto address = parse_address(value);
+            if (!address) {
+                return std::nullopt;
+            }
+            if (key == "--load") {
+                options.load_address = *address;
+            } else if (key == "--pc") {
+                options.pc = address;
+            } else {
+                options.stop.stop_pc = address;
+            }
+        } else if (key == "--format") {
+            options.format = parse_image_format(value);
+            if (!options.format) {
+                return std::nullopt;
+            }
+        } else if (key == "--max-cycles") {
+            const auto [end, error] =
+                std::from_chars(value.data(), value.data() + value.size(), options.stop.max_cycles);
+            if (value.empty() || error != std::errc{} || end != value.data() + value.size()) {
+                return std::nullopt;
+            }
+        } else if (arg == "--no-brk") {
+            options.stop.stop_on_brk = false;
+        } else if (arg == "--json") {
+            options.json = true;
+        } else if (!arg.starts_with("--") && options.image.empty()) {
+            options.image = arg;
+        } else {
+            return std::nullopt;
+        }
     }
 
-    // Test 4: LDX Immediate (2 cycles)
-    cpu.reset(mem);
-    std::println("\n=== Test 4: LDX Immediate ===");
-    mem[0x8000] = static_cast<u8>(Opcode::LDX_IM);
-    mem[0x8001] = 0x20;
+    if (options.image.empty()) {
+        return std::nullopt;
+    }
+    return options;
+}
 
-    result = cpu.execute(2, mem);
-    if (result) {
-        std::println("✓ Value: $0x20 , Effective X: $0x20");
-        std::println("✓ X: 0x{:02X}, Cycles: {}", cpu.get_x(), result.value());
+auto read_image(const std::string& path) -> std::optional<std::vector<u8>> {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return std::nullopt;
     }
+    return std::vector<u8>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
 
-    // Test ADC Basic Addition
-    cpu.reset(mem);
-    std::println("\n=== Test: ADC Basic Addition ===");
-    cpu.set_flag_c(false);
-    mem[0x8000] = static_cast<u8>(Opcode::LDA_IM);
-    mem[0x8001] = 0x05;
-    mem[0x8002] = static_cast<u8>(Opcode::ADC_IM);
-    mem[0x8003] = 0x03;
-
-    result = cpu.execute(4, mem);
-    if (result) {
-        std::println("✓ 0x05 + 0x03 = 0x{:02X} (expected 0x08)", cpu.get_a());
-        std::println("✓ Carry: {}, Zero: {}, Negative: {}, Overflow: {}", cpu.get_flags().carry,
-                     cpu.get_flags().zero, cpu.get_flags().negative, cpu.get_flags().overflow);
+// Peak resident set size of this process in KiB, if the platform reports it
+auto peak_rss_kib() -> std::optional<u64> {
+#if defined(__unix__) || defined(__APPLE__)
+    rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return std::nullopt;
+    }
+#if defined(__APPLE__)
+    return static_cast<u64>(usage.ru_maxrss) / 1024;  // Bytes on macOS
+#else
+    return static_cast<u64>(usage.ru_maxrss);  // KiB on Linux and the BSDs
+#endif
+#else
+    return std::nullopt;
+#endif
+}
+
+auto stop_reason_name(StopReason reason) -> std::string_view {
+    switch (reason) {
+        case StopReason::CycleLimit:
+            return "cycle_limit";
+        case StopReason::StopPc:
+            return "stop_pc";
+        case StopReason::Brk:
+            return "brk";
+        case StopReason::Breakpoint:
+            return "breakpoint";
     }
+    return "unknown";
+}
 
-    // Test ADC with Carry Flag Set
-    cpu.reset(mem);
-    std::println("\n=== Test: ADC with Carry Set ===");
-    mem[0x8000] = static_cast<u8>(Opcode::LDA_IM);
-    mem[0x8001] = 0x05;
-    mem[0x8002] = static_cast<u8>(Opcode::ADC_IM);
-    mem[0x8003] = 0x03;
-    // cpu.execute(2, mem);  // Load 0x05 into A
-    cpu.set_flag_c(true);  // Set carry flag
-
-    result = cpu.execute(4, mem);
-    if (result) {
-        std::println("✓ 0x05 + 0x03 + 1(carry) = 0x{:02X} (expected 0x09)", cpu.get_a());
+struct Report {
+    std::string_view   stop;  // Stop reason, or the emulator error message
+    bool               failed       = false;
+    u16                pc           = 0;
+    u64                cycles       = 0;
+    u64                instructions = 0;
+    double             seconds      = 0.0;
+    std::optional<u64> peak_rss_kib;
+
+    [[nodiscard]] auto mhz() const -> double {
+        return seconds > 0.0 ? static_cast<double>(cycles) / seconds / 1e6 : 0.0;
     }
 
-    // Test ADC Overflow (Positive + Positive = Negative)
-    cpu.reset(mem);
-    std::println("\n=== Test: ADC Signed Overflow ===");
-    mem[0x8000] = static_cast<u8>(Opcode::LDA_IM);
-    mem[0x8001] = 0x50;  // +80 in signed
-    mem[0x8002] = static_cast<u8>(Opcode::ADC_IM);
-    mem[0x8003] = 0x50;  // +80 in signed
+    [[nodiscard]] auto ips() const -> double {
+        return seconds > 0.0 ? static_cast<double>(instructions) / seconds : 0.0;
+    }
+};
 
-    result = cpu.execute(4, mem);
-    if (result) {
-        std::println("✓ 0x50 + 0x50 = 0x{:02X}", cpu.get_a());
-        std::println("✓ Overflow flag: {} (expected true)", cpu.get_flags().overflow);
+void print_text(const Report& report) {
+    std::println("stop:             {}{}", report.failed ? "error: " : "", report.stop);
+    std::println("pc:               ${:04X}", report.pc);
+    std::println("wall time:        {:.6f} s", report.seconds);
+    std::println("emulated cycles:  {}", report.cycles);
+    std::println("instructions:     {}", report.instructions);
+    std::println("emulated MHz:     {:.3f}", report.mhz());
+    std::println("instructions/s:   {:.0f}", report.ips());
+    if (report.peak_rss_kib) {
+        std::println("peak RSS:         {} KiB", *report.peak_rss_kib);
+    } else {
+        std::println("peak RSS:         unavailable");
     }
+}
+
+void print_json(const Report& report) {
+    std::println("{{\"stop\": \"{}\", \"error\": {}, \"pc\": {}, \"wall_seconds\": {:.6f}, "
+                 "\"cycles\": {}, \"instructions\": {}, \"mhz\": {:.3f}, \"ips\": {:.0f}, "
+                 "\"peak_rss_kib\": {}}}",
+                 report.stop, report.failed, report.pc, report.seconds, report.cycles,
+                 report.instructions, report.mhz(), report.ips(),
+                 report.peak_rss_kib ? std::to_string(*report.peak_rss_kib) : "null");
+}
 
-    // Test ADC Carry Generation
+}  // namespace
+
+int main(int argc, char** argv) {
+    const auto options = parse_options(argc, argv);
+    if (!options) {
+        return usage();
+    }
+
+    const auto bytes = read_image(options->image);
+    if (!bytes) {
+        std::println(stderr, "6502emu: cannot read '{}'", options->image);
+        return 2;
+    }
+
+    Memory     mem;
+    CPU        cpu;
+    const auto format = options->format.value_or(detect_image_format(options->image, *bytes));
+    const auto image  = load_image(*bytes, format, mem, {.raw_address = options->load_address});
+    if (!image) {
+        std::println(stderr, "6502emu: cannot load '{}': {}", options->image,
+                     error_message(image.error()));
+        return 2;
+    }
+
+    // Start at the reset vector when the image supplies one
+    const bool has_reset_vector =
+        image->start || (image->covers(0xFFFC) && image->covers(0xFFFD));
     cpu.reset(mem);
-    std::println("\n=== Test: ADC Carry Generation ===");
-    mem[0x8000] = static_cast<u8>(Opcode::LDA_IM);
-    mem[0x8001] = 0xFF;
-    mem[0x8002] = static_cast<u8>(Opcode::ADC_IM);
-    mem[0x8003] = 0x01;
+    if (options->pc) {
+        cpu.set_pc(*options->pc);
+    } else if (!has_reset_vector && !image->segments.empty()) {
+        cpu.set_pc(image->segments.front().address);
+    }
+
+    const auto start  = std::chrono::steady_clock::now();
+    const auto result = cpu.run(options->stop, mem);
+    const auto end    = std::chrono::steady_clock::now();
 
-    result = cpu.execute(4, mem);
+    Report report;
+    report.seconds      = std::chrono::duration<double>(end - start).count();
+    report.cycles       = cpu.get_cycles();
+    report.pc           = cpu.get_pc();
+    report.peak_rss_kib = peak_rss_kib();
     if (result) {
-        std::println("✓ 0xFF + 0x01 = 0x{:02X} (expected 0x00)", cpu.get_a());
-        std::println("✓ Carry: {}, Zero: {}", cpu.get_flags().carry, cpu.get_flags().zero);
+        report.stop         = stop_reason_name(result->reason);
+        report.instructions = result->instructions;
+    } else {
+        report.stop   = error_message(result.error());
+        report.failed = true;
     }
 
-    std::println("\n=== All Tests Complete ===");
-
-    return 0;
+    if (options->json) {
+        print_json(report);
+    } else {
+        print_text(report);
+    }
+    return report.failed ? 1 : 0;
 }
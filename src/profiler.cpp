@@ -0,0 +1,151 @@
+#include "cpu6502/profiler.hpp"
+#include <algorithm>
+#include <format>
+#include <map>
+#include <string>
+#include <utility>
+
+namespace cpu6502
+{
+
+namespace
+{
+
+// Sample counts summed per function name, busiest first
+[[nodiscard]] auto group_by_symbol(std::span<const u64> histogram, const SymbolTable& symbols)
+    -> std::vector<std::pair<std::string, u64>>
+{
+    std::map<std::string, u64> totals;
+    for (std::size_t pc = 0; pc < histogram.size(); ++pc)
+        {
+            if (histogram[pc] != 0)
+                totals[symbols.function_name(static_cast<u16>(pc))] += histogram[pc];
+        }
+
+    std::vector<std::pair<std::string, u64>> sorted(totals.begin(), totals.end());
+    std::ranges::stable_sort(sorted, [](const auto& lhs, const auto& rhs)
+                             { return lhs.second > rhs.second; });
+    return sorted;
+}
+
+}  // namespace
+
+SamplingProfiler::SamplingProfiler(const ProfilerConfig& config)
+    : config_(config), rng_state_(config.seed | 1), histogram_(Memory::MAX_MEM)
+{
+    config_.interval = std::max<u64>(config_.interval, 1);
+    config_.jitter   = std::min(config_.jitter, config_.interval - 1);
+}
+
+auto SamplingProfiler::run(const StopCondition& stop, CPU& cpu, Memory& memory)
+    -> std::expected<RunResult, EmulatorError>
+{
+    RunResult total{};
+
+    while (total.cycles < stop.max_cycles)
+        {
+            StopCondition stretch = stop;
+            stretch.max_cycles    = std::min(next_period(), stop.max_cycles - total.cycles);
+
+            auto result = cpu.run(stretch, memory);
+            if (!result)
+                return std::unexpected(result.error());
+
+            total.cycles += result->cycles;
+            total.instructions += result->instructions;
+            if (result->reason != StopReason::CycleLimit)
+                {
+                    total.reason = result->reason;
+                    return total;
+                }
+
+            record(cpu.get_pc());
+            if (calls_ != nullptr)
+                {
+                    calls_->call_chain(cpu.get_pc(), cpu.get_sp(), chain_);
+                    chain_.push_back(cpu.get_pc());
+                    ++stacks_[chain_];
+                }
+        }
+
+    total.reason = StopReason::CycleLimit;
+    return total;
+}
+
+void SamplingProfiler::record(u16 pc) noexcept
+{
+    ++histogram_[pc];
+    ++samples_;
+}
+
+void SamplingProfiler::clear() noexcept
+{
+    std::ranges::fill(histogram_, 0);
+    samples_ = 0;
+    stacks_.clear();
+}
+
+void SamplingProfiler::write_flat(std::ostream& out, const SymbolTable& symbols) const
+{
+    out << std::format("{:>10}  {:>6}  {}\n", "samples", "%", "symbol");
+    for (const auto& [name, count] : group_by_symbol(histogram_, symbols))
+        {
+            const double share = 100.0 * static_cast<double>(count) / static_cast<double>(samples_);
+            out << std::format("{:>10}  {:>6.2f}  {}\n", count, share, name);
+        }
+}
+
+void SamplingProfiler::write_folded(std::ostream& out, const SymbolTable& symbols) const
+{
+    if (stacks_.empty())
+        {
+            for (const auto& [name, count] : group_by_symbol(histogram_, symbols))
+                {
+                    out << name << ' ' << count << '\n';
+                }
+            return;
+        }
+
+    // Chains differing only in where the PC was inside the leaf fold together
+    std::map<std::string, u64> totals;
+    for (const auto& [chain, count] : stacks_)
+        {
+            std::string       stack;
+            const std::string leaf = symbols.function_name(chain.back());
+            std::string       top;
+            for (std::size_t i = 0; i + 1 < chain.size(); ++i)
+                {
+                    top = symbols.function_name(chain[i]);
+                    if (i != 0)
+                        stack += ';';
+                    stack += top;
+                }
+            if (leaf != top)
+                stack += (stack.empty() ? "" : ";") + leaf;
+            totals[stack] += count;
+        }
+
+    std::vector<std::pair<std::string, u64>> sorted(totals.begin(), totals.end());
+    std::ranges::stable_sort(sorted, [](const auto& lhs, const auto& rhs)
+                             { return lhs.second > rhs.second; });
+    for (const auto& [stack, count] : sorted)
+        {
+            out << stack << ' ' << count << '\n';
+        }
+}
+
+u64 SamplingProfiler::next_period() noexcept
+{
+    // xorshift64: cheap, and the same seed gives the same sample points
+    rng_state_ ^= rng_state_ << 13;
+    rng_state_ ^= rng_state_ >> 7;
+    rng_state_ ^= rng_state_ << 17;
+
+    if (config_.jitter == 0)
+        return config_.interval;
+
+    const u64 span = 2 * config_.jitter + 1;
+    return config_.interval - config_.jitter + rng_state_ % span;
+}
+
+}  // namespace cpu6502
@@ -0,0 +1,315 @@
+#include "cpu6502/rewind.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace cpu6502
+{
+
+namespace
+{
+
+constexpr std::size_t HEADER_SIZE = offsetof(SaveState, memory);
+constexpr std::size_t PAGE_SIZE   = 256;
+constexpr std::size_t PAGE_COUNT  = Memory::MAX_MEM / PAGE_SIZE;
+
+}  // namespace
+
+RewindBuffer::RewindBuffer(const RewindConfig& config)
+    : config_(config), last_(std::make_unique<SaveState>()), scratch_(std::make_unique<SaveState>())
+{
+    config_.interval          = std::max<u64>(config_.interval, 1);
+    config_.keyframe_interval = std::max<u32>(config_.keyframe_interval, 1);
+}
+
+void RewindBuffer::capture(const CPU& cpu, const Memory& memory)
+{
+    truncate(cpu.get_cycles());
+    if (!entries_.empty() && entries_.back().cycles >= cpu.get_cycles())
+        return;
+
+    save_state(cpu, memory, *scratch_);
+
+    Entry entry;
+    entry.cycles   = cpu.get_cycles();
+    entry.keyframe = entries_.empty() || since_keyframe_ + 1 >= config_.keyframe_interval;
+    if (entry.keyframe)
+        {
+            const auto bytes = state_bytes(*scratch_);
+            entry.data.assign(bytes.begin(), bytes.end());
+            since_keyframe_ = 0;
+        }
+    else
+        {
+            encode_delta(*last_, *scratch_, entry.data);
+            ++since_keyframe_;
+        }
+
+    bytes_used_ += entry.data.size();
+    entries_.push_back(std::move(entry));
+    std::swap(last_, scratch_);
+
+    evict();
+}
+
+auto RewindBuffer::run(const StopCondition& stop, CPU& cpu, Memory& memory)
+    -> std::expected<RunResult, EmulatorError>
+{
+    RunResult total{};
+    capture(cpu, memory);
+
+    while (total.cycles < stop.max_cycles)
+        {
+            StopCondition slice = stop;
+            slice.max_cycles    = std::min(config_.interval, stop.max_cycles - total.cycles);
+
+            auto result = cpu.run(slice, memory);
+            if (!result)
+                return std::unexpected(result.error());
+
+            total.cycles += result->cycles;
+            total.instructions += result->instructions;
+            if (result->reason != StopReason::CycleLimit)
+                {
+                    total.reason = result->reason;
+                    return total;
+                }
+
+            capture(cpu, memory);
+        }
+
+    total.reason = StopReason::CycleLimit;
+    return total;
+}
+
+auto RewindBuffer::rewind_to(u64 cycle, CPU& cpu, Memory& memory)
+    -> std::expected<void, EmulatorError>
+{
+    const std::size_t index = find(cycle);
+    if (index == entries_.size())
+        return std::unexpected(EmulatorError::RewindOutOfRange);
+
+    auto restored = restore(index, cpu, memory);
+    if (!restored)
+        return restored;
+
+    if (cpu.get_cycles() >= cycle)
+        return {};
+
+    // Instruction by instruction, so breakpoint traps in the window execute
+    // the instruction under them rather than ending the replay early
+    while (cpu.get_cycles() < cycle)
+        {
+            auto result = cpu.step(memory);
+            if (!result)
+                return std::unexpected(result.error());
+        }
+
+    return {};
+}
+
+auto RewindBuffer::step_back(CPU& cpu, Memory& memory, u64 count)
+    -> std::expected<void, EmulatorError>
+{
+    const u64 current = cpu.get_cycles();
+    if (count == 0)
+        return {};
+    if (current == 0)
+        return std::unexpected(EmulatorError::RewindOutOfRange);
+
+    // Walk back one snapshot interval at a time, replaying each interval once
+    // to count its boundaries, until the interval holding the target is found
+    std::vector<u64> boundaries;
+    u64              seen = 0;  // Boundaries in the intervals after this one
+    u64              end  = current;
+    for (std::size_t index = find(current - 1); index < entries_.size(); --index)
+        {
+            auto restored = restore(index, cpu, memory);
+            if (!restored)
+                return restored;
+
+            boundaries.clear();
+            while (cpu.get_cycles() < end)
+                {
+                    boundaries.push_back(cpu.get_cycles());
+                    auto stepped = cpu.step(memory);
+                    if (!stepped)
+                        return std::unexpected(stepped.error());
+                }
+
+            if (seen + boundaries.size() >= count)
+                return rewind_to(boundaries[boundaries.size() - (count - seen)], cpu, memory);
+
+            seen += boundaries.size();
+            end = entries_[index].cycles;
+            if (index == 0)
+                break;
+        }
+
+    // Not enough history: put the machine back where it was
+    auto restored = rewind_to(current, cpu, memory);
+    if (!restored)
+        return restored;
+
+    return std::unexpected(EmulatorError::RewindOutOfRange);
+}
+
+void RewindBuffer::clear() noexcept
+{
+    entries_.clear();
+    bytes_used_     = 0;
+    since_keyframe_ = 0;
+}
+
+u64 RewindBuffer::oldest_cycle() const noexcept
+{
+    return entries_.empty() ? 0 : entries_.front().cycles;
+}
+
+u64 RewindBuffer::newest_cycle() const noexcept
+{
+    return entries_.empty() ? 0 : entries_.back().cycles;
+}
+
+void RewindBuffer::encode_delta(const SaveState& from, const SaveState& to,
+                                std::vector<u8>& out) const
+{
+    const auto header = state_bytes(to).first<HEADER_SIZE>();
+    out.assign(header.begin(), header.end());
+
+    // Per changed page: page number, then (unchanged run, changed run, XOR bytes...)
+    // pairs until the page is covered; runs are capped at 255 bytes
+    for (std::size_t page = 0; page < PAGE_COUNT; ++page)
+        {
+            const u8* before = from.memory.data() + page * PAGE_SIZE;
+            const u8* after  = to.memory.data() + page * PAGE_SIZE;
+            if (std::memcmp(before, after, PAGE_SIZE) == 0)
+                continue;
+
+            out.push_back(static_cast<u8>(page));
+
+            std::size_t offset = 0;
+            while (offset < PAGE_SIZE)
+                {
+                    std::size_t same = 0;
+                    while (offset + same < PAGE_SIZE && same < 255 &&
+                           before[offset + same] == after[offset + same])
+                        {
+                            ++same;
+                        }
+                    offset += same;
+
+                    std::size_t changed = 0;
+                    while (offset + changed < PAGE_SIZE && changed < 255 &&
+                           before[offset + changed] != after[offset + changed])
+                        {
+                            ++changed;
+                        }
+
+                    out.push_back(static_cast<u8>(same));
+                    out.push_back(static_cast<u8>(changed));
+                    for (std::size_t i = 0; i < changed; ++i)
+                        {
+                            out.push_back(static_cast<u8>(before[offset + i] ^ after[offset + i]));
+                        }
+                    offset += changed;
+                }
+        }
+}
+
+void RewindBuffer::apply_delta(const std::vector<u8>& delta, SaveState& state) const
+{
+    std::memcpy(static_cast<void*>(&state), delta.data(), HEADER_SIZE);
+
+    std::size_t position = HEADER_SIZE;
+    while (position < delta.size())
+        {
+            u8* page = state.memory.data() + std::size_t{delta[position++]} * PAGE_SIZE;
+
+            std::size_t offset = 0;
+            while (offset < PAGE_SIZE)
+                {
+                    offset += delta[position++];
+                    const std::size_t changed = delta[position++];
+                    for (std::size_t i = 0; i < changed; ++i)
+                        {
+                            page[offset + i] ^= delta[position++];
+                        }
+                    offset += changed;
+                }
+        }
+}
+
+void RewindBuffer::reconstruct(std::size_t index, SaveState& state) const
+{
+    std::size_t keyframe = index;
+    while (!entries_[keyframe].keyframe)
+        {
+            --keyframe;
+        }
+
+    std::memcpy(&state, entries_[keyframe].data.data(), sizeof(SaveState));
+    for (std::size_t i = keyframe + 1; i <= index; ++i)
+        {
+            apply_delta(entries_[i].data, state);
+        }
+}
+
+void RewindBuffer::evict()
+{
+    while (bytes_used_ > config_.byte_budget)
+        {
+            // The front is always a keyframe; drop it together with its deltas
+            auto next = std::find_if(entries_.begin() + 1, entries_.end(),
+                                     [](const Entry& entry) { return entry.keyframe; });
+            if (next == entries_.end())
+                return;
+
+            for (auto it = entries_.begin(); it != next; ++it)
+                {
+                    bytes_used_ -= it->data.size();
+                }
+            entries_.erase(entries_.begin(), next);
+        }
+}
+
+auto RewindBuffer::restore(std::size_t index, CPU& cpu, Memory& memory)
+    -> std::expected<void, EmulatorError>
+{
+    reconstruct(index, *scratch_);
+
+    return load_state(*scratch_, cpu, memory);
+}
+
+void RewindBuffer::truncate(u64 cycle)
+{
+    if (entries_.empty() || entries_.back().cycles <= cycle)
+        return;
+
+    while (!entries_.empty() && entries_.back().cycles > cycle)
+        {
+            bytes_used_ -= entries_.back().data.size();
+            entries_.pop_back();
+        }
+
+    since_keyframe_ = 0;
+    if (entries_.empty())
+        return;
+
+    reconstruct(entries_.size() - 1, *last_);
+    for (std::size_t i = entries_.size() - 1; !entries_[i].keyframe; --i)
+        {
+            ++since_keyframe_;
+        }
+}
+
+std::size_t RewindBuffer::find(u64 cycle) const noexcept
+{
+    auto it = std::upper_bound(entries_.begin(), entries_.end(), cycle,
+                               [](u64 value, const Entry& entry) { return value < entry.cycles; });
+    if (it == entries_.begin())
+        return entries_.size();
+
+    return static_cast<std::size_t>(std::distance(entries_.begin(), it)) - 1;
+}
+
+}  // namespace cpu6502
@@ -0,0 +1,115 @@
+#include "cpu6502/save_state.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace cpu6502
+{
+
+namespace
+{
+
+template <std::size_t N>
+constexpr void store_le(std::array<u8, N>& out, u64 value) noexcept
+{
+    for (std::size_t i = 0; i < N; ++i)
+        {
+            out[i] = static_cast<u8>(value >> (8 * i));
+        }
+}
+
+template <std::size_t N>
+[[nodiscard]] constexpr u64 load_le(const std::array<u8, N>& in) noexcept
+{
+    u64 value = 0;
+    for (std::size_t i = 0; i < N; ++i)
+        {
+            value |= static_cast<u64>(in[i]) << (8 * i);
+        }
+    return value;
+}
+
+constexpr u8 IRQ_LINE    = 0x01;
+constexpr u8 NMI_PENDING = 0x02;
+
+// Magic and version at the start of serialized bytes, at least the header's worth
+[[nodiscard]] bool header_valid(std::span<const u8> bytes) noexcept
+{
+    const auto magic   = bytes.subspan(offsetof(SaveState, magic), SaveState::MAGIC.size());
+    const auto version = bytes.subspan(offsetof(SaveState, version), 2);
+    return std::ranges::equal(magic, SaveState::MAGIC) &&
+           (version[0] | (version[1] << 8)) == SaveState::VERSION;
+}
+
+[[nodiscard]] bool header_valid(const SaveState& state) noexcept
+{
+    return state.magic == SaveState::MAGIC && load_le(state.version) == SaveState::VERSION;
+}
+
+}  // namespace
+
+void save_state(const CPU& cpu, const Memory& memory, SaveState& state) noexcept
+{
+    const Registers registers = cpu.get_registers();
+
+    state.magic = SaveState::MAGIC;
+    store_le(state.version, SaveState::VERSION);
+    state.reserved0 = {};
+    store_le(state.cycles, cpu.get_cycles());
+    store_le(state.pc, registers.pc);
+    state.sp         = registers.sp;
+    state.a          = registers.a;
+    state.x          = registers.x;
+    state.y          = registers.y;
+    state.p          = registers.flags.to_byte();
+    state.interrupts = static_cast<u8>((cpu.get_irq_line() ? IRQ_LINE : 0) |
+                                       (cpu.get_nmi_pending() ? NMI_PENDING : 0));
+    state.reserved1  = {};
+
+    // The program's bytes, not the breakpoints patched over them
+    memory.copy_without_traps(state.memory);
+}
+
+auto load_state(const SaveState& state, CPU& cpu, Memory& memory)
+    -> std::expected<void, EmulatorError>
+{
+    if (!header_valid(state))
+        return std::unexpected(EmulatorError::InvalidSaveState);
+
+    Registers registers;
+    registers.pc    = static_cast<u16>(load_le(state.pc));
+    registers.sp    = state.sp;
+    registers.a     = state.a;
+    registers.x     = state.x;
+    registers.y     = state.y;
+    registers.flags = StatusFlags{}.from_byte(state.p);
+
+    cpu.set_registers(registers);
+    cpu.set_cycles(load_le(state.cycles));
+    cpu.set_irq_line((state.interrupts & IRQ_LINE) != 0);
+    cpu.set_nmi_pending((state.interrupts & NMI_PENDING) != 0);
+
+    std::memcpy(memory.data().data(), state.memory.data(), Memory::MAX_MEM);
+    memory.rearm_traps(0, Memory::MAX_MEM);
+    return {};
+}
+
+auto state_bytes(const SaveState& state) noexcept -> std::span<const u8, sizeof(SaveState)>
+{
+    return std::span<const u8, sizeof(SaveState)>(reinterpret_cast<const u8*>(&state),
+                                                  sizeof(SaveState));
+}
+
+auto read_state(std::span<const u8> bytes, SaveState& state) -> std::expected<void, EmulatorError>
+{
+    if (bytes.size() != sizeof(SaveState))
+        return std::unexpected(EmulatorError::InvalidSaveState);
+
+    // Checked in place first, so a bad file leaves state untouched
+    if (!header_valid(bytes))
+        return std::unexpected(EmulatorError::InvalidSaveState);
+
+    std::memcpy(&state, bytes.data(), sizeof(SaveState));
+    return {};
+}
+
+}  // namespace cpu6502
@@ -0,0 +1,181 @@
+#include "cpu6502/scheduler.hpp"
+#include <algorithm>
+
+namespace cpu6502
+{
+
+void Task::promise_type::return_void() noexcept
+{
+    if (scheduler != nullptr)
+        scheduler->finished(std::coroutine_handle<promise_type>::from_promise(*this));
+}
+
+Task& Task::operator=(Task&& other) noexcept
+{
+    if (this != &other)
+        {
+            if (handle_)
+                handle_.destroy();
+            handle_ = std::exchange(other.handle_, nullptr);
+        }
+    return *this;
+}
+
+Task::~Task()
+{
+    // Only a task that was never spawned still owns its frame
+    if (handle_)
+        handle_.destroy();
+}
+
+Scheduler::~Scheduler()
+{
+    // Tasks parked on an Event, or queued when run() was never called again
+    for (void* frame : live_)
+        {
+            std::coroutine_handle<>::from_address(frame).destroy();
+        }
+}
+
+void Scheduler::spawn(Task task)
+{
+    auto handle               = std::exchange(task.handle_, nullptr);
+    handle.promise().scheduler = this;
+
+    {
+        std::lock_guard lock(mutex_);
+        live_.insert(handle.address());
+    }
+    schedule(handle);
+}
+
+void Scheduler::schedule(std::coroutine_handle<> handle)
+{
+    {
+        std::lock_guard lock(mutex_);
+        ready_.push_back(handle);
+    }
+    ready_cv_.notify_one();
+}
+
+void Scheduler::run()
+{
+    // Worker threads only live for one run(); idle machines cost no threads
+    std::vector<std::jthread> helpers;
+    helpers.reserve(thread_count_ - 1);
+    for (unsigned i = 1; i < thread_count_; ++i)
+        {
+            helpers.emplace_back([this] { work(); });
+        }
+
+    work();
+}
+
+std::size_t Scheduler::pending() const
+{
+    std::lock_guard lock(mutex_);
+    return live_.size();
+}
+
+void Scheduler::work()
+{
+    while (true)
+        {
+            std::coroutine_handle<> handle;
+            {
+                std::unique_lock lock(mutex_);
+                ready_cv_.wait(lock, [this] { return !ready_.empty() || running_ == 0; });
+                if (ready_.empty())
+                    return;
+
+                handle = ready_.front();
+                ready_.pop_front();
+                ++running_;
+            }
+
+            // The handle may be re-queued and resumed elsewhere before this returns
+            handle.resume();
+
+            {
+                std::lock_guard lock(mutex_);
+                --running_;
+                if (running_ == 0 && ready_.empty())
+                    ready_cv_.notify_all();
+            }
+        }
+}
+
+void Scheduler::finished(std::coroutine_handle<> handle) noexcept
+{
+    std::lock_guard lock(mutex_);
+    live_.erase(handle.address());
+}
+
+void Event::set()
+{
+    std::vector<std::coroutine_handle<>> waiters;
+    {
+        std::lock_guard lock(mutex_);
+        set_ = true;
+        waiters.swap(waiters_);
+    }
+
+    for (auto handle : waiters)
+        {
+            scheduler_.schedule(handle);
+        }
+}
+
+void Event::reset()
+{
+    std::lock_guard lock(mutex_);
+    set_ = false;
+}
+
+bool Event::is_set() const
+{
+    std::lock_guard lock(mutex_);
+    return set_;
+}
+
+bool Event::Awaiter::await_suspend(std::coroutine_handle<> handle)
+{
+    std::lock_guard lock(event.mutex_);
+    if (event.set_)
+        return false;
+
+    event.waiters_.push_back(handle);
+    return true;
+}
+
+Task run_machine(Scheduler& scheduler, CPU& cpu, Memory& memory, StopCondition stop, u64 quantum,
+                 std::expected<RunResult, EmulatorError>& result)
+{
+    RunResult total{};
+    quantum = std::max<u64>(quantum, 1);
+
+    while (total.cycles < stop.max_cycles)
+        {
+            StopCondition slice = stop;
+            slice.max_cycles    = std::min(quantum, stop.max_cycles - total.cycles);
+
+            auto outcome = co_await scheduler.slice(cpu, memory, slice);
+            if (!outcome)
+                {
+                    result = std::unexpected(outcome.error());
+                    co_return;
+                }
+
+            total.cycles += outcome->cycles;
+            total.instructions += outcome->instructions;
+            if (outcome->reason != StopReason::CycleLimit)
+                {
+                    total.reason = outcome->reason;
+                    break;
+                }
+        }
+
+    result = total;
+}
+
+}  // namespace cpu6502
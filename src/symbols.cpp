@@ -0,0 +1,367 @@
+#include "cpu6502/symbols.hpp"
+#include <algorithm>
+#include <charconv>
+#include <format>
+#include <unordered_map>
+
+namespace cpu6502
+{
+
+namespace
+{
+
+[[nodiscard]] std::string_view trim(std::string_view text) noexcept
+{
+    const auto first = text.find_first_not_of(" \t\r");
+    if (first == std::string_view::npos)
+        return {};
+
+    const auto last = text.find_last_not_of(" \t\r");
+    return text.substr(first, last - first + 1);
+}
+
+// Calls visit(line) for every line of text
+template <typename Visitor>
+void for_each_line(std::string_view text, Visitor&& visit)
+{
+    while (!text.empty())
+        {
+            const auto end = text.find('\n');
+            visit(trim(text.substr(0, end)));
+            if (end == std::string_view::npos)
+                break;
+            text.remove_prefix(end + 1);
+        }
+}
+
+[[nodiscard]] bool parse_digits(std::string_view text, u32& value, int base) noexcept
+{
+    const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value, base);
+    return !text.empty() && error == std::errc{} && end == text.data() + text.size();
+}
+
+// Decimal, or hexadecimal with a 0x or $ prefix
+[[nodiscard]] bool parse_number(std::string_view text, u32& value) noexcept
+{
+    if (text.starts_with("0x") || text.starts_with("0X"))
+        return parse_digits(text.substr(2), value, 16);
+    if (text.starts_with('$'))
+        return parse_digits(text.substr(1), value, 16);
+
+    return parse_digits(text, value, 10);
+}
+
+// Splits "kind<whitespace>fields" and checks the record kind
+[[nodiscard]] bool record_fields(std::string_view line, std::string_view kind,
+                                 std::string_view& fields) noexcept
+{
+    if (!line.starts_with(kind) || line.size() <= kind.size() ||
+        (line[kind.size()] != '\t' && line[kind.size()] != ' '))
+        return false;
+
+    fields = trim(line.substr(kind.size()));
+    return true;
+}
+
+// Calls visit(key, value) for each key=value pair of a debug file record;
+// quoted values are passed without the quotes. False if the record is malformed.
+template <typename Visitor>
+[[nodiscard]] bool for_each_field(std::string_view fields, Visitor&& visit)
+{
+    while (!fields.empty())
+        {
+            const auto equals = fields.find('=');
+            if (equals == std::string_view::npos)
+                return false;
+
+            const std::string_view key = fields.substr(0, equals);
+            fields.remove_prefix(equals + 1);
+
+            std::string_view value;
+            if (fields.starts_with('"'))
+                {
+                    const auto quote = fields.find('"', 1);
+                    if (quote == std::string_view::npos)
+                        return false;
+                    value = fields.substr(1, quote - 1);
+                    fields.remove_prefix(quote + 1);
+                }
+            else
+                {
+                    value = fields.substr(0, fields.find(','));
+                    fields.remove_prefix(value.size());
+                }
+            if (fields.starts_with(','))
+                fields.remove_prefix(1);
+
+            visit(key, value);
+        }
+    return true;
+}
+
+}  // namespace
+
+void SymbolTable::add(u16 address, std::string name, u16 size)
+{
+    auto it = std::ranges::lower_bound(symbols_, address, {}, &Symbol::address);
+    if (it != symbols_.end() && it->address == address)
+        return;
+
+    symbols_.insert(it, Symbol{address, size, std::move(name)});
+}
+
+std::size_t SymbolTable::load_vice_labels(std::string_view text)
+{
+    const std::size_t before = symbols_.size();
+
+    // al [C:]ADDR .name
+    for_each_line(text,
+                  [this](std::string_view line)
+                  {
+                      if (!line.starts_with("al "))
+                          return;
+                      line = trim(line.substr(3));
+
+                      const auto space = line.find_first_of(" \t");
+                      if (space == std::string_view::npos)
+                          return;
+
+                      std::string_view address = line.substr(0, space);
+                      std::string_view name    = trim(line.substr(space));
+                      if (address.size() > 2 && address[1] == ':')
+                          address.remove_prefix(2);
+                      if (name.starts_with('.'))
+                          name.remove_prefix(1);
+
+                      u32 value = 0;
+                      if (name.empty() || !parse_digits(address, value, 16) || value > 0xFFFF)
+                          return;
+
+                      add(static_cast<u16>(value), std::string(name));
+                  });
+
+    return symbols_.size() - before;
+}
+
+std::size_t SymbolTable::load_ca65_dbg(std::string_view text)
+{
+    const std::size_t before = symbols_.size();
+
+    // sym id=0,name="main",addrsize=absolute,size=3,scope=0,def=1,val=0x8000,type=lab
+    for_each_line(text,
+                  [this](std::string_view line)
+                  {
+                      std::string_view fields;
+                      if (!record_fields(line, "sym", fields))
+                          return;
+
+                      std::string_view name;
+                      std::string_view type;
+                      u32              value     = 0;
+                      u32              size      = 0;
+                      bool             has_value = false;
+
+                      const bool parsed = for_each_field(
+                          fields,
+                          [&](std::string_view key, std::string_view field)
+                          {
+                              if (key == "name")
+                                  name = field;
+                              else if (key == "type")
+                                  type = field;
+                              else if (key == "val")
+                                  has_value = parse_number(field, value);
+                              else if (key == "size" && !parse_number(field, size))
+                                  size = 0;
+                          });
+
+                      if (!parsed || type != "lab" || name.empty() || !has_value || value > 0xFFFF)
+                          return;
+
+                      add(static_cast<u16>(value), std::string(name),
+                          static_cast<u16>(std::min<u32>(size, 0xFFFF)));
+                  });
+
+    return symbols_.size() - before;
+}
+
+const Symbol* SymbolTable::resolve(u16 address) const noexcept
+{
+    auto it = std::ranges::upper_bound(symbols_, address, {}, &Symbol::address);
+    if (it == symbols_.begin())
+        return nullptr;
+
+    const Symbol& symbol = *std::prev(it);
+    if (symbol.size != 0 && address - symbol.address >= symbol.size)
+        return nullptr;
+
+    return &symbol;
+}
+
+const Symbol* SymbolTable::find(std::string_view name) const noexcept
+{
+    const auto it = std::ranges::find(symbols_, name, &Symbol::name);
+    return it == symbols_.end() ? nullptr : &*it;
+}
+
+std::string SymbolTable::describe(u16 address) const
+{
+    const Symbol* symbol = resolve(address);
+    if (symbol == nullptr)
+        return std::format("${:04X}", address);
+    if (symbol->address == address)
+        return symbol->name;
+
+    return std::format("{}+{}", symbol->name, address - symbol->address);
+}
+
+std::string SymbolTable::function_name(u16 address) const
+{
+    const Symbol* symbol = resolve(address);
+    if (symbol == nullptr)
+        return std::format("${:04X}", address);
+
+    return symbol->name;
+}
+
+u32 LineTable::add_file(std::string_view name)
+{
+    const auto it = std::ranges::find(files_, name);
+    if (it != files_.end())
+        return static_cast<u32>(std::distance(files_.begin(), it));
+
+    files_.emplace_back(name);
+    return static_cast<u32>(files_.size() - 1);
+}
+
+void LineTable::add(u32 file, u32 line, u16 address, u16 size)
+{
+    ranges_.push_back({address, size, file, line});
+}
+
+std::size_t LineTable::load_ca65_dbg(std::string_view text)
+{
+    struct Span
+    {
+        u32  segment = 0;
+        u32  start   = 0;
+        u32  size    = 0;
+        bool data    = false;  // .byte/.word and friends carry a type
+    };
+    struct Line
+    {
+        u32              file = 0;
+        u32              line = 0;
+        std::string_view spans;  // "id+id+..."
+    };
+
+    // Records refer to each other by id and may come in any order, so collect first
+    std::unordered_map<u32, u32>  file_index;
+    std::unordered_map<u32, u32>  segment_start;
+    std::unordered_map<u32, Span> spans;
+    std::vector<Line>             lines;
+
+    for_each_line(text,
+                  [&](std::string_view record)
+                  {
+                      std::string_view fields;
+                      u32              id = 0;
+                      if (record_fields(record, "file", fields))
+                          {
+                              std::string_view name;
+                              if (for_each_field(fields,
+                                                 [&](std::string_view key, std::string_view value)
+                                                 {
+                                                     if (key == "id")
+                                                         (void)parse_number(value, id);
+                                                     else if (key == "name")
+                                                         name = value;
+                                                 }))
+                                  file_index[id] = add_file(name);
+                          }
+                      else if (record_fields(record, "seg", fields))
+                          {
+                              u32 start = 0;
+                              if (for_each_field(fields,
+                                                 [&](std::string_view key, std::string_view value)
+                                                 {
+                                                     if (key == "id")
+                                                         (void)parse_number(value, id);
+                                                     else if (key == "start")
+                                                         (void)parse_number(value, start);
+                                                 }))
+                                  segment_start[id] = start;
+                          }
+                      else if (record_fields(record, "span", fields))
+                          {
+                              Span span;
+                              if (for_each_field(fields,
+                                                 [&](std::string_view key, std::string_view value)
+                                                 {
+                                                     if (key == "id")
+                                                         (void)parse_number(value, id);
+                                                     else if (key == "seg")
+                                                         (void)parse_number(value, span.segment);
+                                                     else if (key == "start")
+                                                         (void)parse_number(value, span.start);
+                                                     else if (key == "size")
+                                                         (void)parse_number(value, span.size);
+                                                     else if (key == "type")
+                                                         span.data = true;
+                                                 }))
+                                  spans[id] = span;
+                          }
+                      else if (record_fields(record, "line", fields))
+                          {
+                              Line line;
+                              if (for_each_field(fields,
+                                                 [&](std::string_view key, std::string_view value)
+                                                 {
+                                                     if (key == "file")
+                                                         (void)parse_number(value, line.file);
+                                                     else if (key == "line")
+                                                         (void)parse_number(value, line.line);
+                                                     else if (key == "span")
+                                                         line.spans = value;
+                                                 }) &&
+                                  !line.spans.empty())
+                                  lines.push_back(line);
+                          }
+                  });
+
+    const std::size_t before = ranges_.size();
+    for (const Line& line : lines)
+        {
+            const auto file = file_index.find(line.file);
+            if (file == file_index.end())
+                continue;
+
+            std::string_view ids = line.spans;
+            while (!ids.empty())
+                {
+                    const auto plus = ids.find('+');
+                    u32        id   = 0;
+                    const bool ok   = parse_digits(ids.substr(0, plus), id, 10);
+                    ids.remove_prefix(plus == std::string_view::npos ? ids.size() : plus + 1);
+
+                    const auto span = ok ? spans.find(id) : spans.end();
+                    if (span == spans.end() || span->second.size == 0 || span->second.data)
+                        continue;
+
+                    const auto segment = segment_start.find(span->second.segment);
+                    if (segment == segment_start.end())
+                        continue;
+
+                    const u32 address = segment->second + span->second.start;
+                    if (address > 0xFFFF)
+                        continue;
+
+                    const u32 size = std::min<u32>({span->second.size, 0x10000 - address, 0xFFFF});
+                    add(file->second, line.line, static_cast<u16>(address), static_cast<u16>(size));
+                }
+        }
+
+    return ranges_.size() - before;
+}
+
+}  // namespace cpu6502
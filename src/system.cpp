@@ -0,0 +1,205 @@
+#include "cpu6502/system.hpp"
+#include <limits>
+#include <optional>
+
+namespace cpu6502
+{
+
+namespace
+{
+
+/**
+ * @type class
+ * @brief Holds back the notification of a guarded step until it completes
+ *
+ * A step rolled back on a shared page is executed again later, so only the
+ * attempt that completes may reach the real observer.
+ */
+class HeldNotification final : public ExecutionObserver
+{
+ public:
+    void on_instruction(const TraceRecord& record) noexcept override
+    {
+        record_ = record;
+        kind_.reset();
+        held_ = true;
+    }
+
+    void on_interrupt(const TraceRecord& record, InterruptKind kind) noexcept override
+    {
+        record_ = record;
+        kind_   = kind;
+        held_   = true;
+    }
+
+    void release(ExecutionObserver& observer) noexcept
+    {
+        if (held_ && kind_)
+            observer.on_interrupt(record_, *kind_);
+        else if (held_)
+            observer.on_instruction(record_);
+        held_ = false;
+    }
+
+    void discard() noexcept { held_ = false; }
+
+ private:
+    TraceRecord                  record_{};
+    std::optional<InterruptKind> kind_;
+    bool                         held_ = false;
+};
+
+}  // namespace
+
+System::System(std::size_t cpu_count)
+    : bus_(std::make_unique<Memory>()),
+      cpus_(cpu_count),
+      time_(cpu_count, 0),
+      waiting_(cpu_count, false)
+{
+}
+
+auto System::run(u64 cycles, Interleave mode) -> std::expected<void, EmulatorError>
+{
+    target_ += cycles;
+
+    return mode == Interleave::Instruction ? run_instructions() : run_slices();
+}
+
+auto System::run_instructions() -> std::expected<void, EmulatorError>
+{
+    while (true)
+        {
+            std::size_t next = cpus_.size();
+            for (std::size_t i = 0; i < cpus_.size(); ++i)
+                {
+                    if (time_[i] < target_ && (next == cpus_.size() || time_[i] < time_[next]))
+                        next = i;
+                }
+
+            if (next == cpus_.size())
+                return {};
+
+            auto stepped = step(next);
+            if (!stepped)
+                return stepped;
+        }
+}
+
+auto System::run_slices() -> std::expected<void, EmulatorError>
+{
+    while (true)
+        {
+            u64 earliest = std::numeric_limits<u64>::max();
+            for (u64 time : time_)
+                {
+                    if (time < target_)
+                        earliest = std::min(earliest, time);
+                }
+
+            if (earliest == std::numeric_limits<u64>::max())
+                return {};
+
+            const u64 horizon = earliest + std::min(slice_, target_ - earliest);
+
+            // Private phase: every CPU runs alone until the horizon or a shared page
+            set_guards(true);
+            for (std::size_t i = 0; i < cpus_.size(); ++i)
+                {
+                    auto ran = run_guarded(i, horizon);
+                    if (!ran)
+                        {
+                            set_guards(false);
+                            return ran;
+                        }
+                }
+
+            // Shared phase: no CPU can touch a shared page before the earliest waiter
+            while (true)
+                {
+                    std::size_t next = cpus_.size();
+                    for (std::size_t i = 0; i < cpus_.size(); ++i)
+                        {
+                            if (waiting_[i] && (next == cpus_.size() || time_[i] < time_[next]))
+                                next = i;
+                        }
+
+                    if (next == cpus_.size())
+                        break;
+
+                    set_guards(false);
+                    waiting_[next] = false;
+                    auto stepped   = step(next);
+                    set_guards(true);
+
+                    auto ran = stepped ? run_guarded(next, horizon) : stepped;
+                    if (!ran)
+                        {
+                            set_guards(false);
+                            return ran;
+                        }
+                }
+
+            set_guards(false);
+        }
+}
+
+auto System::run_guarded(std::size_t index, u64 horizon) -> std::expected<void, EmulatorError>
+{
+    CPU&                     cpu      = cpus_[index];
+    ExecutionObserver* const observer = cpu.get_observer();
+    HeldNotification         held;
+    if (observer != nullptr)
+        cpu.set_observer(&held);
+
+    std::expected<void, EmulatorError> result;
+    while (time_[index] < horizon)
+        {
+            // A faulting instruction is replayed later from these registers; any
+            // bytes it pushed before faulting are rewritten with the same values
+            const Registers before = cpu.get_registers();
+
+            auto cycles = cpu.step(*bus_);
+            if (!cycles && cycles.error() == EmulatorError::GuardedPageAccess)
+                {
+                    held.discard();
+                    cpu.set_registers(before);
+                    waiting_[index] = true;
+                    break;
+                }
+
+            if (observer != nullptr)
+                held.release(*observer);
+            if (!cycles)
+                {
+                    result = std::unexpected(cycles.error());
+                    break;
+                }
+
+            time_[index] += static_cast<u64>(*cycles);
+        }
+
+    cpu.set_observer(observer);
+    return result;
+}
+
+auto System::step(std::size_t index) -> std::expected<void, EmulatorError>
+{
+    auto cycles = cpus_[index].step(*bus_);
+    if (!cycles)
+        return std::unexpected(cycles.error());
+
+    time_[index] += static_cast<u64>(*cycles);
+    return {};
+}
+
+void System::set_guards(bool guarded) noexcept
+{
+    for (std::size_t page = 0; page < shared_.size(); ++page)
+        {
+            if (shared_[page])
+                bus_->guard_page(static_cast<u8>(page), guarded);
+        }
+}
+
+}  // namespace cpu6502
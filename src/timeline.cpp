@@ -0,0 +1,323 @@
+#include "cpu6502/timeline.hpp"
+#include <array>
+#include <format>
+#include "cpu6502/opcodes.hpp"
+
+namespace cpu6502
+{
+
+namespace
+{
+
+// Perfetto field numbers (protos/perfetto/trace/...)
+constexpr u32 TRACE_PACKET            = 1;   // Trace.packet
+constexpr u32 PACKET_TIMESTAMP        = 8;   // TracePacket.timestamp
+constexpr u32 PACKET_SEQUENCE_ID      = 10;  // TracePacket.trusted_packet_sequence_id
+constexpr u32 PACKET_TRACK_EVENT      = 11;  // TracePacket.track_event
+constexpr u32 PACKET_TRACK_DESCRIPTOR = 60;  // TracePacket.track_descriptor
+constexpr u32 EVENT_TYPE              = 9;   // TrackEvent.type
+constexpr u32 EVENT_TRACK_UUID        = 11;  // TrackEvent.track_uuid
+constexpr u32 EVENT_NAME              = 23;  // TrackEvent.name
+constexpr u32 DESCRIPTOR_UUID         = 1;   // TrackDescriptor.uuid
+constexpr u32 DESCRIPTOR_NAME         = 2;   // TrackDescriptor.name
+constexpr u32 WIRE_VARINT             = 0;
+constexpr u32 WIRE_LENGTH_DELIMITED   = 2;
+constexpr u64 SEQUENCE_ID             = 1;
+
+void put_varint(std::string& out, u64 value)
+{
+    while (value >= 0x80)
+        {
+            out.push_back(static_cast<char>(value | 0x80));
+            value >>= 7;
+        }
+    out.push_back(static_cast<char>(value));
+}
+
+void put_tag(std::string& out, u32 field, u32 wire_type)
+{
+    put_varint(out, (u64{field} << 3) | wire_type);
+}
+
+void put_uint(std::string& out, u32 field, u64 value)
+{
+    put_tag(out, field, WIRE_VARINT);
+    put_varint(out, value);
+}
+
+void put_bytes(std::string& out, u32 field, std::string_view bytes)
+{
+    put_tag(out, field, WIRE_LENGTH_DELIMITED);
+    put_varint(out, bytes.size());
+    out.append(bytes);
+}
+
+constexpr std::string_view HEX_DIGITS = "0123456789ABCDEF";
+
+// Quoted and escaped, written in runs straight to out
+void put_json_string(std::ostream& out, std::string_view text)
+{
+    out << '"';
+    std::size_t run = 0;
+    for (std::size_t i = 0; i < text.size(); ++i)
+        {
+            const auto c = static_cast<unsigned char>(text[i]);
+            if (c != '"' && c != '\\' && c >= 0x20)
+                continue;
+
+            out.write(text.data() + run, static_cast<std::streamsize>(i - run));
+            run = i + 1;
+            if (c >= 0x20)
+                {
+                    const char escaped[2] = {'\\', static_cast<char>(c)};
+                    out.write(escaped, 2);
+                }
+            else
+                {
+                    const char escaped[6] = {'\\', 'u', '0', '0', HEX_DIGITS[c >> 4],
+                                             HEX_DIGITS[c & 0xF]};
+                    out.write(escaped, 6);
+                }
+        }
+    out.write(text.data() + run, static_cast<std::streamsize>(text.size() - run));
+    out << '"';
+}
+
+// "$XXXX", as SymbolTable::function_name() names an unknown address
+struct AddressName
+{
+    std::array<char, 5> text{};
+
+    operator std::string_view() const noexcept { return {text.data(), text.size()}; }
+};
+
+[[nodiscard]] AddressName address_name(u16 address) noexcept
+{
+    AddressName name;
+    name.text[0] = '$';
+    for (std::size_t i = 0; i < 4; ++i)
+        name.text[4 - i] = HEX_DIGITS[(address >> (4 * i)) & 0xF];
+    return name;
+}
+
+}  // namespace
+
+TimelineWriter::TimelineWriter(std::ostream& out, TimelineFormat format, const SymbolTable* symbols)
+    : out_(out), format_(format), symbols_(symbols)
+{
+    if (format_ == TimelineFormat::ChromeJson)
+        out_ << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+
+    describe_track(Track::Cpu, "6502");
+    describe_track(Track::Markers, "markers");
+}
+
+TimelineWriter::~TimelineWriter()
+{
+    if (finished_)
+        return;
+
+    try
+        {
+            finish(last_cycles_);
+        }
+    catch (...)
+        {
+            failed_ = true;
+        }
+}
+
+void TimelineWriter::on_instruction(const TraceRecord& record) noexcept
+{
+    last_cycles_ = record.cycles;
+    if (failed_)
+        return;
+
+    try
+        {
+            if (call_pending_)
+                {
+                    call_pending_ = false;
+                    const Symbol* symbol =
+                        symbols_ != nullptr ? symbols_->resolve(record.pc) : nullptr;
+                    if (symbol != nullptr)
+                        {
+                            open(record, symbol->name, call_sp_);
+                        }
+                    else
+                        {
+                            open(record, address_name(record.pc), call_sp_);
+                        }
+                }
+
+            close_returned(record.sp, record.cycles);
+
+            if (record.opcode == static_cast<u8>(Opcode::JSR))
+                {
+                    call_pending_ = true;
+                    call_sp_      = record.sp;
+                }
+            else if (record.opcode == static_cast<u8>(Opcode::BRK))
+                {
+                    open(record, "BRK", record.sp);
+                }
+        }
+    catch (...)
+        {
+            failed_ = true;
+        }
+}
+
+void TimelineWriter::on_interrupt(const TraceRecord& record, InterruptKind kind) noexcept
+{
+    last_cycles_ = record.cycles;
+    if (failed_)
+        return;
+
+    try
+        {
+            close_returned(record.sp, record.cycles);
+            open(record, kind == InterruptKind::Nmi ? "NMI" : "IRQ", record.sp);
+        }
+    catch (...)
+        {
+            failed_ = true;
+        }
+}
+
+void TimelineWriter::begin(std::string_view name, u64 cycles)
+{
+    ++open_markers_;
+    emit(Phase::Begin, Track::Markers, name, cycles);
+}
+
+void TimelineWriter::end(u64 cycles)
+{
+    if (open_markers_ == 0)
+        return;
+
+    --open_markers_;
+    emit(Phase::End, Track::Markers, {}, cycles);
+}
+
+void TimelineWriter::marker(std::string_view name, u64 cycles)
+{
+    emit(Phase::Instant, Track::Markers, name, cycles);
+}
+
+void TimelineWriter::finish(u64 end_cycles)
+{
+    if (finished_)
+        return;
+
+    // Nothing more goes to a stream that already failed
+    finished_ = true;
+    if (failed_)
+        return;
+
+    while (!frames_.empty())
+        {
+            frames_.pop_back();
+            emit(Phase::End, Track::Cpu, {}, end_cycles);
+        }
+    while (open_markers_ != 0)
+        end(end_cycles);
+
+    if (format_ == TimelineFormat::ChromeJson)
+        out_ << "\n]}\n";
+
+    out_.flush();
+}
+
+void TimelineWriter::open(const TraceRecord& record, std::string_view name, i32 return_sp)
+{
+    frames_.push_back(return_sp);
+    emit(Phase::Begin, Track::Cpu, name, record.cycles);
+}
+
+void TimelineWriter::close_returned(u8 sp, u64 cycles)
+{
+    while (!frames_.empty() && static_cast<i32>(sp) >= frames_.back())
+        {
+            frames_.pop_back();
+            emit(Phase::End, Track::Cpu, {}, cycles);
+        }
+}
+
+void TimelineWriter::describe_track(Track track, std::string_view name)
+{
+    if (format_ == TimelineFormat::ChromeJson)
+        {
+            out_ << (first_event_ ? "" : ",\n");
+            first_event_ = false;
+            out_ << std::format("{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":{},"
+                                "\"args\":{{\"name\":",
+                                static_cast<u32>(track));
+            put_json_string(out_, name);
+            out_ << "}}";
+            return;
+        }
+
+    message_.clear();
+    put_uint(message_, DESCRIPTOR_UUID, static_cast<u64>(track));
+    put_bytes(message_, DESCRIPTOR_NAME, name);
+
+    packet_.clear();
+    put_uint(packet_, PACKET_SEQUENCE_ID, SEQUENCE_ID);
+    put_bytes(packet_, PACKET_TRACK_DESCRIPTOR, message_);
+    write_packet();
+}
+
+void TimelineWriter::emit(Phase phase, Track track, std::string_view name, u64 cycles)
+{
+    if (format_ == TimelineFormat::ChromeJson)
+        emit_json(phase, track, name, cycles);
+    else
+        emit_perfetto(phase, track, name, cycles);
+}
+
+void TimelineWriter::emit_json(Phase phase, Track track, std::string_view name, u64 cycles)
+{
+    static constexpr const char* PHASES[] = {"B", "E", "i"};
+
+    // Written in pieces: this runs for every span the CPU opens or closes
+    out_ << (first_event_ ? "" : ",\n") << "{\"ph\":\"" << PHASES[static_cast<std::size_t>(phase)]
+         << "\",\"ts\":" << cycles << ",\"pid\":1,\"tid\":" << static_cast<u32>(track);
+    first_event_ = false;
+    if (phase != Phase::End)
+        {
+            out_ << ",\"name\":";
+            put_json_string(out_, name);
+        }
+    if (phase == Phase::Instant)
+        out_ << ",\"s\":\"t\"";
+    out_ << '}';
+}
+
+void TimelineWriter::emit_perfetto(Phase phase, Track track, std::string_view name, u64 cycles)
+{
+    // TrackEvent.Type: SLICE_BEGIN = 1, SLICE_END = 2, INSTANT = 3
+    message_.clear();
+    put_uint(message_, EVENT_TYPE, static_cast<u64>(phase) + 1);
+    put_uint(message_, EVENT_TRACK_UUID, static_cast<u64>(track));
+    if (phase != Phase::End)
+        put_bytes(message_, EVENT_NAME, name);
+
+    packet_.clear();
+    put_uint(packet_, PACKET_TIMESTAMP, cycles);
+    put_uint(packet_, PACKET_SEQUENCE_ID, SEQUENCE_ID);
+    put_bytes(packet_, PACKET_TRACK_EVENT, message_);
+    write_packet();
+}
+
+void TimelineWriter::write_packet()
+{
+    // Each Trace.packet field is self-delimiting, so packets can be appended forever
+    header_.clear();
+    put_tag(header_, TRACE_PACKET, WIRE_LENGTH_DELIMITED);
+    put_varint(header_, packet_.size());
+    out_.write(header_.data(), static_cast<std::streamsize>(header_.size()));
+    out_.write(packet_.data(), static_cast<std::streamsize>(packet_.size()));
+}
+
+}  // namespace cpu6502
@@ -0,0 +1,75 @@
+#include "cpu6502/trace_ring.hpp"
+#include <algorithm>
+#include <bit>
+#include <thread>
+
+namespace cpu6502
+{
+
+TraceRing::TraceRing(std::size_t capacity, OverflowPolicy policy)
+    : buffer_(std::make_unique<TraceRecord[]>(std::bit_ceil(std::max<std::size_t>(capacity, 2)))),
+      mask_(std::bit_ceil(std::max<std::size_t>(capacity, 2)) - 1),
+      policy_(policy)
+{
+}
+
+bool TraceRing::push(const TraceRecord& record) noexcept
+{
+    const std::size_t head = head_.load(std::memory_order_relaxed);
+
+    if (head - cached_tail_ > mask_)
+        {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            while (head - cached_tail_ > mask_)
+                {
+                    if (policy_ == OverflowPolicy::Drop)
+                        {
+                            dropped_.fetch_add(1, std::memory_order_relaxed);
+                            return false;
+                        }
+
+                    std::this_thread::yield();
+                    cached_tail_ = tail_.load(std::memory_order_acquire);
+                }
+        }
+
+    buffer_[head & mask_] = record;
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+bool TraceRing::pop(TraceRecord& record) noexcept
+{
+    return pop_bulk(std::span<TraceRecord>(&record, 1)) == 1;
+}
+
+std::size_t TraceRing::pop_bulk(std::span<TraceRecord> out) noexcept
+{
+    const std::size_t tail = tail_.load(std::memory_order_relaxed);
+
+    if (cached_head_ - tail < out.size())
+        cached_head_ = head_.load(std::memory_order_acquire);
+
+    const std::size_t count = std::min(cached_head_ - tail, out.size());
+    for (std::size_t i = 0; i < count; ++i)
+        {
+            out[i] = buffer_[(tail + i) & mask_];
+        }
+
+    tail_.store(tail + count, std::memory_order_release);
+    return count;
+}
+
+bool TraceRing::finished() const noexcept
+{
+    // closed_ first: a push that happened before close() is then visible in head_
+    return closed_.load(std::memory_order_acquire) &&
+           head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_relaxed);
+}
+
+std::size_t TraceRing::size() const noexcept
+{
+    return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+}
+
+}  // namespace cpu6502
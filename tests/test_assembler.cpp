@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+#include <array>
+#include "cpu6502/assembler.hpp"
+#include "cpu6502/cpu.hpp"
+#include "test_support.hpp"
+
+using namespace cpu6502;
+using namespace cpu6502::test;
+
+namespace {
+
+// Adds 5 + 4 + 3 + 2 + 1 into $10 one INC at a time
+constexpr FixedString kSumSource = R"(
+        .org $8000
+total = $10
+        LDX #5
+outer:  LDY identity,X
+inner:  INC total
+        DEY
+        BNE inner
+        DEX
+        BNE outer
+        BRK
+identity:
+        .byte 0, 1, 2, 3, 4, 5
+)";
+
+}  // namespace
+
+TEST(AssemblerTest, EncodesEveryOperandForm) {
+    // given:
+    constexpr auto image = assemble<R"(
+            .org $0200
+    zp = $42
+            LDA #$12
+            LDA zp
+            LDA zp,X
+            LDX zp,Y
+            LDA $1234
+            LDA $1234,X
+            LDA $1234,Y
+            LDA (zp,X)
+            LDA (zp),Y
+            JMP ($1234)
+            ASL A
+            ASL
+            CLC
+    )">();
+
+    // then:
+    constexpr std::array<u8, 27> expected = {
+        op(Opcode::LDA_IM),   0x12,
+        op(Opcode::LDA_ZP),   0x42,
+        op(Opcode::LDA_ZPX),  0x42,
+        op(Opcode::LDX_ZPY),  0x42,
+        op(Opcode::LDA_ABS),  0x34, 0x12,
+        op(Opcode::LDA_ABSX), 0x34, 0x12,
+        op(Opcode::LDA_ABSY), 0x34, 0x12,
+        op(Opcode::LDA_INDX), 0x42,
+        op(Opcode::LDA_INDY), 0x42,
+        op(Opcode::JMP_IND),  0x34, 0x12,
+        op(Opcode::ASL_A),
+        op(Opcode::ASL_A),
+        op(Opcode::CLC),
+    };
+    static_assert(image == expected);
+    EXPECT_EQ(image, expected);
+}
+
+TEST(AssemblerTest, ResolvesForwardAndBackwardBranches) {
+    // given:
+    constexpr FixedString source = R"(
+            .org $8000
+    start:  BEQ done    ; forward
+            DEX
+            BNE start   ; backward
+            JSR sub
+    done:   BRK
+    sub:    RTS
+    )";
+    constexpr auto image = assemble<source>();
+
+    // then:
+    constexpr std::array<u8, 11> expected = {
+        op(Opcode::BEQ), 0x06,
+        op(Opcode::DEX),
+        op(Opcode::BNE), 0xFB,
+        op(Opcode::JSR), 0x0A, 0x80,
+        op(Opcode::BRK), 0x00,
+        op(Opcode::RTS),
+    };
+    static_assert(image == expected);
+    EXPECT_EQ(image, expected);
+    static_assert(assembled_value<source>("done") == 0x8008);
+    static_assert(assembled_origin<source>() == 0x8000);
+}
+
+TEST(AssemblerTest, EvaluatesExpressionsAndData) {
+    // given:
+    constexpr auto image = assemble<R"(
+            .org $C000
+    base = $2000
+    here:   LDA #<table
+            LDX #>table
+            LDY base+$10-1
+            .word here, *
+            .byte 'A', %1010, 255
+    table:
+    )">();
+
+    // then:
+    constexpr std::array<u8, 14> expected = {
+        op(Opcode::LDA_IM), 0x0E,
+        op(Opcode::LDX_IM), 0xC0,
+        op(Opcode::LDY_ABS), 0x0F, 0x20,
+        0x00, 0xC0,
+        0x07, 0xC0,  // * is the address of the statement
+        'A', 0x0A, 0xFF,
+    };
+    static_assert(image == expected);
+    EXPECT_EQ(image, expected);
+}
+
+TEST(AssemblerTest, LabelsAlwaysUseAbsoluteAddressing) {
+    // given: a label in the zero page still assembles to the absolute form
+    constexpr auto image = assemble<R"(
+            .org $0000
+    var:    .byte 0
+            INC var
+    )">();
+
+    // then:
+    static_assert(image[1] == op(Opcode::INC_ABS));
+    EXPECT_EQ(image.size(), 4u);
+}
+
+TEST(AssemblerTest, AssembledProgramRuns) {
+    // given:
+    Machine machine(assemble<kSumSource>(), assembled_origin<kSumSource>());
+
+    // when:
+    auto result = machine.cpu.run(StopCondition{.stop_on_brk = true}, *machine.memory);
+
+    // then:
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(result->reason, StopReason::Brk);
+    EXPECT_EQ((*machine.memory)[0x10], 15);
+}
@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <vector>
+#include "cpu6502/batch.hpp"
+#include "cpu6502/opcodes.hpp"
+
+using namespace cpu6502;
+
+namespace {
+
+// Adds 3 to the seed in A, X times, then stops on BRK
+constexpr std::array<u8, 8> kProgram = {
+    static_cast<u8>(Opcode::CLC),           // $8000 CLC
+    static_cast<u8>(Opcode::ADC_IM), 0x03,  // $8001 ADC #$03
+    static_cast<u8>(Opcode::DEX),           // $8003 DEX
+    static_cast<u8>(Opcode::BNE),    0xFA,  // $8004 BNE $8000
+    static_cast<u8>(Opcode::BRK),    0x00,  // $8006 BRK
+};
+
+auto make_job(u8 seed, u8 count) -> BatchJob {
+    BatchJob job;
+    job.image            = kProgram;
+    job.registers.pc     = 0x8000;
+    job.registers.a      = seed;
+    job.registers.x      = count;
+    job.stop.stop_on_brk = true;
+    return job;
+}
+
+}  // namespace
+
+TEST(BatchTest, SingleThreadMatchesDirectRun) {
+    // given:
+    BatchRunner runner(1);
+    std::vector<BatchJob> jobs = {make_job(0x10, 4)};
+
+    // when:
+    auto results = runner.run(jobs);
+
+    // then:
+    ASSERT_EQ(results.size(), 1u);
+    ASSERT_TRUE(results[0].outcome.has_value());
+    EXPECT_EQ(results[0].outcome->reason, StopReason::Brk);
+    EXPECT_EQ(results[0].registers.a, 0x10 + 4 * 3);
+    EXPECT_EQ(results[0].registers.pc, 0x8006);
+    EXPECT_EQ(results[0].outcome->instructions, 4u * 4u);
+}
+
+TEST(BatchTest, ManyJobsAcrossThreadsLandInTheirOwnResultSlot) {
+    // given:
+    BatchRunner runner(4);
+    std::vector<BatchJob> jobs;
+    for (unsigned i = 0; i < 1000; ++i) {
+        jobs.push_back(make_job(static_cast<u8>(i), static_cast<u8>(1 + i % 50)));
+    }
+    std::vector<BatchResult> results(jobs.size());
+
+    // when:
+    runner.run(jobs, results);
+
+    // then:
+    for (unsigned i = 0; i < jobs.size(); ++i) {
+        ASSERT_TRUE(results[i].outcome.has_value()) << "job " << i;
+        const auto expected = static_cast<u8>(i + (1 + i % 50) * 3);
+        EXPECT_EQ(results[i].registers.a, expected) << "job " << i;
+    }
+}
+
+TEST(BatchTest, RunnerIsReusableAcrossBatches) {
+    BatchRunner runner(3);
+    std::vector<BatchJob> jobs(10, make_job(0x01, 2));
+
+    auto first  = runner.run(jobs);
+    auto second = runner.run(jobs);
+
+    for (std::size_t i = 0; i < jobs.size(); ++i) {
+        EXPECT_EQ(first[i].registers.a, 0x07);
+        EXPECT_EQ(second[i].registers.a, 0x07);
+    }
+}
+
+TEST(BatchTest, JobsDoNotSeeEachOthersMemory) {
+    // given: the first job increments $0200, the second only reads it
+    constexpr std::array<u8, 4> writer = {static_cast<u8>(Opcode::INC_ABS), 0x00, 0x02,
+                                          static_cast<u8>(Opcode::BRK)};
+    constexpr std::array<u8, 4> reader = {static_cast<u8>(Opcode::LDA_ABS), 0x00, 0x02,
+                                          static_cast<u8>(Opcode::BRK)};
+    BatchRunner runner(1);
+    std::vector<BatchJob> jobs = {make_job(0, 0), make_job(0xFF, 0)};
+    jobs[0].image = writer;
+    jobs[1].image = reader;
+
+    // when:
+    auto results = runner.run(jobs);
+
+    // then:
+    EXPECT_EQ(results[1].registers.a, 0x00);
+}
+
+TEST(BatchTest, ErrorsAreReportedPerJob) {
+    // given: an unimplemented opcode in the second job
+    constexpr std::array<u8, 1> invalid = {0xFF};
+    BatchRunner runner(2);
+    std::vector<BatchJob> jobs = {make_job(0, 1), make_job(0, 1)};
+    jobs[1].image = invalid;
+
+    // when:
+    auto results = runner.run(jobs);
+
+    // then:
+    EXPECT_TRUE(results[0].outcome.has_value());
+    ASSERT_FALSE(results[1].outcome.has_value());
+    EXPECT_EQ(results[1].outcome.error(), EmulatorError::InvalidOpcode);
+}
+
+TEST(BatchTest, CycleLimitStopsRunawayJobs) {
+    // given: BNE to itself never terminates
+    constexpr std::array<u8, 2> spin = {static_cast<u8>(Opcode::BNE), 0xFE};
+    BatchRunner runner(2);
+    std::vector<BatchJob> jobs = {make_job(0, 0)};
+    jobs[0].image           = spin;
+    jobs[0].stop.max_cycles = 1000;
+
+    // when:
+    auto results = runner.run(jobs);
+
+    // then:
+    ASSERT_TRUE(results[0].outcome.has_value());
+    EXPECT_EQ(results[0].outcome->reason, StopReason::CycleLimit);
+    EXPECT_GE(results[0].outcome->cycles, 1000u);
+}
@@ -0,0 +1,182 @@
+#include <gtest/gtest.h>
+#include "cpu6502/assembler.hpp"
+#include "cpu6502/cpu.hpp"
+#include "cpu6502/opcodes.hpp"
+
+using namespace cpu6502;
+
+namespace {
+
+// Counts X up to 10 in a loop that crosses into the next page
+constexpr FixedString kLoopSource = R"(
+        .org $80FC
+        LDX #0
+loop:   INX
+        CPX #10
+        BNE loop
+        BRK
+)";
+
+class BreakpointTest : public ::testing::Test {
+ protected:
+    Memory mem;
+    CPU    cpu;
+
+    void SetUp() override {
+        constexpr auto program = assemble<kLoopSource>();
+        ASSERT_TRUE(mem.load(assembled_origin<kLoopSource>(), program).has_value());
+        cpu.set_pc(assembled_origin<kLoopSource>());
+        cpu.set_sp(0xFF);
+    }
+};
+
+}  // namespace
+
+TEST(TrapTest, SetAndClearKeepOriginalByte) {
+    // given:
+    Memory mem;
+    mem[0x8010] = 0xE8;
+
+    // when:
+    EXPECT_TRUE(mem.set_trap(0x8010));
+    EXPECT_TRUE(mem.set_trap(0x8010));
+
+    // then: the opcode is patched, every other view sees the original
+    EXPECT_EQ(mem.trap_count(), 1u);
+    EXPECT_TRUE(mem.is_trap(0x8010));
+    EXPECT_FALSE(mem.is_trap(0x8011));
+    EXPECT_EQ(mem[0x8010], Memory::TRAP_OPCODE);
+    EXPECT_EQ(mem.read_opcode(0x8010).value(), Memory::TRAP_OPCODE);
+    EXPECT_EQ(mem.read_byte(0x8010).value(), 0xE8);
+    EXPECT_EQ(mem.read_word(0x800F).value(), 0xE800);
+    EXPECT_EQ(mem.peek(0x8010), 0xE8);
+
+    // when:
+    mem.clear_trap(0x8010);
+
+    // then:
+    EXPECT_EQ(mem.trap_count(), 0u);
+    EXPECT_FALSE(mem.is_trap(0x8010));
+    EXPECT_EQ(mem[0x8010], 0xE8);
+}
+
+TEST(TrapTest, ProgramWritesGoToShadowTable) {
+    // given:
+    Memory mem;
+    ASSERT_TRUE(mem.set_trap(0x0300));
+
+    // when: self-modifying code rewrites the instruction under the trap
+    ASSERT_TRUE(mem.write_byte(0x0300, 0xC8).has_value());
+
+    // then: the trap stays armed and clearing it restores the new byte
+    EXPECT_EQ(mem[0x0300], Memory::TRAP_OPCODE);
+    EXPECT_EQ(mem.read_byte(0x0300).value(), 0xC8);
+    mem.clear_traps();
+    EXPECT_EQ(mem[0x0300], 0xC8);
+}
+
+TEST(TrapTest, TableFillsAtMaxTraps) {
+    // given:
+    Memory mem;
+    for (std::size_t i = 0; i < Memory::MAX_TRAPS; ++i) {
+        ASSERT_TRUE(mem.set_trap(static_cast<u16>(0x4000 + i * 3)));
+    }
+
+    // when:
+    const bool added = mem.set_trap(0x0200);
+
+    // then:
+    EXPECT_FALSE(added);
+    EXPECT_EQ(mem.trap_count(), Memory::MAX_TRAPS);
+    EXPECT_TRUE(mem.is_trap(0x4000));
+    EXPECT_TRUE(mem.is_trap(static_cast<u16>(0x4000 + (Memory::MAX_TRAPS - 1) * 3)));
+}
+
+TEST_F(BreakpointTest, RunStopsBeforeBreakpoint) {
+    // given: a breakpoint on BNE, the first instruction to start on page $81
+    ASSERT_TRUE(mem.set_trap(0x8101));
+
+    // when:
+    auto result = cpu.run(StopCondition{.stop_on_brk = true}, mem);
+
+    // then:
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(result->reason, StopReason::Breakpoint);
+    EXPECT_EQ(cpu.get_pc(), 0x8101);
+    EXPECT_EQ(cpu.get_x(), 1);
+    EXPECT_EQ(result->instructions, 3u);
+}
+
+TEST_F(BreakpointTest, StepOffBreakpointThenRunHitsItAgain) {
+    // given:
+    ASSERT_TRUE(mem.set_trap(0x80FE));
+    const StopCondition stop{.stop_on_brk = true};
+    ASSERT_TRUE(cpu.run(stop, mem).has_value());
+    ASSERT_EQ(cpu.get_x(), 0);
+
+    // when: the debugger steps over the breakpoint before continuing
+    auto stepped = cpu.step(mem);
+    auto result  = cpu.run(stop, mem);
+
+    // then: INX ran in place of the trap; stopped at the next pass through the loop
+    ASSERT_TRUE(stepped.has_value());
+    EXPECT_EQ(*stepped, 2);
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(result->reason, StopReason::Breakpoint);
+    EXPECT_EQ(cpu.get_x(), 1);
+}
+
+TEST_F(BreakpointTest, LoadingCodeOverTrapKeepsItArmed) {
+    // given: a trap set before the program it belongs to is loaded
+    Memory fresh;
+    ASSERT_TRUE(fresh.set_trap(0x8101));
+
+    // when:
+    constexpr auto program = assemble<kLoopSource>();
+    ASSERT_TRUE(fresh.load(assembled_origin<kLoopSource>(), program).has_value());
+    auto result = cpu.run(StopCondition{.stop_on_brk = true}, fresh);
+
+    // then: the program reads its own BNE, and the breakpoint still fires on it
+    EXPECT_EQ(fresh.read_byte(0x8101).value(), static_cast<u8>(Opcode::BNE));
+    EXPECT_EQ(fresh[0x8101], Memory::TRAP_OPCODE);
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(result->reason, StopReason::Breakpoint);
+    EXPECT_EQ(cpu.get_pc(), 0x8101);
+}
+
+TEST_F(BreakpointTest, ExecuteReportsTrap) {
+    // given:
+    ASSERT_TRUE(mem.set_trap(0x80FE));
+
+    // when:
+    auto result = cpu.execute(100, mem);
+
+    // then:
+    ASSERT_FALSE(result.has_value());
+    EXPECT_EQ(result.error(), EmulatorError::BreakpointTrap);
+    EXPECT_EQ(cpu.get_pc(), 0x80FE);
+}
+
+TEST_F(BreakpointTest, BrkUnderBreakpointStillStopsAsBrk) {
+    // given: a breakpoint on the final BRK
+    ASSERT_TRUE(mem.set_trap(0x8103));
+
+    // when:
+    auto result = cpu.run(StopCondition{.stop_on_brk = true}, mem);
+
+    // then:
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(result->reason, StopReason::Brk);
+    EXPECT_EQ(cpu.get_pc(), 0x8103);
+    EXPECT_EQ(cpu.get_x(), 10);
+}
+
+TEST_F(BreakpointTest, NoTrapsRunsToCompletion) {
+    // when:
+    auto result = cpu.run(StopCondition{.stop_on_brk = true}, mem);
+
+    // then:
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(result->reason, StopReason::Brk);
+    EXPECT_EQ(cpu.get_x(), 10);
+}
@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+#include <sstream>
+#include "cpu6502/assembler.hpp"
+#include "cpu6502/call_graph.hpp"
+#include "cpu6502/cpu.hpp"
+#include "test_support.hpp"
+
+using namespace cpu6502;
+using namespace cpu6502::test;
+
+namespace {
+
+constexpr u8 kJsr = op(Opcode::JSR);
+constexpr u8 kRts = op(Opcode::RTS);
+constexpr u8 kNop = op(Opcode::INX);
+
+auto find(const std::vector<RoutineProfile>& routines, u16 address) -> RoutineProfile {
+    for (const auto& routine : routines) {
+        if (routine.address == address) {
+            return routine;
+        }
+    }
+    return {};
+}
+
+// Feeds a hand-written trace, as if each instruction took two cycles
+struct Trace {
+    CallGraphProfiler profiler;
+    u64               cycles = 0;
+
+    void step(u16 pc, u8 opcode, u8 sp) {
+        profiler.on_instruction(TraceRecord{cycles, pc, opcode, 0, 0, 0, sp, 0x20});
+        cycles += 2;
+    }
+};
+
+}  // namespace
+
+TEST(CallGraphTest, RecursionCountsInclusiveCyclesOnce) {
+    // given: main calls a routine that calls itself until X reaches zero
+    constexpr FixedString source = R"(
+            .org $8000
+    main:   LDX #$04
+            JSR recurse
+            INX
+    done:   BRK
+    recurse:
+            DEX
+            BEQ return
+            JSR recurse
+    return: RTS
+    )";
+    constexpr u16 callee_address = assembled_value<source>("recurse");
+
+    Machine machine(assemble<source>());
+    CPU&    cpu = machine.cpu;
+    Memory& mem = *machine.memory;
+
+    CallGraphProfiler profiler;
+    cpu.set_observer(&profiler);
+
+    // when:
+    StopCondition stop;
+    stop.stop_pc = assembled_value<source>("done");
+    ASSERT_TRUE(cpu.run(stop, mem).has_value());
+    profiler.finish(cpu.get_cycles());
+
+    // then:
+    const auto routines = profiler.routines();
+    const auto main     = find(routines, 0x8000);
+    const auto callee   = find(routines, callee_address);
+    EXPECT_EQ(profiler.depth(), 0u);
+    EXPECT_EQ(main.calls, 1u);
+    EXPECT_EQ(main.inclusive_cycles, cpu.get_cycles());
+    EXPECT_EQ(callee.calls, 4u);
+    EXPECT_EQ(main.exclusive_cycles + callee.exclusive_cycles, cpu.get_cycles());
+    EXPECT_EQ(main.inclusive_cycles, main.exclusive_cycles + callee.inclusive_cycles);
+    EXPECT_EQ(routines.front().address, 0x8000);
+}
+
+TEST(CallGraphTest, RtsUsedAsJumpKeepsTheFrameOpen) {
+    // given:
+    Trace trace;
+    trace.step(0x8000, kJsr, 0xFF);  // main: JSR $9000
+    trace.step(0x9000, kNop, 0xFD);  // routine pushes a target (PHA/PHA)
+    trace.step(0x9001, kRts, 0xFB);  // and "returns" into it
+    trace.step(0x9100, kNop, 0xFD);
+
+    // then:
+    EXPECT_EQ(trace.profiler.depth(), 2u);
+
+    // when: the real return
+    trace.step(0x9101, kRts, 0xFD);
+    trace.step(0x8003, kNop, 0xFF);
+
+    // then:
+    EXPECT_EQ(trace.profiler.depth(), 1u);
+}
+
+TEST(CallGraphTest, ManualStackUnwindClosesFrames) {
+    // given:
+    Trace trace;
+    trace.step(0x8000, kJsr, 0xFF);  // main: JSR outer
+    trace.step(0x9000, kJsr, 0xFD);  // outer: JSR inner
+    trace.step(0xA000, kNop, 0xFB);  // inner discards both return addresses (LDX #$FF / TXS)
+    trace.step(0x8010, kNop, 0xFF);  // and jumps back into main
+
+    // when:
+    trace.profiler.finish(trace.cycles);
+
+    // then:
+    const auto routines = trace.profiler.routines();
+    EXPECT_EQ(find(routines, 0x9000).inclusive_cycles, 4u);
+    EXPECT_EQ(find(routines, 0xA000).inclusive_cycles, 2u);
+    EXPECT_EQ(find(routines, 0xA000).exclusive_cycles, 2u);
+    EXPECT_EQ(find(routines, 0x8000).exclusive_cycles, 4u);
+}
+
+TEST(CallGraphTest, ReportListsRoutinesBySymbol) {
+    // given:
+    Trace trace;
+    trace.step(0x8000, kJsr, 0xFF);
+    trace.step(0x9000, kNop, 0xFD);
+    trace.step(0x9001, kRts, 0xFD);
+    trace.step(0x8003, kNop, 0xFF);
+    trace.profiler.finish(trace.cycles);
+
+    SymbolTable symbols;
+    symbols.add(0x8000, "main");
+    symbols.add(0x9000, "worker");
+
+    // when:
+    std::ostringstream out;
+    trace.profiler.write_report(out, symbols);
+
+    // then:
+    EXPECT_NE(out.str().find("main"), std::string::npos);
+    EXPECT_NE(out.str().find("worker"), std::string::npos);
+    EXPECT_LT(out.str().find("main"), out.str().find("worker"));
+}
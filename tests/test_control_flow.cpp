@@ -30,3 +30,95 @@ TEST_F(ControlFlowTest, JSR_RTS_BasicOperation) {
     ASSERT_TRUE(result.has_value());
     EXPECT_EQ(cpu.get_a(), 0x84);
 }
+
+TEST_F(ControlFlowTest, IRQ_ServicedWhenInterruptsEnabled) {
+    // given:
+    mem[0xFFFE] = 0x00;
+    mem[0xFFFF] = 0x90;
+    mem[0x8000] = static_cast<u8>(Opcode::CLI);
+    cpu.set_sp(0xFF);
+
+    // when:
+    ASSERT_TRUE(cpu.step(mem).has_value());
+    cpu.set_irq_line(true);
+    auto cycles = cpu.step(mem);
+
+    // then:
+    ASSERT_TRUE(cycles.has_value());
+    EXPECT_EQ(*cycles, 7);
+    EXPECT_EQ(cpu.get_pc(), 0x9000);
+    EXPECT_TRUE(cpu.get_flags().interrupt);
+    EXPECT_EQ(cpu.get_sp(), 0xFC);
+    EXPECT_EQ(mem[0x01FF], 0x80);
+    EXPECT_EQ(mem[0x01FE], 0x01);
+    EXPECT_EQ(mem[0x01FD] & 0x10, 0x00);  // Break flag clear for hardware interrupts
+}
+
+TEST_F(ControlFlowTest, IRQ_MaskedByInterruptFlag) {
+    // given:
+    mem[0x8000] = static_cast<u8>(Opcode::INX);
+    cpu.set_sp(0xFF);
+    cpu.set_irq_line(true);
+    StatusFlags flags = cpu.get_flags();
+    flags.interrupt   = true;
+    cpu.set_flags(flags);
+
+    // when:
+    auto cycles = cpu.step(mem);
+
+    // then:
+    ASSERT_TRUE(cycles.has_value());
+    EXPECT_EQ(cpu.get_pc(), 0x8001);
+    EXPECT_EQ(cpu.get_x(), 1);
+}
+
+TEST_F(ControlFlowTest, NMI_IgnoresInterruptFlagAndFiresOnce) {
+    // given:
+    mem[0xFFFA] = 0x00;
+    mem[0xFFFB] = 0xA0;
+    mem[0xA000] = static_cast<u8>(Opcode::INX);
+    cpu.set_sp(0xFF);
+    StatusFlags flags = cpu.get_flags();
+    flags.interrupt   = true;
+    cpu.set_flags(flags);
+    cpu.trigger_nmi();
+
+    // when:
+    ASSERT_TRUE(cpu.step(mem).has_value());
+    ASSERT_TRUE(cpu.step(mem).has_value());
+
+    // then:
+    EXPECT_FALSE(cpu.get_nmi_pending());
+    EXPECT_EQ(cpu.get_pc(), 0xA001);
+    EXPECT_EQ(cpu.get_x(), 1);
+}
+
+TEST_F(ControlFlowTest, NMI_StaysPendingWhenItsVectorCannotBeRead) {
+    // given: the vector page guarded
+    mem[0xFFFA] = 0x00;
+    mem[0xFFFB] = 0xA0;
+    cpu.set_sp(0xFF);
+    cpu.set_flags(StatusFlags{});
+    cpu.trigger_nmi();
+    mem.guard_page(0xFF);
+
+    // when:
+    auto faulted = cpu.step(mem);
+
+    // then: nothing was pushed and I is still clear
+    ASSERT_FALSE(faulted.has_value());
+    EXPECT_EQ(faulted.error(), EmulatorError::GuardedPageAccess);
+    EXPECT_TRUE(cpu.get_nmi_pending());
+    EXPECT_EQ(cpu.get_sp(), 0xFF);
+    EXPECT_FALSE(cpu.get_flags().interrupt);
+
+    // when: retried once the vector is readable
+    mem.guard_page(0xFF, false);
+    ASSERT_TRUE(cpu.step(mem).has_value());
+
+    // then: exactly one frame
+    EXPECT_FALSE(cpu.get_nmi_pending());
+    EXPECT_EQ(cpu.get_sp(), 0xFC);
+    EXPECT_EQ(cpu.get_pc(), 0xA000);
+    EXPECT_TRUE(cpu.get_flags().interrupt);
+}
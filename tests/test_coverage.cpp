@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <sstream>
+#include "cpu6502/assembler.hpp"
+#include "cpu6502/coverage.hpp"
+#include "cpu6502/cpu.hpp"
+#include "test_support.hpp"
+
+using namespace cpu6502;
+using namespace cpu6502::test;
+
+namespace {
+
+constexpr auto kProgram = assemble<R"(
+        .org $8000
+        LDX #$02        ; $8000 line 1
+loop:   DEX             ; $8002 line 2
+        BNE loop        ; $8003 line 3
+        BEQ stop        ; $8005 line 4
+        INX             ; $8007 line 5: macro expanding to INX / INX
+        INX             ; $8008
+stop:   INX             ; $8009 line 7
+        .byte $10       ; $800A line 8
+)">();
+
+constexpr std::string_view kDebugFile =
+    "version\tmajor=2,minor=0\n"
+    "file\tid=0,name=\"main.s\",size=100,mtime=0x00000000,mod=0\n"
+    "seg\tid=0,name=\"CODE\",start=0x008000,size=0x000B,addrsize=absolute,type=ro\n"
+    "span\tid=0,seg=0,start=0,size=2\n"
+    "span\tid=1,seg=0,start=2,size=1\n"
+    "span\tid=2,seg=0,start=3,size=2\n"
+    "span\tid=3,seg=0,start=5,size=2\n"
+    "span\tid=4,seg=0,start=7,size=1\n"
+    "span\tid=5,seg=0,start=8,size=1\n"
+    "span\tid=6,seg=0,start=9,size=1\n"
+    "span\tid=7,seg=0,start=10,size=1,type=0\n"
+    "line\tid=0,file=0,line=1,span=0\n"
+    "line\tid=1,file=0,line=2,span=1\n"
+    "line\tid=2,file=0,line=3,span=2\n"
+    "line\tid=3,file=0,line=4,span=3\n"
+    "line\tid=4,file=0,line=5,span=4+5\n"
+    "line\tid=5,file=0,line=7,span=6\n"
+    "line\tid=6,file=0,line=8,span=7\n";
+
+class CoverageTest : public ::testing::Test {
+ protected:
+    Memory                       mem;
+    CPU                          cpu;
+    std::unique_ptr<CoverageMap> coverage = std::make_unique<CoverageMap>();
+    LineTable                    lines;
+
+    void SetUp() override {
+        ASSERT_TRUE(mem.load(0x8000, kProgram).has_value());
+        ASSERT_EQ(lines.load_ca65_dbg(kDebugFile), 7u);
+        cpu.set_pc(0x8000);
+        cpu.set_sp(0xFF);
+        cpu.set_coverage(coverage.get());
+    }
+
+    void run_program() {
+        StopCondition stop;
+        stop.stop_pc = 0x8009;
+        ASSERT_TRUE(cpu.run(stop, mem).has_value());
+    }
+};
+
+}  // namespace
+
+TEST_F(CoverageTest, RecordsExecutedAddressesAndBranchDirections) {
+    // when:
+    run_program();
+
+    // then:
+    EXPECT_EQ(coverage->executed_count(), 4u);
+    EXPECT_TRUE(coverage->executed(0x8003));
+    EXPECT_FALSE(coverage->executed(0x8004));  // Operand byte
+    EXPECT_FALSE(coverage->executed(0x8007));
+    EXPECT_TRUE(coverage->taken(0x8003));
+    EXPECT_TRUE(coverage->not_taken(0x8003));
+    EXPECT_TRUE(coverage->taken(0x8005));
+    EXPECT_FALSE(coverage->not_taken(0x8005));
+}
+
+TEST_F(CoverageTest, MergeIsUnionOfRuns) {
+    // given:
+    run_program();
+    CoverageMap other;
+    other.record(0x8007, op(Opcode::INX), 0x8008);
+
+    // when:
+    other.merge(*coverage);
+
+    // then:
+    EXPECT_EQ(other.executed_count(), 5u);
+    EXPECT_TRUE(other.taken(0x8005));
+}
+
+TEST_F(CoverageTest, ExportsLcovPerSourceLine) {
+    // given:
+    run_program();
+
+    // when:
+    std::ostringstream out;
+    write_lcov(out, *coverage, lines, mem, "rom");
+
+    // then:
+    EXPECT_EQ(out.str(),
+              "TN:rom\n"
+              "SF:main.s\n"
+              "DA:1,1\n"
+              "DA:2,1\n"
+              "BRDA:3,0,0,1\n"
+              "BRDA:3,0,1,1\n"
+              "DA:3,1\n"
+              "BRDA:4,0,0,1\n"
+              "BRDA:4,0,1,0\n"
+              "DA:4,1\n"
+              "DA:5,0\n"
+              "DA:7,0\n"
+              "BRF:4\n"
+              "BRH:3\n"
+              "LF:6\n"
+              "LH:4\n"
+              "end_of_record\n");
+}
+
+TEST_F(CoverageTest, BranchUnderBreakpointKeepsItsDirections) {
+    // given:
+    run_program();
+    std::ostringstream expected;
+    write_lcov(expected, *coverage, lines, mem, "rom");
+
+    // when: a breakpoint now sits on the BNE
+    ASSERT_TRUE(mem.set_trap(0x8003));
+    std::ostringstream out;
+    write_lcov(out, *coverage, lines, mem, "rom");
+
+    // then:
+    EXPECT_EQ(out.str(), expected.str());
+}
+
+TEST_F(CoverageTest, ExportsCobertura) {
+    // given:
+    run_program();
+
+    // when:
+    std::ostringstream out;
+    write_cobertura(out, *coverage, lines, mem);
+
+    // then:
+    const std::string xml = out.str();
+    EXPECT_NE(xml.find("lines-covered=\"4\" lines-valid=\"6\""), std::string::npos);
+    EXPECT_NE(xml.find("branches-covered=\"3\" branches-valid=\"4\""), std::string::npos);
+    EXPECT_NE(xml.find("<line number=\"4\" hits=\"1\" branch=\"true\" "
+                       "condition-coverage=\"50% (1/2)\"/>"),
+              std::string::npos);
+    EXPECT_NE(xml.find("<line number=\"5\" hits=\"0\" branch=\"false\"/>"), std::string::npos);
+}
@@ -0,0 +1,157 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <sstream>
+#include <string>
+#include "cpu6502/assembler.hpp"
+#include "cpu6502/disassembler.hpp"
+#include "test_support.hpp"
+
+using namespace cpu6502;
+using namespace cpu6502::test;
+
+namespace {
+
+constexpr auto kProgram = assemble<R"(
+        .org $8000
+start:  LDA $2010,X     ; $8000
+        BNE start       ; $8003
+        JSR $9000       ; $8005
+        .byte $02       ; $8008 undocumented
+        ASL A           ; $8009
+        EOR ($40),Y     ; $800A
+        CPX #$7F        ; $800C
+)">();
+
+std::string text(const Instruction& instruction) {
+    std::array<char, MAX_INSTRUCTION_TEXT> buffer{};
+    return std::string(buffer.data(), format_instruction(instruction, buffer));
+}
+
+}  // namespace
+
+TEST(DisassemblerTest, DecodesOperandsAndBranchTargets) {
+    // given:
+    Memory mem;
+    ASSERT_TRUE(mem.load(0x8000, kProgram).has_value());
+
+    // when:
+    const Instruction load   = decode(mem, 0x8000);
+    const Instruction branch = decode(mem, 0x8003);
+
+    // then:
+    EXPECT_EQ(load.length, 3);
+    EXPECT_EQ(load.operand, 0x2010);
+    EXPECT_EQ(branch.length, 2);
+    EXPECT_EQ(branch.target(), 0x8000);
+}
+
+TEST(DisassemblerTest, LinearSweepStopsAtRangeEnd) {
+    // given:
+    Memory                      mem;
+    std::array<Instruction, 16> out{};
+    ASSERT_TRUE(mem.load(0x8000, kProgram).has_value());
+
+    // when:
+    const std::size_t count = disassemble(mem, 0x8000, kProgram.size(), out);
+
+    // then:
+    ASSERT_EQ(count, 7u);
+    EXPECT_EQ(text(out[0]), "LDA $2010,X");
+    EXPECT_EQ(text(out[1]), "BNE $8000");
+    EXPECT_EQ(text(out[2]), "JSR $9000");
+    EXPECT_EQ(text(out[3]), ".byte $02");
+    EXPECT_EQ(text(out[4]), "ASL A");
+    EXPECT_EQ(text(out[5]), "EOR ($40),Y");
+    EXPECT_EQ(text(out[6]), "CPX #$7F");
+}
+
+TEST(DisassemblerTest, LinearSweepStopsWhenOutputIsFull) {
+    // given:
+    Memory                     mem;
+    std::array<Instruction, 2> out{};
+    ASSERT_TRUE(mem.load(0x8000, kProgram).has_value());
+
+    // when:
+    const std::size_t count = disassemble(mem, 0x8000, kProgram.size(), out);
+
+    // then: the sweep resumes after the last decoded instruction
+    ASSERT_EQ(count, 2u);
+    EXPECT_EQ(out[1].address + out[1].length, 0x8005);
+}
+
+TEST(DisassemblerTest, RangeModeDecodesEachAddress) {
+    // given:
+    Memory                     mem;
+    std::array<u16, 3>         addresses = {0x800C, 0x8005, 0x8009};
+    std::array<Instruction, 3> out{};
+    ASSERT_TRUE(mem.load(0x8000, kProgram).has_value());
+
+    // when:
+    const std::size_t count = disassemble(mem, addresses, out);
+
+    // then:
+    ASSERT_EQ(count, 3u);
+    EXPECT_EQ(text(out[0]), "CPX #$7F");
+    EXPECT_EQ(text(out[1]), "JSR $9000");
+    EXPECT_EQ(text(out[2]), "ASL A");
+}
+
+TEST(DisassemblerTest, DecodeWrapsAtTopOfMemory) {
+    // given:
+    Memory mem;
+    mem[0xFFFF] = op(Opcode::LDA_ABS);
+    mem[0x0000] = 0x34;
+    mem[0x0001] = 0x12;
+
+    // when:
+    const Instruction instruction = decode(mem, 0xFFFF);
+
+    // then:
+    EXPECT_EQ(text(instruction), "LDA $1234");
+}
+
+TEST(DisassemblerTest, WriterListsBytesAndSymbols) {
+    // given:
+    Memory      mem;
+    SymbolTable symbols;
+    symbols.add(0x8000, "loop");
+    symbols.add(0x2000, "table", 0x100);
+    symbols.add(0x9000, "print");
+    ASSERT_TRUE(mem.load(0x8000, kProgram).has_value());
+
+    // when:
+    std::ostringstream out;
+    {
+        DisassemblyWriter writer(out, &symbols);
+        writer.write(mem, 0x8000, 8);
+    }
+
+    // then:
+    EXPECT_EQ(out.str(),
+              "loop:\n"
+              "8000  BD 10 20  LDA table+16,X\n"
+              "8003  D0 FB     BNE loop\n"
+              "8005  20 00 90  JSR print\n");
+}
+
+TEST(DisassemblerTest, WriterDecodesTraceRecords) {
+    // given:
+    Memory                     mem;
+    std::array<TraceRecord, 2> records{};
+    records[0].pc     = 0x8003;
+    records[0].opcode = op(Opcode::BNE);
+    records[1].pc     = 0x8000;
+    records[1].opcode = op(Opcode::LDA_ABSX);
+    ASSERT_TRUE(mem.load(0x8000, kProgram).has_value());
+
+    // when:
+    std::ostringstream out;
+    DisassemblyWriter  writer(out);
+    writer.write(mem, records);
+    writer.flush();
+
+    // then:
+    EXPECT_EQ(out.str(),
+              "8003  D0 FB     BNE $8000\n"
+              "8000  BD 10 20  LDA $2010,X\n");
+}
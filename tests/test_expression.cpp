@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+#include "cpu6502/assembler.hpp"
+#include "cpu6502/cpu.hpp"
+#include "cpu6502/expression.hpp"
+#include "cpu6502/symbols.hpp"
+
+using namespace cpu6502;
+
+namespace {
+
+// Counts X up to 10
+constexpr FixedString kLoopSource = R"(
+        .org $8000
+        LDX #0
+loop:   INX
+        CPX #10
+        BNE loop
+        BRK
+)";
+
+class ExpressionTest : public ::testing::Test {
+ protected:
+    Memory mem;
+    CPU    cpu;
+
+    void SetUp() override {
+        Registers registers;
+        registers.a           = 0x42;
+        registers.x           = 5;
+        registers.y           = 0;
+        registers.sp          = 0xFD;
+        registers.pc          = 0x8000;
+        registers.flags.carry = true;
+        cpu.set_registers(registers);
+        mem[0x0200] = 0x07;
+    }
+
+    auto eval(std::string_view text, const SymbolTable* symbols = nullptr) -> i32 {
+        auto expression = Expression::compile(text, symbols);
+        EXPECT_TRUE(expression.has_value()) << text;
+        return expression ? expression->evaluate(cpu, mem) : -1;
+    }
+};
+
+}  // namespace
+
+TEST_F(ExpressionTest, EvaluatesRegistersMemoryAndOperators) {
+    EXPECT_EQ(eval("A == $42 && X > 3 && [$0200] != 0"), 1);
+    EXPECT_EQ(eval("a == 0x42 && x < 3"), 0);
+    EXPECT_EQ(eval("[$01FF + 1] + %10 - 1"), 8);
+    EXPECT_EQ(eval("PC | SP ^ 1"), 0x80FC);
+    EXPECT_EQ(eval("P & 1 == 1"), 1);
+    EXPECT_EQ(eval("!(Y) && -X == ~4"), 1);
+    EXPECT_EQ(eval("X >= 5 || [$0300]"), 1);
+}
+
+TEST_F(ExpressionTest, ResolvesSymbols) {
+    // given:
+    SymbolTable symbols;
+    symbols.add(0x0200, "counter");
+
+    // then:
+    EXPECT_EQ(eval("[counter] == 7", &symbols), 1);
+    EXPECT_FALSE(Expression::compile("[counter]").has_value());
+}
+
+TEST_F(ExpressionTest, RejectsMalformedText) {
+    for (std::string_view text : {"", "A ==", "(X", "[$0200", "$", "12ab", "A = 1", "X >> 1"}) {
+        auto expression = Expression::compile(text);
+        ASSERT_FALSE(expression.has_value()) << text;
+        EXPECT_EQ(expression.error(), EmulatorError::InvalidExpression);
+    }
+}
+
+TEST_F(ExpressionTest, RejectsNestingPastMaxDepth) {
+    // given:
+    const std::string shallow(Expression::MAX_DEPTH, '(');
+    const std::string deep(Expression::MAX_DEPTH + 1, '(');
+
+    // then:
+    EXPECT_TRUE(
+        Expression::compile(shallow + "1" + std::string(Expression::MAX_DEPTH, ')')).has_value());
+    EXPECT_FALSE(
+        Expression::compile(deep + "1" + std::string(Expression::MAX_DEPTH + 1, ')')).has_value());
+}
+
+TEST(BreakpointConditionTest, CountsHitsOnlyWhenConditionHoldsAndIgnoresFirstN) {
+    // given: a trap on CPX, stopping when X is even, ignoring the first two such hits
+    Memory         mem;
+    CPU            cpu;
+    constexpr auto program = assemble<kLoopSource>();
+    ASSERT_TRUE(mem.load(assembled_origin<kLoopSource>(), program).has_value());
+    cpu.set_pc(assembled_origin<kLoopSource>());
+    cpu.set_sp(0xFF);
+    ASSERT_TRUE(mem.set_trap(0x8003));
+
+    BreakpointCondition condition(Expression::compile("X & 1 == 0").value(), 2);
+
+    // when: the debugger loop, stepping over every trap it does not stop at
+    const StopCondition stop{.stop_on_brk = true};
+    u64                 reached = 0;
+    while (true) {
+        auto result = cpu.run(stop, mem);
+        ASSERT_TRUE(result.has_value());
+        if (result->reason != StopReason::Breakpoint) {
+            break;
+        }
+        ++reached;
+        if (condition.reached(cpu, mem)) {
+            break;
+        }
+        ASSERT_TRUE(cpu.step(mem).has_value());
+    }
+
+    // then: X = 2 and 4 were ignored
+    EXPECT_EQ(cpu.get_pc(), 0x8003);
+    EXPECT_EQ(cpu.get_x(), 6);
+    EXPECT_EQ(reached, 6u);
+    EXPECT_EQ(condition.hit_count(), 3u);
+}
@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <stdexcept>
+#include "cpu6502/assembler.hpp"
+#include "cpu6502/fork_server.hpp"
+#include "test_support.hpp"
+
+using namespace cpu6502;
+using namespace cpu6502::test;
+
+namespace {
+
+// Slow "boot" that spins X 256 times per pass through $20 passes, then a test
+// case that reads its input from $40
+constexpr FixedString kSource = R"(
+        .org $8000
+        LDY #$20
+boot:   INX
+        BNE boot
+        DEY
+        BNE boot
+marker: LDA $40
+        ADC #$05
+        INC $41
+done:
+)";
+
+constexpr auto kProgram = assemble<kSource>();
+constexpr u16  kMarker  = assembled_value<kSource>("marker");
+constexpr u16  kDone    = assembled_value<kSource>("done");
+
+auto run_case(CPU& cpu, Memory& memory, u8 input) -> u8 {
+    memory[0x40] = input;
+    StopCondition stop;
+    stop.stop_pc = kDone;
+    EXPECT_TRUE(cpu.run(stop, memory).has_value());
+    return cpu.get_a();
+}
+
+}  // namespace
+
+TEST(ForkServerTest, BootStopsAtMarker) {
+    // given:
+    Machine    machine(kProgram);
+    ForkServer server(machine.cpu, *machine.memory);
+
+    // when:
+    auto booted = server.boot(kMarker);
+
+    // then:
+    ASSERT_TRUE(booted.has_value());
+    EXPECT_TRUE(server.ready());
+    EXPECT_EQ(server.cpu().get_pc(), kMarker);
+    EXPECT_GT(booted->cycles, 10'000u);
+    EXPECT_EQ(machine.cpu.get_pc(), 0x8000);  // Original untouched
+}
+
+TEST(ForkServerTest, BootFailsWhenMarkerIsNotReached) {
+    // given:
+    Machine    machine(kProgram);
+    ForkServer server(machine.cpu, *machine.memory);
+
+    // when:
+    auto booted = server.boot(kMarker, 1000);
+
+    // then:
+    ASSERT_FALSE(booted.has_value());
+    EXPECT_EQ(booted.error(), EmulatorError::MarkerNotReached);
+    EXPECT_FALSE(server.ready());
+}
+
+TEST(ForkServerTest, ClonesStartFromTheWarmStateIndependently) {
+    // given:
+    Machine    machine(kProgram);
+    ForkServer server(machine.cpu, *machine.memory);
+    ASSERT_TRUE(server.boot(kMarker).has_value());
+    const u64 boot_cycles = server.cpu().get_cycles();
+
+    CPU  cpu;
+    auto memory = std::make_unique<Memory>();
+
+    // when / then:
+    for (u8 input = 0; input < 4; ++input) {
+        ASSERT_TRUE(server.clone_into(cpu, *memory).has_value());
+        EXPECT_EQ(cpu.get_cycles(), boot_cycles);
+        EXPECT_EQ(run_case(cpu, *memory, input), input + 5);
+        EXPECT_EQ((*memory)[0x41], 1);  // Previous clone's write is gone
+    }
+    EXPECT_EQ(server.memory()[0x41], 0);
+    EXPECT_EQ(server.cpu().get_pc(), kMarker);
+}
+
+TEST(ForkServerTest, ForkRunReturnsChildStatusAndLeavesParentIntact) {
+    // given:
+    Machine    machine(kProgram);
+    ForkServer server(machine.cpu, *machine.memory);
+    ASSERT_TRUE(server.boot(kMarker).has_value());
+
+    // when:
+    auto status = server.fork_run(
+        [](CPU& cpu, Memory& memory) { return static_cast<int>(run_case(cpu, memory, 37)); });
+
+    // then:
+    ASSERT_TRUE(status.has_value());
+    EXPECT_EQ(*status, 42);
+    EXPECT_EQ(server.memory()[0x40], 0);
+    EXPECT_EQ(server.memory()[0x41], 0);
+}
+
+TEST(ForkServerTest, ForkRunReportsABodyThatThrows) {
+    // given:
+    Machine    machine(kProgram);
+    ForkServer server(machine.cpu, *machine.memory);
+    ASSERT_TRUE(server.boot(kMarker).has_value());
+
+    // when:
+    auto thrown = server.fork_run([](CPU&, Memory&) -> int { throw std::runtime_error("case"); });
+    auto status = server.fork_run([](CPU&, Memory&) { return 255; });
+
+    // then: the child exited rather than unwinding into this test, and a
+    // body returning any status is told apart from one that threw
+    EXPECT_EQ(thrown.error(), EmulatorError::ForkBodyThrew);
+    ASSERT_TRUE(status.has_value());
+    EXPECT_EQ(*status, 255);
+}
+
+TEST(ForkServerTest, CloneAndForkNeedABootedServer) {
+    // given:
+    Machine    machine(kProgram);
+    ForkServer server(machine.cpu, *machine.memory);
+    CPU        cpu;
+    auto       memory = std::make_unique<Memory>();
+
+    // when:
+    auto cloned = server.clone_into(cpu, *memory);
+    auto forked = server.fork_run([](CPU&, Memory&) { return 0; });
+
+    // then:
+    EXPECT_EQ(cloned.error(), EmulatorError::NotBooted);
+    EXPECT_EQ(forked.error(), EmulatorError::NotBooted);
+}
@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+#include <array>
+#include "cpu6502/assembler.hpp"
+#include "cpu6502/host_counters.hpp"
+#include "test_support.hpp"
+
+using namespace cpu6502;
+using namespace cpu6502::test;
+
+namespace {
+
+// Counts X down from 0 forever
+constexpr auto kLoop = assemble<R"(
+        .org $8000
+loop:   DEX
+        CLV
+        BVC loop
+        BRK
+)">();
+
+constexpr std::array kEvents = {HostEvent::Cycles, HostEvent::Instructions,
+                                HostEvent::BranchMisses, HostEvent::L1iMisses};
+
+}  // namespace
+
+TEST(HostCountersTest, MeasureRunReportsEmulatedWork) {
+    // given:
+    HostCounters  counters;
+    Machine       machine(kLoop);
+    StopCondition stop;
+    stop.max_cycles = 7000;
+
+    // when:
+    auto measurement = counters.measure_run(machine.cpu, *machine.memory, stop);
+
+    // then:
+    ASSERT_TRUE(measurement.has_value());
+    EXPECT_EQ(measurement->emulated_instructions, 3000u);
+    EXPECT_EQ(measurement->emulated_cycles, 7000u);  // DEX 2 + CLV 2 + taken BVC 3
+}
+
+TEST(HostCountersTest, UnavailableEventsDegradeToNullopt) {
+    // given:
+    HostCounters  counters;
+    Machine       machine(kLoop);
+    StopCondition stop;
+    stop.max_cycles = 70000;
+
+    // when:
+    auto measurement = counters.measure_run(machine.cpu, *machine.memory, stop);
+
+    // then:
+    ASSERT_TRUE(measurement.has_value());
+    if (!counters.any_available()) {
+        EXPECT_FALSE(counters.unavailable_reason().empty());
+    }
+    for (const HostEvent event : kEvents) {
+        if (!counters.available(event)) {
+            EXPECT_FALSE(measurement->count(event).has_value());
+            EXPECT_FALSE(measurement->per_instruction(event).has_value());
+        } else {
+            EXPECT_TRUE(measurement->count(event).has_value());
+            EXPECT_TRUE(measurement->per_instruction(event).has_value());
+        }
+    }
+    if (counters.available(HostEvent::Instructions)) {
+        EXPECT_GT(*measurement->per_instruction(HostEvent::Instructions), 1.0);
+    }
+}
+
+TEST(HostCountersTest, MeasureExecuteReportsPerCycleOnly) {
+    // given:
+    HostCounters counters;
+    Machine      machine(kLoop);
+
+    // when:
+    auto measurement = counters.measure_execute(machine.cpu, *machine.memory, 700);
+
+    // then:
+    ASSERT_TRUE(measurement.has_value());
+    EXPECT_EQ(measurement->emulated_cycles, 700u);
+    EXPECT_EQ(measurement->emulated_instructions, 0u);
+    EXPECT_FALSE(measurement->per_instruction(HostEvent::Cycles).has_value());
+    EXPECT_EQ(measurement->per_emulated_cycle(HostEvent::Cycles).has_value(),
+              counters.available(HostEvent::Cycles));
+}
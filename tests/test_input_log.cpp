@@ -0,0 +1,210 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <random>
+#include <vector>
+#include "cpu6502/assembler.hpp"
+#include "cpu6502/input_log.hpp"
+#include "test_support.hpp"
+
+using namespace cpu6502;
+using namespace cpu6502::test;
+
+namespace {
+
+// Main loop polls two device registers; the IRQ handler reads a third. Both
+// handlers count their entries in the zero page and branch back to the loop.
+constexpr FixedString kSource = R"(
+        .org $8000
+main:   LDA $D000
+        EOR $D001       ; $8003
+        INC $10
+        CLI
+        CLV
+        BVC main
+irq:    INC $20
+        LDA $D002
+        CLV
+        BVC main
+nmi:    INC $21
+        CLV
+        BVC main
+)";
+
+constexpr auto kProgram = assemble<kSource>();
+
+class RandomDevice final : public IoDevice {
+ public:
+    u8 read(u16) override { return static_cast<u8>(rng_()); }
+    void write(u16, u8) override {}
+
+ private:
+    std::mt19937 rng_{1234};
+};
+
+// The program with its interrupt vectors pointing at the handlers
+struct Console : Machine {
+    Console() : Machine(kProgram) {
+        const u16 irq = assembled_value<kSource>("irq");
+        const u16 nmi = assembled_value<kSource>("nmi");
+        EXPECT_TRUE(memory->write_word(CPU::IRQ_VECTOR, irq).has_value());
+        EXPECT_TRUE(memory->write_word(CPU::NMI_VECTOR, nmi).has_value());
+    }
+};
+
+auto run_for(CPU& cpu, Memory& memory, u64 cycles) -> void {
+    StopCondition stop;
+    stop.max_cycles = cycles;
+    ASSERT_TRUE(cpu.run(stop, memory).has_value());
+}
+
+// Runs the program against a live device, raising interrupts along the way
+auto record(Console& machine, InputLog& log) -> void {
+    RandomDevice  device;
+    InputRecorder recorder(machine.cpu, log);
+    recorder.attach(*machine.memory, 0xD0, device);
+
+    for (int i = 0; i < 20; ++i) {
+        run_for(machine.cpu, *machine.memory, 500);
+        if (i % 5 == 2) {
+            ASSERT_TRUE(recorder.set_irq_line(true).has_value());
+            run_for(machine.cpu, *machine.memory, 1);
+            ASSERT_TRUE(recorder.set_irq_line(false).has_value());
+        }
+        if (i % 7 == 3) {
+            ASSERT_TRUE(recorder.trigger_nmi().has_value());
+        }
+    }
+    machine.memory->map_io(0xD0, nullptr);
+}
+
+}  // namespace
+
+TEST(InputLogTest, ReplayReproducesRecordedRun) {
+    // given:
+    Console  recorded;
+    InputLog log;
+    record(recorded, log);
+
+    // when:
+    Console       replayed;
+    InputReplayer replayer(replayed.cpu, log);
+    replayer.attach(*replayed.memory, 0xD0);
+
+    StopCondition stop;
+    stop.max_cycles = recorded.cpu.get_cycles();
+    auto result     = replayer.run(stop, *replayed.memory);
+
+    // then:
+    ASSERT_TRUE(result.has_value());
+    EXPECT_TRUE(replayer.finished());
+    EXPECT_FALSE(replayer.diverged());
+    EXPECT_GT((*recorded.memory)[0x20], 0);
+    EXPECT_GT((*recorded.memory)[0x21], 0);
+    EXPECT_EQ(replayed.cpu.get_cycles(), recorded.cpu.get_cycles());
+    EXPECT_EQ(replayed.cpu.get_pc(), recorded.cpu.get_pc());
+    EXPECT_EQ(replayed.cpu.get_a(), recorded.cpu.get_a());
+    EXPECT_EQ(replayed.cpu.get_sp(), recorded.cpu.get_sp());
+    EXPECT_EQ(replayed.cpu.get_flags().to_byte(), recorded.cpu.get_flags().to_byte());
+    EXPECT_TRUE(std::ranges::equal(replayed.memory->data(), recorded.memory->data()));
+}
+
+TEST(InputLogTest, ReplayDetectsDivergence) {
+    // given:
+    Console  recorded;
+    InputLog log;
+    record(recorded, log);
+
+    Console replayed;
+    (*replayed.memory)[0x8004] = 0x03;  // EOR $D003 instead of $D001
+
+    // when:
+    InputReplayer replayer(replayed.cpu, log);
+    replayer.attach(*replayed.memory, 0xD0);
+
+    StopCondition stop;
+    stop.max_cycles = recorded.cpu.get_cycles();
+    auto result     = replayer.run(stop, *replayed.memory);
+
+    // then:
+    ASSERT_FALSE(result.has_value());
+    EXPECT_EQ(result.error(), EmulatorError::ReplayDivergence);
+    EXPECT_TRUE(replayer.diverged());
+}
+
+TEST(InputLogTest, InterruptsRaisedFromInsideADeviceAreRefused) {
+    // given: a device that tries to raise an NMI when it is read
+    class NmiOnRead final : public IoDevice {
+     public:
+        std::expected<void, EmulatorError> result;
+        InputRecorder*                     recorder = nullptr;
+
+        u8 read(u16) override {
+            result = recorder->trigger_nmi();
+            return 0;
+        }
+        void write(u16, u8) override {}
+    };
+
+    Console       machine;
+    InputLog      log;
+    NmiOnRead     device;
+    InputRecorder recorder(machine.cpu, log);
+    device.recorder = &recorder;
+    recorder.attach(*machine.memory, 0xD0, device);
+
+    // when: LDA $D000
+    ASSERT_TRUE(machine.cpu.step(*machine.memory).has_value());
+
+    // then: only the read was logged
+    ASSERT_FALSE(device.result.has_value());
+    EXPECT_EQ(device.result.error(), EmulatorError::InterruptInsideInstruction);
+    EXPECT_FALSE(machine.cpu.get_nmi_pending());
+    EXPECT_EQ(log.event_count(), 1u);
+    EXPECT_TRUE(recorder.trigger_nmi().has_value());
+    machine.memory->map_io(0xD0, nullptr);
+}
+
+TEST(InputLogTest, RepeatedReadsEncodeCompactly) {
+    // given:
+    InputLog log;
+
+    // when:
+    for (u64 i = 0; i < 1000; ++i) {
+        log.append({i * 7, InputKind::IoRead, 0xD000, static_cast<u8>(i)});
+    }
+
+    // then:
+    EXPECT_EQ(log.event_count(), 1000u);
+    EXPECT_LE(log.bytes().size(), 3u * 1000u + 2u);
+}
+
+TEST(InputLogTest, SerializedBytesRoundTripAndDropTornRecord) {
+    // given:
+    InputLog log;
+    log.append({10, InputKind::IoRead, 0xD012, 0x42});
+    log.append({300, InputKind::IrqLine, 0, 1});
+    log.append({1'000'000, InputKind::Nmi, 0, 0});
+    log.append({1'000'004, InputKind::IoRead, 0xD012, 0x43});
+
+    const std::vector<u8> bytes(log.bytes().begin(), log.bytes().end());
+
+    // when:
+    InputLog copy(bytes);
+    InputLog torn(std::span<const u8>(bytes).first(bytes.size() - 1));
+
+    // then:
+    std::vector<InputEvent> events;
+    InputLog::Reader        reader(copy);
+    for (InputEvent event; reader.next(event);) {
+        events.push_back(event);
+    }
+    ASSERT_EQ(events.size(), 4u);
+    EXPECT_EQ(events[1].cycles, 300u);
+    EXPECT_EQ(events[1].kind, InputKind::IrqLine);
+    EXPECT_EQ(events[1].value, 1);
+    EXPECT_EQ(events[2].cycles, 1'000'000u);
+    EXPECT_EQ(events[2].kind, InputKind::Nmi);
+    EXPECT_EQ(events[3].address, 0xD012);
+    EXPECT_EQ(events[3].value, 0x43);
+    EXPECT_EQ(torn.event_count(), 3u);
+}
@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+#include <array>
+#include "cpu6502/cpu.hpp"
+#include "cpu6502/isa.hpp"
+#include "cpu6502/opcodes.hpp"
+#include "test_support.hpp"
+
+using namespace cpu6502;
+using namespace cpu6502::test;
+
+namespace {
+
+constexpr u16 kStart = 0x0200;
+
+// One instruction at $0200 with operand bytes lo, hi; ($10) points at $3001.
+// Any byte can be the opcode, so these are raw bytes rather than assembled.
+struct OneInstruction : Machine {
+    OneInstruction(u8 opcode, u8 lo, u8 hi, u8 index, u8 flags)
+        : Machine(std::array<u8, 3>{opcode, lo, hi}, kStart) {
+        (*memory)[0x0010] = 0x01;
+        (*memory)[0x0011] = 0x30;
+
+        Registers registers;
+        registers.pc    = kStart;
+        registers.sp    = 0xF0;  // Leaves room for RTS to pull and BRK to push
+        registers.a     = 0x5A;
+        registers.x     = index;
+        registers.y     = index;
+        registers.flags = StatusFlags{}.from_byte(flags);
+        cpu.set_registers(registers);
+    }
+};
+
+}  // namespace
+
+TEST(IsaTest, TableMatchesOpcodeEnum) {
+    // then:
+    EXPECT_STREQ(opcode_name(Opcode::LDA_ABSX), "LDA_ABSX");
+    EXPECT_STREQ(opcode_name(Opcode::DEC_ZP), "DEC_ZP");
+    EXPECT_STREQ(opcode_name(static_cast<Opcode>(0x02)), "UNKNOWN");
+    EXPECT_EQ(opcode_info(0x6C).mode, AddressingMode::Indirect);
+    EXPECT_EQ(opcode_info(0x00).length, 2);
+    EXPECT_TRUE(is_branch(0xD0));
+    EXPECT_FALSE(is_branch(0x20));
+}
+
+TEST(IsaTest, ImplementedMatchesDispatch) {
+    for (u32 opcode = 0; opcode < 256; ++opcode) {
+        // given:
+        OneInstruction machine(static_cast<u8>(opcode), 0x10, 0x20, 0x00, 0x00);
+
+        // when:
+        auto cycles = machine.cpu.step(*machine.memory);
+
+        // then:
+        const bool dispatched =
+            cycles.has_value() || cycles.error() != EmulatorError::InvalidOpcode;
+        EXPECT_EQ(dispatched, opcode_info(static_cast<u8>(opcode)).implemented)
+            << opcode_info(static_cast<u8>(opcode)).name << " $" << std::hex << opcode;
+    }
+}
+
+TEST(IsaTest, BaseCyclesMatchExecution) {
+    for (u32 opcode = 0; opcode < 256; ++opcode) {
+        const OpcodeInfo& info = opcode_info(static_cast<u8>(opcode));
+        if (!info.implemented) {
+            continue;
+        }
+
+        // given: no page is crossed
+        OneInstruction machine(static_cast<u8>(opcode), 0x10, 0x20, 0x00, 0x00);
+
+        // when:
+        auto cycles = machine.cpu.step(*machine.memory);
+
+        // then: a taken branch costs one more, the offset stays on the page
+        ASSERT_TRUE(cycles.has_value()) << info.name;
+        const bool taken = info.mode == AddressingMode::Relative &&
+                           machine.cpu.get_pc() != kStart + info.length;
+        EXPECT_EQ(*cycles, info.cycles + (taken ? 1 : 0)) << info.name;
+    }
+}
+
+TEST(IsaTest, PagePenaltyMatchesExecution) {
+    for (u32 opcode = 0; opcode < 256; ++opcode) {
+        const OpcodeInfo& info = opcode_info(static_cast<u8>(opcode));
+        if (!info.implemented || info.mode == AddressingMode::Relative) {
+            continue;
+        }
+
+        // given: X = Y = $FF, so $2010,X and ($10),Y cross into the next page
+        OneInstruction machine(static_cast<u8>(opcode), 0x10, 0x20, 0xFF, 0x00);
+
+        // when:
+        auto cycles = machine.cpu.step(*machine.memory);
+
+        // then:
+        ASSERT_TRUE(cycles.has_value()) << info.name;
+        EXPECT_EQ(*cycles, info.cycles + (info.page_penalty ? 1 : 0)) << info.name;
+    }
+}
+
+TEST(IsaTest, FlagsWrittenCoverObservedChanges) {
+    for (u32 opcode = 0; opcode < 256; ++opcode) {
+        const OpcodeInfo& info = opcode_info(static_cast<u8>(opcode));
+        if (!info.implemented) {
+            continue;
+        }
+
+        for (u8 before : {u8{0x00}, u8{0xCF}, u8{0x41}, u8{0x82}}) {
+            // given:
+            OneInstruction machine(static_cast<u8>(opcode), 0x10, 0x20, 0x00, before);
+
+            // when:
+            auto cycles = machine.cpu.step(*machine.memory);
+
+            // then:
+            ASSERT_TRUE(cycles.has_value()) << info.name;
+            // B and the unused bit are not architectural flags
+            const u8 changed = (machine.cpu.get_flags().to_byte() ^ before) & FLAG_ALL;
+            EXPECT_EQ(changed & ~info.flags_written, 0) << info.name << " flags " << +before;
+        }
+    }
+}
@@ -0,0 +1,214 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <span>
+#include <string_view>
+#include <vector>
+#include "cpu6502/loader.hpp"
+
+using namespace cpu6502;
+
+namespace {
+
+std::span<const u8> bytes(std::string_view text) {
+    return {reinterpret_cast<const u8*>(text.data()), text.size()};
+}
+
+// o65 executable: text at $1000, data at $2000, zeroed bss at $3000
+std::vector<u8> o65_image(u16 undefined_references) {
+    std::vector<u8> image = {
+        0x01, 0x00, 'o', '6', '5', 0x00,  // Marker, magic, version
+        0x00, 0x02,                       // Mode: bsszero
+        0x00, 0x10, 0x03, 0x00,           // tbase, tlen
+        0x00, 0x20, 0x02, 0x00,           // dbase, dlen
+        0x00, 0x30, 0x04, 0x00,           // bbase, blen
+        0x00, 0x00, 0x00, 0x00,           // zbase, zlen
+        0x00, 0x00,                       // stack
+        0x05, 0x00, 'a', 's', 0x00,       // Header option: assembler name
+        0x00,                             // End of options
+        0xA9, 0x01, 0x00,                 // Text
+        0x12, 0x34,                       // Data
+    };
+    image.push_back(static_cast<u8>(undefined_references & 0xFF));
+    image.push_back(static_cast<u8>(undefined_references >> 8));
+    return image;
+}
+
+}  // namespace
+
+TEST(LoaderTest, IntelHexMergesRecordsAndSetsResetVector) {
+    // given:
+    Memory mem;
+    constexpr std::string_view hex =
+        ":03800000A905E8E7\r\n"
+        ":0280030000007B\r\n"
+        ":040000050000800077\r\n"
+        ":00000001FF\r\n";
+
+    // when:
+    auto image = load_image(bytes(hex), ImageFormat::IntelHex, mem);
+
+    // then:
+    ASSERT_TRUE(image.has_value());
+    ASSERT_EQ(image->segments.size(), 1u);
+    EXPECT_EQ(image->segments[0].address, 0x8000);
+    EXPECT_EQ(image->segments[0].size, 5u);
+    EXPECT_EQ(image->start, 0x8000);
+    EXPECT_EQ(mem[0x8000], 0xA9);
+    EXPECT_EQ(mem[0x8002], 0xE8);
+    EXPECT_EQ(mem[0xFFFC], 0x00);
+    EXPECT_EQ(mem[0xFFFD], 0x80);
+}
+
+TEST(LoaderTest, IntelHexRejectsBadChecksum) {
+    // given:
+    Memory mem;
+
+    // when:
+    auto image = load_image(bytes(":03800000A905E8E8\n"), ImageFormat::IntelHex, mem);
+
+    // then:
+    ASSERT_FALSE(image.has_value());
+    EXPECT_EQ(image.error(), EmulatorError::InvalidImage);
+}
+
+TEST(LoaderTest, IntelHexRejectsAddressesAbove64K) {
+    // given: extended linear address $0001 puts the data at $10000
+    Memory mem;
+
+    // when:
+    auto image = load_image(bytes(":020000040001F9\n:0100000001FE\n"), ImageFormat::IntelHex, mem);
+
+    // then:
+    ASSERT_FALSE(image.has_value());
+    EXPECT_EQ(image.error(), EmulatorError::InvalidAddress);
+}
+
+TEST(LoaderTest, SRecordLoadsDataAndStartAddress) {
+    // given:
+    Memory mem;
+    constexpr std::string_view srec =
+        "S00600004844521B\n"
+        "S1051000A21038\n"
+        "S205001002CA1E\n"
+        "S9031000EC\n";
+
+    // when:
+    auto image = load_image(bytes(srec), ImageFormat::SRecord, mem);
+
+    // then:
+    ASSERT_TRUE(image.has_value());
+    ASSERT_EQ(image->segments.size(), 1u);
+    EXPECT_EQ(image->segments[0].address, 0x1000);
+    EXPECT_EQ(image->segments[0].size, 3u);
+    EXPECT_EQ(mem[0x1002], 0xCA);
+    EXPECT_EQ(image->start, 0x1000);
+    EXPECT_EQ(mem[0xFFFD], 0x10);
+}
+
+TEST(LoaderTest, SRecordZeroStartMeansNoEntryPoint) {
+    // given:
+    Memory mem;
+    mem[0xFFFC] = 0x34;
+
+    // when:
+    auto image = load_image(bytes("S1051000A21038\nS9030000FC\n"), ImageFormat::SRecord, mem);
+
+    // then:
+    ASSERT_TRUE(image.has_value());
+    EXPECT_FALSE(image->start.has_value());
+    EXPECT_EQ(mem[0xFFFC], 0x34);
+}
+
+TEST(LoaderTest, PrgLoadsAtItsLoadAddress) {
+    // given:
+    Memory                      mem;
+    constexpr std::array<u8, 5> prg = {0x01, 0x08, 0x0B, 0x08, 0x0A};
+
+    // when:
+    auto image = load_image(prg, ImageFormat::Prg, mem);
+
+    // then:
+    ASSERT_TRUE(image.has_value());
+    ASSERT_EQ(image->segments.size(), 1u);
+    EXPECT_EQ(image->segments[0].address, 0x0801);
+    EXPECT_EQ(image->segments[0].size, 3u);
+    EXPECT_EQ(mem[0x0803], 0x0A);
+    EXPECT_FALSE(image->start.has_value());
+}
+
+TEST(LoaderTest, O65LoadsSegmentsAndClearsBss) {
+    // given:
+    Memory mem;
+    mem[0x3003] = 0xFF;
+    const auto o65 = o65_image(0);
+
+    // when:
+    auto image = load_image(o65, ImageFormat::O65, mem);
+
+    // then:
+    ASSERT_TRUE(image.has_value());
+    ASSERT_EQ(image->segments.size(), 3u);
+    EXPECT_EQ(image->segments[0].address, 0x1000);
+    EXPECT_EQ(image->segments[1].address, 0x2000);
+    EXPECT_EQ(image->segments[2].address, 0x3000);
+    EXPECT_EQ(mem[0x1000], 0xA9);
+    EXPECT_EQ(mem[0x2001], 0x34);
+    EXPECT_EQ(mem[0x3003], 0x00);
+}
+
+TEST(LoaderTest, O65WithUndefinedReferencesIsRejected) {
+    // given:
+    Memory     mem;
+    const auto o65 = o65_image(1);
+
+    // when:
+    auto image = load_image(o65, ImageFormat::O65, mem);
+
+    // then:
+    ASSERT_FALSE(image.has_value());
+    EXPECT_EQ(image.error(), EmulatorError::InvalidImage);
+}
+
+TEST(LoaderTest, RawLoadsAtRequestedAddress) {
+    // given:
+    Memory                      mem;
+    constexpr std::array<u8, 4> raw = {1, 2, 3, 4};
+
+    // when:
+    auto fits     = load_image(raw, ImageFormat::Raw, mem, {.raw_address = 0xC000});
+    auto overflow = load_image(raw, ImageFormat::Raw, mem, {.raw_address = 0xFFFE});
+
+    // then:
+    ASSERT_TRUE(fits.has_value());
+    EXPECT_EQ(fits->segments[0].address, 0xC000);
+    EXPECT_EQ(mem[0xC003], 4);
+    ASSERT_FALSE(overflow.has_value());
+    EXPECT_EQ(overflow.error(), EmulatorError::InvalidAddress);
+}
+
+TEST(LoaderTest, LoadingOverTrapUpdatesItsOriginalByte) {
+    // given:
+    Memory                      mem;
+    constexpr std::array<u8, 4> raw = {0xE8, 0xE8, 0xE8, 0x00};
+    ASSERT_TRUE(mem.set_trap(0xC001));
+
+    // when:
+    auto loaded = load_image(raw, ImageFormat::Raw, mem, {.raw_address = 0xC000});
+
+    // then:
+    ASSERT_TRUE(loaded.has_value());
+    EXPECT_TRUE(mem.is_trap(0xC001));
+    EXPECT_EQ(mem[0xC001], Memory::TRAP_OPCODE);
+    EXPECT_EQ(mem.read_byte(0xC001).value(), 0xE8);
+}
+
+TEST(LoaderTest, DetectsFormatFromContentThenExtension) {
+    // then:
+    EXPECT_EQ(detect_image_format("a.bin", bytes(":00000001FF\n")), ImageFormat::IntelHex);
+    EXPECT_EQ(detect_image_format("a.bin", bytes("S9030000FC\n")), ImageFormat::SRecord);
+    EXPECT_EQ(detect_image_format("a.bin", o65_image(0)), ImageFormat::O65);
+    EXPECT_EQ(detect_image_format("game.prg", bytes("\x01\x08")), ImageFormat::Prg);
+    EXPECT_EQ(detect_image_format("rom.bin", bytes("\xEA\xEA")), ImageFormat::Raw);
+    EXPECT_EQ(parse_image_format("srec"), ImageFormat::SRecord);
+    EXPECT_FALSE(parse_image_format("elf").has_value());
+}
@@ -0,0 +1,265 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <memory>
+#include <vector>
+#include "cpu6502/assembler.hpp"
+#include "cpu6502/cpu.hpp"
+#include "cpu6502/lockstep.hpp"
+
+using namespace cpu6502;
+
+namespace {
+
+auto make_image(u16 address, std::span<const u8> program) -> std::unique_ptr<Memory> {
+    auto image = std::make_unique<Memory>();
+    EXPECT_TRUE(image->load(address, program).has_value());
+    return image;
+}
+
+// Runs one job on the scalar CPU, the reference every lane must match
+auto run_scalar(const Memory& image, const LockstepJob& job, const StopCondition& stop)
+    -> LockstepResult {
+    auto memory = std::make_unique<Memory>(image);
+    for (std::size_t i = 0; i < job.zero_page.size() && i < 256; ++i) {
+        (*memory)[static_cast<u16>(i)] = job.zero_page[i];
+    }
+
+    CPU cpu;
+    cpu.set_registers(job.registers);
+
+    LockstepResult result;
+    result.outcome   = cpu.run(stop, *memory);
+    result.registers = cpu.get_registers();
+    for (std::size_t i = 0; i < 256; ++i) {
+        result.zero_page[i] = (*memory)[static_cast<u16>(i)];
+    }
+    return result;
+}
+
+void expect_same(const LockstepResult& actual, const LockstepResult& expected, std::size_t lane) {
+    ASSERT_EQ(actual.outcome.has_value(), expected.outcome.has_value()) << "lane " << lane;
+    if (expected.outcome) {
+        EXPECT_EQ(actual.outcome->reason, expected.outcome->reason) << "lane " << lane;
+        EXPECT_EQ(actual.outcome->cycles, expected.outcome->cycles) << "lane " << lane;
+        EXPECT_EQ(actual.outcome->instructions, expected.outcome->instructions) << "lane " << lane;
+    }
+    EXPECT_EQ(actual.registers.pc, expected.registers.pc) << "lane " << lane;
+    EXPECT_EQ(actual.registers.sp, expected.registers.sp) << "lane " << lane;
+    EXPECT_EQ(actual.registers.a, expected.registers.a) << "lane " << lane;
+    EXPECT_EQ(actual.registers.x, expected.registers.x) << "lane " << lane;
+    EXPECT_EQ(actual.registers.y, expected.registers.y) << "lane " << lane;
+    EXPECT_EQ(actual.registers.flags.to_byte(), expected.registers.flags.to_byte()) << "lane " << lane;
+    EXPECT_EQ(actual.zero_page, expected.zero_page) << "lane " << lane;
+}
+
+template <std::size_t Lanes>
+auto run_both(const Memory& image, const std::vector<LockstepJob>& jobs, const StopCondition& stop)
+    -> LockstepStats {
+    std::vector<LockstepResult> results(jobs.size());
+    const auto stats = run_lockstep<Lanes>(image, jobs, stop, results);
+
+    for (std::size_t i = 0; i < jobs.size(); ++i) {
+        expect_same(results[i], run_scalar(image, jobs[i], stop), i);
+    }
+    return stats;
+}
+
+// Adds 3 to A, X times, then stops on BRK
+constexpr FixedString kAddLoopSource = R"(
+        .org $8000
+loop:   CLC
+        ADC #$03
+        DEX
+        BNE loop
+done:   BRK
+)";
+
+constexpr auto kAddLoop = assemble<kAddLoopSource>();
+
+}  // namespace
+
+TEST(LockstepTest, UniformLanesStayInLockstep) {
+    // given:
+    auto image = make_image(0x8000, kAddLoop);
+    std::vector<LockstepJob> jobs(16);
+    for (std::size_t i = 0; i < jobs.size(); ++i) {
+        jobs[i].registers.pc = 0x8000;
+        jobs[i].registers.a  = static_cast<u8>(i * 7);
+        jobs[i].registers.x  = 10;
+    }
+    StopCondition stop;
+    stop.stop_on_brk = true;
+
+    // when:
+    const auto stats = run_both<16>(*image, jobs, stop);
+
+    // then:
+    EXPECT_EQ(stats.scalar_fallbacks, 0u);
+    EXPECT_EQ(stats.steps, 40u);
+    EXPECT_EQ(stats.lane_instructions, 16u * 40u);
+}
+
+TEST(LockstepTest, DivergentLoopCountsMatchScalarCpu) {
+    // given:
+    auto image = make_image(0x8000, kAddLoop);
+    std::vector<LockstepJob> jobs(50);
+    for (std::size_t i = 0; i < jobs.size(); ++i) {
+        jobs[i].registers.pc = 0x8000;
+        jobs[i].registers.a  = static_cast<u8>(i);
+        jobs[i].registers.x  = static_cast<u8>(1 + i % 13);
+    }
+    StopCondition stop;
+    stop.stop_on_brk = true;
+
+    // when / then:
+    run_both<8>(*image, jobs, stop);
+}
+
+TEST(LockstepTest, ZeroPageSubroutineAndIndexedModesMatchScalarCpu) {
+    // given: sums the per-lane table at $10.. through a subroutine and counts in $00
+    constexpr auto program = assemble<R"(
+            .org $8000
+            LDY #$04
+    next:   JSR sum
+            INC $00
+            DEY
+            BPL next
+            BRK
+    sum:    CLC
+            ADC $10,X
+            ASL $01
+            INX
+            RTS
+    )">();
+    auto image = make_image(0x8000, program);
+
+    std::vector<std::array<u8, 32>> zero_pages(32);
+    std::vector<LockstepJob>        jobs(32);
+    for (std::size_t i = 0; i < jobs.size(); ++i) {
+        for (std::size_t b = 0; b < zero_pages[i].size(); ++b) {
+            zero_pages[i][b] = static_cast<u8>(i * 31 + b * 17);
+        }
+        jobs[i].zero_page    = zero_pages[i];
+        jobs[i].registers.pc = 0x8000;
+    }
+    StopCondition stop;
+    stop.stop_on_brk = true;
+
+    // when:
+    const auto stats = run_both<32>(*image, jobs, stop);
+
+    // then:
+    EXPECT_EQ(stats.scalar_fallbacks, 0u);
+}
+
+TEST(LockstepTest, WriteToSharedMemoryFallsBackToScalarCpu) {
+    // given: lanes with X odd increment the image at $0300
+    constexpr auto program = assemble<R"(
+            .org $8000
+            LDA #$00
+            CPX #$01
+            BNE done
+            INC $0300
+    done:   BRK
+    )">();
+    auto image = make_image(0x8000, program);
+
+    std::vector<LockstepJob> jobs(8);
+    for (std::size_t i = 0; i < jobs.size(); ++i) {
+        jobs[i].registers.pc = 0x8000;
+        jobs[i].registers.x  = static_cast<u8>(i % 2);
+    }
+    StopCondition stop;
+    stop.stop_on_brk = true;
+
+    // when:
+    std::vector<LockstepResult> results(jobs.size());
+    const auto stats = run_lockstep<8>(*image, jobs, stop, results);
+
+    // then:
+    EXPECT_EQ(stats.scalar_fallbacks, 4u);
+    for (std::size_t i = 0; i < jobs.size(); ++i) {
+        EXPECT_EQ(results[i].scalar_fallback, i % 2 == 1) << "lane " << i;
+        expect_same(results[i], run_scalar(*image, jobs[i], stop), i);
+    }
+    EXPECT_EQ((*image)[0x0300], 0x00);
+}
+
+TEST(LockstepTest, FallbackKeepsZeroPageUnderABreakpoint) {
+    // given: a trap on the zero-page counter every lane increments before falling back
+    constexpr auto program = assemble<R"(
+            .org $8000
+            INC $10
+            INC $0300
+            LDA $10
+            BRK
+    )">();
+    auto image = make_image(0x8000, program);
+    ASSERT_TRUE(image->set_trap(0x0010));
+
+    std::vector<LockstepJob> jobs(8);
+    std::vector<u8>          zero_pages(jobs.size() * 256);
+    for (std::size_t i = 0; i < jobs.size(); ++i) {
+        zero_pages[i * 256 + 0x10] = static_cast<u8>(i * 10);
+        jobs[i].zero_page          = std::span(zero_pages).subspan(i * 256, 256);
+        jobs[i].registers.pc       = 0x8000;
+    }
+    StopCondition stop;
+    stop.stop_on_brk = true;
+
+    // when:
+    std::vector<LockstepResult> results(jobs.size());
+    const auto stats = run_lockstep<8>(*image, jobs, stop, results);
+
+    // then: the scalar CPU read the lane's value, not the image's, and left the trap armed
+    EXPECT_EQ(stats.scalar_fallbacks, jobs.size());
+    for (std::size_t i = 0; i < jobs.size(); ++i) {
+        EXPECT_EQ(results[i].registers.a, i * 10 + 1) << "lane " << i;
+        EXPECT_EQ(results[i].zero_page[0x10], i * 10 + 1) << "lane " << i;
+    }
+    EXPECT_TRUE(image->is_trap(0x0010));
+}
+
+TEST(LockstepTest, CycleLimitAndStopPcMatchScalarCpu) {
+    // given:
+    auto image = make_image(0x8000, kAddLoop);
+    std::vector<LockstepJob> jobs(16);
+    for (std::size_t i = 0; i < jobs.size(); ++i) {
+        jobs[i].registers.pc = 0x8000;
+        jobs[i].registers.x  = static_cast<u8>(i + 1);
+    }
+
+    StopCondition by_cycles;
+    by_cycles.max_cycles = 37;
+
+    StopCondition by_pc;
+    by_pc.stop_pc = assembled_value<kAddLoopSource>("done");
+
+    // when / then:
+    run_both<16>(*image, jobs, by_cycles);
+    run_both<16>(*image, jobs, by_pc);
+}
+
+TEST(LockstepTest, UnsupportedOpcodeReportsTheScalarError) {
+    // given: BRK is not vectorised and $02 is not an opcode at all
+    constexpr auto program = assemble<R"(
+            .org $8000
+            LDX #$05
+            .byte $02
+    )">();
+    auto image = make_image(0x8000, program);
+    std::vector<LockstepJob> jobs(8);
+    for (auto& job : jobs) {
+        job.registers.pc = 0x8000;
+    }
+
+    // when:
+    std::vector<LockstepResult> results(jobs.size());
+    run_lockstep<8>(*image, jobs, StopCondition{}, results);
+
+    // then:
+    for (std::size_t i = 0; i < jobs.size(); ++i) {
+        EXPECT_TRUE(results[i].scalar_fallback);
+        expect_same(results[i], run_scalar(*image, jobs[i], StopCondition{}), i);
+    }
+}
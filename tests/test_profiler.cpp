@@ -0,0 +1,183 @@
+#include <gtest/gtest.h>
+#include <sstream>
+#include "cpu6502/assembler.hpp"
+#include "cpu6502/profiler.hpp"
+#include "test_support.hpp"
+
+using namespace cpu6502;
+using namespace cpu6502::test;
+
+namespace {
+
+constexpr std::string_view kViceLabels =
+    "al C:8000 .main\n"
+    "al C:8010 .busy\n"
+    "al C:8020 .light\n"
+    "al C:8020 .light_alias\n"
+    "break 8000\n";
+
+constexpr std::string_view kDebugFile =
+    "version\tmajor=2,minor=0\n"
+    "file\tid=0,name=\"main.s\",size=120,mtime=0x5F000000,mod=0\n"
+    "sym\tid=0,name=\"main\",addrsize=absolute,size=9,scope=0,def=1,ref=5,val=0x8000,seg=0,"
+    "type=lab\n"
+    "sym\tid=1,name=\"busy\",addrsize=absolute,size=6,scope=0,def=2,val=0x8010,seg=0,type=lab\n"
+    "sym\tid=2,name=\"COUNT\",addrsize=zeropage,scope=0,def=3,val=0x20,type=equ\n"
+    "sym\tid=3,name=\"light\",addrsize=absolute,scope=0,def=4,val=0x8020,seg=0,type=lab\n";
+
+// main calls a 32-iteration loop and a two-instruction routine forever
+constexpr FixedString kSource = R"(
+        .org $8000
+main:   JSR busy
+        JSR light
+        CLV
+        BVC main
+busy:   LDX #$20
+spin:   DEX
+        BNE spin
+        RTS
+light:  INX
+        RTS
+)";
+
+constexpr u16 kBusy  = assembled_value<kSource>("busy");
+constexpr u16 kLight = assembled_value<kSource>("light");
+
+// main calls outer, which spends its time in a loop inside inner
+constexpr FixedString kNestedSource = R"(
+        .org $8000
+main:   JSR outer
+        CLV
+        BVC main
+outer:  JSR inner
+        RTS
+inner:  LDX #$20
+spin:   DEX
+        BNE spin
+        RTS
+)";
+
+auto profile(SamplingProfiler& profiler, u64 cycles) -> void {
+    Machine       machine(assemble<kSource>());
+    StopCondition stop;
+    stop.max_cycles = cycles;
+    ASSERT_TRUE(profiler.run(stop, machine.cpu, *machine.memory).has_value());
+}
+
+}  // namespace
+
+TEST(SymbolTableTest, LoadsViceLabels) {
+    // given:
+    SymbolTable symbols;
+
+    // when:
+    const auto added = symbols.load_vice_labels(kViceLabels);
+
+    // then:
+    EXPECT_EQ(added, 3u);
+    EXPECT_EQ(symbols.describe(0x8020), "light");
+    EXPECT_EQ(symbols.describe(0x8013), "busy+3");
+    EXPECT_EQ(symbols.describe(0x7FFF), "$7FFF");
+}
+
+TEST(SymbolTableTest, LoadsLabelsFromCa65DebugFile) {
+    // given:
+    SymbolTable symbols;
+
+    // when:
+    const auto added = symbols.load_ca65_dbg(kDebugFile);
+
+    // then:
+    EXPECT_EQ(added, 3u);  // The equate is not an address label
+    ASSERT_NE(symbols.resolve(0x8015), nullptr);
+    EXPECT_EQ(symbols.resolve(0x8015)->name, "busy");
+    EXPECT_EQ(symbols.resolve(0x8016), nullptr);  // Past the end of busy
+    EXPECT_EQ(symbols.function_name(0x8021), "light");
+}
+
+TEST(SamplingProfilerTest, HotLoopDominatesTheProfile) {
+    // given:
+    SamplingProfiler profiler;
+    SymbolTable      symbols;
+    symbols.add(assembled_value<kSource>("main"), "main");
+    symbols.add(kBusy, "busy");
+    symbols.add(kLight, "light");
+
+    // when:
+    profile(profiler, 1'000'000);
+
+    // then:
+    EXPECT_NEAR(static_cast<double>(profiler.sample_count()), 1000.0, 10.0);
+    u64 busy = 0;
+    for (u16 pc = kBusy; pc < kLight; ++pc) {
+        busy += profiler.samples_at(pc);
+    }
+    EXPECT_GT(busy * 10, profiler.sample_count() * 8);
+
+    std::ostringstream flat;
+    profiler.write_flat(flat, symbols);
+    std::istringstream lines(flat.str());
+    std::string header, first;
+    std::getline(lines, header);
+    std::getline(lines, first);
+    EXPECT_NE(first.find("busy"), std::string::npos);
+
+    std::ostringstream folded;
+    profiler.write_folded(folded, symbols);
+    EXPECT_EQ(folded.str().rfind("busy " + std::to_string(busy) + "\n", 0), 0u);
+}
+
+TEST(SamplingProfilerTest, SameSeedGivesSameProfile) {
+    // given:
+    SamplingProfiler first;
+    SamplingProfiler second;
+
+    // when:
+    profile(first, 200'000);
+    profile(second, 200'000);
+
+    // then:
+    EXPECT_TRUE(std::ranges::equal(first.histogram(), second.histogram()));
+}
+
+TEST(SamplingProfilerTest, ClearDropsAllSamples) {
+    // given:
+    SamplingProfiler profiler;
+    profile(profiler, 50'000);
+
+    // when:
+    profiler.clear();
+
+    // then:
+    EXPECT_EQ(profiler.sample_count(), 0u);
+    EXPECT_EQ(profiler.samples_at(assembled_value<kSource>("spin")), 0u);
+}
+
+TEST(SamplingProfilerTest, FoldedOutputFollowsTheCallChain) {
+    // given:
+    constexpr u16     inner_address = assembled_value<kNestedSource>("inner");
+    Machine           machine(assemble<kNestedSource>());
+    CallGraphProfiler calls;
+    SamplingProfiler  profiler;
+    SymbolTable       symbols;
+    symbols.add(assembled_value<kNestedSource>("main"), "main");
+    symbols.add(assembled_value<kNestedSource>("outer"), "outer");
+    symbols.add(inner_address, "inner");
+    machine.cpu.set_observer(&calls);
+    profiler.set_call_graph(&calls);
+
+    // when:
+    StopCondition stop;
+    stop.max_cycles = 200'000;
+    ASSERT_TRUE(profiler.run(stop, machine.cpu, *machine.memory).has_value());
+
+    // then:
+    u64 inner = 0;
+    for (u16 pc = inner_address; pc < inner_address + 6; ++pc) {  // LDX, DEX, BNE, RTS
+        inner += profiler.samples_at(pc);
+    }
+    std::ostringstream folded;
+    profiler.write_folded(folded, symbols);
+    EXPECT_EQ(folded.str().rfind("main;outer;inner " + std::to_string(inner) + "\n", 0), 0u);
+    EXPECT_EQ(folded.str().find("\ninner "), std::string::npos);
+}
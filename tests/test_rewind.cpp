@@ -0,0 +1,225 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+#include "cpu6502/assembler.hpp"
+#include "cpu6502/rewind.hpp"
+#include "test_support.hpp"
+
+using namespace cpu6502;
+using namespace cpu6502::test;
+
+namespace {
+
+// Endless loop that keeps touching the zero page and page 3
+constexpr auto kProgram = assemble<R"(
+        .org $8000
+loop:   INC $10
+        INC $0300,X
+        INX             ; $8005
+        ADC #$07
+        CLV
+        BVC loop
+)">();
+
+// Fresh run from power-on to the first boundary at or after cycle
+auto machine_at(u64 cycle) -> std::unique_ptr<Machine> {
+    auto machine = std::make_unique<Machine>(kProgram);
+    StopCondition stop;
+    stop.max_cycles = cycle;
+    EXPECT_TRUE(machine->cpu.run(stop, *machine->memory).has_value());
+    return machine;
+}
+
+void expect_same(const Machine& actual, const Machine& expected) {
+    EXPECT_EQ(actual.cpu.get_cycles(), expected.cpu.get_cycles());
+    EXPECT_EQ(actual.cpu.get_pc(), expected.cpu.get_pc());
+    EXPECT_EQ(actual.cpu.get_a(), expected.cpu.get_a());
+    EXPECT_EQ(actual.cpu.get_x(), expected.cpu.get_x());
+    EXPECT_EQ(actual.cpu.get_flags().to_byte(), expected.cpu.get_flags().to_byte());
+    EXPECT_TRUE(std::ranges::equal(actual.memory->data(), expected.memory->data()));
+}
+
+auto run_recorded(RewindBuffer& rewind, Machine& machine, u64 cycles) -> void {
+    StopCondition stop;
+    stop.max_cycles = cycles;
+    ASSERT_TRUE(rewind.run(stop, machine.cpu, *machine.memory).has_value());
+}
+
+}  // namespace
+
+TEST(RewindTest, RewindToMatchesFreshRun) {
+    // given:
+    RewindBuffer rewind(
+        RewindConfig{.byte_budget = 64 << 20, .interval = 1000, .keyframe_interval = 16});
+    Machine machine(kProgram);
+    run_recorded(rewind, machine, 200000);
+
+    for (u64 target : {150000ull, 12345ull, 999ull, 1ull, 0ull}) {
+        SCOPED_TRACE(target);
+
+        // when:
+        ASSERT_TRUE(rewind.rewind_to(target, machine.cpu, *machine.memory).has_value());
+
+        // then:
+        expect_same(machine, *machine_at(target));
+    }
+}
+
+TEST(RewindTest, StepBackUndoesInstructions) {
+    // given: the cycle of every instruction boundary in a reference run
+    std::vector<u64> boundaries;
+    {
+        Machine reference(kProgram);
+        while (reference.cpu.get_cycles() < 5000) {
+            boundaries.push_back(reference.cpu.get_cycles());
+            ASSERT_TRUE(reference.cpu.step(*reference.memory).has_value());
+        }
+        boundaries.push_back(reference.cpu.get_cycles());
+    }
+
+    RewindBuffer rewind(
+        RewindConfig{.byte_budget = 64 << 20, .interval = 500, .keyframe_interval = 4});
+    Machine machine(kProgram);
+    run_recorded(rewind, machine, 5000);
+    ASSERT_EQ(machine.cpu.get_cycles(), boundaries.back());
+
+    // when / then: one instruction back
+    ASSERT_TRUE(rewind.step_back(machine.cpu, *machine.memory).has_value());
+    expect_same(machine, *machine_at(boundaries[boundaries.size() - 2]));
+
+    // when / then: far back across several snapshots
+    ASSERT_TRUE(rewind.step_back(machine.cpu, *machine.memory, 300).has_value());
+    expect_same(machine, *machine_at(boundaries[boundaries.size() - 302]));
+}
+
+TEST(RewindTest, StepBackReplaysEachIntervalOnce) {
+    // given:
+    struct Counter : ExecutionObserver {
+        u64  instructions = 0;
+        void on_instruction(const TraceRecord&) noexcept override { ++instructions; }
+    } counter;
+
+    RewindBuffer rewind(
+        RewindConfig{.byte_budget = 64 << 20, .interval = 200, .keyframe_interval = 8});
+    Machine machine(kProgram);
+    run_recorded(rewind, machine, 10000);
+    machine.cpu.set_observer(&counter);
+
+    // when:
+    ASSERT_TRUE(rewind.step_back(machine.cpu, *machine.memory, 1000).has_value());
+
+    // then: the thousand instructions, plus at most two partial intervals of
+    // 100 two-cycle instructions before the target
+    EXPECT_GE(counter.instructions, 1000u);
+    EXPECT_LE(counter.instructions, 1200u);
+}
+
+TEST(RewindTest, NewerHistoryStaysUntilExecutionResumes) {
+    // given:
+    RewindBuffer rewind(
+        RewindConfig{.byte_budget = 64 << 20, .interval = 1000, .keyframe_interval = 16});
+    Machine machine(kProgram);
+    run_recorded(rewind, machine, 20000);
+    const u64 newest = rewind.newest_cycle();
+
+    // when: back, then forward again without executing in between
+    ASSERT_TRUE(rewind.rewind_to(5000, machine.cpu, *machine.memory).has_value());
+    ASSERT_TRUE(rewind.rewind_to(15000, machine.cpu, *machine.memory).has_value());
+
+    // then:
+    EXPECT_EQ(rewind.newest_cycle(), newest);
+    expect_same(machine, *machine_at(15000));
+
+    // when: running on from an earlier point
+    ASSERT_TRUE(rewind.rewind_to(5000, machine.cpu, *machine.memory).has_value());
+    const u64 resumed = machine.cpu.get_cycles();
+    run_recorded(rewind, machine, 2000);
+
+    // then: the old future is gone and the new one is recorded
+    EXPECT_GE(rewind.newest_cycle(), resumed + 2000);
+    EXPECT_LT(rewind.newest_cycle(), newest);
+    ASSERT_TRUE(rewind.rewind_to(resumed + 1000, machine.cpu, *machine.memory).has_value());
+    expect_same(machine, *machine_at(resumed + 1000));
+}
+
+TEST(RewindTest, MemoryStaysWithinBudget) {
+    // given:
+    const RewindConfig config{.byte_budget = 300000, .interval = 200, .keyframe_interval = 8};
+    RewindBuffer rewind(config);
+    Machine machine(kProgram);
+
+    // when:
+    run_recorded(rewind, machine, 100000);
+
+    // then:
+    EXPECT_LE(rewind.bytes_used(), config.byte_budget);
+    EXPECT_GT(rewind.oldest_cycle(), 0u);
+    EXPECT_EQ(rewind.rewind_to(0, machine.cpu, *machine.memory).error(),
+              EmulatorError::RewindOutOfRange);
+}
+
+TEST(RewindTest, DeltasAreMuchSmallerThanKeyframes) {
+    // given:
+    RewindBuffer rewind(
+        RewindConfig{.byte_budget = 64 << 20, .interval = 100, .keyframe_interval = 64});
+    Machine machine(kProgram);
+
+    // when:
+    run_recorded(rewind, machine, 64 * 100);
+
+    // then: one keyframe plus a small delta per slice
+    EXPECT_GT(rewind.snapshot_count(), 32u);
+    EXPECT_LE(rewind.snapshot_count(), 64u);
+    EXPECT_LT(rewind.bytes_used(), 2 * sizeof(SaveState));
+}
+
+TEST(RewindTest, StepBackPastHistoryLeavesMachineInPlace) {
+    // given:
+    RewindBuffer rewind;
+    Machine machine(kProgram);
+    run_recorded(rewind, machine, 50);
+    const u64 now = machine.cpu.get_cycles();
+
+    // when:
+    auto result = rewind.step_back(machine.cpu, *machine.memory, 1000);
+
+    // then:
+    EXPECT_EQ(result.error(), EmulatorError::RewindOutOfRange);
+    expect_same(machine, *machine_at(now));
+}
+
+TEST(RewindTest, RewindToReplaysThroughBreakpoints) {
+    // given: a breakpoint set after recording, inside every replay window
+    RewindBuffer rewind(
+        RewindConfig{.byte_budget = 64 << 20, .interval = 1000, .keyframe_interval = 16});
+    Machine machine(kProgram);
+    run_recorded(rewind, machine, 20000);
+    ASSERT_TRUE(machine.memory->set_trap(0x8005));
+
+    // when:
+    ASSERT_TRUE(rewind.rewind_to(12345, machine.cpu, *machine.memory).has_value());
+
+    // then: the target cycle was reached and the trap is still armed
+    EXPECT_TRUE(machine.memory->is_trap(0x8005));
+    machine.memory->clear_trap(0x8005);
+    expect_same(machine, *machine_at(12345));
+}
+
+TEST(RewindTest, RewindRestoresInterruptInputs) {
+    // given: the IRQ line asserted, but masked, while a snapshot is taken
+    RewindBuffer rewind(
+        RewindConfig{.byte_budget = 64 << 20, .interval = 1000, .keyframe_interval = 16});
+    Machine machine(kProgram);
+    machine.cpu.set_flags(StatusFlags{}.from_byte(0x24));
+    machine.cpu.set_irq_line(true);
+    run_recorded(rewind, machine, 3000);
+    const u64 asserted = machine.cpu.get_cycles();
+    machine.cpu.set_irq_line(false);
+    run_recorded(rewind, machine, 3000);
+
+    // when:
+    ASSERT_TRUE(rewind.rewind_to(asserted, machine.cpu, *machine.memory).has_value());
+
+    // then:
+    EXPECT_TRUE(machine.cpu.get_irq_line());
+}
@@ -0,0 +1,194 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <memory>
+#include <vector>
+#include "cpu6502/assembler.hpp"
+#include "cpu6502/save_state.hpp"
+#include "test_support.hpp"
+
+using namespace cpu6502;
+using namespace cpu6502::test;
+
+namespace {
+
+// Adds 3 to A 20 times, then stops on BRK
+constexpr FixedString kSource = R"(
+        .org $8000
+        LDX #20
+loop:   CLC
+add:    ADC #$03
+step:   DEX
+        BNE loop
+        BRK
+)";
+
+constexpr auto kProgram = assemble<kSource>();
+constexpr u16  kAdd     = assembled_value<kSource>("add");
+constexpr u16  kStep    = assembled_value<kSource>("step");
+
+}  // namespace
+
+TEST(SaveStateTest, RestoredMachineContinuesIdentically) {
+    // given: a machine stopped half way through its loop
+    Machine original(kProgram);
+    StopCondition half;
+    half.max_cycles = 60;
+    ASSERT_TRUE(original.cpu.run(half, *original.memory).has_value());
+    (*original.memory)[0x0042] = 0x99;
+
+    auto state = std::make_unique<SaveState>();
+    save_state(original.cpu, *original.memory, *state);
+
+    // when:
+    Machine restored(kProgram);
+    restored.cpu.set_x(0);
+    ASSERT_TRUE(load_state(*state, restored.cpu, *restored.memory).has_value());
+
+    StopCondition to_end;
+    to_end.stop_on_brk = true;
+    auto a = original.cpu.run(to_end, *original.memory);
+    auto b = restored.cpu.run(to_end, *restored.memory);
+
+    // then:
+    ASSERT_TRUE(a.has_value());
+    ASSERT_TRUE(b.has_value());
+    EXPECT_EQ(a->cycles, b->cycles);
+    EXPECT_EQ(original.cpu.get_a(), restored.cpu.get_a());
+    EXPECT_EQ(original.cpu.get_cycles(), restored.cpu.get_cycles());
+    EXPECT_EQ(original.cpu.get_flags().to_byte(), restored.cpu.get_flags().to_byte());
+    EXPECT_EQ((*restored.memory)[0x0042], 0x99);
+}
+
+TEST(SaveStateTest, ArmedBreakpointIsSavedAsTheOriginalByte) {
+    // given: a breakpoint on DEX
+    Machine original(kProgram);
+    ASSERT_TRUE(original.memory->set_trap(kStep));
+
+    // when: restored into a machine without breakpoints
+    auto state = std::make_unique<SaveState>();
+    save_state(original.cpu, *original.memory, *state);
+    auto fresh = std::make_unique<Memory>();
+    CPU  cpu;
+    ASSERT_TRUE(load_state(*state, cpu, *fresh).has_value());
+
+    // then: the program runs through
+    EXPECT_EQ(state->memory[kStep], static_cast<u8>(Opcode::DEX));
+    EXPECT_TRUE(original.memory->is_trap(kStep));
+    auto result = cpu.run(StopCondition{.stop_on_brk = true}, *fresh);
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(result->reason, StopReason::Brk);
+    EXPECT_EQ(cpu.get_a(), 60);
+}
+
+TEST(SaveStateTest, LoadingKeepsTargetBreakpointsArmed) {
+    // given:
+    Machine source(kProgram);
+    auto    state = std::make_unique<SaveState>();
+    save_state(source.cpu, *source.memory, *state);
+
+    Machine target(kProgram);
+    ASSERT_TRUE(target.memory->set_trap(kStep));
+
+    // when:
+    ASSERT_TRUE(load_state(*state, target.cpu, *target.memory).has_value());
+    auto result = target.cpu.run(StopCondition{.stop_on_brk = true}, *target.memory);
+
+    // then:
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(result->reason, StopReason::Breakpoint);
+    EXPECT_EQ(target.cpu.get_pc(), kStep);
+    EXPECT_EQ(target.memory->read_byte(kStep).value(), static_cast<u8>(Opcode::DEX));
+}
+
+TEST(SaveStateTest, HeaderHasFixedLittleEndianLayout) {
+    // given:
+    Machine machine(kProgram);
+    machine.cpu.set_pc(0x1234);
+    machine.cpu.set_cycles(0x0102030405060708ull);
+    auto state = std::make_unique<SaveState>();
+
+    // when:
+    save_state(machine.cpu, *machine.memory, *state);
+    const auto bytes = state_bytes(*state);
+
+    // then:
+    EXPECT_EQ(bytes.size(), 32u + Memory::MAX_MEM);
+    EXPECT_EQ(bytes[0], '6');
+    EXPECT_EQ(bytes[4], SaveState::VERSION & 0xFF);
+    EXPECT_EQ(bytes[8], 0x08);
+    EXPECT_EQ(bytes[15], 0x01);
+    EXPECT_EQ(bytes[16], 0x34);
+    EXPECT_EQ(bytes[17], 0x12);
+    EXPECT_EQ(bytes[32 + kAdd], static_cast<u8>(Opcode::ADC_IM));
+}
+
+TEST(SaveStateTest, InterruptInputsAreSavedAndRestored) {
+    // given: an asserted IRQ line and an NMI not yet taken
+    Machine source(kProgram);
+    source.cpu.set_irq_line(true);
+    source.cpu.trigger_nmi();
+    auto state = std::make_unique<SaveState>();
+
+    // when:
+    save_state(source.cpu, *source.memory, *state);
+    Machine target(kProgram);
+    ASSERT_TRUE(load_state(*state, target.cpu, *target.memory).has_value());
+
+    // then:
+    EXPECT_EQ(state_bytes(*state)[23], 0x03);
+    EXPECT_TRUE(target.cpu.get_irq_line());
+    EXPECT_TRUE(target.cpu.get_nmi_pending());
+
+    // when: a state saved with both inputs idle
+    Machine idle(kProgram);
+    save_state(idle.cpu, *idle.memory, *state);
+    ASSERT_TRUE(load_state(*state, target.cpu, *target.memory).has_value());
+
+    // then:
+    EXPECT_FALSE(target.cpu.get_irq_line());
+    EXPECT_FALSE(target.cpu.get_nmi_pending());
+}
+
+TEST(SaveStateTest, SerializedBytesRoundTrip) {
+    // given:
+    Machine machine(kProgram);
+    auto saved = std::make_unique<SaveState>();
+    save_state(machine.cpu, *machine.memory, *saved);
+    const auto bytes = state_bytes(*saved);
+    std::vector<u8> file(bytes.begin(), bytes.end());
+
+    // when:
+    auto loaded = std::make_unique<SaveState>();
+    auto result = read_state(file, *loaded);
+
+    // then:
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(loaded->memory, saved->memory);
+    EXPECT_EQ(loaded->pc, saved->pc);
+}
+
+TEST(SaveStateTest, WrongVersionOrSizeIsRejected) {
+    // given:
+    Machine machine(kProgram);
+    auto state = std::make_unique<SaveState>();
+    save_state(machine.cpu, *machine.memory, *state);
+    state->version[0] = static_cast<u8>(SaveState::VERSION + 1);
+    const auto bytes = state_bytes(*state);
+
+    // when:
+    auto loaded    = std::make_unique<SaveState>();
+    loaded->a      = 0x55;
+    auto truncated = read_state(bytes.first(100), *loaded);
+    auto versioned = read_state(bytes, *loaded);
+    Machine target(kProgram);
+    target.cpu.set_a(0x77);
+    auto restored = load_state(*state, target.cpu, *target.memory);
+
+    // then:
+    EXPECT_EQ(truncated.error(), EmulatorError::InvalidSaveState);
+    EXPECT_EQ(versioned.error(), EmulatorError::InvalidSaveState);
+    EXPECT_EQ(loaded->a, 0x55);  // Rejected files are not copied in
+    EXPECT_TRUE(std::ranges::all_of(loaded->magic, [](u8 b) { return b == 0; }));
+    EXPECT_EQ(restored.error(), EmulatorError::InvalidSaveState);
+    EXPECT_EQ(target.cpu.get_a(), 0x77);
+}
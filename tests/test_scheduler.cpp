@@ -0,0 +1,193 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <vector>
+#include "cpu6502/assembler.hpp"
+#include "cpu6502/scheduler.hpp"
+#include "test_support.hpp"
+
+using namespace cpu6502;
+using namespace cpu6502::test;
+
+namespace {
+
+// Adds 3 to A, X times, then stops on BRK
+constexpr auto kProgram = assemble<R"(
+        .org $8000
+loop:   CLC
+        ADC #$03
+        DEX
+        BNE loop
+        BRK
+)">();
+
+// The program with X preset, and where its scheduled run leaves the outcome
+struct Job : Machine {
+    std::expected<RunResult, EmulatorError> result = std::unexpected(EmulatorError::InvalidOpcode);
+
+    explicit Job(u8 count) : Machine(kProgram) { cpu.set_x(count); }
+};
+
+Task record(Scheduler& scheduler, std::string& log, char name, int turns) {
+    for (int i = 0; i < turns; ++i) {
+        log.push_back(name);
+        co_await scheduler.yield();
+    }
+}
+
+Task wait_for(Event& event, bool& woke) {
+    co_await event;
+    woke = true;
+}
+
+}  // namespace
+
+TEST(SchedulerTest, SlicedMachinesMatchDirectRun) {
+    // given:
+    Scheduler scheduler;
+    StopCondition stop;
+    stop.stop_on_brk = true;
+
+    std::vector<std::unique_ptr<Job>> machines;
+    for (unsigned i = 0; i < 300; ++i) {
+        machines.push_back(std::make_unique<Job>(static_cast<u8>(1 + i % 40)));
+        auto& m = *machines.back();
+        scheduler.spawn(run_machine(scheduler, m.cpu, *m.memory, stop, 16, m.result));
+    }
+
+    // when:
+    scheduler.run();
+
+    // then:
+    EXPECT_EQ(scheduler.pending(), 0u);
+    for (unsigned i = 0; i < machines.size(); ++i) {
+        Job reference(static_cast<u8>(1 + i % 40));
+        auto expected = reference.cpu.run(stop, *reference.memory);
+
+        ASSERT_TRUE(machines[i]->result.has_value()) << "machine " << i;
+        EXPECT_EQ(machines[i]->result->reason, StopReason::Brk);
+        EXPECT_EQ(machines[i]->result->cycles, expected->cycles) << "machine " << i;
+        EXPECT_EQ(machines[i]->result->instructions, expected->instructions) << "machine " << i;
+        EXPECT_EQ(machines[i]->cpu.get_a(), reference.cpu.get_a()) << "machine " << i;
+    }
+}
+
+TEST(SchedulerTest, CycleLimitSplitAcrossSlicesMatchesDirectRun) {
+    // given:
+    Scheduler scheduler;
+    StopCondition stop;
+    stop.max_cycles = 101;
+
+    Job sliced(200);
+    Job reference(200);
+    scheduler.spawn(run_machine(scheduler, sliced.cpu, *sliced.memory, stop, 7, sliced.result));
+
+    // when:
+    scheduler.run();
+    auto expected = reference.cpu.run(stop, *reference.memory);
+
+    // then:
+    ASSERT_TRUE(sliced.result.has_value());
+    EXPECT_EQ(sliced.result->reason, StopReason::CycleLimit);
+    EXPECT_EQ(sliced.result->cycles, expected->cycles);
+    EXPECT_EQ(sliced.cpu.get_registers().pc, reference.cpu.get_registers().pc);
+}
+
+TEST(SchedulerTest, YieldInterleavesTasksRoundRobin) {
+    // given:
+    Scheduler scheduler;
+    std::string log;
+    scheduler.spawn(record(scheduler, log, 'a', 3));
+    scheduler.spawn(record(scheduler, log, 'b', 3));
+
+    // when:
+    scheduler.run();
+
+    // then:
+    EXPECT_EQ(log, "ababab");
+}
+
+TEST(SchedulerTest, RunReturnsWhileTasksWaitOnEvent) {
+    // given:
+    Scheduler scheduler;
+    Event event(scheduler);
+    bool woke = false;
+    scheduler.spawn(wait_for(event, woke));
+
+    // when:
+    scheduler.run();
+
+    // then:
+    EXPECT_FALSE(woke);
+    EXPECT_EQ(scheduler.pending(), 1u);
+
+    // when:
+    event.set();
+    scheduler.run();
+
+    // then:
+    EXPECT_TRUE(woke);
+    EXPECT_EQ(scheduler.pending(), 0u);
+}
+
+TEST(SchedulerTest, DestroyingTheSchedulerFreesParkedTasks) {
+    // given: a task parked on an event that is never set
+    struct Guard {
+        bool& destroyed;
+        ~Guard() { destroyed = true; }
+    };
+    auto parked = [](Event& event, bool& destroyed) -> Task {
+        Guard guard{destroyed};
+        co_await event;
+    };
+
+    bool destroyed = false;
+    {
+        Scheduler scheduler;
+        Event     event(scheduler);
+        scheduler.spawn(parked(event, destroyed));
+        scheduler.run();
+        ASSERT_EQ(scheduler.pending(), 1u);
+
+        // when:
+    }
+
+    // then: its frame, and the locals in it, are gone
+    EXPECT_TRUE(destroyed);
+}
+
+TEST(SchedulerTest, SetEventDoesNotSuspend) {
+    Scheduler scheduler;
+    Event event(scheduler);
+    event.set();
+    bool woke = false;
+    scheduler.spawn(wait_for(event, woke));
+
+    scheduler.run();
+
+    EXPECT_TRUE(woke);
+}
+
+TEST(SchedulerTest, SeveralThreadsRunEveryMachine) {
+    // given:
+    Scheduler scheduler(4);
+    StopCondition stop;
+    stop.stop_on_brk = true;
+
+    std::vector<std::unique_ptr<Job>> machines;
+    for (unsigned i = 0; i < 100; ++i) {
+        machines.push_back(std::make_unique<Job>(static_cast<u8>(1 + i % 20)));
+        auto& m = *machines.back();
+        scheduler.spawn(run_machine(scheduler, m.cpu, *m.memory, stop, 10, m.result));
+    }
+
+    // when:
+    scheduler.run();
+
+    // then:
+    EXPECT_EQ(scheduler.pending(), 0u);
+    for (unsigned i = 0; i < machines.size(); ++i) {
+        ASSERT_TRUE(machines[i]->result.has_value()) << "machine " << i;
+        EXPECT_EQ(machines[i]->cpu.get_a(), static_cast<u8>((1 + i % 20) * 3)) << "machine " << i;
+    }
+}
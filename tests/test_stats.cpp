@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+#include <type_traits>
+#include "cpu6502/assembler.hpp"
+#include "cpu6502/cpu.hpp"
+#include "cpu6502/memory.hpp"
+#include "test_support.hpp"
+
+using namespace cpu6502;
+using namespace cpu6502::test;
+
+namespace {
+
+// Three indexed loads that cross into page 3, then a loop branch taken twice
+constexpr FixedString kSource = R"(
+        .org $8000
+        LDX #$03
+loop:   LDA $02FF,X
+        DEX
+        BNE loop
+done:
+)";
+
+constexpr auto kProgram = assemble<kSource>();
+
+}  // namespace
+
+class StatsTest : public ::testing::Test {
+ protected:
+    Memory mem;
+    CPU    cpu;
+
+    void SetUp() override {
+        ASSERT_TRUE(mem.load(assembled_origin<kSource>(), kProgram).has_value());
+        cpu.set_pc(assembled_origin<kSource>());
+        cpu.set_sp(0xFF);
+    }
+
+    void run_program() {
+        StopCondition stop;
+        stop.stop_pc = assembled_value<kSource>("done");
+        ASSERT_TRUE(cpu.run(stop, mem).has_value());
+    }
+};
+
+// test_stats always defines CPU6502_STATS; test_stats_configured follows CPU6502_ENABLE_STATS
+#ifndef CPU6502_STATS
+
+TEST(StatsDisabledTest, CollectorIsEmptyWhenCompiledOut) {
+    // given:
+    Memory mem;
+    CPU    cpu;
+    mem[0x8000] = op(Opcode::INX);
+    cpu.set_pc(0x8000);
+
+    // when:
+    ASSERT_TRUE(cpu.step(mem).has_value());
+
+    // then:
+    EXPECT_TRUE(std::is_empty_v<StatsCollector>);
+    EXPECT_EQ(cpu.stats().snapshot().total_instructions(), 0u);
+}
+
+#else
+
+TEST_F(StatsTest, CountsExecutionsAndCyclesPerOpcode) {
+    // when:
+    run_program();
+    const ExecutionStats stats = cpu.stats().snapshot();
+
+    // then:
+    EXPECT_EQ(stats.executions[op(Opcode::LDX_IM)], 1u);
+    EXPECT_EQ(stats.executions[op(Opcode::LDA_ABSX)], 3u);
+    EXPECT_EQ(stats.executions[op(Opcode::DEX)], 3u);
+    EXPECT_EQ(stats.executions[op(Opcode::BNE)], 3u);
+    EXPECT_EQ(stats.cycles[op(Opcode::LDA_ABSX)], 15u);
+    EXPECT_EQ(stats.cycles[op(Opcode::BNE)], 8u);
+    EXPECT_EQ(stats.total_instructions(), 10u);
+    EXPECT_EQ(stats.total_cycles(), cpu.get_cycles());
+}
+
+TEST_F(StatsTest, CountsPageCrossesAndBranchOutcomes) {
+    // when:
+    run_program();
+    const ExecutionStats stats = cpu.stats().snapshot();
+
+    // then:
+    EXPECT_EQ(stats.page_crossings, 3u);
+    EXPECT_EQ(stats.taken(Opcode::BNE), 2u);
+    EXPECT_EQ(stats.not_taken(Opcode::BNE), 1u);
+    EXPECT_EQ(stats.taken(Opcode::BEQ), 0u);
+}
+
+TEST_F(StatsTest, ResetClearsCountersButSnapshotsAreKept) {
+    // given:
+    run_program();
+    const ExecutionStats before = cpu.stats().snapshot();
+
+    // when:
+    cpu.stats().reset();
+
+    // then:
+    EXPECT_EQ(cpu.stats().snapshot().total_instructions(), 0u);
+    EXPECT_EQ(before.total_instructions(), 10u);
+}
+
+#endif
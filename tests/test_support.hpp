@@ -0,0 +1,31 @@
+#pragma once
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <span>
+#include "cpu6502/cpu.hpp"
+#include "cpu6502/memory.hpp"
+#include "cpu6502/opcodes.hpp"
+#include "cpu6502/types.hpp"
+
+// Helpers shared by the test executables
+
+namespace cpu6502::test {
+
+constexpr u8 op(Opcode opcode) {
+    return static_cast<u8>(opcode);
+}
+
+// A CPU with a program loaded at origin, PC on its first byte and an empty stack
+struct Machine {
+    CPU                     cpu;
+    std::unique_ptr<Memory> memory = std::make_unique<Memory>();  // 64 KiB, kept off the stack
+
+    explicit Machine(std::span<const u8> program, u16 origin = 0x8000) {
+        EXPECT_TRUE(memory->load(origin, program).has_value());
+        cpu.set_pc(origin);
+        cpu.set_sp(0xFF);
+    }
+};
+
+}  // namespace cpu6502::test
@@ -0,0 +1,203 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "cpu6502/assembler.hpp"
+#include "cpu6502/system.hpp"
+#include "test_support.hpp"
+
+using namespace cpu6502;
+using namespace cpu6502::test;
+
+namespace {
+
+// Producer: spins on a private counter, then bumps the shared mailbox at $0200
+constexpr FixedString kProducerSource = R"(
+        .org $8000
+mailbox = $0200
+start:  LDX #$10
+spin:   DEX
+        BNE spin
+        INC mailbox
+        BVC start       ; V is clear: always taken
+)";
+
+// Consumer: polls the mailbox, then counts in Y until the producer bumps it again
+constexpr FixedString kConsumerSource = R"(
+        .org $9000
+mailbox = $0200
+poll:   LDA mailbox
+        BEQ poll
+count:  INY
+        CMP mailbox
+        BEQ count
+        BVC poll
+)";
+
+void load_producer_consumer(System& system) {
+    constexpr u16 producer_origin = assembled_origin<kProducerSource>();
+    constexpr u16 consumer_origin = assembled_origin<kConsumerSource>();
+    ASSERT_TRUE(system.bus().load(producer_origin, assemble<kProducerSource>()).has_value());
+    ASSERT_TRUE(system.bus().load(consumer_origin, assemble<kConsumerSource>()).has_value());
+    system.share_page(0x02);
+
+    Registers producer;
+    producer.pc = producer_origin;
+    system.cpu(0).set_registers(producer);
+
+    Registers consumer;
+    consumer.pc = consumer_origin;
+    system.cpu(1).set_registers(consumer);
+}
+
+void expect_same_state(const System& a, const System& b) {
+    ASSERT_EQ(a.cpu_count(), b.cpu_count());
+    for (std::size_t i = 0; i < a.cpu_count(); ++i) {
+        const auto ra = a.cpu(i).get_registers();
+        const auto rb = b.cpu(i).get_registers();
+        EXPECT_EQ(a.time(i), b.time(i)) << "cpu " << i;
+        EXPECT_EQ(ra.pc, rb.pc) << "cpu " << i;
+        EXPECT_EQ(ra.a, rb.a) << "cpu " << i;
+        EXPECT_EQ(ra.x, rb.x) << "cpu " << i;
+        EXPECT_EQ(ra.y, rb.y) << "cpu " << i;
+        EXPECT_EQ(ra.flags.to_byte(), rb.flags.to_byte()) << "cpu " << i;
+    }
+    EXPECT_EQ(a.bus()[0x0200], b.bus()[0x0200]);
+}
+
+// Every record an observer receives, interrupts included
+struct Recorder : ExecutionObserver {
+    std::vector<TraceRecord> records;
+
+    void on_instruction(const TraceRecord& record) noexcept override {
+        records.push_back(record);
+    }
+    void on_interrupt(const TraceRecord& record, InterruptKind) noexcept override {
+        records.push_back(record);
+    }
+};
+
+}  // namespace
+
+TEST(MemoryGuardTest, GuardedPageRejectsReadsAndWrites) {
+    // given:
+    Memory memory;
+    memory[0x0210] = 0x42;
+    memory.guard_page(0x02);
+
+    // when / then:
+    EXPECT_EQ(memory.read_byte(0x0210).error(), EmulatorError::GuardedPageAccess);
+    EXPECT_EQ(memory.write_byte(0x0210, 1).error(), EmulatorError::GuardedPageAccess);
+    EXPECT_EQ(memory.read_word(0x01FF).error(), EmulatorError::GuardedPageAccess);
+    EXPECT_EQ(memory[0x0210], 0x42);
+    EXPECT_TRUE(memory.read_byte(0x0310).has_value());
+
+    memory.clear_guards();
+    EXPECT_EQ(memory.read_byte(0x0210).value(), 0x42);
+}
+
+TEST(SystemTest, InstructionInterleaveRunsEarliestCpuFirst) {
+    // given: two CPUs counting with INX at 2 cycles each
+    System system(2);
+    constexpr auto program = assemble<R"(
+            .org $8000
+    count:  INX
+            BVC count
+    )">();
+    ASSERT_TRUE(system.bus().load(0x8000, program).has_value());
+    Registers start;
+    start.pc = 0x8000;
+    system.cpu(0).set_registers(start);
+    system.cpu(1).set_registers(start);
+
+    // when:
+    ASSERT_TRUE(system.run(101, Interleave::Instruction).has_value());
+
+    // then: both clocks reach the target, neither runs past its last instruction
+    EXPECT_GE(system.time(0), 101u);
+    EXPECT_GE(system.time(1), 101u);
+    EXPECT_LT(system.time(0), 101u + 3u);
+    EXPECT_EQ(system.time(0), system.time(1));
+}
+
+TEST(SystemTest, SliceModeMatchesInstructionInterleave) {
+    for (u64 slice : {1ull, 7ull, 64ull, 4096ull}) {
+        // given:
+        System reference(2);
+        System sliced(2);
+        load_producer_consumer(reference);
+        load_producer_consumer(sliced);
+        sliced.set_slice(slice);
+
+        // when:
+        ASSERT_TRUE(reference.run(5000, Interleave::Instruction).has_value());
+        ASSERT_TRUE(sliced.run(5000, Interleave::Slice).has_value());
+
+        // then:
+        SCOPED_TRACE(slice);
+        expect_same_state(reference, sliced);
+        EXPECT_GT(sliced.bus()[0x0200], 0);
+        EXPECT_GT(sliced.cpu(1).get_y(), 0);
+    }
+}
+
+TEST(SystemTest, RunCanBeResumedInSteps) {
+    // given:
+    System once(2);
+    System stepped(2);
+    load_producer_consumer(once);
+    load_producer_consumer(stepped);
+
+    // when:
+    ASSERT_TRUE(once.run(3000).has_value());
+    for (int i = 0; i < 30; ++i) {
+        ASSERT_TRUE(stepped.run(100).has_value());
+    }
+
+    // then:
+    expect_same_state(once, stepped);
+    EXPECT_FALSE(stepped.bus().is_guarded(0x0200));
+}
+
+TEST(SystemTest, CpuErrorStopsTheSystem) {
+    // given: an invalid opcode on the second CPU
+    System system(2);
+    system.bus()[0x9000] = 0x02;
+    Registers start;
+    start.pc = 0x9000;
+    system.cpu(1).set_registers(start);
+    start.pc = 0x8000;
+    system.cpu(0).set_registers(start);
+    system.bus()[0x8000] = op(Opcode::CLC);
+
+    // when:
+    auto result = system.run(100);
+
+    // then:
+    ASSERT_FALSE(result.has_value());
+    EXPECT_EQ(result.error(), EmulatorError::InvalidOpcode);
+}
+
+TEST(SystemTest, ObserverSeesRolledBackInstructionsOnce) {
+    // given: the consumer polls the shared mailbox, so its slices keep faulting
+    System reference(2);
+    System sliced(2);
+    load_producer_consumer(reference);
+    load_producer_consumer(sliced);
+    sliced.set_slice(64);
+
+    Recorder expected;
+    Recorder actual;
+    reference.cpu(1).set_observer(&expected);
+    sliced.cpu(1).set_observer(&actual);
+
+    // when:
+    ASSERT_TRUE(reference.run(5000, Interleave::Instruction).has_value());
+    ASSERT_TRUE(sliced.run(5000, Interleave::Slice).has_value());
+
+    // then: the same records in the same order, and the observer is still attached
+    ASSERT_EQ(actual.records.size(), expected.records.size());
+    for (std::size_t i = 0; i < expected.records.size(); ++i) {
+        EXPECT_EQ(actual.records[i].cycles, expected.records[i].cycles) << "record " << i;
+        EXPECT_EQ(actual.records[i].pc, expected.records[i].pc) << "record " << i;
+    }
+    EXPECT_EQ(sliced.cpu(1).get_observer(), &actual);
+}
@@ -0,0 +1,193 @@
+#include <gtest/gtest.h>
+#include <sstream>
+#include <streambuf>
+#include "cpu6502/assembler.hpp"
+#include "cpu6502/cpu.hpp"
+#include "cpu6502/timeline.hpp"
+#include "test_support.hpp"
+
+using namespace cpu6502;
+using namespace cpu6502::test;
+
+namespace {
+
+constexpr FixedString kSource = R"(
+        .org $8000
+main:   CLI
+loop:   JSR worker
+        CLV
+        BVC loop
+worker: INX
+        RTS
+irq:    INC $30
+        CLV
+        BVC loop
+)";
+
+constexpr auto kProgram = assemble<kSource>();
+
+auto count(const std::string& text, std::string_view needle) -> std::size_t {
+    std::size_t found = 0;
+    for (auto at = text.find(needle); at != std::string::npos; at = text.find(needle, at + 1)) {
+        ++found;
+    }
+    return found;
+}
+
+// Runs main for a while, takes one IRQ and marks a frame
+auto record(TimelineFormat format) -> std::string {
+    Machine machine(kProgram);
+    CPU&    cpu = machine.cpu;
+    Memory& mem = *machine.memory;
+    EXPECT_TRUE(mem.write_word(CPU::IRQ_VECTOR, assembled_value<kSource>("irq")).has_value());
+
+    SymbolTable symbols;
+    symbols.add(assembled_value<kSource>("main"), "main");
+    symbols.add(assembled_value<kSource>("worker"), "worker");
+
+    std::ostringstream out;
+    {
+        TimelineWriter writer(out, format, &symbols);
+        cpu.set_observer(&writer);
+
+        StopCondition stop;
+        stop.max_cycles = 100;
+        writer.begin("frame", cpu.get_cycles());
+        EXPECT_TRUE(cpu.run(stop, mem).has_value());
+        cpu.set_irq_line(true);
+        EXPECT_TRUE(cpu.step(mem).has_value());
+        cpu.set_irq_line(false);
+        EXPECT_TRUE(cpu.run(stop, mem).has_value());
+        writer.end(cpu.get_cycles());
+        writer.marker("vblank", cpu.get_cycles());
+        writer.finish(cpu.get_cycles());
+    }
+    return out.str();
+}
+
+/**
+ * @type class
+ * @brief Stream buffer that takes limit bytes and then fails every write
+ */
+class FailingBuffer final : public std::streambuf {
+ public:
+    explicit FailingBuffer(std::size_t limit) : limit_(limit) {}
+
+ protected:
+    int_type overflow(int_type c) override {
+        if (written_ == limit_) {
+            return traits_type::eof();
+        }
+        ++written_;
+        return traits_type::not_eof(c);
+    }
+
+ private:
+    std::size_t limit_;
+    std::size_t written_ = 0;
+};
+
+auto read_varint(const std::string& bytes, std::size_t& at) -> u64 {
+    u64 value = 0;
+    for (unsigned shift = 0; at < bytes.size(); shift += 7) {
+        const auto byte = static_cast<u8>(bytes[at++]);
+        value |= static_cast<u64>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            break;
+        }
+    }
+    return value;
+}
+
+}  // namespace
+
+TEST(TimelineTest, ChromeJsonHasBalancedSpans) {
+    // when:
+    const std::string json = record(TimelineFormat::ChromeJson);
+
+    // then:
+    EXPECT_TRUE(json.starts_with("{\"displayTimeUnit\":\"ns\",\"traceEvents\":["));
+    EXPECT_TRUE(json.ends_with("]}\n"));
+    EXPECT_GT(count(json, "\"name\":\"worker\""), 5u);
+    EXPECT_EQ(count(json, "\"name\":\"IRQ\""), 1u);
+    EXPECT_EQ(count(json, "\"name\":\"frame\""), 1u);
+    EXPECT_EQ(count(json, "\"ph\":\"i\""), 1u);
+    EXPECT_EQ(count(json, "\"ph\":\"B\""), count(json, "\"ph\":\"E\""));
+}
+
+TEST(TimelineTest, WorkerSpanCoversItsInstructions) {
+    // when:
+    const std::string json = record(TimelineFormat::ChromeJson);
+
+    // then: CLI (2) + JSR (6) puts the first instruction of worker at cycle 8,
+    // INX (2) + RTS (6) closes it at cycle 16
+    EXPECT_NE(json.find("{\"ph\":\"B\",\"ts\":8,\"pid\":1,\"tid\":1,\"name\":\"worker\"}"),
+              std::string::npos);
+    EXPECT_NE(json.find("{\"ph\":\"E\",\"ts\":16,\"pid\":1,\"tid\":1}"), std::string::npos);
+}
+
+TEST(TimelineTest, PerfettoStreamIsASequenceOfPackets) {
+    // when:
+    const std::string proto = record(TimelineFormat::Perfetto);
+
+    // then: every top-level field is Trace.packet (field 1, length-delimited)
+    std::size_t packets = 0;
+    std::size_t at      = 0;
+    while (at < proto.size()) {
+        ASSERT_EQ(static_cast<u8>(proto[at++]), 0x0A);
+        const u64 length = read_varint(proto, at);
+        ASSERT_LE(at + length, proto.size());
+        at += length;
+        ++packets;
+    }
+    EXPECT_EQ(at, proto.size());
+
+    const std::string json = record(TimelineFormat::ChromeJson);
+    const std::size_t events = count(json, "\"ph\":");
+    EXPECT_EQ(packets, events);  // Track descriptors stand in for the thread_name events
+    EXPECT_NE(proto.find("worker"), std::string::npos);
+    EXPECT_NE(proto.find("IRQ"), std::string::npos);
+}
+
+TEST(TimelineTest, StreamFailureIsRecordedInsteadOfThrown) {
+    // given: a stream that throws once its buffer fills, after the header fits
+    Machine machine(kProgram);
+    CPU&    cpu = machine.cpu;
+
+    FailingBuffer buffer(512);
+    std::ostream  out(&buffer);
+    out.exceptions(std::ios::badbit);
+    TimelineWriter writer(out, TimelineFormat::ChromeJson);
+    cpu.set_observer(&writer);
+
+    // when:
+    StopCondition stop;
+    stop.max_cycles = 1000;
+    auto result     = cpu.run(stop, *machine.memory);
+
+    // then:
+    ASSERT_TRUE(result.has_value());
+    EXPECT_TRUE(writer.failed());
+    writer.finish(cpu.get_cycles());
+    cpu.set_observer(nullptr);
+}
+
+TEST(TimelineTest, LongAndEscapedNamesAreWrittenWhole) {
+    // given:
+    const std::string long_name(200, 'x');
+    std::ostringstream out;
+
+    // when:
+    {
+        TimelineWriter writer(out, TimelineFormat::ChromeJson);
+        writer.marker(long_name, 18'446'744'073'709'551'615ull);
+        writer.marker("tab\there \"quoted\" \\", 1);
+    }
+
+    // then:
+    const std::string json = out.str();
+    EXPECT_NE(json.find("\"ts\":18446744073709551615,\"pid\":1,\"tid\":2,\"name\":\"" + long_name +
+                        "\",\"s\":\"t\"}"),
+              std::string::npos);
+    EXPECT_NE(json.find(R"("name":"tab\u0009here \"quoted\" \\")"), std::string::npos);
+}
@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "cpu6502/cpu.hpp"
+#include "cpu6502/opcodes.hpp"
+#include "cpu6502/trace_ring.hpp"
+
+using namespace cpu6502;
+
+namespace {
+
+// Adds 3 to A, X times, then stops on BRK
+constexpr std::array<u8, 8> kProgram = {
+    static_cast<u8>(Opcode::CLC),           // $8000 CLC
+    static_cast<u8>(Opcode::ADC_IM), 0x03,  // $8001 ADC #$03
+    static_cast<u8>(Opcode::DEX),           // $8003 DEX
+    static_cast<u8>(Opcode::BNE),    0xFA,  // $8004 BNE $8000
+    static_cast<u8>(Opcode::BRK),    0x00,  // $8006 BRK
+};
+
+auto make_memory() -> std::unique_ptr<Memory> {
+    auto memory = std::make_unique<Memory>();
+    EXPECT_TRUE(memory->load(0x8000, kProgram).has_value());
+    return memory;
+}
+
+auto record_at(u64 cycles) -> TraceRecord {
+    return TraceRecord{cycles, 0x8000, 0xEA, 0, 0, 0, 0xFF, 0x20};
+}
+
+}  // namespace
+
+TEST(TraceRingTest, CpuWritesOneRecordPerInstruction) {
+    // given:
+    auto memory = make_memory();
+    CPU cpu;
+    cpu.set_pc(0x8000);
+    cpu.set_sp(0xFF);
+    cpu.set_x(2);
+    TraceRing ring(64);
+    cpu.set_observer(&ring);
+
+    StopCondition stop;
+    stop.stop_on_brk = true;
+
+    // when:
+    auto result = cpu.run(stop, *memory);
+
+    // then:
+    ASSERT_TRUE(result.has_value());
+    ASSERT_EQ(ring.size(), result->instructions);
+
+    std::vector<TraceRecord> records(ring.size());
+    EXPECT_EQ(ring.pop_bulk(records), records.size());
+
+    EXPECT_EQ(records[0].pc, 0x8000);
+    EXPECT_EQ(records[0].opcode, static_cast<u8>(Opcode::CLC));
+    EXPECT_EQ(records[0].cycles, 0u);
+    EXPECT_EQ(records[0].x, 2);
+    EXPECT_EQ(records[1].pc, 0x8001);
+    EXPECT_EQ(records[1].cycles, 2u);
+    EXPECT_EQ(records[2].a, 3);
+    EXPECT_EQ(records[4].pc, 0x8000);  // Second loop iteration
+    EXPECT_EQ(records.back().cycles + 2, cpu.get_cycles());
+}
+
+TEST(TraceRingTest, DropPolicyCountsOverflow) {
+    // given:
+    TraceRing ring(4, OverflowPolicy::Drop);
+
+    // when:
+    for (u64 i = 0; i < 10; ++i) {
+        ring.push(record_at(i));
+    }
+
+    // then:
+    EXPECT_EQ(ring.size(), 4u);
+    EXPECT_EQ(ring.dropped(), 6u);
+
+    TraceRecord record{};
+    ASSERT_TRUE(ring.pop(record));
+    EXPECT_EQ(record.cycles, 0u);
+}
+
+TEST(TraceRingTest, CapacityRoundsUpToPowerOfTwo) {
+    TraceRing ring(100);
+
+    EXPECT_EQ(ring.capacity(), 128u);
+}
+
+TEST(TraceRingTest, BlockPolicyDeliversEveryRecordInOrder) {
+    // given:
+    constexpr u64 kCount = 100000;
+    TraceRing ring(16, OverflowPolicy::Block);
+
+    // when:
+    std::vector<u64> seen;
+    seen.reserve(kCount);
+    std::jthread consumer([&] {
+        std::array<TraceRecord, 8> batch{};
+        while (!ring.finished()) {
+            const std::size_t count = ring.pop_bulk(batch);
+            for (std::size_t i = 0; i < count; ++i) {
+                seen.push_back(batch[i].cycles);
+            }
+            if (count == 0) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    for (u64 i = 0; i < kCount; ++i) {
+        ring.push(record_at(i));
+    }
+    ring.close();
+    consumer.join();
+
+    // then:
+    EXPECT_EQ(ring.dropped(), 0u);
+    ASSERT_EQ(seen.size(), kCount);
+    for (u64 i = 0; i < kCount; ++i) {
+        ASSERT_EQ(seen[i], i);
+    }
+}